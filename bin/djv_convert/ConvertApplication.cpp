@@ -31,6 +31,7 @@
 
 #include <djv_convert/ConvertContext.h>
 
+#include <djvAV/AsyncSave.h>
 #include <djvAV/IO.h>
 
 #include <djvCore/Sequence.h>
@@ -171,7 +172,7 @@ namespace djv
                 arg(labelImage(loadInfo.layers[0], loadInfo.sequence)));
 
             // Open the output file.
-            std::unique_ptr<AV::Save> save;
+            std::unique_ptr<AV::AsyncSave> save;
             AV::IOInfo saveInfo(loadInfo.layers[layer]);
             glm::ivec2 scaleSize = loadInfo.layers[0].size;
             glm::ivec2 size = options.size;
@@ -238,7 +239,9 @@ namespace djv
             //DJV_DEBUG_PRINT("save sequence = " << saveInfo.sequence);
             try
             {
-                save = _context->ioFactory()->save(output.file, saveInfo);
+                // Write the images on a separate thread so that the output
+                // overlaps loading and converting the next image.
+                save.reset(new AV::AsyncSave(_context->ioFactory()->save(output.file, saveInfo)));
             }
             catch (Core::Error error)
             {
@@ -277,7 +280,7 @@ namespace djv
                         errorLabels()[ERROR_OPEN_SLATE].
                         arg(QDir::toNativeSeparators(input.slate)));
                     _context->printError(error);
-                    save->close();
+                    save.reset();
                     exit(1);
                     return;
                 }
@@ -299,7 +302,7 @@ namespace djv
                         errorLabels()[ERROR_WRITE_OUTPUT].
                         arg(QDir::toNativeSeparators(output.file)));
                     _context->printError(error);
-                    save->close();
+                    save.reset();
                     exit(1);
                     return;
                 }
@@ -350,7 +353,7 @@ namespace djv
                         errorLabels()[ERROR_READ_INPUT].
                         arg(QDir::toNativeSeparators(input.file)));
                     _context->printError(error);
-                    save->close();
+                    save.reset();
                     exit(1);
                     return;
                 }
@@ -397,7 +400,7 @@ namespace djv
                 try
                 {
                     save->write(
-                        *p,
+                        std::move(*p),
                         AV::ImageIOInfo(
                             saveInfo.sequence.frames.count() ?
                             saveInfo.sequence.frames[i] :
@@ -409,7 +412,7 @@ namespace djv
                         errorLabels()[ERROR_WRITE_OUTPUT].
                         arg(QDir::toNativeSeparators(output.file)));
                     _context->printError(error);
-                    save->close();
+                    save.reset();
                     exit(1);
                     return;
                 }
@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/AsyncSave.h>
+
+#include <djvAV/Image.h>
+
+#include <djvCore/Debug.h>
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QThread>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! This class provides a thread that runs a function.
+            class Thread : public QThread
+            {
+            public:
+                explicit Thread(const std::function<void(void)> & fnc) :
+                    _fnc(fnc)
+                {}
+
+            protected:
+                void run() override
+                {
+                    _fnc();
+                }
+
+            private:
+                std::function<void(void)> _fnc;
+            };
+
+        } // namespace
+
+        struct AsyncSave::Private
+        {
+            std::unique_ptr<Save> save;
+            size_t queueSize = 0;
+
+            std::deque<std::pair<Image, ImageIOInfo> > queue;
+            bool                    writing = false;
+            bool                    stop    = false;
+            std::exception_ptr      error;
+            std::mutex              mutex;
+            std::condition_variable cv;
+
+            QScopedPointer<QOffscreenSurface> offscreenSurface;
+            QScopedPointer<QOpenGLContext>    openGLContext;
+            std::unique_ptr<Thread>           thread;
+
+            void run();
+            void rethrow();
+        };
+
+        AsyncSave::AsyncSave(std::unique_ptr<Save> save, size_t queueSize) :
+            Save(save->fileInfo(), save->ioInfo(), save->context()),
+            _p(new Private)
+        {
+            //DJV_DEBUG("AsyncSave::AsyncSave");
+            //DJV_DEBUG_PRINT("queue size = " << queueSize);
+            _p->save = std::move(save);
+            _p->queueSize = std::max(queueSize, static_cast<size_t>(1));
+
+            // The surface must be created on the main thread.
+            _p->offscreenSurface.reset(new QOffscreenSurface);
+            QSurfaceFormat surfaceFormat = QSurfaceFormat::defaultFormat();
+            surfaceFormat.setSwapBehavior(QSurfaceFormat::SingleBuffer);
+            surfaceFormat.setSamples(1);
+            _p->offscreenSurface->setFormat(surfaceFormat);
+            _p->offscreenSurface->create();
+            _p->openGLContext.reset(new QOpenGLContext);
+            _p->openGLContext->setFormat(surfaceFormat);
+            _p->openGLContext->create();
+
+            Private * p = _p.get();
+            _p->thread.reset(new Thread([p] { p->run(); }));
+            _p->openGLContext->moveToThread(_p->thread.get());
+            _p->thread->start();
+        }
+
+        AsyncSave::~AsyncSave()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->queue.clear();
+                _p->stop = true;
+            }
+            _p->cv.notify_all();
+            _p->thread->wait();
+        }
+
+        size_t AsyncSave::queueSize() const
+        {
+            return _p->queueSize;
+        }
+
+        void AsyncSave::write(const Image & image, const ImageIOInfo & frame)
+        {
+            write(Image(image), frame);
+        }
+
+        void AsyncSave::write(Image && image, const ImageIOInfo & frame)
+        {
+            //DJV_DEBUG("AsyncSave::write");
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->cv.wait(lock, [this]
+                {
+                    return _p->error || _p->queue.size() < _p->queueSize;
+                });
+                _p->rethrow();
+                _p->queue.push_back(std::make_pair(std::move(image), frame));
+            }
+            _p->cv.notify_all();
+        }
+
+        void AsyncSave::close()
+        {
+            //DJV_DEBUG("AsyncSave::close");
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->cv.wait(lock, [this]
+                {
+                    return _p->queue.empty() && !_p->writing;
+                });
+                _p->rethrow();
+            }
+            _p->save->close();
+        }
+
+        void AsyncSave::Private::run()
+        {
+            openGLContext->makeCurrent(offscreenSurface.data());
+            while (true)
+            {
+                std::pair<Image, ImageIOInfo> item;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this]
+                    {
+                        return stop || !queue.empty();
+                    });
+                    if (queue.empty())
+                        break;
+                    item = std::move(queue.front());
+                    queue.pop_front();
+                    writing = true;
+                }
+                cv.notify_all();
+
+                std::exception_ptr exception;
+                try
+                {
+                    save->write(item.first, item.second);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                item.first = Image();
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    writing = false;
+                    if (exception)
+                    {
+                        // Keep the first error and discard the rest of the
+                        // queue; the images would be written out of order.
+                        if (!error)
+                        {
+                            error = exception;
+                        }
+                        queue.clear();
+                    }
+                }
+                cv.notify_all();
+            }
+            openGLContext->doneCurrent();
+        }
+
+        void AsyncSave::Private::rethrow()
+        {
+            if (error)
+            {
+                std::exception_ptr tmp = error;
+                error = nullptr;
+                std::rethrow_exception(tmp);
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
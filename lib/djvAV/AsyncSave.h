@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        //! This class provides a save that writes images on a separate thread.
+        //!
+        //! Images are queued and written in order by a writer thread, so the
+        //! caller can load and convert the next image while the previous one
+        //! is being written. The queue is bounded; write() blocks while it is
+        //! full. An error writing an image is thrown by the next call to
+        //! write() or close(), and the images queued after it are discarded.
+        //!
+        //! The writer thread has its own OpenGL context, so the wrapped save
+        //! may convert images with OpenGLImage.
+        class AsyncSave : public Save
+        {
+        public:
+            explicit AsyncSave(std::unique_ptr<Save>, size_t queueSize = 2);
+            ~AsyncSave() override;
+
+            //! Get the maximum number of queued images.
+            size_t queueSize() const;
+
+            //! Queue a copy of an image to be written.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void write(const Image &, const ImageIOInfo & = ImageIOInfo()) override;
+
+            //! Queue an image to be written, taking ownership of the data.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void write(Image &&, const ImageIOInfo & = ImageIOInfo());
+
+            //! Wait for the queued images to be written and close the file.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void close() override;
+
+        private:
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace AV
+} // namespace djv
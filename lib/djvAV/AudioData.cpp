@@ -29,6 +29,18 @@
 
 #include <djvAV/AudioData.h>
 
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+
+#include <algorithm>
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
 namespace djv
 {
     namespace AV
@@ -60,6 +72,16 @@ namespace djv
         AudioData::AudioData()
         {}
 
+        AudioData::AudioData(const AudioData & other)
+        {
+            *this = other;
+        }
+
+        AudioData::AudioData(AudioData && other)
+        {
+            *this = std::move(other);
+        }
+
         AudioData::AudioData(const AudioInfo & info)
         {
             set(info);
@@ -70,157 +92,715 @@ namespace djv
 
         void AudioData::set(const AudioInfo & info)
         {
-            if (info == _info)
+            if (info == _info && !_fileIO)
                 return;
             _info = info;
+            _fileIO.reset();
             _data.resize(_info.sampleCount * Audio::byteCount(_info.type));
+            _p = _data.data();
+        }
+
+        void AudioData::set(const AudioInfo & info, const uint8_t * p, const std::shared_ptr<Core::FileIO> & fileIO)
+        {
+            _info = info;
+            _data.clear();
+            _data.shrink_to_fit();
+            _p = p;
+            _fileIO = fileIO;
+        }
+
+        void AudioData::zero()
+        {
+            memset(data(), 0, byteCount());
+        }
+
+        void AudioData::detach()
+        {
+            if (_fileIO)
+            {
+                _data.resize(byteCount());
+                memcpy(_data.data(), _p, byteCount());
+                _p = _data.data();
+                _fileIO.reset();
+            }
         }
 
         namespace
         {
+            typedef void(*ConvertFnc)(const uint8_t *, uint8_t *, size_t);
+
             template<typename U, typename V>
-            void _convert(const U * value, V * out, size_t size)
+            void _convert(const uint8_t * in, uint8_t * out, size_t size)
             {
-                for (size_t i = 0; i < size; ++i, ++value, ++out)
+                const U * inP = reinterpret_cast<const U *>(in);
+                V * outP = reinterpret_cast<V *>(out);
+                for (size_t i = 0; i < size; ++i)
                 {
-                    Audio::convert(*value, *out);
+                    Audio::convert(inP[i], outP[i]);
                 }
             }
-        }
 
-        AudioData AudioData::convert(const AudioData & data, Audio::TYPE type)
+#if defined(DJV_AUDIO_SSE2)
+            // The SSE2 kernels produce the same results as the Audio::convert()
+            // functions; the floating-point kernels use the same operations in
+            // the same order, and the integer kernels use the equivalent sign
+            // flips and shifts. Sixteen samples are converted per iteration
+            // and the remainder is passed to the scalar kernels.
+
+            inline __m128i load(const uint8_t * in)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            }
+
+            inline void store(uint8_t * out, __m128i value)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), value);
+            }
+
+            inline void store(uint8_t * out, __m128 value)
+            {
+                _mm_storeu_ps(reinterpret_cast<float *>(out), value);
+            }
+
+            void convertU8S16(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 16, out += 32)
+                {
+                    const __m128i v = _mm_xor_si128(load(in), sign);
+                    store(out,      _mm_unpacklo_epi8(zero, v));
+                    store(out + 16, _mm_unpackhi_epi8(zero, v));
+                }
+                _convert<Audio::U8_T, Audio::S16_T>(in, out, size - i);
+            }
+
+            void convertU8S32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 16, out += 64)
+                {
+                    const __m128i v = _mm_xor_si128(load(in), sign);
+                    const __m128i lo = _mm_unpacklo_epi8(zero, v);
+                    const __m128i hi = _mm_unpackhi_epi8(zero, v);
+                    store(out,      _mm_unpacklo_epi16(zero, lo));
+                    store(out + 16, _mm_unpackhi_epi16(zero, lo));
+                    store(out + 32, _mm_unpacklo_epi16(zero, hi));
+                    store(out + 48, _mm_unpackhi_epi16(zero, hi));
+                }
+                _convert<Audio::U8_T, Audio::S32_T>(in, out, size - i);
+            }
+
+            void convertU8F32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128 max = _mm_set1_ps(static_cast<float>(Audio::u8Max));
+                const __m128 two = _mm_set1_ps(2.f);
+                const __m128 one = _mm_set1_ps(1.f);
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 16, out += 64)
+                {
+                    const __m128i v = load(in);
+                    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                    const __m128i w[] =
+                    {
+                        _mm_unpacklo_epi16(lo, zero),
+                        _mm_unpackhi_epi16(lo, zero),
+                        _mm_unpacklo_epi16(hi, zero),
+                        _mm_unpackhi_epi16(hi, zero)
+                    };
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        store(out + j * 16, _mm_sub_ps(_mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(w[j]), max), two), one));
+                    }
+                }
+                _convert<Audio::U8_T, Audio::F32_T>(in, out, size - i);
+            }
+
+            void convertS16U8(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 32, out += 16)
+                {
+                    const __m128i lo = _mm_srai_epi16(load(in), 8);
+                    const __m128i hi = _mm_srai_epi16(load(in + 16), 8);
+                    store(out, _mm_xor_si128(_mm_packs_epi16(lo, hi), sign));
+                }
+                _convert<Audio::S16_T, Audio::U8_T>(in, out, size - i);
+            }
+
+            void convertS16S32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 32, out += 64)
+                {
+                    const __m128i lo = load(in);
+                    const __m128i hi = load(in + 16);
+                    store(out,      _mm_unpacklo_epi16(zero, lo));
+                    store(out + 16, _mm_unpackhi_epi16(zero, lo));
+                    store(out + 32, _mm_unpacklo_epi16(zero, hi));
+                    store(out + 48, _mm_unpackhi_epi16(zero, hi));
+                }
+                _convert<Audio::S16_T, Audio::S32_T>(in, out, size - i);
+            }
+
+            void convertS16F32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128 max = _mm_set1_ps(static_cast<float>(Audio::s16Max));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 32, out += 64)
+                {
+                    for (int j = 0; j < 2; ++j)
+                    {
+                        const __m128i v = load(in + j * 16);
+                        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                        store(out + j * 32,      _mm_div_ps(_mm_cvtepi32_ps(lo), max));
+                        store(out + j * 32 + 16, _mm_div_ps(_mm_cvtepi32_ps(hi), max));
+                    }
+                }
+                _convert<Audio::S16_T, Audio::F32_T>(in, out, size - i);
+            }
+
+            void convertS32U8(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 64, out += 16)
+                {
+                    const __m128i lo = _mm_packs_epi32(
+                        _mm_srai_epi32(load(in), 24),
+                        _mm_srai_epi32(load(in + 16), 24));
+                    const __m128i hi = _mm_packs_epi32(
+                        _mm_srai_epi32(load(in + 32), 24),
+                        _mm_srai_epi32(load(in + 48), 24));
+                    store(out, _mm_xor_si128(_mm_packs_epi16(lo, hi), sign));
+                }
+                _convert<Audio::S32_T, Audio::U8_T>(in, out, size - i);
+            }
+
+            void convertS32S16(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 64, out += 32)
+                {
+                    store(out, _mm_packs_epi32(
+                        _mm_srai_epi32(load(in), 16),
+                        _mm_srai_epi32(load(in + 16), 16)));
+                    store(out + 16, _mm_packs_epi32(
+                        _mm_srai_epi32(load(in + 32), 16),
+                        _mm_srai_epi32(load(in + 48), 16)));
+                }
+                _convert<Audio::S32_T, Audio::S16_T>(in, out, size - i);
+            }
+
+            void convertS32F32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128 max = _mm_set1_ps(static_cast<float>(Audio::s32Max));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 64, out += 64)
+                {
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        store(out + j * 16, _mm_div_ps(_mm_cvtepi32_ps(load(in + j * 16)), max));
+                    }
+                }
+                _convert<Audio::S32_T, Audio::F32_T>(in, out, size - i);
+            }
+
+            // The floating-point values are clamped before they are truncated
+            // so that out of range values saturate.
+
+            inline __m128i truncate(__m128 value, __m128 min, __m128 max)
+            {
+                return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(value, min), max));
+            }
+
+            void convertF32U8(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128 half = _mm_set1_ps(.5f);
+                const __m128 min = _mm_setzero_ps();
+                const __m128 max = _mm_set1_ps(static_cast<float>(Audio::u8Max));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 64, out += 16)
+                {
+                    __m128i v[4];
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        const __m128 f = _mm_loadu_ps(reinterpret_cast<const float *>(in + j * 16));
+                        v[j] = truncate(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(f, half), half), max), min, max);
+                    }
+                    store(out, _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+                }
+                _convert<Audio::F32_T, Audio::U8_T>(in, out, size - i);
+            }
+
+            void convertF32S16(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                const __m128 min = _mm_set1_ps(static_cast<float>(Audio::s16Min));
+                const __m128 max = _mm_set1_ps(static_cast<float>(Audio::s16Max));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16, in += 64, out += 32)
+                {
+                    __m128i v[4];
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        const __m128 f = _mm_loadu_ps(reinterpret_cast<const float *>(in + j * 16));
+                        v[j] = truncate(_mm_mul_ps(f, max), min, max);
+                    }
+                    store(out,      _mm_packs_epi32(v[0], v[1]));
+                    store(out + 16, _mm_packs_epi32(v[2], v[3]));
+                }
+                _convert<Audio::F32_T, Audio::S16_T>(in, out, size - i);
+            }
+
+            void convertF32S32(const uint8_t * in, uint8_t * out, size_t size)
+            {
+                // The maximum is not representable as a float, so values that
+                // round up to 2^31 are replaced after the truncation.
+                const __m128 scale = _mm_set1_ps(static_cast<float>(Audio::s32Max));
+                const __m128 min = _mm_set1_ps(static_cast<float>(Audio::s32Min));
+                const __m128i max = _mm_set1_epi32(Audio::s32Max);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4, in += 16, out += 16)
+                {
+                    const __m128 f = _mm_mul_ps(_mm_loadu_ps(reinterpret_cast<const float *>(in)), scale);
+                    const __m128i over = _mm_castps_si128(_mm_cmpge_ps(f, scale));
+                    const __m128i v = _mm_cvttps_epi32(_mm_max_ps(f, min));
+                    store(out, _mm_or_si128(_mm_andnot_si128(over, v), _mm_and_si128(over, max)));
+                }
+                _convert<Audio::F32_T, Audio::S32_T>(in, out, size - i);
+            }
+
+#define _CONVERT(U, V) convert##U##V
+#else // DJV_AUDIO_SSE2
+#define _CONVERT(U, V) _convert<Audio::U##_T, Audio::V##_T>
+#endif // DJV_AUDIO_SSE2
+
+            //! Get the conversion kernel between two types. Returns nullptr if
+            //! the types are the same.
+            ConvertFnc convertFnc(Audio::TYPE in, Audio::TYPE out)
+            {
+                static const ConvertFnc data[Audio::TYPE_COUNT][Audio::TYPE_COUNT] =
+                {
+                    { nullptr, nullptr, nullptr, nullptr, nullptr },
+                    { nullptr, nullptr, _CONVERT(U8, S16), _CONVERT(U8, S32), _CONVERT(U8, F32) },
+                    { nullptr, _CONVERT(S16, U8), nullptr, _CONVERT(S16, S32), _CONVERT(S16, F32) },
+                    { nullptr, _CONVERT(S32, U8), _CONVERT(S32, S16), nullptr, _CONVERT(S32, F32) },
+                    { nullptr, _CONVERT(F32, U8), _CONVERT(F32, S16), _CONVERT(F32, S32), nullptr }
+                };
+                return data[in][out];
+            }
+
+#undef _CONVERT
+
+        } // namespace
+
+        void AudioData::convert(const AudioData & in, AudioData & out, Audio::TYPE type)
         {
-            const size_t sampleCount = data.sampleCount();
-            AudioData out(AudioInfo(data.channels(), type, data.sampleRate(), sampleCount));
-            switch (data.type())
+            //DJV_DEBUG("AudioData::convert");
+            //DJV_DEBUG_PRINT("in = " << in.type());
+            //DJV_DEBUG_PRINT("out = " << type);
+            const Audio::TYPE inType = in.type();
+            const uint64_t sampleCount = in.sampleCount();
+            const ConvertFnc fnc = convertFnc(inType, type);
+            if (&in != &out)
             {
-            case Audio::U8:
-                switch (type)
+                out.set(AudioInfo(in.channels(), type, in.sampleRate(), sampleCount));
+                if (fnc)
                 {
-                case Audio::U8:  memcpy(out.data(), data.data(), sampleCount * Audio::byteCount(type)); break;
-                case Audio::S16: _convert(reinterpret_cast<const Audio::U8_T *>(data.data()), reinterpret_cast<Audio::S16_T *>(out.data()), sampleCount); break;
-                case Audio::S32: _convert(reinterpret_cast<const Audio::U8_T *>(data.data()), reinterpret_cast<Audio::S32_T *>(out.data()), sampleCount); break;
-                case Audio::F32: _convert(reinterpret_cast<const Audio::U8_T *>(data.data()), reinterpret_cast<Audio::F32_T *>(out.data()), sampleCount); break;
-                default: break;
+                    fnc(in.data(), out.data(), sampleCount);
                 }
-                break;
-            case Audio::S16:
-                switch (type)
+                else if (sampleCount)
                 {
-                case Audio::U8:  _convert(reinterpret_cast<const Audio::S16_T *>(data.data()), reinterpret_cast<Audio::U8_T *> (out.data()), sampleCount); break;
-                case Audio::S16: memcpy(out.data(), data.data(), data.sampleCount() * Audio::byteCount(type)); break;
-                case Audio::S32: _convert(reinterpret_cast<const Audio::S16_T *>(data.data()), reinterpret_cast<Audio::S32_T *>(out.data()), sampleCount); break;
-                case Audio::F32: _convert(reinterpret_cast<const Audio::S16_T *>(data.data()), reinterpret_cast<Audio::F32_T *>(out.data()), sampleCount); break;
-                default: break;
+                    memcpy(out.data(), in.data(), in.byteCount());
                 }
-                break;
-            case Audio::S32:
-                switch (type)
+            }
+            else if (fnc && out.isMapped())
+            {
+                AudioData tmp;
+                convert(in, tmp, type);
+                out = std::move(tmp);
+            }
+            else if (fnc)
+            {
+                // Convert in place through a small staging buffer. Narrowing
+                // conversions work from the front of the buffer and widening
+                // conversions from the back so that the output never
+                // overwrites samples that have not been read yet.
+                const size_t inByteCount = Audio::byteCount(inType);
+                const size_t outByteCount = Audio::byteCount(type);
+                const size_t chunkSize = 1024;
+                uint8_t staging[chunkSize * sizeof(Audio::F32_T)];
+                if (outByteCount > inByteCount)
                 {
-                case Audio::U8:  _convert(reinterpret_cast<const Audio::S32_T *>(data.data()), reinterpret_cast<Audio::U8_T *> (out.data()), sampleCount); break;
-                case Audio::S16: _convert(reinterpret_cast<const Audio::S32_T *>(data.data()), reinterpret_cast<Audio::S16_T *>(out.data()), sampleCount); break;
-                case Audio::S32: memcpy(out.data(), data.data(), data.sampleCount() * Audio::byteCount(type)); break;
-                case Audio::F32: _convert(reinterpret_cast<const Audio::S32_T *>(data.data()), reinterpret_cast<Audio::F32_T *>(out.data()), sampleCount); break;
-                default: break;
+                    out._data.resize(sampleCount * outByteCount);
+                    uint8_t * p = out._data.data();
+                    for (uint64_t i = sampleCount; i > 0;)
+                    {
+                        const size_t size = static_cast<size_t>(std::min<uint64_t>(i, chunkSize));
+                        i -= size;
+                        memcpy(staging, p + i * inByteCount, size * inByteCount);
+                        fnc(staging, p + i * outByteCount, size);
+                    }
                 }
-                break;
-            case Audio::F32:
-                switch (type)
+                else
                 {
-                case Audio::U8:  _convert(reinterpret_cast<const Audio::F32_T *>(data.data()), reinterpret_cast<Audio::U8_T *> (out.data()), sampleCount); break;
-                case Audio::S16: _convert(reinterpret_cast<const Audio::F32_T *>(data.data()), reinterpret_cast<Audio::S16_T *>(out.data()), sampleCount); break;
-                case Audio::S32: _convert(reinterpret_cast<const Audio::F32_T *>(data.data()), reinterpret_cast<Audio::S32_T *>(out.data()), sampleCount); break;
-                case Audio::F32: memcpy(out.data(), data.data(), data.sampleCount() * Audio::byteCount(type)); break;
-                default: break;
+                    uint8_t * p = out._data.data();
+                    for (uint64_t i = 0; i < sampleCount;)
+                    {
+                        const size_t size = static_cast<size_t>(std::min<uint64_t>(sampleCount - i, chunkSize));
+                        memcpy(staging, p + i * inByteCount, size * inByteCount);
+                        fnc(staging, p + i * outByteCount, size);
+                        i += size;
+                    }
+                    out._data.resize(sampleCount * outByteCount);
                 }
-                break;
-            default: break;
+                out._p = out._data.data();
+                out._info.type = type;
             }
+        }
+
+        AudioData AudioData::convert(const AudioData & data, Audio::TYPE type)
+        {
+            AudioData out;
+            convert(data, out, type);
             return out;
         }
 
         namespace
         {
-            template<typename U>
-            void _planarInterleave(const U * value, U * out, size_t channels, size_t size)
+            typedef void(*InterleaveFnc)(const uint8_t *, uint8_t *, size_t channels, size_t planeSize);
+
+            // The kernels are specialized on the number of channels so that
+            // the inner loops are unrolled, with SSE2 kernels for stereo.
+
+            template<typename T, size_t C>
+            void _planarInterleave(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                const T * inP = reinterpret_cast<const T *>(in);
+                T * outP = reinterpret_cast<T *>(out);
+                for (size_t i = 0; i < planeSize; ++i, outP += C)
+                {
+                    for (size_t c = 0; c < C; ++c)
+                    {
+                        outP[c] = inP[c * planeSize + i];
+                    }
+                }
+            }
+
+            template<typename T, size_t C>
+            void _planarDeinterleave(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                const T * inP = reinterpret_cast<const T *>(in);
+                T * outP = reinterpret_cast<T *>(out);
+                for (size_t i = 0; i < planeSize; ++i, inP += C)
+                {
+                    for (size_t c = 0; c < C; ++c)
+                    {
+                        outP[c * planeSize + i] = inP[c];
+                    }
+                }
+            }
+
+            template<typename T>
+            void _planarInterleave(const uint8_t * in, uint8_t * out, size_t channels, size_t planeSize)
+            {
+                const T * inP = reinterpret_cast<const T *>(in);
+                T * outP = reinterpret_cast<T *>(out);
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    const T * p = inP + c * planeSize;
+                    for (size_t i = 0; i < planeSize; ++i)
+                    {
+                        outP[i * channels + c] = p[i];
+                    }
+                }
+            }
+
+            template<typename T>
+            void _planarDeinterleave(const uint8_t * in, uint8_t * out, size_t channels, size_t planeSize)
             {
-                const size_t planeSize = size / channels;
+                const T * inP = reinterpret_cast<const T *>(in);
+                T * outP = reinterpret_cast<T *>(out);
                 for (size_t c = 0; c < channels; ++c)
                 {
-                    const U * inP = value + c * planeSize;
-                    U * outP = out + c;
-                    for (size_t i = 0; i < planeSize; ++i, ++inP, outP += channels)
+                    T * p = outP + c * planeSize;
+                    for (size_t i = 0; i < planeSize; ++i)
                     {
-                        *outP = *inP;
+                        p[i] = inP[i * channels + c];
                     }
                 }
             }
+
+#if defined(DJV_AUDIO_SSE2)
+            void interleaveStereo8(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                const uint8_t * l = in;
+                const uint8_t * r = in + planeSize;
+                size_t i = 0;
+                for (; i + 16 <= planeSize; i += 16, out += 32)
+                {
+                    const __m128i lv = load(l + i);
+                    const __m128i rv = load(r + i);
+                    store(out,      _mm_unpacklo_epi8(lv, rv));
+                    store(out + 16, _mm_unpackhi_epi8(lv, rv));
+                }
+                for (; i < planeSize; ++i, out += 2)
+                {
+                    out[0] = l[i];
+                    out[1] = r[i];
+                }
+            }
+
+            void interleaveStereo16(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                const uint16_t * l = reinterpret_cast<const uint16_t *>(in);
+                const uint16_t * r = l + planeSize;
+                size_t i = 0;
+                for (; i + 8 <= planeSize; i += 8, out += 32)
+                {
+                    const __m128i lv = load(reinterpret_cast<const uint8_t *>(l + i));
+                    const __m128i rv = load(reinterpret_cast<const uint8_t *>(r + i));
+                    store(out,      _mm_unpacklo_epi16(lv, rv));
+                    store(out + 16, _mm_unpackhi_epi16(lv, rv));
+                }
+                uint16_t * outP = reinterpret_cast<uint16_t *>(out);
+                for (; i < planeSize; ++i, outP += 2)
+                {
+                    outP[0] = l[i];
+                    outP[1] = r[i];
+                }
+            }
+
+            void interleaveStereo32(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                const uint32_t * l = reinterpret_cast<const uint32_t *>(in);
+                const uint32_t * r = l + planeSize;
+                size_t i = 0;
+                for (; i + 4 <= planeSize; i += 4, out += 32)
+                {
+                    const __m128i lv = load(reinterpret_cast<const uint8_t *>(l + i));
+                    const __m128i rv = load(reinterpret_cast<const uint8_t *>(r + i));
+                    store(out,      _mm_unpacklo_epi32(lv, rv));
+                    store(out + 16, _mm_unpackhi_epi32(lv, rv));
+                }
+                uint32_t * outP = reinterpret_cast<uint32_t *>(out);
+                for (; i < planeSize; ++i, outP += 2)
+                {
+                    outP[0] = l[i];
+                    outP[1] = r[i];
+                }
+            }
+
+            void deinterleaveStereo8(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                uint8_t * l = out;
+                uint8_t * r = out + planeSize;
+                const __m128i mask = _mm_set1_epi16(0xff);
+                size_t i = 0;
+                for (; i + 16 <= planeSize; i += 16, in += 32)
+                {
+                    const __m128i a = load(in);
+                    const __m128i b = load(in + 16);
+                    store(l + i, _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+                    store(r + i, _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+                }
+                for (; i < planeSize; ++i, in += 2)
+                {
+                    l[i] = in[0];
+                    r[i] = in[1];
+                }
+            }
+
+            void deinterleaveStereo16(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                uint16_t * l = reinterpret_cast<uint16_t *>(out);
+                uint16_t * r = l + planeSize;
+                size_t i = 0;
+                for (; i + 8 <= planeSize; i += 8, in += 32)
+                {
+                    // Sign extend each half of the 32-bit words so that the
+                    // saturating pack leaves the values unchanged.
+                    const __m128i a = load(in);
+                    const __m128i b = load(in + 16);
+                    store(reinterpret_cast<uint8_t *>(l + i), _mm_packs_epi32(
+                        _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                        _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)));
+                    store(reinterpret_cast<uint8_t *>(r + i), _mm_packs_epi32(
+                        _mm_srai_epi32(a, 16),
+                        _mm_srai_epi32(b, 16)));
+                }
+                const uint16_t * inP = reinterpret_cast<const uint16_t *>(in);
+                for (; i < planeSize; ++i, inP += 2)
+                {
+                    l[i] = inP[0];
+                    r[i] = inP[1];
+                }
+            }
+
+            void deinterleaveStereo32(const uint8_t * in, uint8_t * out, size_t, size_t planeSize)
+            {
+                uint32_t * l = reinterpret_cast<uint32_t *>(out);
+                uint32_t * r = l + planeSize;
+                size_t i = 0;
+                for (; i + 4 <= planeSize; i += 4, in += 32)
+                {
+                    const __m128 a = _mm_castsi128_ps(load(in));
+                    const __m128 b = _mm_castsi128_ps(load(in + 16));
+                    store(reinterpret_cast<uint8_t *>(l + i), _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                    store(reinterpret_cast<uint8_t *>(r + i), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+                const uint32_t * inP = reinterpret_cast<const uint32_t *>(in);
+                for (; i < planeSize; ++i, inP += 2)
+                {
+                    l[i] = inP[0];
+                    r[i] = inP[1];
+                }
+            }
+#endif // DJV_AUDIO_SSE2
+
+            template<typename T>
+            InterleaveFnc interleaveFnc(size_t channels)
+            {
+                switch (channels)
+                {
+                case 1: return _planarInterleave<T, 1>;
+                case 2: return _planarInterleave<T, 2>;
+                case 3: return _planarInterleave<T, 3>;
+                case 4: return _planarInterleave<T, 4>;
+                case 5: return _planarInterleave<T, 5>;
+                case 6: return _planarInterleave<T, 6>;
+                case 7: return _planarInterleave<T, 7>;
+                case 8: return _planarInterleave<T, 8>;
+                default: break;
+                }
+                return _planarInterleave<T>;
+            }
+
+            template<typename T>
+            InterleaveFnc deinterleaveFnc(size_t channels)
+            {
+                switch (channels)
+                {
+                case 1: return _planarDeinterleave<T, 1>;
+                case 2: return _planarDeinterleave<T, 2>;
+                case 3: return _planarDeinterleave<T, 3>;
+                case 4: return _planarDeinterleave<T, 4>;
+                case 5: return _planarDeinterleave<T, 5>;
+                case 6: return _planarDeinterleave<T, 6>;
+                case 7: return _planarDeinterleave<T, 7>;
+                case 8: return _planarDeinterleave<T, 8>;
+                default: break;
+                }
+                return _planarDeinterleave<T>;
+            }
+
+            //! Get the (de)interleave kernel for the given sample size and
+            //! number of channels.
+            InterleaveFnc interleaveFnc(bool interleave, size_t byteCount, size_t channels)
+            {
+#if defined(DJV_AUDIO_SSE2)
+                if (2 == channels)
+                {
+                    switch (byteCount)
+                    {
+                    case 1: return interleave ? interleaveStereo8  : deinterleaveStereo8;
+                    case 2: return interleave ? interleaveStereo16 : deinterleaveStereo16;
+                    case 4: return interleave ? interleaveStereo32 : deinterleaveStereo32;
+                    default: break;
+                    }
+                }
+#endif // DJV_AUDIO_SSE2
+                switch (byteCount)
+                {
+                case 1: return interleave ? interleaveFnc<uint8_t>(channels)  : deinterleaveFnc<uint8_t>(channels);
+                case 2: return interleave ? interleaveFnc<uint16_t>(channels) : deinterleaveFnc<uint16_t>(channels);
+                case 4: return interleave ? interleaveFnc<uint32_t>(channels) : deinterleaveFnc<uint32_t>(channels);
+                default: break;
+                }
+                return nullptr;
+            }
+
+            void planarInterleaveData(bool interleave, const AudioData & in, AudioData & out)
+            {
+                DJV_ASSERT(&in != &out);
+                out.set(in.info());
+                const size_t channels = in.channels();
+                if (!channels)
+                    return;
+                if (auto fnc = interleaveFnc(interleave, Audio::byteCount(in.type()), channels))
+                {
+                    fnc(in.data(), out.data(), channels, in.sampleCount() / channels);
+                }
+            }
+
+        } // namespace
+
+        void AudioData::planarInterleave(const AudioData & in, AudioData & out)
+        {
+            planarInterleaveData(true, in, out);
         }
 
         AudioData AudioData::planarInterleave(const AudioData & data)
         {
-            AudioData out(data.info());
-            const size_t channels = data.channels();
-            const size_t sampleCount = data.sampleCount();
-            switch (data.type())
-            {
-            case Audio::U8: 
-                _planarInterleave(reinterpret_cast<const Audio::U8_T *> (data.data()), reinterpret_cast<Audio::U8_T *> (out.data()), channels, sampleCount);
-                break;
-            case Audio::S16:
-                _planarInterleave(reinterpret_cast<const Audio::S16_T *>(data.data()), reinterpret_cast<Audio::S16_T *>(out.data()), channels, sampleCount);
-                break;
-            case Audio::S32:
-                _planarInterleave(reinterpret_cast<const Audio::S32_T *>(data.data()), reinterpret_cast<Audio::S32_T *>(out.data()), channels, sampleCount);
-                break;
-            case Audio::F32:
-                _planarInterleave(reinterpret_cast<const Audio::F32_T *>(data.data()), reinterpret_cast<Audio::F32_T *>(out.data()), channels, sampleCount);
-                break;
-            default: break;
-            }
+            AudioData out;
+            planarInterleave(data, out);
             return out;
         }
 
-        namespace
+        void AudioData::planarDeinterleave(const AudioData & in, AudioData & out)
+        {
+            planarInterleaveData(false, in, out);
+        }
+
+        AudioData AudioData::planarDeinterleave(const AudioData & data)
+        {
+            AudioData out;
+            planarDeinterleave(data, out);
+            return out;
+        }
+
+        AudioData & AudioData::operator = (const AudioData & other)
         {
-            template<typename U>
-            void _planarDeinterleave(const U * value, U * out, size_t channels, size_t size)
+            if (&other != this)
             {
-                const size_t planeSize = size / channels;
-                for (size_t c = 0; c < channels; ++c)
+                _info = other._info;
+                _fileIO = other._fileIO;
+                if (_fileIO)
                 {
-                    const U * inP = value + c;
-                    U * outP = out + c * planeSize;
-                    for (size_t i = 0; i < planeSize; ++i, inP += channels, ++outP)
-                    {
-                        *outP = *inP;
-                    }
+                    _data.clear();
+                    _p = other._p;
+                }
+                else
+                {
+                    _data = other._data;
+                    _p = _data.data();
                 }
             }
+            return *this;
         }
 
-        AudioData AudioData::planarDeinterleave(const AudioData & data)
+        AudioData & AudioData::operator = (AudioData && other)
         {
-            AudioData out(data.info());
-            const size_t channels = data.channels();
-            const size_t sampleCount = data.sampleCount();
-            switch (data.type())
-            {
-            case Audio::U8:
-                _planarDeinterleave(reinterpret_cast<const Audio::U8_T *> (data.data()), reinterpret_cast<Audio::U8_T *> (out.data()), channels, sampleCount);
-                break;
-            case Audio::S16:
-                _planarDeinterleave(reinterpret_cast<const Audio::S16_T *>(data.data()), reinterpret_cast<Audio::S16_T *>(out.data()), channels, sampleCount);
-                break;
-            case Audio::S32:
-                _planarDeinterleave(reinterpret_cast<const Audio::S32_T *>(data.data()), reinterpret_cast<Audio::S32_T *>(out.data()), channels, sampleCount);
-                break;
-            case Audio::F32:
-                _planarDeinterleave(reinterpret_cast<const Audio::F32_T *>(data.data()), reinterpret_cast<Audio::F32_T *>(out.data()), channels, sampleCount);
-                break;
-            default: break;
+            if (&other != this)
+            {
+                _info = other._info;
+                _data = std::move(other._data);
+                _p = other._p;
+                _fileIO = std::move(other._fileIO);
+                other._info = AudioInfo();
+                other._data.clear();
+                other._p = other._data.data();
+                other._fileIO.reset();
             }
-            return out;
+            return *this;
         }
 
         bool AudioData::operator == (const AudioData & other) const
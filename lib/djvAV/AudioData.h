@@ -31,7 +31,10 @@
 
 #include <djvAV/Audio.h>
 
+#include <djvCore/FileIO.h>
+
 #include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -62,12 +65,23 @@ namespace djv
 
         public:
             AudioData();
+            AudioData(const AudioData &);
+            AudioData(AudioData &&);
             AudioData(const AudioInfo &);
             ~AudioData();
 
             void set(const AudioInfo &);
+
+            //! Set the audio data to reference memory kept alive by the file
+            //! I/O, for example a window of a memory-mapped file. The memory is
+            //! copied the first time the data is modified.
+            void set(const AudioInfo &, const uint8_t *, const std::shared_ptr<Core::FileIO> &);
+
             void zero();
 
+            //! Get whether the data references memory owned by a file I/O.
+            inline bool isMapped() const;
+
             inline const AudioInfo & info() const;
             inline size_t channels() const;
             inline Audio::TYPE type() const;
@@ -84,15 +98,37 @@ namespace djv
 
             static AudioData convert(const AudioData &, Audio::TYPE);
 
+            //! Convert the audio data, re-using the memory of the output when
+            //! the size is unchanged. The input and output may be the same
+            //! object to convert the data in place.
+            static void convert(const AudioData &, AudioData &, Audio::TYPE);
+
             static AudioData planarInterleave(const AudioData &);
             static AudioData planarDeinterleave(const AudioData &);
 
+            //! Interleave planar audio data, re-using the memory of the output
+            //! when the size is unchanged. The input and output must be
+            //! different objects.
+            static void planarInterleave(const AudioData &, AudioData &);
+
+            //! De-interleave audio data into planes, re-using the memory of
+            //! the output when the size is unchanged. The input and output
+            //! must be different objects.
+            static void planarDeinterleave(const AudioData &, AudioData &);
+
+            AudioData & operator = (const AudioData &);
+            AudioData & operator = (AudioData &&);
+
             bool operator == (const AudioData &) const;
             bool operator != (const AudioData &) const;
 
         private:
-            AudioInfo _info;
-            std::vector<uint8_t> _data;
+            void detach();
+
+            AudioInfo                     _info;
+            std::vector<uint8_t>          _data;
+            const uint8_t *               _p = nullptr;
+            std::shared_ptr<Core::FileIO> _fileIO;
         };
 
     } // namespace AV
@@ -66,6 +66,11 @@ namespace djv
             return _info.sampleCount;
         }
 
+        inline bool AudioData::isMapped() const
+        {
+            return _fileIO.get() != nullptr;
+        }
+
         inline bool AudioData::isValid() const
         {
             return _info.isValid();
@@ -73,22 +78,23 @@ namespace djv
 
         inline uint8_t * AudioData::data()
         {
+            detach();
             return _data.data();
         }
 
         inline const uint8_t * AudioData::data() const
         {
-            return _data.data();
+            return _p;
         }
 
         inline uint8_t * AudioData::data(uint64_t offset)
         {
-            return _data.data();
+            return data() + offset * Audio::byteCount(_info.type);
         }
 
         inline const uint8_t * AudioData::data(uint64_t offset) const
         {
-            return _data.data();
+            return _p + offset * Audio::byteCount(_info.type);
         }
 
         inline uint64_t AudioData::byteCount() const
@@ -0,0 +1,382 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/AudioResampler.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! This struct provides the filter parameters for each quality.
+            struct Quality
+            {
+                size_t taps;
+                size_t phases;
+                double rolloff;
+                double beta;
+            };
+
+            const Quality qualities[AudioResampler::QUALITY_COUNT] =
+            {
+                { 16,   64, .85,  6.0 },
+                { 32,  256, .9,   8.0 },
+                { 64, 1024, .94, 10.0 }
+            };
+
+            //! The maximum factor the filter is widened by when downsampling.
+            const size_t downsampleMax = 8;
+
+            //! The modified Bessel function of the first kind, used by the
+            //! Kaiser window.
+            double besselI0(double value)
+            {
+                double out = 1.0;
+                double term = 1.0;
+                for (int k = 1; k < 64; ++k)
+                {
+                    const double tmp = value / (2.0 * k);
+                    term *= tmp * tmp;
+                    out += term;
+                    if (term < out * 1.0e-12)
+                        break;
+                }
+                return out;
+            }
+
+            //! Create the filter bank. There is one extra phase so that the
+            //! coefficients can be interpolated without wrapping, and each
+            //! phase is normalized for unity gain.
+            void filter(size_t taps, size_t phases, double cutoff, double beta, std::vector<float> & out)
+            {
+                const double pi = 3.14159265358979323846;
+                const double half = static_cast<double>(taps / 2);
+                const double i0Beta = besselI0(beta);
+                out.resize((phases + 1) * taps);
+                std::vector<double> tmp(taps);
+                for (size_t p = 0; p <= phases; ++p)
+                {
+                    const double frac = p / static_cast<double>(phases);
+                    double sum = 0.0;
+                    for (size_t j = 0; j < taps; ++j)
+                    {
+                        const double t = j - (half - 1.0) - frac;
+                        const double x = t / half;
+                        const double window = x * x < 1.0 ? besselI0(beta * std::sqrt(1.0 - x * x)) / i0Beta : 0.0;
+                        const double a = 2.0 * pi * cutoff * t;
+                        tmp[j] = 2.0 * cutoff * (a != 0.0 ? std::sin(a) / a : 1.0) * window;
+                        sum += tmp[j];
+                    }
+                    for (size_t j = 0; j < taps; ++j)
+                    {
+                        out[p * taps + j] = static_cast<float>(tmp[j] / sum);
+                    }
+                }
+            }
+
+            //! Interpolate between two phases of the filter bank. The size must
+            //! be a multiple of eight.
+            inline void lerp(const float * a, const float * b, float t, float * out, size_t size)
+            {
+#if defined(DJV_AUDIO_SSE2)
+                const __m128 tv = _mm_set1_ps(t);
+                for (size_t i = 0; i < size; i += 4)
+                {
+                    const __m128 av = _mm_loadu_ps(a + i);
+                    const __m128 bv = _mm_loadu_ps(b + i);
+                    _mm_storeu_ps(out + i, _mm_add_ps(av, _mm_mul_ps(_mm_sub_ps(bv, av), tv)));
+                }
+#else // DJV_AUDIO_SSE2
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[i] = a[i] + (b[i] - a[i]) * t;
+                }
+#endif // DJV_AUDIO_SSE2
+            }
+
+            //! Get the dot product of two vectors. The size must be a multiple
+            //! of eight.
+            inline float dot(const float * a, const float * b, size_t size)
+            {
+#if defined(DJV_AUDIO_SSE2)
+                __m128 sum0 = _mm_setzero_ps();
+                __m128 sum1 = _mm_setzero_ps();
+                for (size_t i = 0; i < size; i += 8)
+                {
+                    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i),     _mm_loadu_ps(b + i)));
+                    sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+                }
+                __m128 sum = _mm_add_ps(sum0, sum1);
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+                return _mm_cvtss_f32(sum);
+#else // DJV_AUDIO_SSE2
+                float sum[2] = { 0.f, 0.f };
+                for (size_t i = 0; i < size; i += 2)
+                {
+                    sum[0] += a[i] * b[i];
+                    sum[1] += a[i + 1] * b[i + 1];
+                }
+                return sum[0] + sum[1];
+#endif // DJV_AUDIO_SSE2
+            }
+
+        } // namespace
+
+        struct AudioResampler::Private
+        {
+            size_t  channels         = 0;
+            size_t  inputSampleRate  = 0;
+            size_t  outputSampleRate = 0;
+            QUALITY quality          = QUALITY_MEDIUM;
+
+            size_t             taps   = 0;
+            size_t             phases = 0;
+            std::vector<float> filter;
+            std::vector<float> coefficients;
+
+            //! The input that has not been consumed yet, one plane per channel.
+            std::vector<std::vector<float> > history;
+
+            //! The position of the next output in the history, as a frame and
+            //! a remainder in units of the output sample rate. Stepping the
+            //! position with integers keeps the result of resampling a stream
+            //! the same however it is split up.
+            size_t   position  = 0;
+            uint64_t remainder = 0;
+
+            uint64_t    inputFrames  = 0;
+            uint64_t    outputFrames = 0;
+            Audio::TYPE type         = Audio::F32;
+
+            AudioData f32;
+            AudioData planar;
+            AudioData result;
+
+            void resample(uint64_t maxFrames, AudioData & out);
+        };
+
+        const QStringList & AudioResampler::qualityLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::AV::AudioResampler", "Fast") <<
+                qApp->translate("djv::AV::AudioResampler", "Medium") <<
+                qApp->translate("djv::AV::AudioResampler", "Best");
+            DJV_ASSERT(data.count() == QUALITY_COUNT);
+            return data;
+        }
+
+        AudioResampler::AudioResampler(
+            size_t  channels,
+            size_t  inputSampleRate,
+            size_t  outputSampleRate,
+            QUALITY quality) :
+            _p(new Private)
+        {
+            //DJV_DEBUG("AudioResampler::AudioResampler");
+            //DJV_DEBUG_PRINT("channels = " << channels);
+            //DJV_DEBUG_PRINT("input sample rate = " << inputSampleRate);
+            //DJV_DEBUG_PRINT("output sample rate = " << outputSampleRate);
+            DJV_ASSERT(channels > 0 && inputSampleRate > 0 && outputSampleRate > 0);
+            _p->channels = channels;
+            _p->inputSampleRate = inputSampleRate;
+            _p->outputSampleRate = outputSampleRate;
+            _p->quality = quality;
+
+            // When downsampling the cutoff frequency is lowered and the filter
+            // is widened by the same factor to keep the transition band.
+            const Quality & q = qualities[quality];
+            const double ratio = outputSampleRate / static_cast<double>(inputSampleRate);
+            const double widen = ratio < 1.0 ? std::min(1.0 / ratio, static_cast<double>(downsampleMax)) : 1.0;
+            _p->taps = static_cast<size_t>(std::ceil(q.taps * widen / 8.0)) * 8;
+            _p->phases = q.phases;
+            filter(_p->taps, _p->phases, .5 * std::min(ratio, 1.0) * q.rolloff, q.beta, _p->filter);
+            _p->coefficients.resize(_p->taps);
+            //DJV_DEBUG_PRINT("taps = " << _p->taps);
+            reset();
+        }
+
+        AudioResampler::~AudioResampler()
+        {}
+
+        size_t AudioResampler::channels() const
+        {
+            return _p->channels;
+        }
+
+        size_t AudioResampler::inputSampleRate() const
+        {
+            return _p->inputSampleRate;
+        }
+
+        size_t AudioResampler::outputSampleRate() const
+        {
+            return _p->outputSampleRate;
+        }
+
+        AudioResampler::QUALITY AudioResampler::quality() const
+        {
+            return _p->quality;
+        }
+
+        size_t AudioResampler::latency() const
+        {
+            return _p->taps / 2;
+        }
+
+        void AudioResampler::process(const AudioData & in, AudioData & out)
+        {
+            //DJV_DEBUG("AudioResampler::process");
+            //DJV_DEBUG_PRINT("in = " << in.sampleCount());
+            DJV_ASSERT(in.channels() == _p->channels);
+            _p->type = in.type();
+            const AudioData * f32 = &in;
+            if (in.type() != Audio::F32)
+            {
+                AudioData::convert(in, _p->f32, Audio::F32);
+                f32 = &_p->f32;
+            }
+            AudioData::planarDeinterleave(*f32, _p->planar);
+            const size_t frames = static_cast<size_t>(in.sampleCount() / _p->channels);
+            const float * planarP = reinterpret_cast<const float *>(_p->planar.data());
+            for (size_t c = 0; c < _p->channels; ++c)
+            {
+                const float * p = planarP + c * frames;
+                _p->history[c].insert(_p->history[c].end(), p, p + frames);
+            }
+            _p->inputFrames += frames;
+            _p->resample(std::numeric_limits<uint64_t>::max(), out);
+        }
+
+        void AudioResampler::flush(AudioData & out)
+        {
+            //DJV_DEBUG("AudioResampler::flush");
+            // Pad the input with silence and stop at the output frame that
+            // corresponds to the end of the input.
+            const size_t half = _p->taps / 2;
+            for (size_t c = 0; c < _p->channels; ++c)
+            {
+                _p->history[c].insert(_p->history[c].end(), half, 0.f);
+            }
+            const uint64_t outputFrames =
+                (_p->inputFrames * _p->outputSampleRate + _p->inputSampleRate - 1) / _p->inputSampleRate;
+            _p->resample(outputFrames > _p->outputFrames ? outputFrames - _p->outputFrames : 0, out);
+            reset();
+        }
+
+        void AudioResampler::reset()
+        {
+            // The history starts with silence so that the first output frame
+            // is aligned with the first input frame.
+            const size_t half = _p->taps / 2;
+            _p->history.resize(_p->channels);
+            for (auto & i : _p->history)
+            {
+                i.assign(half - 1, 0.f);
+            }
+            _p->position = half - 1;
+            _p->remainder = 0;
+            _p->inputFrames = 0;
+            _p->outputFrames = 0;
+        }
+
+        void AudioResampler::Private::resample(uint64_t maxFrames, AudioData & out)
+        {
+            const size_t half = taps / 2;
+            const size_t historyFrames = history[0].size();
+
+            // Count the output frames that can be computed from the history.
+            size_t frames = 0;
+            for (uint64_t i = position, r = remainder;
+                frames < maxFrames && i + half < historyFrames;
+                r += inputSampleRate, i += r / outputSampleRate, r %= outputSampleRate)
+            {
+                ++frames;
+            }
+
+            // Compute the output frames.
+            AudioData & f32 = Audio::F32 == type ? out : result;
+            f32.set(AudioInfo(channels, Audio::F32, outputSampleRate, frames * channels));
+            float * outP = reinterpret_cast<float *>(f32.data());
+            for (size_t i = 0; i < frames; ++i)
+            {
+                const uint64_t phase = remainder * phases;
+                const size_t p = static_cast<size_t>(phase / outputSampleRate);
+                lerp(
+                    filter.data() + p * taps,
+                    filter.data() + (p + 1) * taps,
+                    (phase % outputSampleRate) / static_cast<float>(outputSampleRate),
+                    coefficients.data(),
+                    taps);
+                for (size_t c = 0; c < channels; ++c, ++outP)
+                {
+                    *outP = dot(coefficients.data(), history[c].data() + position + 1 - half, taps);
+                }
+                remainder += inputSampleRate;
+                position += static_cast<size_t>(remainder / outputSampleRate);
+                remainder %= outputSampleRate;
+            }
+            outputFrames += frames;
+            if (&f32 != &out)
+            {
+                AudioData::convert(f32, out, type);
+            }
+
+            // Discard the input that is no longer needed.
+            const size_t n = std::min(position + 1 - half, historyFrames);
+            for (auto & i : history)
+            {
+                i.erase(i.begin(), i.begin() + n);
+            }
+            position -= n;
+        }
+
+    } // namespace AV
+
+    _DJV_STRING_OPERATOR_LABEL(
+        AV::AudioResampler::QUALITY,
+        AV::AudioResampler::qualityLabels());
+
+} // namespace djv
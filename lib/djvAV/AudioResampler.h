@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvAV/AudioData.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        //! This class provides a polyphase windowed-sinc audio resampler.
+        //!
+        //! The resampler keeps the end of the previous input so that a stream
+        //! can be resampled in pieces. The output of each call is delayed by
+        //! half of the filter length; call flush() at the end of the stream to
+        //! get the remaining samples.
+        class AudioResampler
+        {
+            Q_GADGET
+
+        public:
+            //! This enumeration provides the resampling quality.
+            enum QUALITY
+            {
+                QUALITY_FAST,   //!< 16 taps, 64 phases
+                QUALITY_MEDIUM, //!< 32 taps, 256 phases
+                QUALITY_BEST,   //!< 64 taps, 1024 phases
+
+                QUALITY_COUNT
+            };
+            Q_ENUM(QUALITY);
+
+            //! Get the quality labels.
+            static const QStringList & qualityLabels();
+
+            AudioResampler(
+                size_t  channels,
+                size_t  inputSampleRate,
+                size_t  outputSampleRate,
+                QUALITY quality = QUALITY_MEDIUM);
+            ~AudioResampler();
+
+            size_t channels() const;
+            size_t inputSampleRate() const;
+            size_t outputSampleRate() const;
+            QUALITY quality() const;
+
+            //! Get the number of input frames the output is delayed by.
+            size_t latency() const;
+
+            //! Resample interleaved audio data. The output has the same channels
+            //! and type as the input and may be empty if there is not enough
+            //! input yet.
+            void process(const AudioData & in, AudioData & out);
+
+            //! Get the remaining output at the end of the stream. The output
+            //! has the type of the last input.
+            void flush(AudioData & out);
+
+            //! Reset the resampler for a new stream.
+            void reset();
+
+        private:
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace AV
+
+    DJV_STRING_OPERATOR(AV::AudioResampler::QUALITY);
+
+} // namespace djv
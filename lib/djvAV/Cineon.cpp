@@ -173,7 +173,8 @@ namespace djv
                 qApp->translate("djv::AV::Cineon", "Input Color Profile") <<
                 qApp->translate("djv::AV::Cineon", "Input Film Print") <<
                 qApp->translate("djv::AV::Cineon", "Output Color Profile") <<
-                qApp->translate("djv::AV::Cineon", "Output Film Print");
+                qApp->translate("djv::AV::Cineon", "Output Film Print") <<
+                qApp->translate("djv::AV::Cineon", "Read Mode");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
@@ -31,6 +31,8 @@
 
 #include <djvAV/PixelData.h>
 
+#include <djvCore/FileIO.h>
+
 namespace djv
 {
     namespace AV
@@ -118,6 +120,7 @@ namespace djv
                 INPUT_FILM_PRINT_OPTION,
                 OUTPUT_COLOR_PROFILE_OPTION,
                 OUTPUT_FILM_PRINT_OPTION,
+                READ_MODE_OPTION,
 
                 OPTIONS_COUNT
             };
@@ -132,6 +135,7 @@ namespace djv
                 Cineon::FilmPrintToLinear inputFilmPrint;
                 Cineon::COLOR_PROFILE     outputColorProfile = Cineon::COLOR_PROFILE_FILM_PRINT;
                 Cineon::LinearToFilmPrint outputFilmPrint;
+                Core::FileIO::READ_MODE   readMode           = Core::FileIO::READ_AUTO;
             };
         };
 
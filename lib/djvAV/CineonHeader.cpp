@@ -29,6 +29,8 @@
 
 #include <djvAV/CineonHeader.h>
 
+#include <djvAV/PixelDataUtil.h>
+
 #include <djvCore/FileIO.h>
 #include <djvCore/Time.h>
 
@@ -292,6 +294,7 @@ namespace djv
             file.headerSize = 1024;
             file.industryHeaderSize = 1024;
             file.userHeaderSize = 0;
+            file.size = file.imageOffset + PixelDataUtil::dataByteCount(info.layers[0]);
 
             image.orient = ORIENT_LEFT_RIGHT_TOP_BOTTOM;
 
@@ -444,6 +447,7 @@ namespace djv
 
             // Write.
             debug();
+            io.preallocate(file.size);
             const bool endian = Core::Memory::endian() != Core::Memory::MSB;
             io.setEndian(endian);
             if (endian)
@@ -462,13 +466,6 @@ namespace djv
             io.set(&film, sizeof(Film));
         }
 
-        void CineonHeader::saveEnd(Core::FileIO & io)
-        {
-            const quint32 size = static_cast<quint32>(io.pos());
-            io.setPos(20);
-            io.setU32(size);
-        }
-
         void CineonHeader::endian()
         {
             Core::Memory::convertEndian(&file.imageOffset, 1, 4);
@@ -172,12 +172,6 @@ namespace djv
             //! - Core::Error
             void save(Core::FileIO &, const IOInfo &, Cineon::COLOR_PROFILE);
 
-            //! Update the header when saving is finished.
-            //!
-            //! Throws:
-            //! - Core::Error
-            void saveEnd(Core::FileIO &);
-
             //! Zero memory.
             static void zero(qint32 *);
 
@@ -36,6 +36,7 @@
 #include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -60,12 +61,14 @@ namespace djv
         {
             //DJV_DEBUG("CineonLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::CineonLoad::read");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame != -1 ? frame.frame : _fileInfo.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
             QScopedPointer<Core::FileIO> io(new Core::FileIO);
+            io->setReadMode(_options.readMode);
             _open(fileName, info, *io);
             image.tags = info.tags;
 
@@ -78,6 +78,10 @@ namespace djv
             {
                 out << _options.outputFilmPrint;
             }
+            else if (0 == in.compare(options()[Cineon::READ_MODE_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.readMode;
+            }
             return out;
         }
 
@@ -131,6 +135,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[Cineon::READ_MODE_OPTION], Qt::CaseInsensitive))
+                {
+                    Core::FileIO::READ_MODE readMode = static_cast<Core::FileIO::READ_MODE>(0);
+                    data >> readMode;
+                    if (readMode != _options.readMode)
+                    {
+                        _options.readMode = readMode;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -173,6 +187,11 @@ namespace djv
                     {
                         in >> _options.outputFilmPrint;
                     }
+                    else if (
+                        qApp->translate("djv::AV::CineonPlugin", "-cineon_read_mode") == arg)
+                    {
+                        in >> _options.readMode;
+                    }
                     else
                     {
                         tmp << arg;
@@ -196,6 +215,8 @@ namespace djv
             outputColorProfileLabel << _options.outputColorProfile;
             QStringList outputFilmPrintLabel;
             outputFilmPrintLabel << _options.outputFilmPrint;
+            QStringList readModeLabel;
+            readModeLabel << _options.readMode;
             return qApp->translate("djv::AV::CineonPlugin",
                 "\n"
                 "Cineon Options\n"
@@ -211,13 +232,17 @@ namespace djv
                 "Default = %5.\n"
                 "    -cineon_output_film_print (black) (white) (gamma) (soft clip)\n"
                 "        Set the film print values used when saving Cineon images. Default = "
-                "%6.\n").
+                "%6.\n"
+                "    -cineon_read_mode (value)\n"
+                "        Set how Cineon images are read: %7. Default = %8.\n").
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(inputColorProfileLabel.join(", ")).
                 arg(inputFilmPrintLabel.join(", ")).
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(outputColorProfileLabel.join(", ")).
-                arg(outputFilmPrintLabel.join(", "));
+                arg(outputFilmPrintLabel.join(", ")).
+                arg(Core::FileIO::readModeLabels().join(", ")).
+                arg(readModeLabel.join(", "));
         }
 
         std::unique_ptr<Load> CineonPlugin::createLoad(const Core::FileInfo & fileInfo) const
@@ -31,8 +31,10 @@
 
 #include <djvAV/CineonHeader.h>
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -67,6 +69,7 @@ namespace djv
             //DJV_DEBUG("CineonSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::CineonSave::write");
 
             // Set the color profile.
             ColorProfile colorProfile;
@@ -96,16 +99,23 @@ namespace djv
                 colorProfile.type != ColorProfile::RAW)
             {
                 //Core::_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImageOptions options;
-                options.colorProfile = colorProfile;
-                OpenGLImage().copy(*p, _image, options);
+
+                // Without a color profile 10-bit data is packed on the CPU.
+                if (in.colorProfile.type != ColorProfile::RAW ||
+                    colorProfile.type != ColorProfile::RAW ||
+                    !PixelDataUtil::packU10(in, _image))
+                {
+                    _image.zero();
+                    OpenGLImageOptions options;
+                    options.colorProfile = colorProfile;
+                    OpenGLImage().copy(*p, _image, options);
+                }
                 p = &_image;
             }
 
             // Write the file.
             io.set(p->data(), p->dataByteCount());
-            _header.saveEnd(io);
+            io.close();
         }
 
     } // namespace AV
@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/CompressedPixelData.h>
+
+#include <djvAV/RLEUtil.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/ParallelUtil.h>
+
+#include <QCoreApplication>
+
+#include <string.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            // The size of the bands the data is split into.
+            const quint64 bandByteCount = Core::Memory::megabyte;
+
+            //! Compress a band, returning false if the data does not compress.
+            bool compressBand(
+                const quint8 *        in,
+                quint64               size,
+                int                   planes,
+                std::vector<quint8> & out)
+            {
+                const int count = static_cast<int>(size / planes);
+                const quint64 tail = size - static_cast<quint64>(count) * planes;
+                std::vector<quint8> plane(count);
+                out.resize(planes * RLEUtil::packetsMaxByteCount(count, 1) + tail);
+                quint8 * outP = out.data();
+                for (int p = 0; p < planes; ++p)
+                {
+                    // Store each byte as the difference from the same byte of
+                    // the previous pixel.
+                    const quint8 * inP = in + p;
+                    quint8 prev = 0;
+                    for (int i = 0; i < count; ++i, inP += planes)
+                    {
+                        plane[i] = *inP - prev;
+                        prev = *inP;
+                    }
+                    outP += RLEUtil::writePackets(plane.data(), outP, count, 1);
+                    if (static_cast<quint64>(outP - out.data()) >= size)
+                    {
+                        return false;
+                    }
+                }
+                memcpy(outP, in + size - tail, tail);
+                outP += tail;
+                out.resize(outP - out.data());
+                out.shrink_to_fit();
+                return out.size() < size;
+            }
+
+            bool decompressBand(
+                const quint8 * in,
+                const quint8 * end,
+                quint64        size,
+                int            planes,
+                quint8 *       out)
+            {
+                const int count = static_cast<int>(size / planes);
+                const quint64 tail = size - static_cast<quint64>(count) * planes;
+                for (int p = 0; p < planes; ++p)
+                {
+                    in = RLEUtil::readPackets(in, end, out + p, count, 1, planes);
+                    if (!in)
+                    {
+                        return false;
+                    }
+                }
+                if (static_cast<quint64>(end - in) != tail)
+                {
+                    return false;
+                }
+                memcpy(out + size - tail, in, tail);
+
+                // Undo the delta encoding. Each byte depends on the byte one
+                // pixel before it, so this runs in order over the whole band.
+                const quint64 deltaSize = static_cast<quint64>(count) * planes;
+                for (quint64 i = planes; i < deltaSize; ++i)
+                {
+                    out[i] += out[i - planes];
+                }
+                return true;
+            }
+
+        } // namespace
+
+        CompressedPixelData::CompressedPixelData()
+        {}
+
+        CompressedPixelData::CompressedPixelData(const PixelData & in) :
+            _info(in.info()),
+            _scanlineByteCount(in.scanlineByteCount()),
+            _dataByteCount(in.dataByteCount())
+        {
+            //DJV_DEBUG("CompressedPixelData::CompressedPixelData");
+            //DJV_DEBUG_PRINT("in = " << in);
+            if (!in.isValid())
+                return;
+            const int h = in.h();
+            const int bandHeight = Core::Math::clamp(
+                static_cast<int>(bandByteCount / Core::Math::max<quint64>(_scanlineByteCount, 1)), 1, h);
+            const int bandCount = (h + bandHeight - 1) / bandHeight;
+            _bands.resize(bandCount);
+            for (int i = 0; i < bandCount; ++i)
+            {
+                _bands[i].y = i * bandHeight;
+                _bands[i].h = Core::Math::min(bandHeight, h - _bands[i].y);
+            }
+            const int planes = static_cast<int>(in.pixelByteCount());
+            const quint8 * p = in.data();
+            const quint64 scanlineByteCount = _scanlineByteCount;
+            Core::ParallelUtil::forEach(
+                bandCount,
+                [this, p, planes, scanlineByteCount](int i)
+            {
+                Band & band = _bands[i];
+                const quint8 * bandP = p + band.y * scanlineByteCount;
+                const quint64 size = band.h * scanlineByteCount;
+                band.compressed = compressBand(bandP, size, planes, band.data);
+                if (!band.compressed)
+                {
+                    band.data.assign(bandP, bandP + size);
+                }
+            });
+            for (const auto & band : _bands)
+            {
+                _byteCount += band.data.size();
+            }
+            //DJV_DEBUG_PRINT("ratio = " << _dataByteCount / static_cast<float>(_byteCount));
+        }
+
+        const PixelDataInfo & CompressedPixelData::info() const
+        {
+            return _info;
+        }
+
+        quint64 CompressedPixelData::dataByteCount() const
+        {
+            return _dataByteCount;
+        }
+
+        quint64 CompressedPixelData::byteCount() const
+        {
+            return _byteCount;
+        }
+
+        void CompressedPixelData::decompress(PixelData & out) const
+        {
+            //DJV_DEBUG("CompressedPixelData::decompress");
+            out.set(_info);
+            if (out.dataByteCount() != _dataByteCount)
+            {
+                throw Core::Error(
+                    "djv::AV::CompressedPixelData",
+                    qApp->translate("djv::AV::CompressedPixelData", "Cannot decompress the pixel data"));
+            }
+            const int planes = static_cast<int>(out.pixelByteCount());
+            quint8 * p = out.data();
+            const quint64 scanlineByteCount = _scanlineByteCount;
+            Core::ParallelUtil::forEach(
+                static_cast<int>(_bands.size()),
+                [this, p, planes, scanlineByteCount](int i)
+            {
+                const Band & band = _bands[i];
+                quint8 * bandP = p + band.y * scanlineByteCount;
+                const quint64 size = band.h * scanlineByteCount;
+                if (!band.compressed)
+                {
+                    memcpy(bandP, band.data.data(), size);
+                }
+                else if (!decompressBand(band.data.data(), band.data.data() + band.data.size(), size, planes, bandP))
+                {
+                    throw Core::Error(
+                        "djv::AV::CompressedPixelData",
+                        qApp->translate("djv::AV::CompressedPixelData", "Cannot decompress the pixel data"));
+                }
+            });
+        }
+
+    } // namespace AV
+} // namespace djv
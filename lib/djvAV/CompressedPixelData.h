@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvAV/PixelData.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        //! This class provides losslessly compressed pixel data.
+        //!
+        //! The data is split into bands of scanlines that are compressed and
+        //! decompressed in parallel. Within a band each byte of the pixel is
+        //! stored as a separate plane, the planes are delta encoded and then
+        //! run-length encoded. This works well for images with large smooth or
+        //! empty areas, like many computer generated images. Bands that do not
+        //! compress are stored as they are.
+        class CompressedPixelData
+        {
+        public:
+            CompressedPixelData();
+            explicit CompressedPixelData(const PixelData &);
+
+            //! Get the pixel data information.
+            const PixelDataInfo & info() const;
+
+            //! Get the number of bytes in the uncompressed data.
+            quint64 dataByteCount() const;
+
+            //! Get the number of bytes in the compressed data.
+            quint64 byteCount() const;
+
+            //! Decompress the pixel data.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void decompress(PixelData &) const;
+
+        private:
+            struct Band
+            {
+                int                 y          = 0;
+                int                 h          = 0;
+                bool                compressed = false;
+                std::vector<quint8> data;
+            };
+
+            PixelDataInfo     _info;
+            quint64           _scanlineByteCount = 0;
+            quint64           _dataByteCount = 0;
+            quint64           _byteCount = 0;
+            std::vector<Band> _bands;
+        };
+
+    } // namespace AV
+} // namespace djv
@@ -114,7 +114,8 @@ namespace djv
                 qApp->translate("djv::AV::DPX", "Output Film Print") <<
                 qApp->translate("djv::AV::DPX", "Version") <<
                 qApp->translate("djv::AV::DPX", "Type") <<
-                qApp->translate("djv::AV::DPX", "Endian");
+                qApp->translate("djv::AV::DPX", "Endian") <<
+                qApp->translate("djv::AV::DPX", "Read Mode");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
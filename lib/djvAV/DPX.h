@@ -128,6 +128,7 @@ namespace djv
                 VERSION_OPTION,
                 TYPE_OPTION,
                 ENDIAN_OPTION,
+                READ_MODE_OPTION,
 
                 OPTIONS_COUNT
             };
@@ -145,6 +146,7 @@ namespace djv
                 DPX::VERSION              version            = DPX::VERSION_2_0;
                 DPX::TYPE                 type               = DPX::TYPE_U10;
                 DPX::ENDIAN               endian             = DPX::ENDIAN_MSB;
+                Core::FileIO::READ_MODE   readMode           = Core::FileIO::READ_AUTO;
             };
         };
 
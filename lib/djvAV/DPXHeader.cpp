@@ -30,6 +30,7 @@
 #include <djvAV/DPXHeader.h>
 
 #include <djvAV/CineonHeader.h>
+#include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/Debug.h>
 #include <djvCore/Time.h>
@@ -164,6 +165,16 @@ namespace djv
                 found = Pixel::intPixel(channels, image.elem[0].bitDepth, pixel);
             }
             break;
+            case TYPE_B:
+                //DJV_DEBUG_PRINT("type b");
+                // Filling method B is only supported for 10-bit RGB data, the
+                // loader converts it to the memory layout.
+                if (DESCRIPTOR_RGB == image.elem[0].descriptor && 10 == image.elem[0].bitDepth)
+                {
+                    pixel = Pixel::RGB_U10;
+                    found = true;
+                }
+                break;
             case TYPE_A:
                 //DJV_DEBUG_PRINT("type a");
                 switch (image.elem[0].descriptor)
@@ -427,7 +438,7 @@ namespace djv
             file.headerSize = 2048 - 384;
             file.industryHeaderSize = 384;
             file.userHeaderSize = 0;
-            file.size = 0;
+            file.size = file.imageOffset + PixelDataUtil::dataByteCount(info.layers[0]);
             file.dittoKey = 1;
 
             image.elemSize = 1;
@@ -770,6 +781,7 @@ namespace djv
 
             // Write.
             debug();
+            io.preallocate(file.size);
             Core::Memory::ENDIAN fileEndian = Core::Memory::endian();
             if (DPX::ENDIAN_MSB == endian)
             {
@@ -796,13 +808,6 @@ namespace djv
             io.set(&tv, sizeof(Tv));
         }
 
-        void DPXHeader::saveEnd(Core::FileIO & io)
-        {
-            const quint32 size = static_cast<quint32>(io.pos());
-            io.setPos(12);
-            io.setU32(size);
-        }
-
         void DPXHeader::zero(char * in, int size)
         {
             memset(in, 0, size);
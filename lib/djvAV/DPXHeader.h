@@ -275,12 +275,6 @@ namespace djv
             //! - Core::Error
             void save(Core::FileIO &, const IOInfo &, DPX::ENDIAN, Cineon::COLOR_PROFILE, DPX::VERSION);
 
-            //! Update the header when saving is finished.
-            //!
-            //! Throws:
-            //! - Core::Error
-            void saveEnd(Core::FileIO &);
-
             //! Zero memory.
             static void zero(char *, int size);
 
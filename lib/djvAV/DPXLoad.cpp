@@ -35,6 +35,8 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -64,20 +66,26 @@ namespace djv
             _filmPrint = false;
             DPXHeader header;
             header.load(io, info, _filmPrint);
+            _u10Fill = DPXHeader::TYPE_B == header.image.elem[0].packing ?
+                Pixel::U10_FILL_B :
+                Pixel::U10_FILL_A;
             //DJV_DEBUG_PRINT("info = " << info);
             //DJV_DEBUG_PRINT("film print = " << _filmPrint);
+            //DJV_DEBUG_PRINT("10-bit fill = " << _u10Fill);
         }
 
         void DPXLoad::read(Image & image, const ImageIOInfo & frame)
         {
             //DJV_DEBUG("DPXLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::DPXLoad::read");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame != -1 ? frame.frame : _fileInfo.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
             QScopedPointer<Core::FileIO> io(new Core::FileIO);
+            io->setReadMode(_options.readMode);
             _open(fileName, info, *io);
             image.tags = info.tags;
 
@@ -107,7 +115,46 @@ namespace djv
                 mmap = false;
             }
             //DJV_DEBUG_PRINT("mmap = " << mmap);
-            if (mmap)
+
+            // 10-bit data stored with filling method B is converted to the
+            // memory layout.
+            const bool u10 = Pixel::RGB_U10 == pixelDataInfo.pixel && Pixel::U10_FILL_B == _u10Fill;
+            const bool u10Endian = pixelDataInfo.endian != Core::Memory::endian();
+            if (u10)
+            {
+                pixelDataInfo.endian = Core::Memory::endian();
+            }
+            //DJV_DEBUG_PRINT("u10 = " << u10);
+
+            if (mmap && u10)
+            {
+                PixelData * data = frame.proxy ? &_tmp : &image;
+                data->set(pixelDataInfo);
+                const quint8 * inP = io->mmapP();
+                quint8 * outP = data->data();
+                const int w = pixelDataInfo.size.x;
+                Core::ParallelUtil::forBands(
+                    pixelDataInfo.size.y,
+                    64,
+                    [inP, outP, w, u10Endian](int start, int end)
+                {
+                    Pixel::unpackU10(
+                        inP + start * w * 4,
+                        Pixel::U10_FILL_B,
+                        u10Endian,
+                        outP + start * w * 4,
+                        Pixel::RGB_U10,
+                        (end - start) * w);
+                });
+                if (frame.proxy)
+                {
+                    pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
+                    pixelDataInfo.proxy = frame.proxy;
+                    image.set(pixelDataInfo);
+                    PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                }
+            }
+            else if (mmap)
             {
                 if (!frame.proxy)
                 {
@@ -143,6 +190,16 @@ namespace djv
                     error = otherError;
                     errorValid = true;
                 }
+                if (u10)
+                {
+                    Pixel::unpackU10(
+                        data->data(),
+                        Pixel::U10_FILL_B,
+                        u10Endian,
+                        data->data(),
+                        Pixel::RGB_U10,
+                        pixelDataInfo.size.x * pixelDataInfo.size.y);
+                }
                 if (frame.proxy)
                 {
                     pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
@@ -49,10 +49,11 @@ namespace djv
         private:
             void _open(const QString &, IOInfo &, Core::FileIO &);
 
-            DPX::Options _options;
-            bool         _filmPrint = false;
-            PixelData    _filmPrintLut;
-            PixelData    _tmp;
+            DPX::Options    _options;
+            bool            _filmPrint = false;
+            Pixel::U10_FILL _u10Fill = Pixel::U10_FILL_A;
+            PixelData       _filmPrintLut;
+            PixelData       _tmp;
         };
 
     } // namespace AV
@@ -87,6 +87,10 @@ namespace djv
             {
                 out << _options.endian;
             }
+            else if (0 == in.compare(options()[DPX::READ_MODE_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.readMode;
+            }
 
             return out;
         }
@@ -168,6 +172,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[DPX::READ_MODE_OPTION], Qt::CaseInsensitive))
+                {
+                    Core::FileIO::READ_MODE readMode = static_cast<Core::FileIO::READ_MODE>(0);
+                    data >> readMode;
+                    if (readMode != _options.readMode)
+                    {
+                        _options.readMode = readMode;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -225,6 +239,11 @@ namespace djv
                     {
                         in >> _options.endian;
                     }
+                    else if (
+                        qApp->translate("djv::AV::DPXPlugin", "-dpx_read_mode") == arg)
+                    {
+                        in >> _options.readMode;
+                    }
                     else
                     {
                         tmp << arg;
@@ -254,6 +273,8 @@ namespace djv
             typeLabel << _options.type;
             QStringList endianLabel;
             endianLabel << _options.endian;
+            QStringList readModeLabel;
+            readModeLabel << _options.readMode;
             return qApp->translate("djv::AV::DPXPlugin",
                 "\n"
                 "DPX Options\n"
@@ -278,7 +299,9 @@ namespace djv
                 "Default = %10.\n"
                 "    -dpx_endian (value)\n"
                 "        Set the endian used when saving DPX images: %11. Default = "
-                "%12.\n").
+                "%12.\n"
+                "    -dpx_read_mode (value)\n"
+                "        Set how DPX images are read: %13. Default = %14.\n").
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(inputColorProfileLabel.join(", ")).
                 arg(inputFilmPrintLabel.join(", ")).
@@ -290,7 +313,9 @@ namespace djv
                 arg(DPX::typeLabels().join(", ")).
                 arg(typeLabel.join(", ")).
                 arg(DPX::endianLabels().join(", ")).
-                arg(endianLabel.join(", "));
+                arg(endianLabel.join(", ")).
+                arg(Core::FileIO::readModeLabels().join(", ")).
+                arg(readModeLabel.join(", "));
         }
 
         std::unique_ptr<Load> DPXPlugin::createLoad(const Core::FileInfo & fileInfo) const
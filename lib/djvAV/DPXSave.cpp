@@ -30,8 +30,10 @@
 #include <djvAV/DPXSave.h>
 
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -92,6 +94,7 @@ namespace djv
         {
             //DJV_DEBUG("DPXSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::DPXSave::write");
 
             // Set the color profile.
             ColorProfile colorProfile;
@@ -126,16 +129,25 @@ namespace djv
                 colorProfile.type != ColorProfile::RAW)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImageOptions options;
-                options.colorProfile = colorProfile;
-                OpenGLImage().copy(*p, _image, options);
+
+                // Without a color profile 10-bit data is packed on the CPU.
+                if (in.colorProfile.type != ColorProfile::RAW ||
+                    colorProfile.type != ColorProfile::RAW ||
+                    !PixelDataUtil::packU10(in, _image))
+                {
+                    _image.zero();
+                    OpenGLImageOptions options;
+                    options.colorProfile = colorProfile;
+                    OpenGLImage().copy(*p, _image, options);
+                }
                 p = &_image;
             }
 
             // Write the file.
             io.set(p->data(), p->dataByteCount());
-            _header.saveEnd(io);
+
+            // Close the file to get any errors writing the buffered data.
+            io.close();
         }
 
     } // namespace AV
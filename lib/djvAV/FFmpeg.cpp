@@ -34,6 +34,7 @@
 #include <djvCore/Error.h>
 #include <djvCore/FileIOUtil.h>
 #include <djvCore/Math.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringUtil.h>
 
 #include <QCoreApplication>
@@ -105,7 +106,9 @@ namespace djv
                 //qApp->translate("djv::AV::FFmpeg", "H264") <<
                 qApp->translate("djv::AV::FFmpeg", "MPEG4") <<
                 qApp->translate("djv::AV::FFmpeg", "ProRes") <<
-                qApp->translate("djv::AV::FFmpeg", "MJPEG");
+                qApp->translate("djv::AV::FFmpeg", "MJPEG") <<
+                qApp->translate("djv::AV::FFmpeg", "ProRes 4444") <<
+                qApp->translate("djv::AV::FFmpeg", "DNxHR");
             DJV_ASSERT(data.count() == FORMAT_COUNT);
             return data;
         }
@@ -174,6 +177,38 @@ namespace djv
             return i != data.end() ? i->second : unknown;
         }
 
+        bool FFmpeg::toFFmpeg(const PixelDataInfo & info, AVPixelFormat & out)
+        {
+            if (info.mirror.x)
+                return false;
+            const bool msb = Core::Memory::MSB == info.endian;
+            switch (info.pixel)
+            {
+            case Pixel::L_U8:     out = AV_PIX_FMT_GRAY8; break;
+            case Pixel::L_U16:    out = msb ? AV_PIX_FMT_GRAY16BE : AV_PIX_FMT_GRAY16LE; break;
+            case Pixel::RGB_U8:   out = info.bgr ? AV_PIX_FMT_BGR24 : AV_PIX_FMT_RGB24; break;
+            case Pixel::RGBA_U8:  out = info.bgr ? AV_PIX_FMT_BGRA : AV_PIX_FMT_RGBA; break;
+            case Pixel::RGB_U16:
+                out = info.bgr ?
+                    (msb ? AV_PIX_FMT_BGR48BE : AV_PIX_FMT_BGR48LE) :
+                    (msb ? AV_PIX_FMT_RGB48BE : AV_PIX_FMT_RGB48LE);
+                break;
+            case Pixel::RGBA_U16:
+                out = info.bgr ?
+                    (msb ? AV_PIX_FMT_BGRA64BE : AV_PIX_FMT_BGRA64LE) :
+                    (msb ? AV_PIX_FMT_RGBA64BE : AV_PIX_FMT_RGBA64LE);
+                break;
+            default: return false;
+            }
+            return true;
+        }
+
+        bool FFmpeg::isHighBitDepth(AVPixelFormat value)
+        {
+            const AVPixFmtDescriptor * desc = av_pix_fmt_desc_get(value);
+            return desc && desc->comp[0].depth > 8;
+        }
+
         const QStringList & FFmpeg::optionsLabels()
         {
             static const QStringList data = QStringList() <<
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvAV/Audio.h>
+#include <djvAV/PixelData.h>
 
 #include <djvCore/StringUtil.h>
 
@@ -45,6 +46,7 @@ extern "C"
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/dict.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 
 } // extern "C"
@@ -67,6 +69,8 @@ namespace djv
                 MPEG4,
                 PRO_RES,
                 MJPEG,
+                PRO_RES_4444,
+                DNXHR,
 
                 FORMAT_COUNT
             };
@@ -138,6 +142,15 @@ namespace djv
             //! Convert an FFmpeg audio format to a string.
             static QString toString(AVSampleFormat);
 
+            //! Convert pixel data information to an FFmpeg pixel format. Returns
+            //! false if there is no FFmpeg pixel format that matches the memory
+            //! layout of the pixel data.
+            static bool toFFmpeg(const PixelDataInfo &, AVPixelFormat &);
+
+            //! Get whether an FFmpeg pixel format has more than eight bits per
+            //! component.
+            static bool isHighBitDepth(AVPixelFormat);
+
             //! This struct provides options.
             struct Options
             {
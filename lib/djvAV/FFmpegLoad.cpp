@@ -35,6 +35,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Debug.h>
 #include <djvCore/FileIOUtil.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 
@@ -298,6 +299,7 @@ namespace djv
         {
             //DJV_DEBUG("FFmpegLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::FFmpegLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -30,8 +30,10 @@
 #include <djvAV/FFmpegSave.h>
 
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 
@@ -51,14 +53,19 @@ namespace djv
 
             _frame = 0;
 
-            // Open the file.    
+            // Open the file.
+            //
+            // The high bit depth formats are fed 16-bit RGB(A) data so that
+            // deep images (e.g., DPX and OpenEXR) are converted to 10-bit
+            // YUV by a single software scaler pass.
+            const bool alpha = Pixel::channels(ioInfo.layers[0].pixel) == 4 ||
+                Pixel::channels(ioInfo.layers[0].pixel) == 2;
             Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(0);
-            bool bgr = false;
             QString avFormatName;
+            QString avCodecName;
             AVCodecID avCodecId = static_cast<AVCodecID>(0);
             AVPixelFormat avPixel = static_cast<AVPixelFormat>(0);
             float avQScale = -1.f;
-            _avFrameRgbPixel = static_cast<AVPixelFormat>(0);
 
             FFmpeg::Dictionary dictionary;
             QString value;
@@ -83,11 +90,9 @@ namespace djv
                     break;*/
             case FFmpeg::MPEG4:
                 pixel = Pixel::RGBA_U8;
-                bgr = ioInfo.layers[0].bgr;
                 avFormatName = "mp4";
                 avCodecId = AV_CODEC_ID_MPEG4;
                 avPixel = AV_PIX_FMT_YUV420P;
-                _avFrameRgbPixel = bgr ? AV_PIX_FMT_BGRA : AV_PIX_FMT_RGBA;
                 switch (_options.quality)
                 {
                 case FFmpeg::LOW:    avQScale = 9.f; break;
@@ -98,11 +103,10 @@ namespace djv
                 break;
             case FFmpeg::PRO_RES:
                 pixel = Pixel::RGB_U16;
-                bgr = ioInfo.layers[0].bgr;
                 avFormatName = "mov";
+                avCodecName = "prores_ks";
                 avCodecId = AV_CODEC_ID_PRORES;
                 avPixel = AV_PIX_FMT_YUV422P10;
-                _avFrameRgbPixel = bgr ? AV_PIX_FMT_BGR48 : AV_PIX_FMT_RGB48;
                 switch (_options.quality)
                 {
                 case FFmpeg::LOW:    value = "1"; break;
@@ -116,13 +120,51 @@ namespace djv
                     value.toUtf8().data(),
                     0);
                 break;
+            case FFmpeg::PRO_RES_4444:
+                pixel = alpha ? Pixel::RGBA_U16 : Pixel::RGB_U16;
+                avFormatName = "mov";
+                avCodecName = "prores_ks";
+                avCodecId = AV_CODEC_ID_PRORES;
+                avPixel = alpha ? AV_PIX_FMT_YUVA444P10 : AV_PIX_FMT_YUV444P10;
+                av_dict_set(
+                    dictionary(),
+                    "profile",
+                    "4",
+                    0);
+                break;
+            case FFmpeg::DNXHR:
+                avFormatName = "mov";
+                avCodecId = AV_CODEC_ID_DNXHD;
+                switch (_options.quality)
+                {
+                case FFmpeg::LOW:
+                    pixel = Pixel::RGBA_U8;
+                    avPixel = AV_PIX_FMT_YUV422P;
+                    value = "dnxhr_sq";
+                    break;
+                case FFmpeg::MEDIUM:
+                    pixel = Pixel::RGB_U16;
+                    avPixel = AV_PIX_FMT_YUV422P10;
+                    value = "dnxhr_hqx";
+                    break;
+                case FFmpeg::HIGH:
+                    pixel = Pixel::RGB_U16;
+                    avPixel = AV_PIX_FMT_YUV444P10;
+                    value = "dnxhr_444";
+                    break;
+                default: break;
+                }
+                av_dict_set(
+                    dictionary(),
+                    "profile",
+                    value.toUtf8().data(),
+                    0);
+                break;
             case FFmpeg::MJPEG:
                 pixel = Pixel::RGBA_U8;
-                bgr = ioInfo.layers[0].bgr;
                 avFormatName = "mov";
                 avCodecId = AV_CODEC_ID_MJPEG;
                 avPixel = AV_PIX_FMT_YUVJ422P;
-                _avFrameRgbPixel = bgr ? AV_PIX_FMT_BGRA : AV_PIX_FMT_RGBA;
                 switch (_options.quality)
                 {
                 case FFmpeg::LOW:    avQScale = 9.f; break;
@@ -137,7 +179,6 @@ namespace djv
             //DJV_DEBUG_PRINT("av format name = " << avFormatName);
             //DJV_DEBUG_PRINT("av codec id = " << avCodecId);
             //DJV_DEBUG_PRINT("av pixel = " << avPixel);
-            //DJV_DEBUG_PRINT("av rgb pixel = " << _avFrameRgbPixel);
             //DJV_DEBUG_PRINT("av qscale = " << avQScale);
 
             AVOutputFormat * avFormat = av_guess_format(
@@ -156,7 +197,15 @@ namespace djv
             _avFormatContext = avformat_alloc_context();
             _avFormatContext->oformat = avFormat;
 
-            AVCodec * avCodec = avcodec_find_encoder(avCodecId);
+            AVCodec * avCodec = nullptr;
+            if (!avCodecName.isEmpty())
+            {
+                avCodec = avcodec_find_encoder_by_name(avCodecName.toUtf8().data());
+            }
+            if (!avCodec)
+            {
+                avCodec = avcodec_find_encoder(avCodecId);
+            }
             if (!avCodec)
             {
                 throw Core::Error(
@@ -233,9 +282,8 @@ namespace djv
             _info.pixel = pixel;
             _info.bgr = ioInfo.layers[0].bgr;
 
-            // Initialize the buffers.
-            _image.set(_info);
-
+            // Initialize the buffers. The conversion image is only allocated
+            // if it is needed.
             _avFrame = av_frame_alloc();
             _avFrame->width = ioInfo.layers[0].size.x;
             _avFrame->height = ioInfo.layers[0].size.y;
@@ -254,26 +302,8 @@ namespace djv
                 avCodecContext->width,
                 avCodecContext->height);
 
-            _avFrameRgb = av_frame_alloc();
-
-            // Initialize the software scaler.
-            _swsContext = sws_getContext(
-                ioInfo.layers[0].size.x,
-                ioInfo.layers[0].size.y,
-                _avFrameRgbPixel,
-                avCodecContext->width,
-                avCodecContext->height,
-                avCodecContext->pix_fmt,
-                SWS_BILINEAR,
-                0,
-                0,
-                0);
-            if (!_swsContext)
-            {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    qApp->translate("djv::AV::FFmpegSave", "Cannot create software scaler"));
-            }
+            // The software scaler is created when the first image is written,
+            // since it depends on the pixel layout of the incoming images.
         }
 
         FFmpegSave::~FFmpegSave()
@@ -284,45 +314,77 @@ namespace djv
             //DJV_DEBUG("FFmpegSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::FFmpegSave::write");
 
-            // Convert the image if necessary.
+            // Images whose memory layout FFmpeg understands directly (for
+            // example RGB_U16 from DPX and TIFF) are handed straight to the
+            // software scaler. Otherwise convert the image, preferring the
+            // CPU when only the pixel type or endian needs to change.
             const PixelData * p = &in;
-            if (in.info() != _info)
+            AVPixelFormat avPixel = static_cast<AVPixelFormat>(0);
+            if (in.size() != _info.size ||
+                in.proxy() != PixelDataInfo::PROXY_NONE ||
+                !FFmpeg::toFFmpeg(in.info(), avPixel))
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                if (!_image.isValid())
+                {
+                    _image.set(_info);
+                }
+                if (in.size() == _info.size &&
+                    in.proxy() == PixelDataInfo::PROXY_NONE &&
+                    in.info().mirror == _info.mirror)
+                {
+                    PixelDataUtil::proxyScale(in, _image, PixelDataInfo::PROXY_NONE);
+                }
+                else
+                {
+                    _image.zero();
+                    OpenGLImage().copy(in, _image);
+                }
                 p = &_image;
+                FFmpeg::toFFmpeg(_info, avPixel);
             }
+            //DJV_DEBUG_PRINT("av pixel = " << avPixel);
 
-            // Encode the image.
-            avpicture_fill(
-                (AVPicture *)_avFrameRgb,
-                p->data(),
-                _avFrameRgbPixel,
+            // Initialize the software scaler.
+            AVCodecContext * avCodecContext = _avStream->codec;
+            _swsContext = sws_getCachedContext(
+                _swsContext,
                 p->w(),
-                p->h());
-
-            quint64 scanlineByteCount = p->scanlineByteCount();
-            quint64 dataByteCount = p->dataByteCount();
-            const uint8_t * const data[] =
-            {
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount
-            };
-            const int lineSize[] =
+                p->h(),
+                avPixel,
+                avCodecContext->width,
+                avCodecContext->height,
+                avCodecContext->pix_fmt,
+                FFmpeg::isHighBitDepth(avCodecContext->pix_fmt) ?
+                (SWS_BILINEAR | SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT) :
+                SWS_BILINEAR,
+                0,
+                0,
+                0);
+            if (!_swsContext)
             {
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount)
-            };
+                throw Core::Error(
+                    FFmpeg::staticName,
+                    qApp->translate("djv::AV::FFmpegSave", "Cannot create software scaler"));
+            }
+
+            // Encode the image. The image data is stored bottom to top so the
+            // scanlines are flipped unless the image is already mirrored.
+            const quint64 scanlineByteCount = p->scanlineByteCount();
+            const quint64 dataByteCount = p->dataByteCount();
+            const bool flip = !p->info().mirror.y;
+            const uint8_t * const start = flip ?
+                (p->data() + dataByteCount - scanlineByteCount) :
+                p->data();
+            const int stride = flip ?
+                -static_cast<int>(scanlineByteCount) :
+                static_cast<int>(scanlineByteCount);
+            const uint8_t * const data[] = { start, start, start, start };
+            const int lineSize[] = { stride, stride, stride, stride };
             sws_scale(
                 _swsContext,
-                //(uint8_t const * const *)_avFrameRgb->data,
-                //_avFrameRgb->linesize,
                 data,
                 lineSize,
                 0,
@@ -330,7 +392,6 @@ namespace djv
                 _avFrame->data,
                 _avFrame->linesize);
 
-            AVCodecContext * avCodecContext = _avStream->codec;
             FFmpeg::Packet packet;
             packet().data = nullptr;
             packet().size = 0;
@@ -408,11 +469,6 @@ namespace djv
                 sws_freeContext(_swsContext);
                 _swsContext = nullptr;
             }
-            if (_avFrameRgb)
-            {
-                av_frame_free(&_avFrameRgb);
-                _avFrameRgb = nullptr;
-            }
             if (_avFrameBuf)
             {
                 av_free(_avFrameBuf);
@@ -59,8 +59,6 @@ namespace djv
             AVIOContext * _avIoContext = nullptr;
             AVFrame * _avFrame = nullptr;
             uint8_t * _avFrameBuf = nullptr;
-            AVFrame * _avFrameRgb = nullptr;
-            AVPixelFormat _avFrameRgbPixel = static_cast<AVPixelFormat>(0);
             SwsContext * _swsContext = nullptr;
         };
 
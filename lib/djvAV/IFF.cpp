@@ -457,132 +457,6 @@ namespace djv
             header.save(io, info, compression);
         }
 
-        int IFF::readRle(const quint8 * in, quint8 * out, int size)
-        {
-            //DJV_DEBUG("IFF::readRle");
-            //DJV_DEBUG_PRINT("size = " << size);
-
-            const quint8 * const _in = in;
-            const quint8 * const end = out + size;
-
-            while (out < end)
-            {
-                // Information.
-                const quint8 count = (*in & 0x7f) + 1;
-                const bool run = (*in & 0x80) ? true : false;
-                ++in;
-
-                // Find runs.
-                if (!run)
-                {
-                    // Verbatim.
-                    for (int i = 0; i < count; i++)
-                    {
-                        *out++ = *in++;
-                    }
-                }
-                else
-                {
-                    // Duplicate.
-                    const quint8 p = *in++;
-
-                    for (int i = 0; i < count; i++)
-                    {
-                        *out++ = p;
-                    }
-                }
-            }
-
-            const int r = in - _in;
-            //DJV_DEBUG_PRINT("tile r = " << r);
-            return r;
-        }
-
-        namespace
-        {
-            void saveVerbatim(const quint8 *& in, quint8 *& out, int size)
-            {
-                int count = 1;
-                unsigned char byte = 0;
-
-                // Two in a row or count.
-                for (; count < size; ++count)
-                {
-                    if (in[count - 1] == in[count])
-                    {
-                        if (byte == in[count - 1])
-                        {
-                            count -= 2;
-                            break;
-                        }
-                    }
-
-                    byte = in[count - 1];
-                }
-
-                // Information.
-                *out++ = count - 1;
-                memcpy(out, in, count);
-
-                out += count;
-                in += count;
-            }
-
-            void saveDuplicate(const quint8 *& in, quint8 *& out, int size)
-            {
-                int count = 1;
-                for (; count < size; ++count)
-                {
-                    if (in[count - 1] != in[count])
-                    {
-                        break;
-                    }
-                }
-                const bool run = count > 1;
-                const int length = run ? 1 : count;
-
-                // Information.
-                *out++ = ((count - 1) & 0x7f) | (run << 7);
-                *out = *in;
-
-                out += length;
-                in += count;
-            }
-
-        } // namespace
-
-        int IFF::writeRle(const quint8 * in, quint8 * out, int size)
-        {
-            //DJV_DEBUG("IFF::writeRle");
-            //DJV_DEBUG_PRINT("size = " << size);
-
-            const quint8 * const _out = out;
-            const quint8 * const end = in + size;
-
-            while (in < end)
-            {
-                // Find runs.
-                const int max = Core::Math::min(0x7f + 1, static_cast<int>(end - in));
-                if (max > 0)
-                {
-                    if (in[0] != in[1])
-                    {
-                        // Verbatim.
-                        saveVerbatim(in, out, max);
-                    }
-                    else
-                    {
-                        // Duplicate.
-                        saveDuplicate(in, out, max);
-                    }
-                }
-            }
-
-            const int r = out - _out;
-            //DJV_DEBUG_PRINT("tile r = " << r);
-            return r;
-        }
-
         quint32 IFF::alignSize(quint32 size, quint32 alignment)
         {
             quint32 mod = size % alignment;
@@ -68,12 +68,6 @@ namespace djv
             //! - Core::Error
             static void saveInfo(Core::FileIO & io, const IOInfo & info, bool compression);
 
-            //! Load RLE compressed data.
-            static int readRle(const quint8 * in, quint8 * end, int size);
-
-            //! Save RLE compressed data.
-            static int writeRle(const quint8 * in, quint8 * out, int size);
-
             //! Get alignment size.
             static quint32 alignSize(quint32 size, quint32 alignment);
 
@@ -32,8 +32,11 @@
 
 #include <djvAV/Image.h>
 #include <djvAV/PixelDataUtil.h>
+#include <djvAV/RLEUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -43,7 +46,8 @@ namespace djv
             Load(fileInfo, context)
         {
             Core::FileIO io;
-            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io);
+            int tiles = 0;
+            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io, tiles);
             if (Core::FileInfo::SEQUENCE == _fileInfo.type())
             {
                 _ioInfo.sequence.frames = _fileInfo.sequence().frames;
@@ -53,42 +57,148 @@ namespace djv
         IFFLoad::~IFFLoad()
         {}
 
+        namespace
+        {
+            //! This struct provides information about a tile.
+            struct Tile
+            {
+                const quint8 * p    = nullptr;
+                quint32        size = 0;
+                quint16        xmin = 0;
+                quint16        ymin = 0;
+                quint16        xmax = 0;
+                quint16        ymax = 0;
+            };
+
+            void readTile(const Tile & tile, const PixelDataInfo & info, quint8 * out)
+            {
+                const int channels = Pixel::channels(info.pixel);
+                const int channelByteCount = Pixel::channelByteCount(info.pixel);
+                const int byteCount = Pixel::byteCount(info.pixel);
+                const int tw = tile.xmax - tile.xmin + 1;
+                const int th = tile.ymax - tile.ymin + 1;
+                const bool lsb = Core::Memory::endian() == Core::Memory::LSB;
+
+                // If tile compression fails to be less than image data stored
+                // uncompressed, the tile is written uncompressed.
+                if (static_cast<quint32>(tw * th * byteCount) > tile.size)
+                {
+                    // The compressed data is stored as one plane for each byte
+                    // of the pixel. Map the planes to the bytes of the pixel.
+                    static const int map8[] = { 0, 1, 2, 3 };
+                    static const int rgb16LSB[] = { 0, 2, 4, 1, 3, 5 };
+                    static const int rgba16LSB[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+                    static const int rgb16MSB[] = { 1, 3, 5, 0, 2, 4 };
+                    static const int rgba16MSB[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+                    const int * map = map8;
+                    switch (info.pixel)
+                    {
+                    case Pixel::RGB_U16:  map = lsb ? rgb16LSB : rgb16MSB; break;
+                    case Pixel::RGBA_U16: map = lsb ? rgba16LSB : rgba16MSB; break;
+                    default: break;
+                    }
+                    std::vector<quint8> plane(tw * th);
+                    const quint8 * p = tile.p;
+                    const quint8 * const end = tile.p + tile.size;
+                    for (int c = byteCount - 1; c >= 0; --c)
+                    {
+                        p = RLEUtil::readPackets(p, end, plane.data(), tw * th, 1, 1);
+                        if (!p)
+                        {
+                            throw Core::Error(
+                                IFF::staticName,
+                                IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                        }
+                        const quint8 * inP = plane.data();
+                        for (int y = tile.ymin; y <= tile.ymax; ++y)
+                        {
+                            quint8 * outP = out + (y * info.size.x + tile.xmin) * byteCount + map[c];
+                            for (int x = 0; x < tw; ++x, outP += byteCount)
+                            {
+                                *outP = *inP++;
+                            }
+                        }
+                    }
+                    if (p != end)
+                    {
+                        throw Core::Error(
+                            IFF::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
+                    }
+                }
+                else
+                {
+                    // The uncompressed data is stored with the channels in
+                    // reverse order and 16-bit data is big endian.
+                    const quint8 * inP = tile.p;
+                    for (int y = tile.ymin; y <= tile.ymax; ++y)
+                    {
+                        quint8 * outP = out + (y * info.size.x + tile.xmin) * byteCount;
+                        for (int x = 0; x < tw; ++x, inP += byteCount)
+                        {
+                            for (int c = channels - 1; c >= 0; --c, outP += channelByteCount)
+                            {
+                                const quint8 * in = inP + c * channelByteCount;
+                                if (1 == channelByteCount)
+                                {
+                                    outP[0] = in[0];
+                                }
+                                else if (lsb)
+                                {
+                                    outP[0] = in[1];
+                                    outP[1] = in[0];
+                                }
+                                else
+                                {
+                                    outP[0] = in[0];
+                                    outP[1] = in[1];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            bool isType(const quint8 * type, const char * in)
+            {
+                return
+                    type[0] == in[0] &&
+                    type[1] == in[1] &&
+                    type[2] == in[2] &&
+                    type[3] == in[3];
+            }
+
+        } // namespace
+
         void IFFLoad::read(Image & image, const ImageIOInfo & frame)
         {
             //DJV_DEBUG("IFFLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::IFFLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
 
             quint8 type[4];
-            quint8 pixels[32];
-
             quint32 size;
             quint32 chunkSize;
-            quint32 tilesRgba;
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame != -1 ? frame.frame : _fileInfo.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
             Core::FileIO io;
-            _open(fileName, info, io);
+            int tileCount = 0;
+            _open(fileName, info, io, tileCount);
             image.tags = info.tags;
-
-            // Read the file.
-            const int channelByteCount = Pixel::channelByteCount(info.layers[0].pixel);
-            const uint byteCount = Pixel::byteCount(info.layers[0].pixel);
-            //DJV_DEBUG_PRINT("channels = " << channels);
-            //DJV_DEBUG_PRINT("channelByteCount = " << channelByteCount);
-            //DJV_DEBUG_PRINT("byteCount = " << byteCount);
             io.readAhead();
-            PixelData * data = frame.proxy ? &_tmp : &image;
-            data->set(info.layers[0]);
-            tilesRgba = _tiles;
 
-            // Read FOR4 <size> TBMP block
-            for (;;)
+            // Build the tile table from the FOR4 <size> TBMP block.
+            const PixelDataInfo & pixelDataInfo = info.layers[0];
+            std::vector<Tile> tiles;
+            tiles.reserve(tileCount);
+            bool tbmp = false;
+            while (!tbmp)
             {
                 // Get type.
                 io.get(&type, 4);
@@ -97,10 +207,7 @@ namespace djv
                 io.getU32(&size, 1);
                 chunkSize = IFF::alignSize(size, 4);
 
-                if (type[0] == 'A' &&
-                    type[1] == 'U' &&
-                    type[2] == 'T' &&
-                    type[3] == 'H')
+                if (isType(type, "AUTH"))
                 {
                     //DJV_DEBUG_PRINT("type = AUTH");
                     const quint8 * p = io.mmapP();
@@ -114,10 +221,7 @@ namespace djv
                     // Set tag.
                     image.tags = info.tags;
                 }
-                else if (type[0] == 'F' &&
-                    type[1] == 'O' &&
-                    type[2] == 'R' &&
-                    type[3] == '4')
+                else if (isType(type, "FOR4"))
                 {
                     //DJV_DEBUG_PRINT("type = FOR4");
 
@@ -125,15 +229,13 @@ namespace djv
                     io.get(&type, 4);
 
                     // Check if TBMP.
-                    if (type[0] == 'T' &&
-                        type[1] == 'B' &&
-                        type[2] == 'M' &&
-                        type[3] == 'P')
+                    if (isType(type, "TBMP"))
                     {
                         //DJV_DEBUG_PRINT("type = TBMP");
+                        tbmp = true;
 
-                        // Read RGBA and ZBUF block.
-                        for (;;)
+                        // Read the RGBA blocks, skipping the ZBUF blocks.
+                        while (static_cast<int>(tiles.size()) < tileCount)
                         {
                             // Get type.
                             io.get(&type, 4);
@@ -141,328 +243,34 @@ namespace djv
                             // Get length.
                             io.getU32(&size, 1);
                             chunkSize = IFF::alignSize(size, 4);
-
-                            // Tiles and RGBA.
-                            if (tilesRgba &&
-                                type[0] == 'R' &&
-                                type[1] == 'G' &&
-                                type[2] == 'B' &&
-                                type[3] == 'A')
-                            {
-                                // Set image size.
-                                quint32 imageSize = size;
-
-                                // Get tile coordinates.
-                                quint16 xmin, xmax, ymin, ymax;
-                                io.getU16(&xmin, 1);
-                                io.getU16(&ymin, 1);
-                                io.getU16(&xmax, 1);
-                                io.getU16(&ymax, 1);
-
-                                if (xmin > xmax ||
-                                    ymin > ymax ||
-                                    xmax >= info.layers[0].size.x ||
-                                    ymax >= info.layers[0].size.y)
-                                {
-                                    throw Core::Error(
-                                        IFF::staticName,
-                                        IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
-                                }
-
-                                // NOTE: tile w = xmax - xmin + 1
-                                //       tile h = ymax - ymin + 1
-
-                                quint32 tw = xmax - xmin + 1;
-                                quint32 th = ymax - ymin + 1;
-
-                                if (!tw || !th)
-                                {
-                                    throw Core::Error(
-                                        IFF::staticName,
-                                        IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
-                                }
-
-                                bool tile_compress = false;
-
-                                // If tile compression fails to be less than
-                                // image data stored uncompressed, the tile
-                                // is written uncompressed.
-
-                                // Set channels.
-                                quint8 channels = Pixel::channels(info.layers[0].pixel);
-
-                                // Set tile pixels.
-
-                                // Append xmin, xmax, ymin and ymax.
-                                quint32 tileSize =
-                                    tw * th * channels *
-                                    Pixel::channelByteCount(info.layers[0].pixel) + 8;
-
-                                // Test compressed.
-                                if (tileSize > imageSize)
-                                {
-                                    tile_compress = true;
-                                }
-
-                                // Handle 8-bit data.
-                                if (info.layers[0].pixel == Pixel::RGB_U8 ||
-                                    info.layers[0].pixel == Pixel::RGBA_U8)
-                                {
-
-                                    // Tile compress.
-                                    if (tile_compress)
-                                    {
-                                        // Set bytes.
-                                        const quint8 * p = io.mmapP();
-
-                                        // Map: RGB(A)8 BGRA to RGBA
-                                        for (int c = (channels * channelByteCount) - 1;
-                                            c >= 0;
-                                            --c)
-                                        {
-                                            std::vector<quint8> in(tw * th);
-                                            quint8 * inP = in.data();
-
-                                            // Uncompress.
-                                            p += IFF::readRle(p, in.data(), tw * th);
-
-                                            for (quint16 py = ymin; py <= ymax; py++)
-                                            {
-                                                quint8 * out_dy = data->data(0, py);
-
-                                                for (
-                                                    quint16 px = xmin;
-                                                    px <= xmax;
-                                                    px++)
-                                                {
-                                                    quint8 * outP =
-                                                        out_dy + px * byteCount + c;
-                                                    *outP++ = *inP++;
-                                                }
-                                            }
-                                        }
-
-                                        // Seek
-                                        io.seek(imageSize - 8);
-
-                                        // Test.
-                                        if (p != io.mmapP())
-                                        {
-                                            throw Core::Error(
-                                                IFF::staticName,
-                                                IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
-                                        }
-                                    }
-                                    else
-                                    {
-                                        for (quint16 py = ymin; py <= ymax; py++)
-                                        {
-                                            quint8 * out_dy = data->data(xmin, py);
-
-                                            // Tile scanline.
-                                            std::vector<quint8> scanline(tw * byteCount);
-                                            quint8 * outP = scanline.data();
-
-                                            // Set bytes.
-                                            for (quint16 px = xmin; px <= xmax; px++)
-                                            {
-                                                // Get pixels.
-                                                io.get(&pixels, byteCount);
-
-                                                if (size < static_cast<quint32>(byteCount))
-                                                {
-                                                    throw Core::Error(
-                                                        IFF::staticName,
-                                                        IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
-                                                }
-
-                                                size -= byteCount;
-
-                                                // Map: RGB(A)8 ABGR to ARGB
-                                                for (int c = channels - 1; c >= 0; --c)
-                                                {
-                                                    quint8 pixel;
-                                                    quint8 * inP =
-                                                        pixels + c * channelByteCount;
-                                                    memcpy(&pixel, inP, 1);
-                                                    *outP++ = pixel;
-                                                }
-                                            }
-
-                                            // Copy data.
-                                            memcpy(out_dy, scanline.data(), tw * byteCount);
-                                        }
-                                    }
-                                }
-                                // Handle 16-bit data.
-                                else if (
-                                    info.layers[0].pixel == Pixel::RGB_U16 ||
-                                    info.layers[0].pixel == Pixel::RGBA_U16)
-                                {
-                                    if (tile_compress)
-                                    {
-
-                                        // Set bytes.
-                                        const quint8 * p = io.mmapP();
-
-                                        // Set map.
-                                        int* map = NULL;
-
-                                        if (Core::Memory::endian() == Core::Memory::LSB)
-                                        {
-                                            int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                            int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                            if (info.layers[0].pixel == Pixel::RGB_U16)
-                                            {
-                                                map = rgb16;
-                                            }
-                                            else
-                                            {
-                                                map = rgba16;
-                                            }
-                                        }
-                                        else
-                                        {
-                                            int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                            int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                            if (info.layers[0].pixel == Pixel::RGB_U16)
-                                            {
-                                                map = rgb16;
-                                            }
-                                            else
-                                            {
-                                                map = rgba16;
-                                            }
-                                        }
-
-                                        // Map: RGB(A)8 BGRA to RGBA
-                                        for (int c = (channels * channelByteCount) - 1;
-                                            c >= 0;
-                                            --c)
-                                        {
-                                            int mc = map[c];
-
-                                            std::vector<quint8> in(tw * th);
-                                            quint8 * inP = in.data();
-
-                                            // Uncompress.
-                                            p += IFF::readRle(p, in.data(), tw * th);
-
-                                            for (quint16 py = ymin; py <= ymax; py++)
-                                            {
-                                                quint8 * out_dy = data->data(0, py);
-
-                                                for (
-                                                    quint16 px = xmin;
-                                                    px <= xmax;
-                                                    px++)
-                                                {
-                                                    quint8 * outP =
-                                                        out_dy + px * byteCount + mc;
-                                                    *outP++ = *inP++;
-                                                }
-                                            }
-                                        }
-
-                                        // Seek
-                                        io.seek(imageSize - 8);
-
-                                        // Test.
-                                        if (p != io.mmapP())
-                                        {
-                                            throw Core::Error(
-                                                IFF::staticName,
-                                                IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
-                                        }
-                                    }
-                                    else
-                                    {
-                                        for (quint16 py = ymin; py <= ymax; py++)
-                                        {
-                                            quint8 * out_dy = data->data(xmin, py);
-
-                                            // Tile scanline.
-                                            std::vector<quint16> scanline(tw * byteCount);
-                                            quint16 * outP = scanline.data();
-
-                                            // Set bytes.
-                                            for (quint16 px = xmin; px <= xmax; px++)
-                                            {
-                                                // Get pixels.
-                                                io.get(&pixels, byteCount);
-
-                                                if (size < static_cast<quint32>(byteCount))
-                                                {
-                                                    throw Core::Error(
-                                                        IFF::staticName,
-                                                        IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
-                                                }
-
-                                                size -= byteCount;
-
-                                                // Map: RGB8 ABGR to ARGB
-                                                for (int c = channels - 1; c >= 0; --c)
-                                                {
-                                                    quint16 pixel;
-                                                    quint8 * in =
-                                                        pixels + c * channelByteCount;
-
-                                                    if (Core::Memory::endian() == Core::Memory::LSB)
-                                                    {
-                                                        Core::Memory::convertEndian(in, &pixel, 1, 2);
-                                                    }
-                                                    else
-                                                    {
-                                                        memcpy(&pixel, in, 2);
-                                                    }
-
-                                                    // Set pixel.
-                                                    *outP++ = pixel;
-                                                }
-                                            }
-
-                                            // Copy data.
-                                            memcpy(out_dy, scanline.data(), tw * byteCount);
-                                        }
-                                    }
-                                }
-                                else
-                                {
-                                    io.seek(chunkSize);
-                                }
-
-                                // Seek to align to chunksize.
-                                size = chunkSize - imageSize;
-
-                                if (size)
-                                {
-                                    io.seek(size);
-                                }
-
-                                tilesRgba--;
-                            }
-                            else
+                            if (!isType(type, "RGBA"))
                             {
                                 io.seek(chunkSize);
-                            }
-
-                            if (tilesRgba)
-                            {
                                 continue;
                             }
-                            else
+
+                            // Get tile coordinates.
+                            Tile tile;
+                            io.getU16(&tile.xmin, 1);
+                            io.getU16(&tile.ymin, 1);
+                            io.getU16(&tile.xmax, 1);
+                            io.getU16(&tile.ymax, 1);
+                            if (size < 8 ||
+                                tile.xmin > tile.xmax ||
+                                tile.ymin > tile.ymax ||
+                                tile.xmax >= pixelDataInfo.size.x ||
+                                tile.ymax >= pixelDataInfo.size.y)
                             {
-                                break;
+                                throw Core::Error(
+                                    IFF::staticName,
+                                    IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
                             }
-
+                            tile.p = io.mmapP();
+                            tile.size = size - 8;
+                            io.seek(chunkSize - 8);
+                            tiles.push_back(tile);
                         }
-
-                        // TBMP done, break.
-                        break;
                     }
-
                 }
                 else
                 {
@@ -470,26 +278,51 @@ namespace djv
                     io.seek(chunkSize);
                 }
             }
+            //DJV_DEBUG_PRINT("tiles = " << tiles.size());
+
+            // Decompress the tiles in parallel.
+            PixelData tmp;
+            PixelData * data = frame.proxy ? &tmp : &image;
+            data->set(pixelDataInfo);
+            switch (pixelDataInfo.pixel)
+            {
+            case Pixel::RGB_U8:
+            case Pixel::RGBA_U8:
+            case Pixel::RGB_U16:
+            case Pixel::RGBA_U16:
+            {
+                quint8 * out = data->data();
+                Core::ParallelUtil::forEach(
+                    static_cast<int>(tiles.size()),
+                    [&tiles, &pixelDataInfo, out](int i)
+                {
+                    readTile(tiles[i], pixelDataInfo, out);
+                });
+                break;
+            }
+            default: break;
+            }
 
             if (frame.proxy)
             {
                 info.layers[0].size = PixelDataUtil::proxyScale(info.layers[0].size, frame.proxy);
                 info.layers[0].proxy = frame.proxy;
                 image.set(info.layers[0]);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                PixelDataUtil::proxyScale(tmp, image, frame.proxy);
             }
 
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
-        void IFFLoad::_open(const Core::FileInfo & in, IOInfo & info, Core::FileIO & io)
+        void IFFLoad::_open(const Core::FileInfo & in, IOInfo & info, Core::FileIO & io, int & tiles) const
         {
             //DJV_DEBUG("IFFLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
             io.setEndian(Core::Memory::endian() != Core::Memory::MSB);
             io.open(in, Core::FileIO::READ);
             info.layers[0].fileName = in;
-            IFF::loadInfo(io, info, &_tiles, &_compression);
+            bool compression = false;
+            IFF::loadInfo(io, info, &tiles, &compression);
         }
 
     } // namespace AV
@@ -49,11 +49,7 @@ namespace djv
             void read(Image &, const ImageIOInfo &) override;
 
         private:
-            void _open(const Core::FileInfo &, IOInfo &, Core::FileIO &);
-
-            int       _tiles       = 0;
-            bool      _compression = false;
-            PixelData _tmp;
+            void _open(const Core::FileInfo &, IOInfo &, Core::FileIO &, int & tiles) const;
         };
 
     } // namespace AV
@@ -31,8 +31,10 @@
 #include <djvAV/IFFSave.h>
 
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/RLEUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -85,6 +87,7 @@ namespace djv
         {
             //DJV_DEBUG("djvIFFSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::IFFSave::write");
 
             // Open the file.
             Core::FileIO io;
@@ -224,7 +227,7 @@ namespace djv
                                 }
 
                                 // Compress
-                                size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
+                                size = RLEUtil::writePackets(in.data(), tmp.data() + index, tw * th, 1);
                                 index += size;
                             }
 
@@ -354,7 +357,7 @@ namespace djv
                                 }
 
                                 // Compress
-                                size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
+                                size = RLEUtil::writePackets(in.data(), tmp.data() + index, tw * th, 1);
                                 index += size;
                             }
 
@@ -451,6 +454,7 @@ namespace djv
             // NOTE: FOR4 <size> TBMP
             io.setPos(pos + 4);
             io.setU32(p1);
+            io.close();
         }
 
     } // namespace AV
@@ -37,6 +37,7 @@
 #include <djvCore/Error.h>
 #include <djvCore/FileIOUtil.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -98,6 +99,7 @@ namespace djv
         {
             //DJV_DEBUG("IFLLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::IFLLoad::read");
             image.colorProfile = ColorProfile();
             image.tags = Tags();
             QString fileName;
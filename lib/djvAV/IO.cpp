@@ -36,6 +36,7 @@
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QDir>
@@ -298,6 +299,7 @@ namespace djv
         {
             //DJV_DEBUG("IOFactory::load");
             //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+            DJV_TRACE_ZONE("djv::AV::IOFactory::load");
             //DJV_LOG("IOFactory", QString("Loading: \"%1\"...").arg(fileInfo));
             const QString extensionLower = fileInfo.extension().toLower();
             if (_p->extensionMap.contains(extensionLower))
@@ -322,6 +324,7 @@ namespace djv
             //DJV_DEBUG("IOFactory::save");
             //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
             //DJV_DEBUG_PRINT("ioInfo = " << ioInfp);
+            DJV_TRACE_ZONE("djv::AV::IOFactory::save");
             //DJV_LOG("IOFactory", QString("Saving: \"%1\"").arg(fileInfo));
             //QStringList tmp;
             //tmp << ioInfo.size;
@@ -36,6 +36,18 @@ namespace djv
         Image::Image()
         {}
 
+        Image::Image(const Image & other) :
+            PixelData(other),
+            tags(other.tags),
+            colorProfile(other.colorProfile)
+        {}
+
+        Image::Image(Image && other) :
+            PixelData(std::move(other)),
+            tags(std::move(other.tags)),
+            colorProfile(std::move(other.colorProfile))
+        {}
+
         Image::Image(const PixelDataInfo & in, const quint8 * p, Core::FileIO * fileIo) :
             PixelData(in, p, fileIo)
         {}
@@ -43,6 +55,28 @@ namespace djv
         Image::~Image()
         {}
 
+        Image & Image::operator = (const Image & other)
+        {
+            if (&other != this)
+            {
+                PixelData::operator = (other);
+                tags = other.tags;
+                colorProfile = other.colorProfile;
+            }
+            return *this;
+        }
+
+        Image & Image::operator = (Image && other)
+        {
+            if (&other != this)
+            {
+                PixelData::operator = (std::move(other));
+                tags = std::move(other.tags);
+                colorProfile = std::move(other.colorProfile);
+            }
+            return *this;
+        }
+
     } // namespace AV
 
     bool operator == (const AV::Image & a, const AV::Image & b)
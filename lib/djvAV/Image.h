@@ -42,9 +42,14 @@ namespace djv
         {
         public:
             Image();
+            Image(const Image &);
+            Image(Image &&);
             Image(const PixelDataInfo & in, const quint8 * = 0, Core::FileIO * = 0);
             ~Image() override;
 
+            Image & operator = (const Image &);
+            Image & operator = (Image &&);
+
             Tags tags;
             ColorProfile colorProfile;
         };
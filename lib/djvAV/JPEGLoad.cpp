@@ -34,6 +34,7 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -92,6 +93,7 @@ namespace djv
         {
             //DJV_DEBUG("JPEGLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::JPEGLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -34,6 +34,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -107,6 +108,7 @@ namespace djv
         {
             //DJV_DEBUG("JPEGSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::JPEGSave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
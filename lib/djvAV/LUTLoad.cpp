@@ -35,6 +35,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -59,6 +60,7 @@ namespace djv
         {
             //DJV_DEBUG("LUTLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::LUTLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -34,6 +34,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -71,6 +72,7 @@ namespace djv
             //DJV_DEBUG("LUTSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::LUTSave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
@@ -116,6 +118,7 @@ namespace djv
                 break;
             default: break;
             }
+            io.close();
         }
 
     } // namespace AV
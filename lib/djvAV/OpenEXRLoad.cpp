@@ -36,6 +36,7 @@
 #include <djvCore/BoxUtil.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
 
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
@@ -126,6 +127,7 @@ namespace djv
         {
             //DJV_DEBUG("OpenEXRLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::OpenEXRLoad::read");
             try
             {
                 // Open the file.
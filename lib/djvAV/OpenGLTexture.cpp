@@ -33,6 +33,7 @@
 #include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/Debug.h>
+#include <djvCore/FrameStats.h>
 
 #include <QCoreApplication>
 
@@ -123,6 +124,7 @@ namespace djv
         {
             //DJV_DEBUG("OpenGLTexture::copy");
             //DJV_DEBUG_PRINT("in = " << in);
+            Core::FrameStats::Scope scope(Core::FrameStats::UPLOAD);
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
             const PixelDataInfo & info = in.info();
             glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _p->pbo);
@@ -152,6 +154,7 @@ namespace djv
             //DJV_DEBUG("OpenGLTexture::copy");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("area = " << area);
+            Core::FrameStats::Scope scope(Core::FrameStats::UPLOAD);
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
             const PixelDataInfo & info = in.info();
             glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _p->pbo);
@@ -29,6 +29,8 @@
 
 #include <djvAV/PIC.h>
 
+#include <djvAV/RLEUtil.h>
+
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
 #include <djvCore/Memory.h>
@@ -63,24 +65,34 @@ namespace djv
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("stride = " << stride);
-            const quint8 * const outEnd = out + size * stride;
-            while (in < end && out < outEnd)
+            while (size > 0)
             {
                 // Get RLE information.
-                quint16 count = *in++;
+                if (in >= end)
+                {
+                    return nullptr;
+                }
+                int count = *in++;
                 //DJV_DEBUG_PRINT("count = " << count);
-                if (count >= 128)
+                const bool run = count >= 128;
+                if (run)
                 {
                     if (128 == count)
                     {
+                        if (end - in < 2)
+                        {
+                            return nullptr;
+                        }
+                        quint16 tmp = 0;
                         if (endian)
                         {
-                            Core::Memory::convertEndian(in, &count, 1, 2);
+                            Core::Memory::convertEndian(in, &tmp, 1, 2);
                         }
                         else
                         {
-                            memcpy(&count, in, 2);
+                            memcpy(&tmp, in, 2);
                         }
+                        count = tmp;
                         in += 2;
                     }
                     else
@@ -88,40 +100,30 @@ namespace djv
                         count -= 127;
                     }
                     //DJV_DEBUG_PRINT("repeat = " << count);
-                    const quint8 * p = in;
-                    in += channels;
-                    if (in > end)
-                    {
-                        break;
-                    }
-                    for (quint16 i = 0; i < count; ++i, out += stride)
-                    {
-                        for (int j = 0; j < channels; ++j)
-                        {
-                            out[j] = p[j];
-                        }
-                    }
                 }
                 else
                 {
                     ++count;
                     //DJV_DEBUG_PRINT("raw = " << count);
-                    const quint8 * p = in;
-                    in += count * channels;
-                    if (in > end)
-                    {
-                        break;
-                    }
-                    for (quint16 i = 0; i < count; ++i, p += channels, out += stride)
-                    {
-                        for (int j = 0; j < channels; ++j)
-                        {
-                            out[j] = p[j];
-                        }
-                    }
                 }
+                const int length = (run ? 1 : count) * channels;
+                if (count > size || length > end - in)
+                {
+                    return nullptr;
+                }
+                if (run)
+                {
+                    RLEUtil::fill(in, channels, out, count, stride);
+                }
+                else
+                {
+                    RLEUtil::copy(in, channels, out, count, stride);
+                }
+                in += length;
+                out += count * stride;
+                size -= count;
             }
-            return in > end ? 0 : in;
+            return in;
         }
 
     } // namespace AV
@@ -64,7 +64,8 @@ namespace djv
             //! Get the compression labels.
             static const QStringList & compressionLabels();
 
-            //! Load RLE data.
+            //! Load RLE data. Returns a pointer to the end of the compressed
+            //! data, or nullptr if the data is corrupt.
             static const quint8 * readRle(
                 const quint8 * in,
                 const quint8 * end,
@@ -34,6 +34,7 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -57,6 +58,7 @@ namespace djv
         {
             //DJV_DEBUG("PICLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::PICLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
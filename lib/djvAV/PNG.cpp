@@ -29,9 +29,12 @@
 
 #include <djvAV/PNG.h>
 
+#include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/DebugLog.h>
 
+#include <QCoreApplication>
+
 using namespace djv;
 
 namespace djv
@@ -40,7 +43,46 @@ namespace djv
     {
         const QString PNG::staticName = "PNG";
 
+        const QStringList & PNG::strategyLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::AV::PNG", "Default") <<
+                qApp->translate("djv::AV::PNG", "Filtered") <<
+                qApp->translate("djv::AV::PNG", "Huffman Only") <<
+                qApp->translate("djv::AV::PNG", "RLE") <<
+                qApp->translate("djv::AV::PNG", "Fixed");
+            DJV_ASSERT(data.count() == STRATEGY_COUNT);
+            return data;
+        }
+
+        const QStringList & PNG::filterLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::AV::PNG", "Auto") <<
+                qApp->translate("djv::AV::PNG", "None") <<
+                qApp->translate("djv::AV::PNG", "Sub") <<
+                qApp->translate("djv::AV::PNG", "Up") <<
+                qApp->translate("djv::AV::PNG", "Average") <<
+                qApp->translate("djv::AV::PNG", "Paeth");
+            DJV_ASSERT(data.count() == FILTER_COUNT);
+            return data;
+        }
+
+        const QStringList & PNG::optionsLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::AV::PNG", "Compression Level") <<
+                qApp->translate("djv::AV::PNG", "Strategy") <<
+                qApp->translate("djv::AV::PNG", "Filter");
+            DJV_ASSERT(data.count() == OPTIONS_COUNT);
+            return data;
+        }
+
     } // namespace AV
+
+    _DJV_STRING_OPERATOR_LABEL(AV::PNG::STRATEGY, AV::PNG::strategyLabels())
+    _DJV_STRING_OPERATOR_LABEL(AV::PNG::FILTER, AV::PNG::filterLabels())
+
 } // namespace djv
 
 extern "C"
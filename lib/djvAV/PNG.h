@@ -49,6 +49,58 @@ namespace djv
         struct PNG
         {
             static const QString staticName;
+
+            //! This enumeration provides the zlib compression strategies.
+            enum STRATEGY
+            {
+                STRATEGY_DEFAULT,
+                STRATEGY_FILTERED,
+                STRATEGY_HUFFMAN_ONLY,
+                STRATEGY_RLE,
+                STRATEGY_FIXED,
+
+                STRATEGY_COUNT
+            };
+
+            //! Get the compression strategy labels.
+            static const QStringList & strategyLabels();
+
+            //! This enumeration provides the row filters.
+            enum FILTER
+            {
+                FILTER_AUTO,
+                FILTER_NONE,
+                FILTER_SUB,
+                FILTER_UP,
+                FILTER_AVERAGE,
+                FILTER_PAETH,
+
+                FILTER_COUNT
+            };
+
+            //! Get the row filter labels.
+            static const QStringList & filterLabels();
+
+            //! This enumeration provides the options.
+            enum OPTIONS
+            {
+                COMPRESSION_LEVEL_OPTION,
+                STRATEGY_OPTION,
+                FILTER_OPTION,
+
+                OPTIONS_COUNT
+            };
+
+            //! Get option labels.
+            static const QStringList & optionsLabels();
+
+            //! This struct provides options.
+            struct Options
+            {
+                int      compressionLevel = 6;
+                STRATEGY strategy         = STRATEGY_DEFAULT;
+                FILTER   filter           = FILTER_AUTO;
+            };
         };
 
         //! This struct provides libpng error handling.
@@ -59,6 +111,10 @@ namespace djv
         };
 
     } // namespace AV
+
+    DJV_STRING_OPERATOR(AV::PNG::STRATEGY);
+    DJV_STRING_OPERATOR(AV::PNG::FILTER);
+
 } // namespace djv
 
 extern "C"
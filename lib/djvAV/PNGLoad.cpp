@@ -34,18 +34,42 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
+
+#include <vector>
 
 namespace djv
 {
     namespace AV
     {
+        //! This struct provides the state for reading a file.
+        struct PNGLoad::File
+        {
+            ~File()
+            {
+                if (png || pngInfo || pngInfoEnd)
+                {
+                    png_destroy_read_struct(
+                        png ? &png : nullptr,
+                        pngInfo ? &pngInfo : nullptr,
+                        pngInfoEnd ? &pngInfoEnd : nullptr);
+                }
+            }
+
+            Core::FileIO   io;
+            png_structp    png = nullptr;
+            png_infop      pngInfo = nullptr;
+            png_infop      pngInfoEnd = nullptr;
+            PNGErrorStruct pngError;
+        };
+
         PNGLoad::PNGLoad(const Core::FileInfo & fileInfo, const QPointer<Core::CoreContext> & context) :
             Load(fileInfo, context)
         {
-            _pngError.context = context;
-            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo);
-            _close();
+            File file;
+            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, file);
             if (Core::FileInfo::SEQUENCE == _fileInfo.type())
             {
                 _ioInfo.sequence.frames = _fileInfo.sequence().frames;
@@ -53,19 +77,17 @@ namespace djv
         }
 
         PNGLoad::~PNGLoad()
-        {
-            _close();
-        }
+        {}
 
         namespace
         {
-            bool pngScanline(png_structp png, quint8 * out)
+            bool pngRows(png_structp png, png_bytepp rows, int count)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
                     return false;
                 }
-                png_read_row(png, out, 0);
+                png_read_rows(png, rows, 0, count);
                 return true;
             }
 
@@ -85,6 +107,7 @@ namespace djv
         {
             //DJV_DEBUG("PNGLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::PNGLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -93,22 +116,28 @@ namespace djv
             const QString fileName = _fileInfo.fileName(frame.frame != -1 ? frame.frame : _fileInfo.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
-            _open(fileName, info);
+            File file;
+            _open(fileName, info, file);
 
-            // Read the file.
-            PixelData * data = frame.proxy ? &_tmp : &image;
+            // Read the file. The rows are stored bottom to top so we pass
+            // libpng a table of row pointers and read them in one call.
+            PixelData tmp;
+            PixelData * data = frame.proxy ? &tmp : &image;
             auto pixelDataInfo = info.layers[0];
             data->set(pixelDataInfo);
-            for (int y = 0; y < pixelDataInfo.size.y; ++y)
+            const int h = pixelDataInfo.size.y;
+            std::vector<png_bytep> rows(h);
+            for (int y = 0; y < h; ++y)
             {
-                if (!pngScanline(_png, data->data(0, data->h() - 1 - y)))
-                {
-                    throw Core::Error(PNG::staticName, _pngError.msg);
-                }
+                rows[y] = data->data(0, h - 1 - y);
             }
-            if (!pngEnd(_png, _pngInfoEnd))
+            if (!pngRows(file.png, rows.data(), h))
             {
-                throw Core::Error(PNG::staticName, _pngError.msg);
+                throw Core::Error(PNG::staticName, file.pngError.msg);
+            }
+            if (!pngEnd(file.png, file.pngInfoEnd))
+            {
+                throw Core::Error(PNG::staticName, file.pngError.msg);
             }
 
             // Proxy scale the image.
@@ -117,21 +146,38 @@ namespace djv
                 pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
                 pixelDataInfo.proxy = frame.proxy;
                 image.set(pixelDataInfo);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                PixelDataUtil::proxyScale(tmp, image, frame.proxy);
             }
 
             //DJV_DEBUG_PRINT("image = " << image);
-
-            _close();
         }
 
         namespace
         {
+            void pngRead(png_structp png, png_bytep out, png_size_t size)
+            {
+                // Errors must not be thrown through libpng, so convert them to a
+                // libpng error.
+                bool error = false;
+                try
+                {
+                    reinterpret_cast<Core::FileIO *>(png_get_io_ptr(png))->get(out, size);
+                }
+                catch (const Core::Error &)
+                {
+                    error = true;
+                }
+                if (error)
+                {
+                    png_error(png, "Cannot read file");
+                }
+            }
+
             bool pngOpen(
-                FILE *      f,
-                png_structp png,
-                png_infop * pngInfo,
-                png_infop * pngInfoEnd)
+                Core::FileIO & io,
+                png_structp    png,
+                png_infop *    pngInfo,
+                png_infop *    pngInfoEnd)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
@@ -148,15 +194,12 @@ namespace djv
                     return false;
                 }
                 quint8 tmp[8];
-                if (::fread(tmp, 8, 1, f) != 1)
-                {
-                    return false;
-                }
+                io.get(tmp, 8);
                 if (png_sig_cmp(tmp, 0, 8))
                 {
                     return false;
                 }
-                png_init_io(png, f);
+                png_set_read_fn(png, &io, pngRead);
                 png_set_sig_bytes(png, 8);
                 png_read_info(png, *pngInfo);
                 if (png_get_interlace_type(png, *pngInfo) != PNG_INTERLACE_NONE)
@@ -172,37 +215,30 @@ namespace djv
 
         } // namespace
 
-        void PNGLoad::_open(const QString & in, IOInfo & info)
+        void PNGLoad::_open(const QString & in, IOInfo & info, File & file) const
         {
             //DJV_DEBUG("PNGLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
 
             // Initialize libpng.
-            _png = png_create_read_struct(
+            file.pngError.context = context();
+            file.png = png_create_read_struct(
                 PNG_LIBPNG_VER_STRING,
-                &_pngError,
+                &file.pngError,
                 djvPNGError,
                 djvPNGWarning);
-            if (!_png)
+            if (!file.png)
             {
                 throw Core::Error(
                     PNG::staticName,
                     IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
             }
 
-            // Open the file.
-#if defined(DJV_WINDOWS)
-            ::_wfopen_s(&_f, Core::StringUtil::qToStdWString(in).data(), L"rb");
-#else
-            _f = ::fopen(in.toUtf8().data(), "rb");
-#endif
-            if (!_f)
-            {
-                throw Core::Error(
-                    PNG::staticName,
-                    IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
-            }
-            if (!pngOpen(_f, _png, &_pngInfo, &_pngInfoEnd))
+            // Open the file. The file is memory mapped and libpng reads from
+            // the map with a custom callback.
+            file.io.open(in, Core::FileIO::READ);
+            file.io.readAhead();
+            if (!pngOpen(file.io, file.png, &file.pngInfo, &file.pngInfoEnd))
             {
                 throw Core::Error(
                     PNG::staticName,
@@ -210,21 +246,23 @@ namespace djv
             }
 
             // Get file information.
+            png_structp png = file.png;
+            png_infop pngInfo = file.pngInfo;
             info.layers[0].fileName = in;
             info.layers[0].size = glm::ivec2(
-                png_get_image_width(_png, _pngInfo),
-                png_get_image_height(_png, _pngInfo));
-            int channels = png_get_channels(_png, _pngInfo);
-            if (png_get_color_type(_png, _pngInfo) == PNG_COLOR_TYPE_PALETTE)
+                png_get_image_width(png, pngInfo),
+                png_get_image_height(png, pngInfo));
+            int channels = png_get_channels(png, pngInfo);
+            if (png_get_color_type(png, pngInfo) == PNG_COLOR_TYPE_PALETTE)
             {
                 channels = 3;
             }
-            if (png_get_valid(_png, _pngInfo, PNG_INFO_tRNS))
+            if (png_get_valid(png, pngInfo, PNG_INFO_tRNS))
             {
                 ++channels;
             }
             //DJV_DEBUG_PRINT("channels = " << channels);
-            int bitDepth = png_get_bit_depth(_png, _pngInfo);
+            int bitDepth = png_get_bit_depth(png, pngInfo);
             if (bitDepth < 8)
             {
                 bitDepth = 8;
@@ -240,26 +278,7 @@ namespace djv
             // Set the endian.
             if (bitDepth >= 16 && Core::Memory::LSB == Core::Memory::endian())
             {
-                png_set_swap(_png);
-            }
-        }
-
-        void PNGLoad::_close()
-        {
-            if (_png || _pngInfo || _pngInfoEnd)
-            {
-                png_destroy_read_struct(
-                    _png ? &_png : nullptr,
-                    _pngInfo ? &_pngInfo : nullptr,
-                    _pngInfoEnd ? &_pngInfoEnd : nullptr);
-                _png = nullptr;
-                _pngInfo = nullptr;
-                _pngInfoEnd = nullptr;
-            }
-            if (_f)
-            {
-                ::fclose(_f);
-                _f = nullptr;
+                png_set_swap(png);
             }
         }
 
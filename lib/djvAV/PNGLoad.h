@@ -38,6 +38,8 @@ namespace djv
 {
     namespace AV
     {
+        //! This class provides a PNG loader. The loader does not keep any state
+        //! between reads, so frames may be read from several threads at once.
         class PNGLoad : public Load
         {
         public:
@@ -47,15 +49,9 @@ namespace djv
             void read(Image &, const ImageIOInfo &) override;
 
         private:
-            void _open(const QString &, IOInfo &);
-            void _close();
-
-            FILE *         _f = nullptr;
-            png_structp    _png = nullptr;
-            png_infop      _pngInfo = nullptr;
-            png_infop      _pngInfoEnd = nullptr;
-            PNGErrorStruct _pngError;
-            PixelData      _tmp;
+            struct File;
+
+            void _open(const QString &, IOInfo &, File &) const;
         };
 
     } // namespace AV
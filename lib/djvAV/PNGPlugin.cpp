@@ -34,6 +34,8 @@
 
 #include <djvCore/CoreContext.h>
 
+#include <QCoreApplication>
+
 namespace djv
 {
     namespace AV
@@ -52,6 +54,133 @@ namespace djv
             return QStringList() << ".png";
         }
 
+        QStringList PNGPlugin::option(const QString & in) const
+        {
+            QStringList out;
+            if (0 == in.compare(options()[PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.compressionLevel;
+            }
+            else if (0 == in.compare(options()[PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.strategy;
+            }
+            else if (0 == in.compare(options()[PNG::FILTER_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.filter;
+            }
+            return out;
+        }
+
+        bool PNGPlugin::setOption(const QString & in, QStringList & data)
+        {
+            try
+            {
+                if (0 == in.compare(options()[PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+                {
+                    int compressionLevel = 0;
+                    data >> compressionLevel;
+                    if (compressionLevel != _options.compressionLevel)
+                    {
+                        _options.compressionLevel = compressionLevel;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+                {
+                    PNG::STRATEGY strategy = static_cast<PNG::STRATEGY>(0);
+                    data >> strategy;
+                    if (strategy != _options.strategy)
+                    {
+                        _options.strategy = strategy;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[PNG::FILTER_OPTION], Qt::CaseInsensitive))
+                {
+                    PNG::FILTER filter = static_cast<PNG::FILTER>(0);
+                    data >> filter;
+                    if (filter != _options.filter)
+                    {
+                        _options.filter = filter;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+            }
+            catch (const QString &)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        QStringList PNGPlugin::options() const
+        {
+            return PNG::optionsLabels();
+        }
+
+        void PNGPlugin::commandLine(QStringList & in)
+        {
+            QStringList tmp;
+            QString     arg;
+            try
+            {
+                while (!in.isEmpty())
+                {
+                    in >> arg;
+                    if (qApp->translate("djv::AV::PNGPlugin", "-png_compression_level") == arg)
+                    {
+                        in >> _options.compressionLevel;
+                    }
+                    else if (qApp->translate("djv::AV::PNGPlugin", "-png_strategy") == arg)
+                    {
+                        in >> _options.strategy;
+                    }
+                    else if (qApp->translate("djv::AV::PNGPlugin", "-png_filter") == arg)
+                    {
+                        in >> _options.filter;
+                    }
+                    else
+                    {
+                        tmp << arg;
+                    }
+                }
+            }
+            catch (const QString &)
+            {
+                throw arg;
+            }
+            in = tmp;
+        }
+
+        QString PNGPlugin::commandLineHelp() const
+        {
+            QStringList compressionLevelLabel;
+            compressionLevelLabel << _options.compressionLevel;
+            QStringList strategyLabel;
+            strategyLabel << _options.strategy;
+            QStringList filterLabel;
+            filterLabel << _options.filter;
+            return qApp->translate("djv::AV::PNGPlugin",
+                "\n"
+                "PNG Options\n"
+                "\n"
+                "    -png_compression_level (value)\n"
+                "        Set the zlib compression level (0-9) used when saving PNG images. "
+                "Default = %1.\n"
+                "    -png_strategy (value)\n"
+                "        Set the zlib compression strategy used when saving PNG images: %2. "
+                "Default = %3.\n"
+                "    -png_filter (value)\n"
+                "        Set the row filter used when saving PNG images: %4. "
+                "Default = %5.\n").
+                arg(compressionLevelLabel.join(", ")).
+                arg(PNG::strategyLabels().join(", ")).
+                arg(strategyLabel.join(", ")).
+                arg(PNG::filterLabels().join(", ")).
+                arg(filterLabel.join(", "));
+        }
+
         std::unique_ptr<Load> PNGPlugin::createLoad(const Core::FileInfo & fileInfo) const
         {
             return std::unique_ptr<Load>(new PNGLoad(fileInfo, context()));
@@ -59,7 +188,7 @@ namespace djv
 
         std::unique_ptr<Save> PNGPlugin::createSave(const Core::FileInfo & fileInfo, const IOInfo & ioInfo) const
         {
-            return std::unique_ptr<Save>(new PNGSave(fileInfo, ioInfo, context()));
+            return std::unique_ptr<Save>(new PNGSave(fileInfo, ioInfo, _options, context()));
         }
 
     } // namespace AV
@@ -45,6 +45,7 @@ namespace djv
         //!
         //! Supported features:
         //! - 8-bit, 16-bit, Luminance, RGB, RGBA
+        //! - Configurable zlib compression level, strategy, and row filter
         class PNGPlugin : public IOPlugin
         {
         public:
@@ -53,8 +54,18 @@ namespace djv
             QString pluginName() const override;
             QStringList extensions() const override;
 
+            QStringList option(const QString &) const override;
+            bool setOption(const QString &, QStringList &) override;
+            QStringList options() const override;
+
+            void commandLine(QStringList &) override;
+            QString commandLineHelp() const override;
+
             std::unique_ptr<Load> createLoad(const Core::FileInfo &) const override;
             std::unique_ptr<Save> createSave(const Core::FileInfo &, const IOInfo &) const override;
+
+        private:
+            PNG::Options _options;
         };
 
     } // namespace AV
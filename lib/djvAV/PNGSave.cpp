@@ -33,15 +33,27 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
+
+#include <zlib.h>
 
 namespace djv
 {
     namespace AV
     {
-        PNGSave::PNGSave(const Core::FileInfo & fileInfo, const IOInfo & ioInfo, const QPointer<Core::CoreContext> & context) :
-            Save(fileInfo, ioInfo, context)
+        namespace
+        {
+            //! The size of the write buffer.
+            const size_t writeBufferSize = 256 * 1024;
+
+        } // namespace
+
+        PNGSave::PNGSave(const Core::FileInfo & fileInfo, const IOInfo & ioInfo, const PNG::Options & options, const QPointer<Core::CoreContext> & context) :
+            Save(fileInfo, ioInfo, context),
+            _options(options)
         {
             //DJV_DEBUG("PNGSave::PNGSave");
             //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
@@ -72,11 +84,11 @@ namespace djv
 
         namespace
         {
-            bool pngScanline(png_structp png, const quint8 * in)
+            bool pngRows(png_structp png, png_bytepp rows, int count)
             {
                 if (setjmp(png_jmpbuf(png)))
                     return false;
-                png_write_row(png, (png_byte *)in);
+                png_write_rows(png, rows, count);
                 return true;
             }
 
@@ -94,6 +106,7 @@ namespace djv
         {
             //DJV_DEBUG("PNGSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::PNGSave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
@@ -113,17 +126,22 @@ namespace djv
 
             // Write the file.
             const int h = p->h();
+            std::vector<png_bytep> rows(h);
             for (int y = 0; y < h; ++y)
             {
-                if (!pngScanline(_png, p->data(0, h - 1 - y)))
-                {
-                    throw Core::Error(PNG::staticName, _pngError.msg);
-                }
+                rows[y] = const_cast<png_bytep>(p->data(0, h - 1 - y));
+            }
+            if (!pngRows(_png, rows.data(), h))
+            {
+                throw Core::Error(PNG::staticName, _pngError.msg);
             }
             if (!pngEnd(_png, _pngInfo))
             {
                 throw Core::Error(PNG::staticName, _pngError.msg);
             }
+            _writer->io.set(_writer->buffer.data(), _writer->buffer.size());
+            _writer->buffer.clear();
+            _writer->io.close();
 
             _close();
         }
@@ -131,10 +149,10 @@ namespace djv
         namespace
         {
             bool pngOpen(
-                FILE *         f,
-                png_structp    png,
-                png_infop *    pngInfo,
-                const IOInfo & info)
+                png_structp          png,
+                png_infop *          pngInfo,
+                const IOInfo &       info,
+                const PNG::Options & options)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
@@ -145,7 +163,28 @@ namespace djv
                 {
                     return false;
                 }
-                png_init_io(png, f);
+                png_set_compression_level(png, Core::Math::clamp(options.compressionLevel, 0, 9));
+                int strategy = Z_DEFAULT_STRATEGY;
+                switch (options.strategy)
+                {
+                case PNG::STRATEGY_FILTERED:     strategy = Z_FILTERED;     break;
+                case PNG::STRATEGY_HUFFMAN_ONLY: strategy = Z_HUFFMAN_ONLY; break;
+                case PNG::STRATEGY_RLE:          strategy = Z_RLE;          break;
+                case PNG::STRATEGY_FIXED:        strategy = Z_FIXED;        break;
+                default: break;
+                }
+                png_set_compression_strategy(png, strategy);
+                int filter = PNG_ALL_FILTERS;
+                switch (options.filter)
+                {
+                case PNG::FILTER_NONE:    filter = PNG_FILTER_NONE;  break;
+                case PNG::FILTER_SUB:     filter = PNG_FILTER_SUB;   break;
+                case PNG::FILTER_UP:      filter = PNG_FILTER_UP;    break;
+                case PNG::FILTER_AVERAGE: filter = PNG_FILTER_AVG;   break;
+                case PNG::FILTER_PAETH:   filter = PNG_FILTER_PAETH; break;
+                default: break;
+                }
+                png_set_filter(png, PNG_FILTER_TYPE_BASE, filter);
                 int colorType = 0;
                 switch (info.layers[0].pixel)
                 {
@@ -201,19 +240,13 @@ namespace djv
                     IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
             }
 
-            // Open the file.
-#if defined(DJV_WINDOWS)
-            ::_wfopen_s(&_f, Core::StringUtil::qToStdWString(in).data(), L"wb");
-#else
-            _f = ::fopen(in.toUtf8().data(), "wb");
-#endif
-            if (!_f)
-            {
-                throw Core::Error(
-                    PNG::staticName,
-                    IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
-            }
-            if (!pngOpen(_f, _png, &_pngInfo, info))
+            // Open the file. libpng writes through a custom callback into a
+            // buffer that is flushed to the file in large blocks.
+            _writer.reset(new Writer);
+            _writer->io.open(in, Core::FileIO::WRITE);
+            _writer->buffer.reserve(writeBufferSize);
+            png_set_write_fn(_png, _writer.get(), _pngWrite, _pngFlush);
+            if (!pngOpen(_png, &_pngInfo, info, _options))
             {
                 throw Core::Error(PNG::staticName, _pngError.msg);
             }
@@ -236,11 +269,44 @@ namespace djv
                 _png = nullptr;
                 _pngInfo = nullptr;
             }
-            if (_f)
+            _writer.reset();
+        }
+
+        void PNGSave::_pngWrite(png_structp png, png_bytep in, png_size_t size)
+        {
+            // Errors must not be thrown through libpng, so convert them to a
+            // libpng error.
+            bool error = false;
+            try
             {
-                ::fclose(_f);
-                _f = nullptr;
+                Writer * writer = reinterpret_cast<Writer *>(png_get_io_ptr(png));
+                if (writer->buffer.size() + size > writeBufferSize)
+                {
+                    writer->io.set(writer->buffer.data(), writer->buffer.size());
+                    writer->buffer.clear();
+                }
+                if (size >= writeBufferSize)
+                {
+                    writer->io.set(in, size);
+                }
+                else
+                {
+                    writer->buffer.insert(writer->buffer.end(), in, in + size);
+                }
             }
+            catch (const Core::Error &)
+            {
+                error = true;
+            }
+            if (error)
+            {
+                png_error(png, "Cannot write file");
+            }
+        }
+
+        void PNGSave::_pngFlush(png_structp)
+        {
+            // The buffer is flushed when the image has been written.
         }
 
     } // namespace AV
@@ -34,6 +34,10 @@
 #include <djvAV/PNG.h>
 
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
+
+#include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -42,23 +46,33 @@ namespace djv
         class PNGSave : public Save
         {
         public:
-            explicit PNGSave(const Core::FileInfo &, const IOInfo &, const QPointer<Core::CoreContext> &);
+            explicit PNGSave(const Core::FileInfo &, const IOInfo &, const PNG::Options &, const QPointer<Core::CoreContext> &);
             ~PNGSave() override;
 
             void write(const Image &, const ImageIOInfo &) override;
 
         private:
+            //! This struct provides a buffered file writer for libpng.
+            struct Writer
+            {
+                Core::FileIO        io;
+                std::vector<quint8> buffer;
+            };
+
+            static void _pngWrite(png_structp, png_bytep, png_size_t);
+            static void _pngFlush(png_structp);
+
             void _open(const QString &, const IOInfo &);
             void _close();
 
-            FILE *         _f = nullptr;
-            png_structp    _png = nullptr;
-            png_infop      _pngInfo = nullptr;
-            PNGErrorStruct _pngError;
-            PixelDataInfo  _info;
-            Image          _image;
+            PNG::Options            _options;
+            std::unique_ptr<Writer> _writer;
+            png_structp             _png = nullptr;
+            png_infop               _pngInfo = nullptr;
+            PNGErrorStruct          _pngError;
+            PixelDataInfo           _info;
+            Image                   _image;
         };
 
     } // namespace AV
 } // namespace djv
-
@@ -29,9 +29,10 @@
 
 #include <djvAV/PPM.h>
 
+#include <djvAV/IO.h>
+
 #include <djvCore/Assert.h>
 #include <djvCore/Error.h>
-#include <djvCore/FileIOUtil.h>
 #include <djvCore/Math.h>
 
 #include <QCoreApplication>
@@ -109,42 +110,135 @@ namespace djv
             return out;
         }
 
+        namespace
+        {
+            //! Skip white space and comments.
+            inline const quint8 * skipSpace(const quint8 * p, const quint8 * end)
+            {
+                while (p < end)
+                {
+                    switch (*p)
+                    {
+                    case ' ':
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                    case '\v':
+                    case '\f':
+                    case '\0':
+                        ++p;
+                        break;
+                    case '#':
+                        while (p < end && *p != '\n' && *p != '\r')
+                        {
+                            ++p;
+                        }
+                        break;
+                    default: return p;
+                    }
+                }
+                return p;
+            }
+
+            //! Parse an unsigned number, clamping it to the given maximum.
+            //! Returns nullptr if there is no number.
+            inline const quint8 * parseNumber(
+                const quint8 * p,
+                const quint8 * end,
+                unsigned int   max,
+                unsigned int & out)
+            {
+                const quint8 * const start = p;
+                unsigned int value = 0;
+                for (; p < end && *p >= '0' && *p <= '9'; ++p)
+                {
+                    value = value * 10 + (*p - '0');
+                    if (value > max)
+                    {
+                        value = max + 1;
+                    }
+                }
+                if (p == start)
+                {
+                    return nullptr;
+                }
+                out = value > max ? max : value;
+                return p;
+            }
+
+            //! Format an unsigned number.
+            inline char * formatNumber(unsigned int value, char * out)
+            {
+                char tmp[10];
+                int size = 0;
+                do
+                {
+                    tmp[size++] = '0' + value % 10;
+                    value /= 10;
+                } while (value);
+                while (size)
+                {
+                    *out++ = tmp[--size];
+                }
+                return out;
+            }
+
+        } // namespace
+
         void PPM::asciiLoad(Core::FileIO & io, void * out, int size, int bitDepth)
         {
             //DJV_DEBUG("PPM::asciiLoad");
-            char tmp[Core::StringUtil::cStringLength] = "";
-            int i = 0;
+
+            // Parse the numbers directly from the memory-map.
+            const quint8 * p = io.mmapP();
+            const quint8 * const end = io.mmapEnd();
+            unsigned int value = 0;
             switch (bitDepth)
             {
             case 1:
             {
+                // Bitmap samples are single digits that may not be separated
+                // by white space.
                 quint8 * outP = reinterpret_cast<quint8 *>(out);
-                for (; i < size; ++i)
+                for (int i = 0; i < size; ++i)
                 {
-                    Core::FileIOUtil::word(io, tmp, Core::StringUtil::cStringLength);
-                    outP[i] = QString(tmp).toInt() ? 0 : 255;
+                    p = skipSpace(p, end);
+                    if (p >= end || (*p != '0' && *p != '1'))
+                    {
+                        throw Core::Error(
+                            PPM::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                    }
+                    outP[i] = '1' == *p++ ? 0 : 255;
                 }
             }
             break;
-#define _LOAD(TYPE) \
+#define _LOAD(TYPE, MAX) \
     TYPE * outP = reinterpret_cast<TYPE *>(out); \
-    for (; i < size; ++i) \
+    for (int i = 0; i < size; ++i) \
     { \
-        Core::FileIOUtil::word(io, tmp, Core::StringUtil::cStringLength); \
-        outP[i] = QString(tmp).toInt(); \
+        p = parseNumber(skipSpace(p, end), end, MAX, value); \
+        if (!p) \
+        { \
+            throw Core::Error( \
+                PPM::staticName, \
+                IOPlugin::errorLabels()[IOPlugin::ERROR_READ]); \
+        } \
+        outP[i] = static_cast<TYPE>(value); \
     }
             case 8:
             {
-                _LOAD(quint8)
+                _LOAD(quint8, 255)
             }
             break;
             case 16:
             {
-                _LOAD(quint16)
+                _LOAD(quint16, 65535)
             }
             break;
             default: break;
             }
+            io.seek(p - io.mmapP());
         }
 
         quint64 PPM::asciiSave(
@@ -171,10 +265,7 @@ namespace djv
     const TYPE * inP = reinterpret_cast<const TYPE *>(in); \
     for (int i = 0; i < size; ++i) \
     { \
-        QString s = QString::number(inP[i]); \
-        const char * c = s.toLatin1().data(); \
-        for (int j = 0; j < s.count(); ++j) \
-            *outP++ = c[j]; \
+        outP = formatNumber(inP[i], outP); \
         *outP++ = ' '; \
     }
             case 8:
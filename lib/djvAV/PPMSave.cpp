@@ -32,6 +32,8 @@
 #include <djvAV/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Math.h>
+#include <djvCore/Trace.h>
 
 #include <stdio.h>
 
@@ -101,6 +103,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("type = " << _type);
             //DJV_DEBUG_PRINT("data = " << _data);
+            DJV_TRACE_ZONE("djv::AV::PPMSave::write");
 
             // Open the file.
             Core::FileIO io;
@@ -130,7 +133,13 @@ namespace djv
                     channels,
                     _bitDepth,
                     _options.data);
-                std::vector<quint8> scanline(scanlineByteCount);
+                // ASCII scanlines are formatted into a large buffer that is
+                // written when full.
+                const quint64 bufferByteCount = PPM::DATA_ASCII == _options.data ?
+                    Core::Math::max(scanlineByteCount, quint64(1024 * 1024)) :
+                    scanlineByteCount;
+                std::vector<quint8> scanline(bufferByteCount);
+                quint64 bufferSize = 0;
                 //DJV_DEBUG_PRINT("scanline = " << static_cast<int>(scanlineByteCount));
                 for (int y = 0; y < h; ++y)
                 {
@@ -155,15 +164,24 @@ namespace djv
                     }
                     else
                     {
-                        const quint64 size = PPM::asciiSave(
+                        if (bufferSize + scanlineByteCount > bufferByteCount)
+                        {
+                            io.set(scanline.data(), bufferSize);
+                            bufferSize = 0;
+                        }
+                        bufferSize += PPM::asciiSave(
                             p->data(0, y),
-                            scanline.data(),
+                            scanline.data() + bufferSize,
                             w * channels,
                             _bitDepth);
-                        io.set(scanline.data(), size);
                     }
                 }
+                if (bufferSize)
+                {
+                    io.set(scanline.data(), bufferSize);
+                }
             }
+            io.close();
         }
 
         void PPMSave::_open(const QString & in, Core::FileIO & io)
@@ -106,6 +106,16 @@ namespace djv
             typedef U10_S_LSB U10_S;
 #endif
 
+            //! This enumeration provides the methods used to fill a 32-bit word
+            //! with 10-bit RGB data.
+            enum U10_FILL
+            {
+                U10_FILL_A, //!< Padding in the two least significant bits
+                U10_FILL_B, //!< Padding in the two most significant bits
+
+                U10_FILL_COUNT
+            };
+
             static const int channelsMax = 4;
             static const int bytesMax    = 4;
 
@@ -281,6 +291,31 @@ namespace djv
                 int          size = 1,
                 int          stride = 1,
                 bool         bgr = false);
+
+            //! Unpack 10-bit RGB words into RGB_U8, RGB_U16, RGB_F16, or RGB_F32
+            //! pixels. Unpacking into RGB_U10 converts the words to the memory
+            //! layout (filling method A and machine endian), and may be done in
+            //! place. The stride is given in words. Returns false if the output
+            //! pixel is not supported.
+            static bool unpackU10(
+                const void * in,
+                U10_FILL     fill,
+                bool         endian,
+                void *       out,
+                PIXEL        outPixel,
+                int          size,
+                int          stride = 1);
+
+            //! Pack RGB_U8, RGB_U16, RGB_F16, RGB_F32, or RGB_U10 pixels into
+            //! 10-bit RGB words. Returns false if the input pixel is not
+            //! supported.
+            static bool packU10(
+                const void * in,
+                PIXEL        inPixel,
+                void *       out,
+                U10_FILL     fill,
+                bool         endian,
+                int          size);
         };
 
     } // namespace AV
@@ -337,7 +337,23 @@ namespace djv
             }
             else
             {
-                fnc_tbl[inPixel][outPixel](in, out, size, stride, bgr);
+                // Use the dedicated kernels for packed 10-bit data.
+                bool u10 = false;
+                if (!bgr)
+                {
+                    if (RGB_U10 == inPixel)
+                    {
+                        u10 = unpackU10(in, U10_FILL_A, false, out, outPixel, size, stride);
+                    }
+                    else if (RGB_U10 == outPixel && 1 == stride)
+                    {
+                        u10 = packU10(in, inPixel, out, U10_FILL_A, false, size);
+                    }
+                }
+                if (!u10)
+                {
+                    fnc_tbl[inPixel][outPixel](in, out, size, stride, bgr);
+                }
             }
         }
 
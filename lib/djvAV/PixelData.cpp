@@ -117,6 +117,12 @@ namespace djv
             copy(in);
         }
 
+        PixelData::PixelData(PixelData && in)
+        {
+            //DJV_DEBUG("PixelData::PixelData");
+            *this = std::move(in);
+        }
+
         PixelData::PixelData(
             const PixelDataInfo & in,
             const quint8 *        p,
@@ -163,6 +169,31 @@ namespace djv
             return *this;
         }
 
+        PixelData & PixelData::operator = (PixelData && in)
+        {
+            if (&in != this)
+            {
+                delete _fileIo;
+                _info = in._info;
+                _channels = in._channels;
+                _data = std::move(in._data);
+                _p = in._p;
+                _pixelByteCount = in._pixelByteCount;
+                _scanlineByteCount = in._scanlineByteCount;
+                _dataByteCount = in._dataByteCount;
+                _fileIo = in._fileIo;
+                in._info = PixelDataInfo();
+                in._channels = 0;
+                in._data.clear();
+                in._p = nullptr;
+                in._pixelByteCount = 0;
+                in._scanlineByteCount = 0;
+                in._dataByteCount = 0;
+                in._fileIo = nullptr;
+            }
+            return *this;
+        }
+
         void PixelData::detach()
         {
             if (_fileIo)
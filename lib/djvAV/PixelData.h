@@ -129,6 +129,7 @@ namespace djv
         public:
             PixelData();
             PixelData(const PixelData &);
+            PixelData(PixelData &&);
             PixelData(const PixelDataInfo &, const quint8 * = 0, Core::FileIO * = 0);
             virtual ~PixelData();
 
@@ -188,6 +189,7 @@ namespace djv
             void close();
 
             PixelData & operator = (const PixelData &);
+            PixelData & operator = (PixelData &&);
 
             bool operator == (const PixelData &) const;
             bool operator != (const PixelData &) const;
@@ -30,6 +30,11 @@
 #include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
+#include <djvCore/Math.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
+
+#include <vector>
 
 namespace djv
 {
@@ -57,6 +62,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("out = " << out);
             //DJV_DEBUG_PRINT("proxy = " << proxy);
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::proxyScale");
 
             const int  w = out.w();
             const int  h = out.h();
@@ -111,12 +117,24 @@ namespace djv
                         }
                     }
                 }
+                else if (
+                    endian &&
+                    !bgr &&
+                    Pixel::RGB_U10 == in.pixel() &&
+                    Pixel::unpackU10(inP, Pixel::U10_FILL_A, true, outP, out.pixel(), w, proxyScale))
+                {
+                    // Packed 10-bit data is swapped and unpacked in one pass.
+                }
                 else
                 {
                     if (endian)
                     {
-                        const int size = w * proxyScale;
-                        const int wordSize = Pixel::byteCount(in.pixel());
+                        // Packed 10-bit data is swapped a pixel at a time, everything
+                        // else a channel at a time.
+                        const int wordSize = Pixel::RGB_U10 == in.pixel() ?
+                            Pixel::byteCount(in.pixel()) :
+                            Pixel::channelByteCount(in.pixel());
+                        const int size = w * proxyScale * Pixel::byteCount(in.pixel()) / wordSize;
                         //DJV_DEBUG_PRINT("endian size = " << size);
                         //DJV_DEBUG_PRINT("endian word size = " << wordSize);
                         Core::Memory::convertEndian(inP, tmp.data(), size, wordSize);
@@ -164,6 +182,7 @@ namespace djv
             PixelData &          out,
             PixelDataInfo::PROXY proxy)
         {
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::planarInterleave");
             DJV_ASSERT(in.pixel() == out.pixel());
             DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
 
@@ -204,6 +223,7 @@ namespace djv
 
         void PixelDataUtil::planarDeinterleave(const PixelData & in, PixelData & out)
         {
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::planarDeinterleave");
             DJV_ASSERT(in.pixel() == out.pixel());
             DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
 
@@ -239,9 +259,258 @@ namespace djv
             }
         }
 
+        bool PixelDataUtil::packU10(const PixelData & in, PixelData & out)
+        {
+            //DJV_DEBUG("PixelDataUtil::packU10");
+            //DJV_DEBUG_PRINT("in = " << in);
+            //DJV_DEBUG_PRINT("out = " << out);
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::packU10");
+            const PixelDataInfo & inInfo = in.info();
+            const PixelDataInfo & outInfo = out.info();
+            switch (inInfo.pixel)
+            {
+            case Pixel::RGB_U8:
+            case Pixel::RGB_U10:
+            case Pixel::RGB_U16:
+            case Pixel::RGB_F16:
+            case Pixel::RGB_F32: break;
+            default: return false;
+            }
+            if (outInfo.pixel != Pixel::RGB_U10 ||
+                inInfo.size != outInfo.size ||
+                inInfo.proxy != outInfo.proxy ||
+                inInfo.bgr != outInfo.bgr ||
+                inInfo.mirror.x != outInfo.mirror.x ||
+                (inInfo.endian != Core::Memory::endian() && Pixel::channelByteCount(inInfo.pixel) > 1))
+            {
+                return false;
+            }
+            const int  w = outInfo.size.x;
+            const int  h = outInfo.size.y;
+            const bool mirror = inInfo.mirror.y != outInfo.mirror.y;
+            const bool endian = outInfo.endian != Core::Memory::endian();
+            //DJV_DEBUG_PRINT("mirror = " << mirror);
+            //DJV_DEBUG_PRINT("endian = " << endian);
+            const Pixel::PIXEL pixel = inInfo.pixel;
+            const quint64 inScanline = w * in.pixelByteCount();
+            const quint64 outScanline = w * out.pixelByteCount();
+            const quint8 * inP = in.data();
+            quint8 * outP = out.data();
+            Core::ParallelUtil::forBands(
+                h,
+                64,
+                [inP, outP, pixel, inScanline, outScanline, w, h, mirror, endian](int start, int end)
+            {
+                for (int y = start; y < end; ++y)
+                {
+                    Pixel::packU10(
+                        inP + (mirror ? (h - 1 - y) : y) * inScanline,
+                        pixel,
+                        outP + y * outScanline,
+                        Pixel::U10_FILL_A,
+                        endian,
+                        w);
+                }
+            });
+            return true;
+        }
+
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return Core::Math::log(x * f + 1.f) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.f, f1 = 1.f;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.f;
+                }
+                for (int i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.f;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.f;
+            }
+
+            // The color profile is applied the same way as the OpenGLImage
+            // shaders, so that images look the same whichever path converted
+            // them.
+            struct ColorProfileKernel
+            {
+                ColorProfileKernel(const ColorProfile & colorProfile) :
+                    type(colorProfile.type)
+                {
+                    switch (type)
+                    {
+                    case ColorProfile::LUT:
+                    {
+                        lutSize = colorProfile.lut.w();
+                        lutChannels = colorProfile.lut.channels();
+                        lut.resize(lutSize * lutChannels);
+                        Pixel::convert(
+                            colorProfile.lut.data(),
+                            colorProfile.lut.pixel(),
+                            lut.data(),
+                            Pixel::pixel(Pixel::format(colorProfile.lut.pixel()), Pixel::F32),
+                            lutSize);
+                        break;
+                    }
+                    case ColorProfile::GAMMA:
+                        gamma = 1.f / colorProfile.gamma;
+                        break;
+                    case ColorProfile::EXPOSURE:
+                        exposureV = Core::Math::pow(2.f, colorProfile.exposure.value + 2.47393f);
+                        exposureD = colorProfile.exposure.defog;
+                        exposureK = Core::Math::pow(2.f, colorProfile.exposure.kneeLow);
+                        exposureF = knee2(
+                            Core::Math::pow(2.f, colorProfile.exposure.kneeHigh) - exposureK,
+                            Core::Math::pow(2.f, 3.5f) - exposureK);
+                        break;
+                    default: break;
+                    }
+                }
+
+                float lutValue(float value, int channel) const
+                {
+                    const int i = Core::Math::clamp(static_cast<int>(value * lutSize), 0, lutSize - 1);
+                    return lut[i * lutChannels + channel];
+                }
+
+                // Apply the color profile to the color channels of a row of
+                // pixels. The alpha channel is only changed by a LUT.
+                void operator () (Pixel::F32_T * p, int size, int channels) const
+                {
+                    const int  colorChannels = channels < 3 ? 1 : 3;
+                    const bool alpha = 2 == channels || 4 == channels;
+                    switch (type)
+                    {
+                    case ColorProfile::LUT:
+                        for (int x = 0; x < size; ++x, p += channels)
+                        {
+                            for (int c = 0; c < colorChannels; ++c)
+                            {
+                                p[c] = lutValue(p[c], lutChannels < 3 ? 0 : c);
+                            }
+                            if (alpha && (2 == lutChannels || 4 == lutChannels))
+                            {
+                                p[channels - 1] = lutValue(p[channels - 1], lutChannels - 1);
+                            }
+                        }
+                        break;
+                    case ColorProfile::GAMMA:
+                        for (int x = 0; x < size; ++x, p += channels)
+                        {
+                            for (int c = 0; c < colorChannels; ++c)
+                            {
+                                if (p[c] >= 0.f)
+                                {
+                                    p[c] = Core::Math::pow(p[c], gamma);
+                                }
+                            }
+                        }
+                        break;
+                    case ColorProfile::EXPOSURE:
+                        for (int x = 0; x < size; ++x, p += channels)
+                        {
+                            for (int c = 0; c < colorChannels; ++c)
+                            {
+                                float v = Core::Math::max(0.f, p[c] - exposureD) * exposureV;
+                                if (v > exposureK)
+                                {
+                                    v = exposureK + knee(v - exposureK, exposureF);
+                                }
+                                p[c] = v * .332f;
+                            }
+                        }
+                        break;
+                    default: break;
+                    }
+                }
+
+                ColorProfile::PROFILE type;
+                std::vector<float>    lut;
+                int                   lutSize     = 0;
+                int                   lutChannels = 0;
+                float                 gamma       = 1.f;
+                float                 exposureV   = 1.f;
+                float                 exposureD   = 0.f;
+                float                 exposureK   = 1.f;
+                float                 exposureF   = 1.f;
+            };
+
+        } // namespace
+
+        bool PixelDataUtil::convertU8(const PixelData & in, PixelData & out, const ColorProfile & colorProfile)
+        {
+            //DJV_DEBUG("PixelDataUtil::convertU8");
+            //DJV_DEBUG_PRINT("in = " << in);
+            //DJV_DEBUG_PRINT("out = " << out);
+            //DJV_DEBUG_PRINT("color profile = " << colorProfile.type);
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::convertU8");
+            const PixelDataInfo & inInfo = in.info();
+            const PixelDataInfo & outInfo = out.info();
+            const Pixel::FORMAT format = Pixel::format(inInfo.pixel);
+            if (outInfo.pixel != Pixel::pixel(format, Pixel::U8) ||
+                inInfo.size != outInfo.size ||
+                inInfo.proxy != outInfo.proxy ||
+                inInfo.bgr != outInfo.bgr ||
+                inInfo.mirror != outInfo.mirror ||
+                (inInfo.endian != Core::Memory::endian() && Pixel::channelByteCount(inInfo.pixel) > 1) ||
+                (ColorProfile::LUT == colorProfile.type && (inInfo.bgr || !colorProfile.lut.isValid())))
+            {
+                return false;
+            }
+            const int          w = outInfo.size.x;
+            const int          h = outInfo.size.y;
+            const int          channels = Pixel::channels(format);
+            const Pixel::PIXEL inPixel = inInfo.pixel;
+            const Pixel::PIXEL f32Pixel = Pixel::pixel(format, Pixel::F32);
+            const Pixel::PIXEL outPixel = outInfo.pixel;
+            const quint64      inScanline = w * in.pixelByteCount();
+            const quint64      outScanline = w * out.pixelByteCount();
+            const ColorProfileKernel kernel(colorProfile);
+            const quint8 * inP = in.data();
+            quint8 * outP = out.data();
+            Core::ParallelUtil::forBands(
+                h,
+                16,
+                [inP, outP, w, channels, inPixel, f32Pixel, outPixel, inScanline, outScanline, &kernel](int start, int end)
+            {
+                std::vector<Pixel::F32_T> tmp(w * channels);
+                for (int y = start; y < end; ++y)
+                {
+                    if (ColorProfile::RAW == kernel.type)
+                    {
+                        Pixel::convert(inP + y * inScanline, inPixel, outP + y * outScanline, outPixel, w);
+                    }
+                    else
+                    {
+                        Pixel::convert(inP + y * inScanline, inPixel, tmp.data(), f32Pixel, w);
+                        kernel(tmp.data(), w, channels);
+                        Pixel::convert(tmp.data(), f32Pixel, outP + y * outScanline, outPixel, w);
+                    }
+                }
+            });
+            return true;
+        }
+
         void PixelDataUtil::gradient(PixelData & out)
         {
             //DJV_DEBUG("gradient");
+            DJV_TRACE_ZONE("djv::AV::PixelDataUtil::gradient");
             const PixelDataInfo info(out.size(), Pixel::L_F32);
             out.set(info);
             //DJV_DEBUG_PRINT("out = " << out);
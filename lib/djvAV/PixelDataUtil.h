@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <djvAV/ColorProfile.h>
 #include <djvAV/OpenGLImage.h>
 #include <djvAV/PixelData.h>
 
@@ -72,6 +73,20 @@ namespace djv
             //! De-interleave pixel data channels.
             static void planarDeinterleave(const PixelData &, PixelData &);
 
+            //! Pack pixel data into RGB_U10 pixel data on the CPU, converting to
+            //! the endian of the output. Returns false if the conversion is not
+            //! supported and needs to be done with OpenGLImage instead.
+            static bool packU10(const PixelData &, PixelData &);
+
+            //! Convert pixel data to 8-bits on the CPU, applying the color
+            //! profile. The output must have the same size and layout as the
+            //! input. Returns false if the conversion is not supported and needs
+            //! to be done with OpenGLImage instead.
+            static bool convertU8(
+                const PixelData &,
+                PixelData &,
+                const ColorProfile & = ColorProfile());
+
             //! Create a linear gradient.
             static void gradient(PixelData &);
         };
@@ -0,0 +1,370 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/Pixel.h>
+
+#include <djvCore/Debug.h>
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_PIXEL_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! The shifts of the red, green, and blue components for each of the
+            //! filling methods.
+            const int shifts[Pixel::U10_FILL_COUNT][3] =
+            {
+                { 22, 12, 2 },
+                { 20, 10, 0 }
+            };
+
+            inline quint32 swap(quint32 in)
+            {
+                return
+                    (in >> 24) |
+                    ((in >> 8) & 0xff00) |
+                    ((in << 8) & 0xff0000) |
+                    (in << 24);
+            }
+
+            inline quint32 getWord(const quint8 * in, bool endian)
+            {
+                quint32 out;
+                memcpy(&out, in, 4);
+                return endian ? swap(out) : out;
+            }
+
+            inline void setWord(quint32 in, quint8 * out, bool endian)
+            {
+                if (endian)
+                {
+                    in = swap(in);
+                }
+                memcpy(out, &in, 4);
+            }
+
+            template<typename T, T(*F)(Pixel::U10_T)>
+            void unpack(const quint8 * in, const int * shift, bool endian, T * out, int size, int stride)
+            {
+                const int inStride = stride * 4;
+                for (int i = 0; i < size; ++i, in += inStride, out += 3)
+                {
+                    const quint32 word = getWord(in, endian);
+                    out[0] = F((word >> shift[0]) & 0x3ff);
+                    out[1] = F((word >> shift[1]) & 0x3ff);
+                    out[2] = F((word >> shift[2]) & 0x3ff);
+                }
+            }
+
+            template<typename T, Pixel::U10_T(*F)(T)>
+            void pack(const T * in, quint8 * out, const int * shift, bool endian, int size)
+            {
+                for (int i = 0; i < size; ++i, in += 3, out += 4)
+                {
+                    setWord(
+                        static_cast<quint32>(F(in[0])) << shift[0] |
+                        static_cast<quint32>(F(in[1])) << shift[1] |
+                        static_cast<quint32>(F(in[2])) << shift[2],
+                        out,
+                        endian);
+                }
+            }
+
+            //! Convert words between filling methods and endians. The input and
+            //! output may be the same.
+            void repack(
+                const quint8 * in,
+                const int *    inShift,
+                bool           inEndian,
+                quint8 *       out,
+                const int *    outShift,
+                bool           outEndian,
+                int            size,
+                int            stride)
+            {
+                const int inStride = stride * 4;
+                for (int i = 0; i < size; ++i, in += inStride, out += 4)
+                {
+                    const quint32 word = getWord(in, inEndian);
+                    setWord(
+                        ((word >> inShift[0]) & 0x3ff) << outShift[0] |
+                        ((word >> inShift[1]) & 0x3ff) << outShift[1] |
+                        ((word >> inShift[2]) & 0x3ff) << outShift[2],
+                        out,
+                        outEndian);
+                }
+            }
+
+#if defined(DJV_PIXEL_SSE2)
+            inline __m128i swap(__m128i in)
+            {
+                in = _mm_or_si128(_mm_slli_epi16(in, 8), _mm_srli_epi16(in, 8));
+                in = _mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+                return _mm_shufflehi_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+
+            //! Load four words and convert the components to floating point.
+            inline void load(
+                const quint8 * in,
+                const __m128i  shift[3],
+                bool           endian,
+                __m128 &       r,
+                __m128 &       g,
+                __m128 &       b)
+            {
+                const __m128i mask = _mm_set1_epi32(0x3ff);
+                __m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                if (endian)
+                {
+                    word = swap(word);
+                }
+                r = _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(word, shift[0]), mask));
+                g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(word, shift[1]), mask));
+                b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(word, shift[2]), mask));
+            }
+
+            // The kernels use the same floating point operations as the lookup
+            // tables in PixelInline.h so the results are identical. The stores
+            // overlap into the next pixel, so the last pixel is always left for
+            // the scalar code. Returns the number of pixels converted.
+
+            int unpackU16(const quint8 * in, const int * shift, bool endian, Pixel::U16_T * out, int size)
+            {
+                const __m128i _shift[] =
+                {
+                    _mm_cvtsi32_si128(shift[0]),
+                    _mm_cvtsi32_si128(shift[1]),
+                    _mm_cvtsi32_si128(shift[2])
+                };
+                const __m128 u10Max = _mm_set1_ps(static_cast<float>(Pixel::u10Max));
+                const __m128 u16Max = _mm_set1_ps(static_cast<float>(Pixel::u16Max));
+                int i = 0;
+                for (; i + 4 < size; i += 4, in += 16, out += 12)
+                {
+                    __m128 r, g, b;
+                    load(in, _shift, endian, r, g, b);
+                    const __m128i _r = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(r, u10Max), u16Max));
+                    const __m128i _g = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(g, u10Max), u16Max));
+                    const __m128i _b = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(b, u10Max), u16Max));
+                    const __m128i rg = _mm_or_si128(_r, _mm_slli_epi32(_g, 16));
+                    const __m128i lo = _mm_unpacklo_epi32(rg, _b);
+                    const __m128i hi = _mm_unpackhi_epi32(rg, _b);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), lo);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 3), _mm_srli_si128(lo, 8));
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 6), hi);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 9), _mm_srli_si128(hi, 8));
+                }
+                return i;
+            }
+
+            int unpackF32(const quint8 * in, const int * shift, bool endian, Pixel::F32_T * out, int size)
+            {
+                const __m128i _shift[] =
+                {
+                    _mm_cvtsi32_si128(shift[0]),
+                    _mm_cvtsi32_si128(shift[1]),
+                    _mm_cvtsi32_si128(shift[2])
+                };
+                const __m128 u10Max = _mm_set1_ps(static_cast<float>(Pixel::u10Max));
+                int i = 0;
+                for (; i + 4 < size; i += 4, in += 16, out += 12)
+                {
+                    __m128 r, g, b;
+                    load(in, _shift, endian, r, g, b);
+                    r = _mm_div_ps(r, u10Max);
+                    g = _mm_div_ps(g, u10Max);
+                    b = _mm_div_ps(b, u10Max);
+                    const __m128 rgLo = _mm_unpacklo_ps(r, g);
+                    const __m128 rgHi = _mm_unpackhi_ps(r, g);
+                    _mm_storeu_ps(out, _mm_movelh_ps(rgLo, b));
+                    _mm_storeu_ps(out + 3, _mm_shuffle_ps(rgLo, b, _MM_SHUFFLE(1, 1, 3, 2)));
+                    _mm_storeu_ps(out + 6, _mm_shuffle_ps(rgHi, b, _MM_SHUFFLE(2, 2, 1, 0)));
+                    _mm_storeu_ps(out + 9, _mm_shuffle_ps(rgHi, b, _MM_SHUFFLE(3, 3, 3, 2)));
+                }
+                return i;
+            }
+
+            //! Convert floating point components to 10-bit the same way as
+            //! Pixel::f32ToU10().
+            inline __m128i f32ToU10(__m128 in)
+            {
+                const __m128 u10Max = _mm_set1_ps(static_cast<float>(Pixel::u10Max));
+                const __m128d half = _mm_set1_pd(.5);
+                const __m128d zero = _mm_setzero_pd();
+                const __m128d max = _mm_set1_pd(Pixel::u10Max);
+                in = _mm_mul_ps(in, u10Max);
+                __m128d lo = _mm_add_pd(_mm_cvtps_pd(in), half);
+                __m128d hi = _mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(in, in)), half);
+                lo = _mm_min_pd(_mm_max_pd(lo, zero), max);
+                hi = _mm_min_pd(_mm_max_pd(hi, zero), max);
+                return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+            }
+
+            int packF32(const Pixel::F32_T * in, quint8 * out, const int * shift, bool endian, int size)
+            {
+                const __m128i _shift[] =
+                {
+                    _mm_cvtsi32_si128(shift[0]),
+                    _mm_cvtsi32_si128(shift[1]),
+                    _mm_cvtsi32_si128(shift[2])
+                };
+                int i = 0;
+                for (; i + 4 <= size; i += 4, in += 12, out += 16)
+                {
+                    const __m128i r = f32ToU10(_mm_setr_ps(in[0], in[3], in[6], in[9]));
+                    const __m128i g = f32ToU10(_mm_setr_ps(in[1], in[4], in[7], in[10]));
+                    const __m128i b = f32ToU10(_mm_setr_ps(in[2], in[5], in[8], in[11]));
+                    __m128i word = _mm_or_si128(
+                        _mm_or_si128(_mm_sll_epi32(r, _shift[0]), _mm_sll_epi32(g, _shift[1])),
+                        _mm_sll_epi32(b, _shift[2]));
+                    if (endian)
+                    {
+                        word = swap(word);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), word);
+                }
+                return i;
+            }
+#endif // DJV_PIXEL_SSE2
+
+        } // namespace
+
+        bool Pixel::unpackU10(
+            const void * in,
+            U10_FILL     fill,
+            bool         endian,
+            void *       out,
+            PIXEL        outPixel,
+            int          size,
+            int          stride)
+        {
+            //DJV_DEBUG("Pixel::unpackU10");
+            //DJV_DEBUG_PRINT("fill = " << fill);
+            //DJV_DEBUG_PRINT("endian = " << endian);
+            //DJV_DEBUG_PRINT("out = " << outPixel);
+            //DJV_DEBUG_PRINT("size = " << size);
+            //DJV_DEBUG_PRINT("stride = " << stride);
+            const quint8 * inP = reinterpret_cast<const quint8 *>(in);
+            const int * shift = shifts[fill];
+            switch (outPixel)
+            {
+            case RGB_U8:
+                unpack<U8_T, u10ToU8>(inP, shift, endian, reinterpret_cast<U8_T *>(out), size, stride);
+                break;
+            case RGB_U10:
+                repack(inP, shift, endian, reinterpret_cast<quint8 *>(out), shifts[U10_FILL_A], false, size, stride);
+                break;
+            case RGB_U16:
+            {
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                int i = 0;
+#if defined(DJV_PIXEL_SSE2)
+                if (1 == stride)
+                {
+                    i = unpackU16(inP, shift, endian, outP, size);
+                }
+#endif // DJV_PIXEL_SSE2
+                unpack<U16_T, u10ToU16>(inP + i * stride * 4, shift, endian, outP + i * 3, size - i, stride);
+                break;
+            }
+            case RGB_F16:
+                unpack<F16_T, u10ToF16>(inP, shift, endian, reinterpret_cast<F16_T *>(out), size, stride);
+                break;
+            case RGB_F32:
+            {
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                int i = 0;
+#if defined(DJV_PIXEL_SSE2)
+                if (1 == stride)
+                {
+                    i = unpackF32(inP, shift, endian, outP, size);
+                }
+#endif // DJV_PIXEL_SSE2
+                unpack<F32_T, u10ToF32>(inP + i * stride * 4, shift, endian, outP + i * 3, size - i, stride);
+                break;
+            }
+            default: return false;
+            }
+            return true;
+        }
+
+        bool Pixel::packU10(
+            const void * in,
+            PIXEL        inPixel,
+            void *       out,
+            U10_FILL     fill,
+            bool         endian,
+            int          size)
+        {
+            //DJV_DEBUG("Pixel::packU10");
+            //DJV_DEBUG_PRINT("in = " << inPixel);
+            //DJV_DEBUG_PRINT("fill = " << fill);
+            //DJV_DEBUG_PRINT("endian = " << endian);
+            //DJV_DEBUG_PRINT("size = " << size);
+            quint8 * outP = reinterpret_cast<quint8 *>(out);
+            const int * shift = shifts[fill];
+            switch (inPixel)
+            {
+            case RGB_U8:
+                pack<U8_T, u8ToU10>(reinterpret_cast<const U8_T *>(in), outP, shift, endian, size);
+                break;
+            case RGB_U10:
+                repack(reinterpret_cast<const quint8 *>(in), shifts[U10_FILL_A], false, outP, shift, endian, size, 1);
+                break;
+            case RGB_U16:
+                pack<U16_T, u16ToU10>(reinterpret_cast<const U16_T *>(in), outP, shift, endian, size);
+                break;
+            case RGB_F16:
+                pack<F16_T, f16ToU10>(reinterpret_cast<const F16_T *>(in), outP, shift, endian, size);
+                break;
+            case RGB_F32:
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                int i = 0;
+#if defined(DJV_PIXEL_SSE2)
+                i = packF32(inP, outP, shift, endian, size);
+#endif // DJV_PIXEL_SSE2
+                pack<F32_T, f32ToU10>(inP + i * 3, outP + i * 4, shift, endian, size - i);
+                break;
+            }
+            default: return false;
+            }
+            return true;
+        }
+
+    } // namespace AV
+} // namespace djv
@@ -29,6 +29,8 @@
 
 #include <djvAV/RLA.h>
 
+#include <djvAV/RLEUtil.h>
+
 #include <djvCore/Debug.h>
 #include <djvCore/Memory.h>
 
@@ -38,8 +40,73 @@ namespace djv
     {
         const QString RLA::staticName = "RLA";
 
-        void RLA::readRle(
-            Core::FileIO & io,
+        namespace
+        {
+            //! Decode packets that start with a signed byte, where a positive
+            //! value is a run of the value plus one and a negative value is
+            //! a literal of the negated value.
+            const quint8 * readPackets(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            stride)
+            {
+                while (size > 0)
+                {
+                    if (in >= end)
+                    {
+                        return nullptr;
+                    }
+                    int count = *reinterpret_cast<const qint8 *>(in);
+                    ++in;
+                    //DJV_DEBUG_PRINT("count = " << count);
+                    const bool run = count >= 0;
+                    count = run ? (count + 1) : -count;
+                    const int length = run ? 1 : count;
+                    if (count > size || length > end - in)
+                    {
+                        return nullptr;
+                    }
+                    if (run)
+                    {
+                        RLEUtil::fill(in, 1, out, count, stride);
+                    }
+                    else
+                    {
+                        RLEUtil::copy(in, 1, out, count, stride);
+                    }
+                    in += length;
+                    out += count * stride;
+                    size -= count;
+                }
+                return in;
+            }
+
+            //! Get the data for a channel, checking the big endian size stored
+            //! in front of it.
+            const quint8 * getData(const quint8 * in, const quint8 * end, int minSize, const quint8 *& dataEnd)
+            {
+                if (end - in < 2)
+                {
+                    return nullptr;
+                }
+                const int size = static_cast<qint16>((in[0] << 8) | in[1]);
+                //DJV_DEBUG_PRINT("io size = " << size);
+                in += 2;
+                if (size < minSize || size > end - in)
+                {
+                    return nullptr;
+                }
+                dataEnd = in + size;
+                return in;
+            }
+
+        } // namespace
+
+        const quint8 * RLA::readRle(
+            const quint8 * in,
+            const quint8 * end,
             quint8 *       out,
             int            size,
             int            channels,
@@ -49,46 +116,23 @@ namespace djv
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("bytes = " << bytes);
-            qint16 _size = 0;
-            io.get16(&_size);
-            //DJV_DEBUG_PRINT("io size = " << _size);
-            const quint8 * start = io.mmapP();
-            const quint8 * p = start;
-            io.seek(_size);
-            for (int b = 0; b < bytes; ++b)
+            const quint8 * dataEnd = nullptr;
+            const quint8 * p = getData(in, end, 0, dataEnd);
+
+            // The bytes of each channel are stored as separate planes, most
+            // significant first.
+            const int stride = channels * bytes;
+            for (int b = 0; b < bytes && p; ++b)
             {
                 quint8 * outP = out + (Core::Memory::LSB == Core::Memory::endian() ? (bytes - 1 - b) : b);
-                const int outInc = channels * bytes;
-                for (int i = 0; i < size;)
-                {
-                    int count = *((qint8 *)p);
-                    ++p;
-                    //DJV_DEBUG_PRINT("count = " << count);
-                    if (count >= 0)
-                    {
-                        ++count;
-                        for (int j = 0; j < count; ++j, outP += outInc)
-                        {
-                            *outP = *p;
-                        }
-                        ++p;
-                    }
-                    else
-                    {
-                        count = -count;
-                        for (int j = 0; j < count; ++j, ++p, outP += outInc)
-                        {
-                            *outP = *p;
-                        }
-                    }
-                    i += count;
-                }
+                p = readPackets(p, dataEnd, outP, size, stride);
             }
-            //DJV_DEBUG_PRINT("out = " << p - start);
+            return p ? dataEnd : nullptr;
         }
 
-        void RLA::floatLoad(
-            Core::FileIO & io,
+        const quint8 * RLA::floatLoad(
+            const quint8 * in,
+            const quint8 * end,
             quint8 *       out,
             int            size,
             int            channels)
@@ -96,12 +140,12 @@ namespace djv
             //DJV_DEBUG("RLA::floatLoad");
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("channels = " << channels);
-            qint16 _size = 0;
-            io.get16(&_size);
-            //DJV_DEBUG_PRINT("io size = " << _size);
-            const quint8 * start = io.mmapP();
-            const quint8 * p = start;
-            io.seek(_size);
+            const quint8 * dataEnd = nullptr;
+            const quint8 * p = getData(in, end, size * 4, dataEnd);
+            if (!p)
+            {
+                return nullptr;
+            }
             const int outInc = channels * 4;
             if (Core::Memory::LSB == Core::Memory::endian())
             {
@@ -115,22 +159,15 @@ namespace djv
             }
             else
             {
-                for (int i = 0; i < size; ++i, p += 4, out += outInc)
-                {
-                    out[0] = p[0];
-                    out[1] = p[1];
-                    out[2] = p[2];
-                    out[3] = p[3];
-                }
+                RLEUtil::copy(p, 4, out, size, outInc);
             }
-            //DJV_DEBUG_PRINT("out = " << p - start);
+            return dataEnd;
         }
 
-        void RLA::skip(Core::FileIO & io)
+        const quint8 * RLA::skip(const quint8 * in, const quint8 * end)
         {
-            qint16 size = 0;
-            io.get16(&size);
-            io.seek(size);
+            const quint8 * dataEnd = nullptr;
+            return getData(in, end, 0, dataEnd) ? dataEnd : nullptr;
         }
 
     } // namespace AV
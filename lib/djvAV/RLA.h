@@ -29,7 +29,7 @@
 
 #pragma once
 
-#include <djvCore/FileIO.h>
+#include <QString>
 
 namespace djv
 {
@@ -41,23 +41,31 @@ namespace djv
             //! Plugin name.
             static const QString staticName;
 
-            //! Load RLE data.
-            //!
-            //! Throws:
-            //! - Core::Error
-            static void readRle(Core::FileIO & io, quint8 * out, int size, int channels, int bytes);
+            //! Load the RLE data for a channel of a scanline, writing each
+            //! element to the output with the given number of channels between
+            //! them. Returns a pointer to the end of the channel data, or
+            //! nullptr if the data is corrupt.
+            static const quint8 * readRle(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            channels,
+                int            bytes);
 
-            //! Load floating point data.
-            //!
-            //! Throws:
-            //! - Core::Error
-            static void floatLoad(Core::FileIO & io, quint8 * out, int size, int channels);
+            //! Load the floating point data for a channel of a scanline.
+            //! Returns a pointer to the end of the channel data, or nullptr if
+            //! the data is corrupt.
+            static const quint8 * floatLoad(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            channels);
 
-            //! Skip file data.
-            //!
-            //! Throws:
-            //! - Core::Error
-            static void skip(Core::FileIO &);
+            //! Skip the data for a channel of a scanline. Returns a pointer to
+            //! the end of the channel data, or nullptr if the data is corrupt.
+            static const quint8 * skip(const quint8 * in, const quint8 * end);
         };
 
     } // namespace AV
@@ -33,6 +33,8 @@
 #include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -42,7 +44,8 @@ namespace djv
             Load(fileInfo, context)
         {
             Core::FileIO io;
-            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io);
+            std::vector<qint32> rleOffset;
+            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io, rleOffset);
             if (Core::FileInfo::SEQUENCE == _fileInfo.type())
             {
                 _ioInfo.sequence.frames = _fileInfo.sequence().frames;
@@ -56,6 +59,7 @@ namespace djv
         {
             //DJV_DEBUG("RLALoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::RLALoad::read");
             image.colorProfile = ColorProfile();
             image.tags = Tags();
 
@@ -64,7 +68,8 @@ namespace djv
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
             Core::FileIO io;
-            _open(fileName, info, io);
+            std::vector<qint32> rleOffset;
+            _open(fileName, info, io, rleOffset);
             if (frame.layer >= info.layers.size())
             {
                 throw Core::Error(
@@ -73,32 +78,46 @@ namespace djv
             }
             PixelDataInfo _info = info.layers[frame.layer];
 
-            // Read the file.
+            // Read the file. Each scanline has its own offset so they are
+            // decoded in parallel bands.
             io.readAhead();
-            PixelData * p = frame.proxy ? &_tmp : &image;
+            const quint8 * const start = io.mmapP() - io.pos();
+            const quint8 * const end = io.mmapEnd();
+            PixelData tmp;
+            PixelData * p = frame.proxy ? &tmp : &image;
             p->set(_info);
-            const int w = _info.size.x;
-            const int h = _info.size.y;
-            const int channels = Pixel::channels(_info.pixel);
-            const int bytes = Pixel::channelByteCount(_info.pixel);
+            const int  w = _info.size.x;
+            const int  h = _info.size.y;
+            const int  channels = Pixel::channels(_info.pixel);
+            const int  bytes = Pixel::channelByteCount(_info.pixel);
+            const bool floatData = Pixel::F32 == Pixel::type(_info.pixel);
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("bytes = " << bytes);
-            quint8 * data_p = p->data();
-            for (int y = 0; y < h; ++y, data_p += w * channels * bytes)
+            quint8 * const data = p->data();
+            Core::ParallelUtil::forBands(
+                h,
+                16,
+                [start, end, data, &rleOffset, w, channels, bytes, floatData](int y0, int y1)
             {
-                io.setPos(_rleOffset[y]);
-                for (int c = 0; c < channels; ++c)
+                for (int y = y0; y < y1; ++y)
                 {
-                    if (Pixel::F32 == Pixel::type(_info.pixel))
+                    const qint32 offset = rleOffset[y];
+                    const quint8 * in = offset >= 0 && offset < end - start ? start + offset : nullptr;
+                    quint8 * out = data + static_cast<quint64>(y) * w * channels * bytes;
+                    for (int c = 0; c < channels && in; ++c)
                     {
-                        RLA::floatLoad(io, data_p + c * bytes, w, channels);
+                        in = floatData ?
+                            RLA::floatLoad(in, end, out + c * bytes, w, channels) :
+                            RLA::readRle(in, end, out + c * bytes, w, channels, bytes);
                     }
-                    else
+                    if (!in)
                     {
-                        RLA::readRle(io, data_p + c * bytes, w, channels, bytes);
+                        throw Core::Error(
+                            RLA::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
                     }
                 }
-            }
+            });
 
             // Proxy scale the image.
             if (frame.proxy)
@@ -106,7 +125,7 @@ namespace djv
                 _info.size = PixelDataUtil::proxyScale(_info.size, frame.proxy);
                 _info.proxy = frame.proxy;
                 image.set(_info);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                PixelDataUtil::proxyScale(tmp, image, frame.proxy);
             }
 
             //DJV_DEBUG_PRINT("image = " << image);
@@ -212,7 +231,11 @@ namespace djv
 
         } // namespace
 
-        void RLALoad::_open(const QString & in, IOInfo & info, Core::FileIO & io)
+        void RLALoad::_open(
+            const QString &       in,
+            IOInfo &              info,
+            Core::FileIO &        io,
+            std::vector<qint32> & rleOffset) const
         {
             //DJV_DEBUG("djvRLALoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
@@ -234,8 +257,8 @@ namespace djv
             const int h = header.active[3] - header.active[2] + 1;
 
             // Read the scanline table.
-            _rleOffset.resize(h);
-            io.get32(_rleOffset.data(), h);
+            rleOffset.resize(h);
+            io.get32(rleOffset.data(), h);
 
             // Get file information.
             const glm::ivec2 size(w, h);
@@ -33,6 +33,7 @@
 #include <djvAV/RLA.h>
 
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
 
 namespace djv
 {
@@ -47,10 +48,7 @@ namespace djv
             void read(Image &, const ImageIOInfo &) override;
 
         private:
-            void _open(const QString &, IOInfo &, Core::FileIO &);
-
-            std::vector<qint32> _rleOffset;
-            PixelData           _tmp;
+            void _open(const QString &, IOInfo &, Core::FileIO &, std::vector<qint32> & rleOffset) const;
         };
 
     } // namespace AV
@@ -0,0 +1,351 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/RLEUtil.h>
+
+#include <djvCore/Debug.h>
+
+#include <algorithm>
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_RLE_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+#endif // __SSE2__
+
+namespace djv
+{
+    namespace AV
+    {
+        RLEUtil::~RLEUtil()
+        {}
+
+        namespace
+        {
+#if defined(DJV_RLE_SSE2)
+            //! Get a mask of the bytes that differ between two 16 byte blocks.
+            inline int differMask(const quint8 * a, const quint8 * b)
+            {
+                const __m128i _a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+                const __m128i _b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(_a, _b)) ^ 0xffff;
+            }
+
+            //! Get the index of the lowest bit set in a non-zero mask.
+            inline int lowestBit(int mask)
+            {
+#if defined(_MSC_VER)
+                unsigned long out = 0;
+                _BitScanForward(&out, static_cast<unsigned long>(mask));
+                return static_cast<int>(out);
+#else // _MSC_VER
+                return __builtin_ctz(static_cast<unsigned int>(mask));
+#endif // _MSC_VER
+            }
+#endif // DJV_RLE_SSE2
+
+            inline bool isEqual(const quint8 * a, const quint8 * b, int elementSize)
+            {
+                return 1 == elementSize ? *a == *b : 0 == memcmp(a, b, elementSize);
+            }
+
+            template<int N>
+            inline void fillStride(const quint8 * in, quint8 * out, int count, int stride)
+            {
+                for (int i = 0; i < count; ++i, out += stride)
+                {
+                    memcpy(out, in, N);
+                }
+            }
+
+            template<int N>
+            inline void copyStride(const quint8 * in, quint8 * out, int count, int stride)
+            {
+                for (int i = 0; i < count; ++i, in += N, out += stride)
+                {
+                    memcpy(out, in, N);
+                }
+            }
+
+        } // namespace
+
+        int RLEUtil::runLength(const quint8 * in, int elementSize, int max)
+        {
+            if (max < 2)
+            {
+                return max;
+            }
+
+            // Compare the data against itself offset by one element; the run
+            // ends at the first byte that differs.
+            const size_t size = static_cast<size_t>(max - 1) * elementSize;
+            size_t i = 0;
+#if defined(DJV_RLE_SSE2)
+            for (; i + 16 <= size; i += 16)
+            {
+                const int mask = differMask(in + i, in + i + elementSize);
+                if (mask)
+                {
+                    return static_cast<int>((i + lowestBit(mask)) / elementSize) + 1;
+                }
+            }
+#endif // DJV_RLE_SSE2
+            for (; i < size; ++i)
+            {
+                if (in[i] != in[i + elementSize])
+                {
+                    return static_cast<int>(i / elementSize) + 1;
+                }
+            }
+            return max;
+        }
+
+        int RLEUtil::literalLength(const quint8 * in, int elementSize, int max, int minRun)
+        {
+            int match = 1;
+            int i = 1;
+            while (i < max)
+            {
+#if defined(DJV_RLE_SSE2)
+                // Skip over the elements that differ from the next element,
+                // sixteen bytes at a time.
+                if (1 == match && elementSize <= 16)
+                {
+                    const int step = 16 / elementSize;
+                    const int elementMask = (1 << elementSize) - 1;
+                    while (
+                        static_cast<size_t>(i - 1) * elementSize + 16 + elementSize <=
+                        static_cast<size_t>(max) * elementSize)
+                    {
+                        const int mask = differMask(in + (i - 1) * elementSize, in + i * elementSize);
+                        int j = 0;
+                        for (; j < step && ((mask >> (j * elementSize)) & elementMask); ++j)
+                            ;
+                        i += j;
+                        if (j < step)
+                        {
+                            break;
+                        }
+                    }
+                    if (i >= max)
+                    {
+                        break;
+                    }
+                }
+#endif // DJV_RLE_SSE2
+                if (isEqual(in + i * elementSize, in + (i - 1) * elementSize, elementSize))
+                {
+                    if (++match >= minRun)
+                    {
+                        return std::max(1, i - minRun + 1);
+                    }
+                }
+                else
+                {
+                    match = 1;
+                }
+                ++i;
+            }
+            return max;
+        }
+
+        void RLEUtil::fill(const quint8 * in, int elementSize, quint8 * out, int count, int stride)
+        {
+            if (count <= 0)
+            {
+                return;
+            }
+            if (stride == elementSize)
+            {
+                if (1 == elementSize)
+                {
+                    memset(out, *in, count);
+                }
+                else
+                {
+                    // Double the filled area with each copy.
+                    const size_t size = static_cast<size_t>(count) * elementSize;
+                    memcpy(out, in, elementSize);
+                    for (size_t i = elementSize; i < size;)
+                    {
+                        const size_t n = std::min(i, size - i);
+                        memcpy(out + i, out, n);
+                        i += n;
+                    }
+                }
+                return;
+            }
+            switch (elementSize)
+            {
+            case 1:
+            {
+                const quint8 value = *in;
+                for (int i = 0; i < count; ++i, out += stride)
+                {
+                    *out = value;
+                }
+                break;
+            }
+            case 2: fillStride<2>(in, out, count, stride); break;
+            case 3: fillStride<3>(in, out, count, stride); break;
+            case 4: fillStride<4>(in, out, count, stride); break;
+            default:
+                for (int i = 0; i < count; ++i, out += stride)
+                {
+                    memcpy(out, in, elementSize);
+                }
+                break;
+            }
+        }
+
+        void RLEUtil::copy(const quint8 * in, int elementSize, quint8 * out, int count, int stride)
+        {
+            if (count <= 0)
+            {
+                return;
+            }
+            if (stride == elementSize)
+            {
+                memcpy(out, in, static_cast<size_t>(count) * elementSize);
+                return;
+            }
+            switch (elementSize)
+            {
+            case 1:
+                for (int i = 0; i < count; ++i, out += stride)
+                {
+                    *out = in[i];
+                }
+                break;
+            case 2: copyStride<2>(in, out, count, stride); break;
+            case 3: copyStride<3>(in, out, count, stride); break;
+            case 4: copyStride<4>(in, out, count, stride); break;
+            default:
+                for (int i = 0; i < count; ++i, in += elementSize, out += stride)
+                {
+                    memcpy(out, in, elementSize);
+                }
+                break;
+            }
+        }
+
+        const quint8 * RLEUtil::readPackets(
+            const quint8 * in,
+            const quint8 * end,
+            quint8 *       out,
+            int            size,
+            int            elementSize,
+            int            stride)
+        {
+            //DJV_DEBUG("RLEUtil::readPackets");
+            //DJV_DEBUG_PRINT("size = " << size);
+            //DJV_DEBUG_PRINT("element size = " << elementSize);
+            //DJV_DEBUG_PRINT("stride = " << stride);
+            while (size > 0)
+            {
+                // Information.
+                if (in >= end)
+                {
+                    return nullptr;
+                }
+                const int  count = (*in & 0x7f) + 1;
+                const bool run = (*in & 0x80) ? true : false;
+                ++in;
+                if (count > size)
+                {
+                    return nullptr;
+                }
+
+                // Unpack.
+                const int length = (run ? 1 : count) * elementSize;
+                if (length > end - in)
+                {
+                    return nullptr;
+                }
+                if (run)
+                {
+                    fill(in, elementSize, out, count, stride);
+                }
+                else
+                {
+                    copy(in, elementSize, out, count, stride);
+                }
+                in += length;
+                out += count * stride;
+                size -= count;
+            }
+            return in;
+        }
+
+        quint64 RLEUtil::writePackets(const quint8 * in, quint8 * out, int size, int elementSize)
+        {
+            //DJV_DEBUG("RLEUtil::writePackets");
+            //DJV_DEBUG_PRINT("size = " << size);
+            //DJV_DEBUG_PRINT("element size = " << elementSize);
+
+            // Literal packets are broken at runs that would compress better
+            // than a new packet header costs.
+            const int minRun = elementSize > 1 ? 2 : 3;
+            quint8 * outP = out;
+            while (size > 0)
+            {
+                const int max = std::min(0x80, size);
+                int count = runLength(in, elementSize, max);
+                if (count > 1)
+                {
+                    *outP++ = static_cast<quint8>(0x80 | (count - 1));
+                    memcpy(outP, in, elementSize);
+                    outP += elementSize;
+                }
+                else
+                {
+                    count = literalLength(in, elementSize, max, minRun);
+                    *outP++ = static_cast<quint8>(count - 1);
+                    memcpy(outP, in, count * elementSize);
+                    outP += count * elementSize;
+                }
+                in += count * elementSize;
+                size -= count;
+            }
+            const quint64 r = outP - out;
+            //DJV_DEBUG_PRINT("r = " << r);
+            return r;
+        }
+
+        quint64 RLEUtil::packetsMaxByteCount(int size, int elementSize)
+        {
+            return static_cast<quint64>(size) * elementSize + (size + 0x7f) / 0x80;
+        }
+
+    } // namespace AV
+} // namespace djv
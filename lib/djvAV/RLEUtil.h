@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <QtGlobal>
+
+namespace djv
+{
+    namespace AV
+    {
+        //! This class provides run-length encoding utilities shared by the
+        //! image file formats.
+        //!
+        //! Data is handled as elements of one or more bytes, for example a
+        //! pixel or a single channel. Encoded elements are written to the
+        //! output with a stride so that channels can be decoded directly into
+        //! interleaved pixel data.
+        class RLEUtil
+        {
+        public:
+            virtual ~RLEUtil() = 0;
+
+            //! Get the number of elements at the start of the data that are
+            //! equal to the first element, up to the given maximum.
+            static int runLength(const quint8 * in, int elementSize, int max);
+
+            //! Get the number of elements at the start of the data that do not
+            //! begin a run of at least the given length, up to the given
+            //! maximum. The result is always at least one.
+            static int literalLength(const quint8 * in, int elementSize, int max, int minRun);
+
+            //! Fill the output with copies of an element.
+            static void fill(const quint8 * in, int elementSize, quint8 * out, int count, int stride);
+
+            //! Copy elements to the output.
+            static void copy(const quint8 * in, int elementSize, quint8 * out, int count, int stride);
+
+            //! Decode packets that start with a byte containing the element
+            //! count minus one in the low seven bits and the high bit set for
+            //! a run. This is the encoding used by IFF and Targa. Returns a
+            //! pointer to the end of the compressed data, or nullptr if the
+            //! data is corrupt.
+            static const quint8 * readPackets(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            elementSize,
+                int            stride);
+
+            //! Encode packets, returning the number of bytes written.
+            static quint64 writePackets(const quint8 * in, quint8 * out, int size, int elementSize);
+
+            //! Get the maximum number of bytes written by writePackets().
+            static quint64 packetsMaxByteCount(int size, int elementSize);
+        };
+
+    } // namespace AV
+} // namespace djv
@@ -29,6 +29,8 @@
 
 #include <djvAV/SGI.h>
 
+#include <djvAV/RLEUtil.h>
+
 #include <djvCore/Assert.h>
 #include <djvCore/Error.h>
 
@@ -185,79 +187,76 @@ namespace djv
 
         namespace
         {
+            template<typename T>
+            inline T getWord(const quint8 * in, bool endian)
+            {
+                T out;
+                if (endian)
+                {
+                    Core::Memory::convertEndian(in, &out, 1, sizeof(T));
+                }
+                else
+                {
+                    memcpy(&out, in, sizeof(T));
+                }
+                return out;
+            }
+
             template<typename T>
             bool load(
-                const void * in,
-                const void * end,
-                void *       out,
-                int          size,
-                bool         endian)
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            stride,
+                bool           endian)
             {
                 //DJV_DEBUG("load");
                 //DJV_DEBUG_PRINT("size = " << size);
+                //DJV_DEBUG_PRINT("stride = " << stride);
                 //DJV_DEBUG_PRINT("endian = " << endian);
-                const quint64 bytes = sizeof(T);
+                const int bytes = sizeof(T);
                 //DJV_DEBUG_PRINT("bytes = " << bytes);
-                const T * inP = reinterpret_cast<const T *>(in);
-                T * outP = reinterpret_cast<T *>(out);
-                const T * const outEnd = outP + size;
-                while (outP < outEnd)
+                while (size > 0)
                 {
                     // Information.
-                    if (inP > end)
+                    if (end - in < bytes)
                     {
                         return false;
                     }
-                    const int  count = *inP & 0x7f;
-                    const bool run = !(*inP & 0x80);
-                    const int  length = run ? 1 : count;
+                    const T    header = getWord<T>(in, endian);
+                    const int  count = header & 0x7f;
+                    const bool run = !(header & 0x80);
+                    const int  length = (run ? 1 : count) * bytes;
                     //DJV_DEBUG_PRINT("count = " << count);
                     //DJV_DEBUG_PRINT("  run = " << run);
                     //DJV_DEBUG_PRINT("  length = " << length);
-                    ++inP;
+                    in += bytes;
 
                     // Unpack.
-                    if (inP + length > end)
+                    if (!count || count > size || length > end - in)
                     {
                         return false;
                     }
                     if (run)
                     {
-                        if (!endian)
-                        {
-                            for (int j = 0; j < count; ++j, ++outP)
-                            {
-                                *outP = *inP;
-                            }
-                        }
-                        else
+                        const T value = getWord<T>(in, endian);
+                        RLEUtil::fill(reinterpret_cast<const quint8 *>(&value), bytes, out, count, stride);
+                    }
+                    else if (endian)
+                    {
+                        for (int i = 0; i < count; ++i)
                         {
-                            Core::Memory::convertEndian(inP, outP, 1, bytes);
-                            Core::Memory::convertEndian(inP, outP, 1, bytes);
-                            if (count > 1)
-                            {
-                                Core::Memory::fill<T>(*outP, outP + 1, count - 1);
-                            }
-                            outP += count;
+                            Core::Memory::convertEndian(in + i * bytes, out + i * stride, 1, bytes);
                         }
-                        ++inP;
                     }
                     else
                     {
-                        if (!endian)
-                        {
-                            for (int j = 0; j < length; ++j, ++inP, ++outP)
-                            {
-                                *outP = *inP;
-                            }
-                        }
-                        else
-                        {
-                            Core::Memory::convertEndian(inP, outP, length, bytes);
-                            inP += length;
-                            outP += length;
-                        }
+                        RLEUtil::copy(in, bytes, out, count, stride);
                     }
+                    in += length;
+                    out += count * stride;
+                    size -= count;
                 }
                 return true;
             }
@@ -265,17 +264,19 @@ namespace djv
         } // namespace
 
         bool SGI::readRle(
-            const void * in,
-            const void * end,
-            void *       out,
-            int          size,
-            int          bytes,
-            bool         endian)
+            const quint8 * in,
+            const quint8 * end,
+            quint8 *       out,
+            int            size,
+            int            bytes,
+            int            stride,
+            bool           endian)
         {
             switch (bytes)
             {
-            case 1: return load<quint8>(in, end, out, size, false);
-            case 2: return load<quint16>(in, end, out, size, endian);
+            case 1: return load<quint8>(in, end, out, size, stride, false);
+            case 2: return load<quint16>(in, end, out, size, stride, endian);
+            default: break;
             }
             return false;
         }
@@ -284,74 +285,63 @@ namespace djv
         {
             template<typename T>
             quint64 save(
-                const void * in,
-                void *       out,
-                int          size,
-                bool         endian)
+                const quint8 * in,
+                quint8 *       out,
+                int            size,
+                bool           endian)
             {
                 //DJV_DEBUG("save");
                 //DJV_DEBUG_PRINT("size = " << size);
                 //DJV_DEBUG_PRINT("endian = " << endian);
-                const quint64 bytes = sizeof(T);
+                const int bytes = sizeof(T);
                 //DJV_DEBUG_PRINT("bytes = " << bytes);
-                const T * inP = reinterpret_cast<const T *>(in);
-                T * outP = reinterpret_cast<T *>(out);
-                const T * const end = inP + size;
-                while (inP < end)
+                quint8 * const start = out;
+                while (size > 0)
                 {
                     // Pixel runs.
                     const int min = 3;
-                    const int max = Core::Math::min(0x7f, static_cast<int>(end - inP));
-                    int count = 1, match = 1;
-                    for (; count < max; ++count)
+                    const int max = Core::Math::min(0x7f, size);
+                    int count = RLEUtil::runLength(in, bytes, max);
+                    const bool run = count >= min;
+                    if (!run)
                     {
-                        if (inP[count] == inP[count - 1])
-                        {
-                            ++match;
-                            if (min == match && count >= min)
-                            {
-                                count -= min - 1;
-                                match = 1;
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            if (match >= min)
-                            {
-                                break;
-                            }
-                            match = 1;
-                        }
+                        count = RLEUtil::literalLength(in, bytes, max, min);
                     }
-                    const bool run = match > min;
-                    const int  length = run ? 1 : count;
+                    const int length = run ? 1 : count;
                     //DJV_DEBUG_PRINT("count = " << count);
                     //DJV_DEBUG_PRINT("  run = " << run);
                     //DJV_DEBUG_PRINT("  length = " << length);
 
                     // Information.
-                    *outP++ = (count & 0x7f) | ((!run) << 7);
+                    const T header = static_cast<T>((count & 0x7f) | ((!run) << 7));
+                    if (endian)
+                    {
+                        Core::Memory::convertEndian(&header, out, 1, bytes);
+                    }
+                    else
+                    {
+                        memcpy(out, &header, bytes);
+                    }
+                    out += bytes;
 
                     // Pack.
-                    if (!endian)
+                    if (endian)
                     {
-                        for (int i = 0; i < length; ++i)
-                        {
-                            outP[i] = inP[i];
-                        }
+                        Core::Memory::convertEndian(in, out, length, bytes);
                     }
                     else
                     {
-                        Core::Memory::convertEndian(inP, outP, length, bytes);
+                        memcpy(out, in, length * bytes);
                     }
-                    outP += length;
-                    inP += count;
+                    out += length * bytes;
+                    in += count * bytes;
+                    size -= count;
                 }
 
                 // Cap the end.
-                *outP++ = 0;
-                const quint64 r = (outP - reinterpret_cast<T *>(out)) * bytes;
+                memset(out, 0, bytes);
+                out += bytes;
+                const quint64 r = out - start;
                 //DJV_DEBUG_PRINT("r = " << r);
                 return r;
             }
@@ -359,11 +349,11 @@ namespace djv
         } // namespace
 
         quint64 SGI::writeRle(
-            const void * in,
-            void *       out,
-            int          size,
-            int          bytes,
-            bool         endian)
+            const quint8 * in,
+            quint8 *       out,
+            int            size,
+            int            bytes,
+            bool           endian)
         {
             switch (bytes)
             {
@@ -374,6 +364,11 @@ namespace djv
             return 0;
         }
 
+        quint64 SGI::rleMaxByteCount(int size, int bytes)
+        {
+            return (static_cast<quint64>(size) + (size + 0x7e) / 0x7f + 1) * bytes;
+        }
+
         const QStringList & SGI::optionsLabels()
         {
             static const QStringList data = QStringList() <<
@@ -67,11 +67,31 @@ namespace djv
             //! - Core::Error
             static void saveInfo(Core::FileIO & io, const IOInfo & info, bool compression) ;
 
-            //! Load RLE data.
-            static bool readRle(const void * in, const void * end, void * out, int size, int bytes, bool endian);
-
-            //! Save RLE data.
-            static quint64 writeRle(const void * in, void * out, int size, int bytes, bool endian);
+            //! Load a scanline of RLE data for one channel, writing each
+            //! element to the output with the given stride. The input is the
+            //! data as stored in the file; the endian flag converts the 16-bit
+            //! words to the machine endian. Returns false if the data is
+            //! corrupt.
+            //!
+            //! The 16-bit words are big endian as the format specifies. Files
+            //! saved by DJV 1.2.7 and earlier on little endian machines stored
+            //! the values little endian and are not read correctly.
+            static bool readRle(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            bytes,
+                int            stride,
+                bool           endian);
+
+            //! Save a scanline of RLE data for one channel, returning the
+            //! number of bytes written. The output is the data as stored in the
+            //! file and must have room for rleMaxByteCount() bytes.
+            static quint64 writeRle(const quint8 * in, quint8 * out, int size, int bytes, bool endian);
+
+            //! Get the maximum number of bytes written by writeRle().
+            static quint64 rleMaxByteCount(int size, int bytes);
 
             //! This enumeration provides the options.
             enum OPTIONS
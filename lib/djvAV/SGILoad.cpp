@@ -31,8 +31,11 @@
 
 #include <djvAV/Image.h>
 #include <djvAV/PixelDataUtil.h>
+#include <djvAV/RLEUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -42,7 +45,9 @@ namespace djv
             Load(fileInfo, context)
         {
             Core::FileIO io;
-            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io);
+            bool compression = false;
+            std::vector<quint32> rleOffset;
+            _open(_fileInfo.fileName(_fileInfo.sequence().start()), _ioInfo, io, compression, rleOffset);
             if (Core::FileInfo::SEQUENCE == _fileInfo.type())
             {
                 _ioInfo.sequence.frames = _fileInfo.sequence().frames;
@@ -56,6 +61,7 @@ namespace djv
         {
             //DJV_DEBUG("SGILoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::SGILoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -65,75 +71,111 @@ namespace djv
             //DJV_DEBUG_PRINT("file name = " << fileName);
             IOInfo info;
             Core::FileIO io;
-            _open(fileName, info, io);
+            bool compression = false;
+            std::vector<quint32> rleOffset;
+            _open(fileName, info, io, compression, rleOffset);
 
-            // Read the file.
+            // Read the file. The channels are stored as separate planes of
+            // scanlines which are decoded in parallel bands directly into the
+            // interleaved image.
             io.readAhead();
-            const quint64 pos = io.pos();
-            const quint64 size = io.size() - pos;
+            const quint8 * const start = io.mmapP() - io.pos();
+            const quint8 * const end = io.mmapEnd();
             auto pixelDataInfo = info.layers[0];
-            const int channels = Pixel::channels(pixelDataInfo.pixel);
-            const int bytes = Pixel::channelByteCount(pixelDataInfo.pixel);
-            if (!_compression)
+            PixelData tmp;
+            PixelData * data = frame.proxy ? &tmp : &image;
+            data->set(pixelDataInfo);
+            const int  w = pixelDataInfo.size.x;
+            const int  h = pixelDataInfo.size.y;
+            const int  channels = Pixel::channels(pixelDataInfo.pixel);
+            const int  bytes = Pixel::channelByteCount(pixelDataInfo.pixel);
+            const int  stride = channels * bytes;
+            const bool endian = io.endian();
+            quint8 * const out = data->data();
+            if (!compression)
             {
-                if (1 == bytes)
+                const quint8 * const in = io.mmapP();
+                if (static_cast<quint64>(end - in) < PixelDataUtil::dataByteCount(pixelDataInfo))
                 {
-                    const quint8 * p = io.mmapP();
-                    io.seek(PixelDataUtil::dataByteCount(pixelDataInfo));
-                    _tmp.set(pixelDataInfo, p);
+                    throw Core::Error(
+                        SGI::staticName,
+                        IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
                 }
-                else
+                Core::ParallelUtil::forBands(
+                    h,
+                    64,
+                    [in, out, w, h, channels, bytes, stride, endian](int y0, int y1)
                 {
-                    if (size != PixelDataUtil::dataByteCount(pixelDataInfo))
+                    for (int y = y0; y < y1; ++y)
                     {
-                        throw Core::Error(
-                            SGI::staticName,
-                            IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                        for (int c = 0; c < channels; ++c)
+                        {
+                            const quint8 * inP = in + (static_cast<quint64>(c) * h + y) * w * bytes;
+                            quint8 * outP = out + static_cast<quint64>(y) * w * stride + c * bytes;
+                            if (endian)
+                            {
+                                for (int x = 0; x < w; ++x, inP += bytes, outP += stride)
+                                {
+                                    Core::Memory::convertEndian(inP, outP, 1, bytes);
+                                }
+                            }
+                            else
+                            {
+                                RLEUtil::copy(inP, bytes, outP, w, stride);
+                            }
+                        }
                     }
-                    _tmp.set(pixelDataInfo);
-                    io.get(_tmp.data(), size / bytes, bytes);
-                }
+                });
             }
             else
             {
-                _tmp.set(pixelDataInfo);
-                std::vector<quint8> tmp(size);
-                io.get(tmp.data(), size / bytes, bytes);
-                const quint8 * inP = tmp.data();
-                const quint8 * end = inP + size;
-                quint8 *       outP = _tmp.data();
-                for (int c = 0; c < channels; ++c)
+                Core::ParallelUtil::forBands(
+                    h,
+                    16,
+                    [start, end, out, &rleOffset, w, h, channels, bytes, stride, endian](int y0, int y1)
                 {
-                    //DJV_DEBUG_PRINT("channel = " << c);
-                    for (int y = 0; y < pixelDataInfo.size.y; ++y, outP += pixelDataInfo.size.x * bytes)
+                    for (int y = y0; y < y1; ++y)
                     {
-                        //DJV_DEBUG_PRINT("y = " << y);
-                        if (!SGI::readRle(
-                            inP + _rleOffset[y + pixelDataInfo.size.y * c] - pos,
-                            end,
-                            outP,
-                            pixelDataInfo.size.x,
-                            bytes,
-                            io.endian()))
+                        for (int c = 0; c < channels; ++c)
                         {
-                            throw Core::Error(
-                                SGI::staticName,
-                                IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                            const quint32 offset = rleOffset[y + h * c];
+                            if (offset >= static_cast<quint64>(end - start) ||
+                                !SGI::readRle(
+                                    start + offset,
+                                    end,
+                                    out + static_cast<quint64>(y) * w * stride + c * bytes,
+                                    w,
+                                    bytes,
+                                    stride,
+                                    endian))
+                            {
+                                throw Core::Error(
+                                    SGI::staticName,
+                                    IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                            }
                         }
                     }
-                }
+                });
             }
 
-            // Interleave the image channels.
-            pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
-            pixelDataInfo.proxy = frame.proxy;
-            image.set(pixelDataInfo);
-            PixelDataUtil::planarInterleave(_tmp, image, frame.proxy);
+            // Proxy scale the image.
+            if (frame.proxy)
+            {
+                pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
+                pixelDataInfo.proxy = frame.proxy;
+                image.set(pixelDataInfo);
+                PixelDataUtil::proxyScale(tmp, image, frame.proxy);
+            }
 
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
-        void SGILoad::_open(const QString & in, IOInfo & info, Core::FileIO & io)
+        void SGILoad::_open(
+            const QString &        in,
+            IOInfo &               info,
+            Core::FileIO &         io,
+            bool &                 compression,
+            std::vector<quint32> & rleOffset) const
         {
             //DJV_DEBUG("SGILoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
@@ -142,17 +184,17 @@ namespace djv
             io.setEndian(Core::Memory::endian() != Core::Memory::MSB);
             io.open(in, Core::FileIO::READ);
             info.layers[0].fileName = in;
-            SGI::loadInfo(io, info, &_compression);
+            SGI::loadInfo(io, info, &compression);
 
-            // Read the scanline tables.
-            if (_compression)
+            // Read the scanline offset table. The table of scanline sizes
+            // that follows it is not needed since the RLE data is checked
+            // against the end of the file.
+            if (compression)
             {
                 const int tableSize = info.layers[0].size.y * Pixel::channels(info.layers[0].pixel);
                 //DJV_DEBUG_PRINT("rle table size = " << tableSize);
-                _rleOffset.resize(tableSize);
-                _rleSize.resize(tableSize);
-                io.getU32(_rleOffset.data(), tableSize);
-                io.getU32(_rleSize.data(), tableSize);
+                rleOffset.resize(tableSize);
+                io.getU32(rleOffset.data(), tableSize);
             }
         }
 
@@ -46,12 +46,12 @@ namespace djv
             void read(Image &, const ImageIOInfo &) override;
 
         private:
-            void _open(const QString &, IOInfo &, Core::FileIO &);
-
-            bool                 _compression = false;
-            std::vector<quint32> _rleOffset;
-            std::vector<quint32> _rleSize;
-            PixelData            _tmp;
+            void _open(
+                const QString &,
+                IOInfo &,
+                Core::FileIO &,
+                bool & compression,
+                std::vector<quint32> & rleOffset) const;
         };
 
     } // namespace AV
@@ -33,6 +33,7 @@
 #include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -70,6 +71,7 @@ namespace djv
             //DJV_DEBUG("SGISave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("compression = " << _options.compression);
+            DJV_TRACE_ZONE("djv::AV::SGISave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
@@ -116,7 +118,7 @@ namespace djv
             }
             else
             {
-                std::vector<quint8> scanline(w * bytes * 2);
+                std::vector<quint8> scanline(SGI::rleMaxByteCount(w, bytes));
                 for (int c = 0; c < channels; ++c)
                 {
                     for (int y = 0; y < h; ++y)
@@ -129,13 +131,14 @@ namespace djv
                             io.endian());
                         _rleOffset[y + c * h] = quint32(io.pos());
                         _rleSize[y + c * h] = quint32(size);
-                        io.set(scanline.data(), size / bytes, bytes);
+                        io.set(scanline.data(), size);
                     }
                 }
                 io.setPos(512);
                 io.setU32(_rleOffset.data(), h * channels);
                 io.setU32(_rleSize.data(), h * channels);
             }
+            io.close();
         }
 
     } // namespace AV
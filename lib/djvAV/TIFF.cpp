@@ -45,7 +45,9 @@ namespace djv
             static const QStringList data = QStringList() <<
                 qApp->translate("djv::AV::TIFF", "None") <<
                 qApp->translate("djv::AV::TIFF", "RLE") <<
-                qApp->translate("djv::AV::TIFF", "LZW");
+                qApp->translate("djv::AV::TIFF", "LZW") <<
+                qApp->translate("djv::AV::TIFF", "Deflate") <<
+                qApp->translate("djv::AV::TIFF", "ZSTD");
             DJV_ASSERT(data.count() == COMPRESSION_COUNT);
             return data;
         }
@@ -94,7 +96,8 @@ namespace djv
         const QStringList & TIFF::optionsLabels()
         {
             static const QStringList data = QStringList() <<
-                qApp->translate("djv::AV::TIFF", "Compression");
+                qApp->translate("djv::AV::TIFF", "Compression") <<
+                qApp->translate("djv::AV::TIFF", "Rows Per Strip");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
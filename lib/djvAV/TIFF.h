@@ -50,6 +50,8 @@ namespace djv
                 _COMPRESSION_NONE,
                 _COMPRESSION_RLE,
                 _COMPRESSION_LZW,
+                _COMPRESSION_DEFLATE,
+                _COMPRESSION_ZSTD,
 
                 COMPRESSION_COUNT
             };
@@ -70,6 +72,7 @@ namespace djv
             enum OPTIONS
             {
                 COMPRESSION_OPTION,
+                ROWS_PER_STRIP_OPTION,
 
                 OPTIONS_COUNT
             };
@@ -81,6 +84,10 @@ namespace djv
             struct Options
             {
                 COMPRESSION compression = _COMPRESSION_NONE;
+
+                //! The number of rows in each strip, or zero to pick a size
+                //! automatically.
+                int rowsPerStrip = 0;
             };
         };
 
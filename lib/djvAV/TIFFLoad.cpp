@@ -33,11 +33,51 @@
 #include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
 
 namespace djv
 {
     namespace AV
     {
+        namespace
+        {
+            ::TIFF * tiffOpen(const QString & fileName)
+            {
+#if defined(DJV_WINDOWS)
+                return TIFFOpenW(Core::StringUtil::qToStdWString(fileName).data(), "r");
+#else
+                return TIFFOpen(fileName.toUtf8().data(), "r");
+#endif // DJV_WINDOWS
+            }
+
+            //! This struct provides an additional file handle for reading in
+            //! parallel.
+            struct Handle
+            {
+                explicit Handle(const QString & fileName) :
+                    f(tiffOpen(fileName))
+                {
+                    if (!f)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
+                    }
+                }
+
+                ~Handle()
+                {
+                    TIFFClose(f);
+                }
+
+                ::TIFF * f = nullptr;
+            };
+
+        } // namespace
+
         TIFFLoad::TIFFLoad(const Core::FileInfo & fileInfo, const QPointer<Core::CoreContext> & context) :
             Load(fileInfo, context)
         {
@@ -58,6 +98,7 @@ namespace djv
         {
             //DJV_DEBUG("TIFFLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::TIFFLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -69,27 +110,33 @@ namespace djv
             _open(fileName, info);
             image.tags = info.tags;
 
-            // Read the file.
+            // Read the file. Strips and tiles are independent of each other so
+            // compressed files are decoded in parallel, with each thread using
+            // its own handle since libtiff handles are not thread safe.
             auto data = frame.proxy ? &_tmp : &image;
             auto pixelDataInfo = info.layers[0];
             data->set(pixelDataInfo);
-            for (int y = 0; y < pixelDataInfo.size.y; ++y)
+            const int w = pixelDataInfo.size.x;
+            const int h = pixelDataInfo.size.y;
+            const int chunks = _tiled ?
+                static_cast<int>(((w + _tileWidth - 1) / _tileWidth) * ((h + _tileHeight - 1) / _tileHeight)) :
+                static_cast<int>((h + _rowsPerStrip - 1) / _rowsPerStrip);
+            //DJV_DEBUG_PRINT("chunks = " << chunks);
+            Core::ParallelUtil::forBands(
+                chunks,
+                _compression ? 1 : chunks,
+                [this, data, &fileName](int start, int end)
             {
-                if (TIFFReadScanline(_f, (tdata_t *)data->data(0, y), y) == -1)
+                if (0 == start)
                 {
-                    throw Core::Error(
-                        TIFF::staticName,
-                        IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                    _read(_f, *data, start, end);
                 }
-                if (_palette)
+                else
                 {
-                    TIFF::paletteLoad(
-                        data->data(0, y),
-                        pixelDataInfo.size.x,
-                        Pixel::channelByteCount(pixelDataInfo.pixel),
-                        _colormap[0], _colormap[1], _colormap[2]);
+                    Handle handle(fileName);
+                    _read(handle.f, *data, start, end);
                 }
-            }
+            });
 
             // Proxy scaling.
             if (frame.proxy)
@@ -111,11 +158,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
 
             // Open the file.
-#if defined(DJV_WINDOWS)
-            _f = TIFFOpenW(Core::StringUtil::qToStdWString(in).data(), "r");
-#else
-            _f = TIFFOpen(in.toUtf8().data(), "r");
-#endif // DJV_WINDOWS
+            _f = tiffOpen(in);
             if (!_f)
             {
                 throw Core::Error(
@@ -135,6 +178,9 @@ namespace djv
             uint16   orient = 0;
             uint16   compression = 0;
             uint16   channels = 0;
+            uint32   rowsPerStrip = 0;
+            uint32   tileWidth = 0;
+            uint32   tileHeight = 0;
             TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGEWIDTH, &width);
             TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGELENGTH, &height);
             TIFFGetFieldDefaulted(_f, TIFFTAG_PHOTOMETRIC, &photometric);
@@ -148,22 +194,25 @@ namespace djv
             TIFFGetFieldDefaulted(_f, TIFFTAG_PLANARCONFIG, &channels);
             TIFFGetFieldDefaulted(_f, TIFFTAG_COLORMAP,
                 &_colormap[0], &_colormap[1], &_colormap[2]);
+            TIFFGetFieldDefaulted(_f, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+            const bool tiled = TIFFIsTiled(_f) != 0;
+            if (tiled)
+            {
+                TIFFGetField(_f, TIFFTAG_TILEWIDTH, &tileWidth);
+                TIFFGetField(_f, TIFFTAG_TILELENGTH, &tileHeight);
+            }
 
             //DJV_DEBUG_PRINT("tiff size = " << width << " " << height);
             //DJV_DEBUG_PRINT("tiff photometric = " << photometric);
             //DJV_DEBUG_PRINT("tiff samples = " << samples);
             //DJV_DEBUG_PRINT("tiff sample depth = " << sampleDepth);
             //DJV_DEBUG_PRINT("tiff channels = " << channels);
+            //DJV_DEBUG_PRINT("tiff rows per strip = " << rowsPerStrip);
+            //DJV_DEBUG_PRINT("tiff tiled = " << tiled);
 
             // Get file information.
             info.layers[0].fileName = in;
             info.layers[0].size = glm::ivec2(width, height);
-            if (samples > 1 && PLANARCONFIG_SEPARATE == channels)
-            {
-                throw Core::Error(
-                    TIFF::staticName,
-                    IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
-            }
             Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(0);
             bool found = false;
             switch (photometric)
@@ -198,6 +247,27 @@ namespace djv
             info.layers[0].pixel = pixel;
             _compression = compression != COMPRESSION_NONE;
             _palette = PHOTOMETRIC_PALETTE == photometric;
+            _planar = samples > 1 && PLANARCONFIG_SEPARATE == channels;
+            _tiled = tiled;
+            _samples = samples;
+            _sampleBytes = sampleDepth / 8;
+            _rowsPerStrip = std::max(uint32(1), std::min(rowsPerStrip, height));
+            _tileWidth = tileWidth;
+            _tileHeight = tileHeight;
+
+            // Check that the data in the file matches our pixel layout (this
+            // rules out packed bit depths like 10 and 12-bit).
+            const quint64 rowByteCount = static_cast<quint64>(width) *
+                (_planar || _palette ? 1 : _samples) * _sampleBytes;
+            if ((sampleDepth % 8) != 0 ||
+                (tiled && (!tileWidth || !tileHeight)) ||
+                (tiled && static_cast<quint64>(TIFFTileRowSize(_f)) != rowByteCount / width * tileWidth) ||
+                (!tiled && static_cast<quint64>(TIFFScanlineSize(_f)) != rowByteCount))
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
+            }
             switch (orient)
             {
             case ORIENTATION_TOPLEFT:  info.layers[0].mirror.y = true; break;
@@ -227,6 +297,98 @@ namespace djv
             }
         }
 
+        void TIFFLoad::_read(::TIFF * f, PixelData & data, int start, int end) const
+        {
+            //DJV_DEBUG("TIFFLoad::_read");
+            //DJV_DEBUG_PRINT("start = " << start);
+            //DJV_DEBUG_PRINT("end = " << end);
+            const int w = data.w();
+            const int h = data.h();
+            const int pixelByteCount = static_cast<int>(data.pixelByteCount());
+            const int sampleBytes = _sampleBytes;
+            const int fileChannels = _planar || _palette ? 1 : _samples;
+            const int planes = _planar ? _samples : 1;
+            const int chunkW = _tiled ? static_cast<int>(_tileWidth) : w;
+            const int chunkH = _tiled ? static_cast<int>(_tileHeight) : static_cast<int>(_rowsPerStrip);
+            const int chunksAcross = (w + chunkW - 1) / chunkW;
+            const tmsize_t chunkRowByteCount = chunkW * fileChannels * sampleBytes;
+
+            // Contiguous strips without a palette are decoded directly into
+            // the image, everything else goes through a temporary buffer.
+            const bool direct = !_tiled && !_planar && !_palette;
+            std::vector<quint8> buf(direct ? 0 : chunkRowByteCount * chunkH);
+            for (int chunk = start; chunk < end; ++chunk)
+            {
+                const int x0 = (chunk % chunksAcross) * chunkW;
+                const int y0 = (chunk / chunksAcross) * chunkH;
+                const int cw = std::min(chunkW, w - x0);
+                const int ch = std::min(chunkH, h - y0);
+                for (int plane = 0; plane < planes; ++plane)
+                {
+                    // Decode the strip or tile.
+                    quint8 * p = direct ? data.data(0, y0) : buf.data();
+                    tmsize_t size = 0;
+                    if (_tiled)
+                    {
+                        size = TIFFReadEncodedTile(
+                            f,
+                            TIFFComputeTile(f, x0, y0, 0, plane),
+                            p,
+                            buf.size());
+                    }
+                    else
+                    {
+                        size = TIFFReadEncodedStrip(
+                            f,
+                            TIFFComputeStrip(f, y0, plane),
+                            p,
+                            chunkRowByteCount * ch);
+                    }
+                    if (-1 == size)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                    }
+                    if (direct)
+                        continue;
+
+                    // Copy the data into the image.
+                    for (int y = 0; y < ch; ++y)
+                    {
+                        const quint8 * inP = buf.data() + y * chunkRowByteCount;
+                        quint8 * outP = data.data(x0, y0 + y);
+                        if (_planar)
+                        {
+                            outP += plane * sampleBytes;
+                            for (int x = 0; x < cw; ++x, inP += sampleBytes, outP += pixelByteCount)
+                            {
+                                switch (sampleBytes)
+                                {
+                                case 4: outP[3] = inP[3];
+                                case 3: outP[2] = inP[2];
+                                case 2: outP[1] = inP[1];
+                                case 1: outP[0] = inP[0];
+                                }
+                            }
+                        }
+                        else
+                        {
+                            memcpy(outP, inP, cw * fileChannels * sampleBytes);
+                            if (_palette)
+                            {
+                                TIFF::paletteLoad(
+                                    outP,
+                                    cw,
+                                    sampleBytes,
+                                    _colormap[0], _colormap[1], _colormap[2]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         void TIFFLoad::_close()
         {
             if (_f)
@@ -50,9 +50,19 @@ namespace djv
             void _open(const QString &, IOInfo &);
             void _close();
 
+            //! Read the strips or tiles in the range [start, end).
+            void _read(::TIFF *, PixelData &, int start, int end) const;
+
             ::TIFF *  _f           = nullptr;
             bool      _compression = false;
             bool      _palette     = false;
+            bool      _planar      = false;
+            bool      _tiled       = false;
+            int       _samples     = 0;
+            int       _sampleBytes = 0;
+            uint32    _rowsPerStrip = 0;
+            uint32    _tileWidth   = 0;
+            uint32    _tileHeight  = 0;
             uint16 *  _colormap[3] = { nullptr, nullptr, nullptr };
             PixelData _tmp;
         };
@@ -71,6 +71,10 @@ namespace djv
             {
                 out << _options.compression;
             }
+            else if (0 == in.compare(options()[TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.rowsPerStrip;
+            }
             return out;
         }
 
@@ -88,6 +92,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+                {
+                    int rowsPerStrip = 0;
+                    data >> rowsPerStrip;
+                    if (rowsPerStrip != _options.rowsPerStrip)
+                    {
+                        _options.rowsPerStrip = rowsPerStrip;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -114,6 +128,10 @@ namespace djv
                     {
                         in >> _options.compression;
                     }
+                    else if (qApp->translate("djv::AV::TIFFPlugin", "-tiff_rows_per_strip") == arg)
+                    {
+                        in >> _options.rowsPerStrip;
+                    }
                     else
                     {
                         tmp << arg;
@@ -131,15 +149,21 @@ namespace djv
         {
             QStringList compressionLabel;
             compressionLabel << _options.compression;
+            QStringList rowsPerStripLabel;
+            rowsPerStripLabel << _options.rowsPerStrip;
             return qApp->translate("djv::AV::TIFFPlugin",
                 "\n"
                 "TIFF Options\n"
                 "\n"
                 "    -tiff_compression (value)\n"
                 "        Set the file compression used when saving TIFF images: %1. "
-                "Default = %2.\n").
+                "Default = %2.\n"
+                "    -tiff_rows_per_strip (value)\n"
+                "        Set the number of rows in each strip when saving TIFF images, "
+                "or zero to pick a size automatically. Default = %3.\n").
                 arg(TIFF::compressionLabels().join(", ")).
-                arg(compressionLabel.join(", "));
+                arg(compressionLabel.join(", ")).
+                arg(rowsPerStripLabel.join(", "));
         }
 
         std::unique_ptr<Load> TIFFPlugin::createLoad(const Core::FileInfo & fileInfo) const
@@ -30,13 +30,103 @@
 #include <djvAV/TIFFSave.h>
 
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/ParallelUtil.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
+
+#include <string.h>
 
 namespace djv
 {
     namespace AV
     {
+        namespace
+        {
+            //! The target size of a strip when the rows per strip are picked
+            //! automatically.
+            const quint64 stripByteCount = 256 * 1024;
+
+            //! This struct provides an in-memory file for encoding strips.
+            struct MemoryFile
+            {
+                std::vector<quint8> data;
+                toff_t              pos = 0;
+            };
+
+            tsize_t memoryRead(thandle_t, tdata_t, tsize_t)
+            {
+                return 0;
+            }
+
+            tsize_t memoryWrite(thandle_t handle, tdata_t in, tsize_t size)
+            {
+                MemoryFile * file = static_cast<MemoryFile *>(handle);
+                const toff_t end = file->pos + size;
+                if (end > file->data.size())
+                {
+                    file->data.resize(end);
+                }
+                memcpy(file->data.data() + file->pos, in, size);
+                file->pos = end;
+                return size;
+            }
+
+            toff_t memorySeek(thandle_t handle, toff_t offset, int whence)
+            {
+                MemoryFile * file = static_cast<MemoryFile *>(handle);
+                switch (whence)
+                {
+                case SEEK_SET: file->pos = offset; break;
+                case SEEK_CUR: file->pos += offset; break;
+                case SEEK_END: file->pos = file->data.size() + offset; break;
+                default: break;
+                }
+                return file->pos;
+            }
+
+            int memoryClose(thandle_t)
+            {
+                return 0;
+            }
+
+            toff_t memorySize(thandle_t handle)
+            {
+                return static_cast<MemoryFile *>(handle)->data.size();
+            }
+
+            int memoryMap(thandle_t, tdata_t *, toff_t *)
+            {
+                return 0;
+            }
+
+            void memoryUnmap(thandle_t, tdata_t, toff_t)
+            {}
+
+            //! This class provides a TIFF handle that is closed automatically.
+            class Handle
+            {
+            public:
+                explicit Handle(::TIFF * f) :
+                    f(f)
+                {}
+
+                ~Handle()
+                {
+                    if (f)
+                    {
+                        TIFFClose(f);
+                    }
+                }
+
+                ::TIFF * f = nullptr;
+            };
+
+        } // namespace
+
         TIFFSave::TIFFSave(const Core::FileInfo & fileInfo, const IOInfo & ioInfo, const TIFF::Options & options, const QPointer<Core::CoreContext> & context) :
             Save(fileInfo, ioInfo, context),
             _options(options)
@@ -61,6 +151,97 @@ namespace djv
             //DJV_DEBUG_PRINT("info = " << _info);
 
             _image.set(_info);
+
+            // Set the file layout.
+            switch (Pixel::format(_info.pixel))
+            {
+            case Pixel::L:
+                _photometric = PHOTOMETRIC_MINISBLACK;
+                _samples = 1;
+                break;
+            case Pixel::LA:
+                _photometric = PHOTOMETRIC_MINISBLACK;
+                _samples = 2;
+                break;
+            case Pixel::RGB:
+                _photometric = PHOTOMETRIC_RGB;
+                _samples = 3;
+                break;
+            case Pixel::RGBA:
+                _photometric = PHOTOMETRIC_RGB;
+                _samples = 4;
+                break;
+            default: break;
+            }
+            switch (Pixel::type(_info.pixel))
+            {
+            case Pixel::U8:
+                _sampleDepth = 8;
+                _sampleFormat = SAMPLEFORMAT_UINT;
+                break;
+            case Pixel::U16:
+                _sampleDepth = 16;
+                _sampleFormat = SAMPLEFORMAT_UINT;
+                break;
+            case Pixel::F16:
+            case Pixel::F32:
+                _sampleDepth = 32;
+                _sampleFormat = SAMPLEFORMAT_IEEEFP;
+                break;
+            default: break;
+            }
+            switch (_options.compression)
+            {
+            case TIFF::_COMPRESSION_NONE:
+                _compression = COMPRESSION_NONE;
+                break;
+            case TIFF::_COMPRESSION_RLE:
+                _compression = COMPRESSION_PACKBITS;
+                break;
+            case TIFF::_COMPRESSION_LZW:
+                _compression = COMPRESSION_LZW;
+                break;
+            case TIFF::_COMPRESSION_DEFLATE:
+                _compression = COMPRESSION_ADOBE_DEFLATE;
+                break;
+            case TIFF::_COMPRESSION_ZSTD:
+#if defined(COMPRESSION_ZSTD)
+                _compression = COMPRESSION_ZSTD;
+#endif // COMPRESSION_ZSTD
+                break;
+            default: break;
+            }
+            if ((TIFF::_COMPRESSION_ZSTD == _options.compression && !_compression) ||
+                !TIFFIsCODECConfigured(_compression))
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    IOPlugin::errorLabels()[IOPlugin::ERROR_UNSUPPORTED]);
+            }
+
+            // The predictor improves the compression of smooth images.
+            switch (_options.compression)
+            {
+            case TIFF::_COMPRESSION_DEFLATE:
+            case TIFF::_COMPRESSION_ZSTD:
+                _predictor = SAMPLEFORMAT_IEEEFP == _sampleFormat ?
+                    PREDICTOR_FLOATINGPOINT :
+                    PREDICTOR_HORIZONTAL;
+                break;
+            default:
+                _predictor = PREDICTOR_NONE;
+                break;
+            }
+
+            // Set the strip size.
+            _rowsPerStrip = _options.rowsPerStrip;
+            if (_rowsPerStrip <= 0)
+            {
+                const quint64 scanlineByteCount = std::max(PixelDataUtil::scanlineByteCount(_info), quint64(1));
+                _rowsPerStrip = static_cast<int>(std::max(stripByteCount / scanlineByteCount, quint64(1)));
+            }
+            _rowsPerStrip = std::min(_rowsPerStrip, std::max(_info.size.y, 1));
+            //DJV_DEBUG_PRINT("rows per strip = " << _rowsPerStrip);
         }
 
         TIFFSave::~TIFFSave()
@@ -72,6 +253,7 @@ namespace djv
         {
             //DJV_DEBUG("TIFFSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::TIFFSave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
@@ -90,15 +272,58 @@ namespace djv
                 p = &_image;
             }
 
-            //! Write the file.
+            // Write the file. The strips are compressed in parallel and then
+            // written in order.
             const int h = p->h();
-            for (int y = 0; y < h; ++y)
+            const int strips = (h + _rowsPerStrip - 1) / _rowsPerStrip;
+            const quint64 scanlineByteCount = PixelDataUtil::scanlineByteCount(_info);
+            //DJV_DEBUG_PRINT("strips = " << strips);
+            if (COMPRESSION_NONE == _compression)
+            {
+                for (int i = 0; i < strips; ++i)
+                {
+                    const int y = i * _rowsPerStrip;
+                    const int rows = std::min(_rowsPerStrip, h - y);
+                    if (TIFFWriteRawStrip(
+                        _f,
+                        i,
+                        (tdata_t)p->data(0, y),
+                        rows * scanlineByteCount) == -1)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            IOPlugin::errorLabels()[IOPlugin::ERROR_WRITE]);
+                    }
+                }
+            }
+            else
             {
-                if (TIFFWriteScanline(_f, (tdata_t *)p->data(0, y), y) == -1)
+                // Limit the number of compressed strips held in memory.
+                const int batch = std::min(Core::ParallelUtil::threadCount() * 2, strips);
+                std::vector<std::vector<quint8> > buffers(batch);
+                for (int i = 0; i < strips; i += batch)
                 {
-                    throw Core::Error(
-                        TIFF::staticName,
-                        IOPlugin::errorLabels()[IOPlugin::ERROR_WRITE]);
+                    const int count = std::min(batch, strips - i);
+                    Core::ParallelUtil::forEach(
+                        count,
+                        [this, p, h, i, &buffers](int j)
+                    {
+                        const int y = (i + j) * _rowsPerStrip;
+                        _encodeStrip(p->data(0, y), std::min(_rowsPerStrip, h - y), buffers[j]);
+                    });
+                    for (int j = 0; j < count; ++j)
+                    {
+                        if (TIFFWriteRawStrip(
+                            _f,
+                            i + j,
+                            buffers[j].data(),
+                            buffers[j].size()) == -1)
+                        {
+                            throw Core::Error(
+                                TIFF::staticName,
+                                IOPlugin::errorLabels()[IOPlugin::ERROR_WRITE]);
+                        }
+                    }
                 }
             }
 
@@ -124,75 +349,19 @@ namespace djv
             }
 
             // Write the header.
-            uint16 photometric = 0;
-            uint16 samples = 0;
-            uint16 sampleDepth = 0;
-            uint16 sampleFormat = 0;
+            _setFields(_f, _info.size.y);
             uint16 extraSamples[] = { EXTRASAMPLE_ASSOCALPHA };
             uint16 extraSamplesSize = 0;
-            uint16 compression = 0;
-            switch (Pixel::format(_image.pixel()))
+            switch (Pixel::format(_info.pixel))
             {
-            case Pixel::L:
-                photometric = PHOTOMETRIC_MINISBLACK;
-                samples = 1;
-                break;
             case Pixel::LA:
-                photometric = PHOTOMETRIC_MINISBLACK;
-                samples = 2;
-                extraSamplesSize = 1;
-                break;
-            case Pixel::RGB:
-                photometric = PHOTOMETRIC_RGB;
-                samples = 3;
-                break;
             case Pixel::RGBA:
-                photometric = PHOTOMETRIC_RGB;
-                samples = 4;
                 extraSamplesSize = 1;
                 break;
             default: break;
             }
-            switch (Pixel::type(_image.pixel()))
-            {
-            case Pixel::U8:
-                sampleDepth = 8;
-                sampleFormat = SAMPLEFORMAT_UINT;
-                break;
-            case Pixel::U16:
-                sampleDepth = 16;
-                sampleFormat = SAMPLEFORMAT_UINT;
-                break;
-            case Pixel::F16:
-            case Pixel::F32:
-                sampleDepth = 32;
-                sampleFormat = SAMPLEFORMAT_IEEEFP;
-                break;
-            default: break;
-            }
-            switch (_options.compression)
-            {
-            case TIFF::_COMPRESSION_NONE:
-                compression = COMPRESSION_NONE;
-                break;
-            case TIFF::_COMPRESSION_RLE:
-                compression = COMPRESSION_PACKBITS;
-                break;
-            case TIFF::_COMPRESSION_LZW:
-                compression = COMPRESSION_LZW;
-                break;
-            default: break;
-            }
-            TIFFSetField(_f, TIFFTAG_IMAGEWIDTH, _image.w());
-            TIFFSetField(_f, TIFFTAG_IMAGELENGTH, _image.h());
-            TIFFSetField(_f, TIFFTAG_PHOTOMETRIC, photometric);
-            TIFFSetField(_f, TIFFTAG_SAMPLESPERPIXEL, samples);
-            TIFFSetField(_f, TIFFTAG_BITSPERSAMPLE, sampleDepth);
-            TIFFSetField(_f, TIFFTAG_SAMPLEFORMAT, sampleFormat);
             TIFFSetField(_f, TIFFTAG_EXTRASAMPLES, extraSamplesSize, extraSamples);
             TIFFSetField(_f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-            TIFFSetField(_f, TIFFTAG_COMPRESSION, compression);
-            TIFFSetField(_f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
 
             // Set tags.
             const QStringList & tags = Tags::tagLabels();
@@ -218,6 +387,65 @@ namespace djv
             }
         }
 
+        void TIFFSave::_setFields(::TIFF * f, int h) const
+        {
+            TIFFSetField(f, TIFFTAG_IMAGEWIDTH, _info.size.x);
+            TIFFSetField(f, TIFFTAG_IMAGELENGTH, h);
+            TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, std::min(_rowsPerStrip, h));
+            TIFFSetField(f, TIFFTAG_PHOTOMETRIC, _photometric);
+            TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, _samples);
+            TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, _sampleDepth);
+            TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, _sampleFormat);
+            TIFFSetField(f, TIFFTAG_COMPRESSION, _compression);
+            TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+            if (_predictor != PREDICTOR_NONE)
+            {
+                TIFFSetField(f, TIFFTAG_PREDICTOR, _predictor);
+            }
+        }
+
+        void TIFFSave::_encodeStrip(const quint8 * in, int h, std::vector<quint8> & out) const
+        {
+            // Encode the strip with libtiff into an in-memory file and copy out
+            // the compressed data.
+            MemoryFile file;
+            Handle handle(TIFFClientOpen(
+                "", "w",
+                &file,
+                memoryRead,
+                memoryWrite,
+                memorySeek,
+                memoryClose,
+                memorySize,
+                memoryMap,
+                memoryUnmap));
+            if (!handle.f)
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    IOPlugin::errorLabels()[IOPlugin::ERROR_WRITE]);
+            }
+            _setFields(handle.f, h);
+            uint64 * offsets = nullptr;
+            uint64 * byteCounts = nullptr;
+            if (TIFFWriteEncodedStrip(
+                    handle.f,
+                    0,
+                    (tdata_t)in,
+                    h * PixelDataUtil::scanlineByteCount(_info)) == -1 ||
+                !TIFFGetField(handle.f, TIFFTAG_STRIPOFFSETS, &offsets) ||
+                !TIFFGetField(handle.f, TIFFTAG_STRIPBYTECOUNTS, &byteCounts) ||
+                offsets[0] + byteCounts[0] > file.data.size())
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    IOPlugin::errorLabels()[IOPlugin::ERROR_WRITE]);
+            }
+            out.assign(
+                file.data.begin() + offsets[0],
+                file.data.begin() + offsets[0] + byteCounts[0]);
+        }
+
         void TIFFSave::_close()
         {
             if (_f)
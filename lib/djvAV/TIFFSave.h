@@ -35,6 +35,8 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <vector>
+
 namespace djv
 {
     namespace AV
@@ -50,12 +52,21 @@ namespace djv
 
         private:
             void _open(const QString &, const IOInfo &);
+            void _setFields(::TIFF *, int h) const;
+            void _encodeStrip(const quint8 *, int h, std::vector<quint8> &) const;
             void _close();
 
             TIFF::Options _options;
             ::TIFF *      _f = nullptr;
             PixelDataInfo _info;
             Image         _image;
+            uint16        _photometric   = 0;
+            uint16        _samples       = 0;
+            uint16        _sampleDepth   = 0;
+            uint16        _sampleFormat  = 0;
+            uint16        _compression   = 0;
+            uint16        _predictor     = 0;
+            int           _rowsPerStrip  = 0;
         };
 
     } // namespace AV
@@ -251,127 +251,6 @@ namespace djv
             header.save(io, info, compression);
         }
 
-        const quint8 * Targa::readRle(
-            const quint8 * in,
-            const quint8 * end,
-            quint8 *       out,
-            int            size,
-            int            channels)
-        {
-            //DJV_DEBUG("readRle");
-            //DJV_DEBUG_PRINT("size = " << size);
-            //DJV_DEBUG_PRINT("channels = " << channels);
-            const quint8 * const outEnd = out + size * channels;
-            while (out < outEnd)
-            {
-                // Information.
-                if (in > end)
-                {
-                    return 0;
-                }
-                const quint8 count = (*in & 0x7f) + 1;
-                const bool   run = (*in & 0x80) ? true : false;
-                const int    length = run ? 1 : count;
-                //DJV_DEBUG_PRINT("length = " << length);
-                ++in;
-
-                // Unpack.
-                if (in + length * channels > end)
-                {
-                    return 0;
-                }
-                if (run)
-                {
-                    for (int j = 0; j < count; ++j, out += channels)
-                    {
-                        switch (channels)
-                        {
-                        case 4: out[3] = in[3];
-                        case 3: out[2] = in[2];
-                        case 2: out[1] = in[1];
-                        case 1: out[0] = in[0]; break;
-                        }
-                    }
-                    in += channels;
-                }
-                else
-                {
-                    for (int j = 0; j < count; ++j, in += channels, out += channels)
-                    {
-                        switch (channels)
-                        {
-                        case 4: out[3] = in[3];
-                        case 3: out[2] = in[2];
-                        case 2: out[1] = in[1];
-                        case 1: out[0] = in[0]; break;
-                        }
-                    }
-                }
-            }
-            return in;
-        }
-
-        quint64 Targa::writeRle(
-            const quint8 * in,
-            quint8 *       out,
-            int            size,
-            int            channels)
-        {
-            //DJV_DEBUG("Targa::writeRle");
-            //DJV_DEBUG_PRINT("size = " << size);
-            //DJV_DEBUG_PRINT("channels = " << channels);
-
-            const quint8 * const _out = out;
-            const quint8 * const end = in + size * channels;
-            while (in < end)
-            {
-                // Find runs.
-                const int max = Core::Math::min(0x7f + 1, static_cast<int>(end - in) / channels);
-                int count = 1;
-                for (; count < max; ++count)
-                {
-                    int c = 0;
-                    for (; c < channels; ++c)
-                    {
-                        if (in[count * channels + c] != in[(count - 1) * channels + c])
-                        {
-                            break;
-                        }
-                    }
-                    if (c < channels)
-                    {
-                        break;
-                    }
-                }
-                const bool run = count > 1;
-                const int  length = run ? 1 : count;
-                //DJV_DEBUG_PRINT("count = " << count);
-                //DJV_DEBUG_PRINT("  run = " << run);
-                //DJV_DEBUG_PRINT("  length = " << length);
-
-                // Information.
-                *out++ = ((count - 1) & 0x7f) | (run << 7);
-
-                // Pack.
-                for (int j = 0; j < length * channels; j += channels)
-                {
-                    switch (channels)
-                    {
-                    case 4: out[j + 3] = in[j + 3];
-                    case 3: out[j + 2] = in[j + 2];
-                    case 2: out[j + 1] = in[j + 1];
-                    case 1: out[j] = in[j]; break;
-                    }
-                }
-                out += length * channels;
-                in += count * channels;
-            }
-
-            const quint64 r = out - _out;
-            //DJV_DEBUG_PRINT("return = " << static_cast<int>(r));
-            return r;
-        }
-
         const QStringList & Targa::optionsLabels()
         {
             static const QStringList data = QStringList() <<
@@ -67,12 +67,6 @@ namespace djv
             //! - Core::Error
             static void saveInfo(Core::FileIO &, const IOInfo &, bool compression);
 
-            //! Load RLE data.
-            static const quint8 * readRle(const quint8 * in ,const quint8 * end, quint8 * out, int size, int channels);
-
-            //! Save RLE data.
-            static quint64 writeRle(const quint8 * in, quint8 * out, int size, int channels);
-
             //! This enumeration provides the options.
             enum OPTIONS
             {
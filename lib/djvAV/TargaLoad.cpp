@@ -31,8 +31,10 @@
 
 #include <djvAV/Image.h>
 #include <djvAV/PixelDataUtil.h>
+#include <djvAV/RLEUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -56,6 +58,7 @@ namespace djv
         {
             //DJV_DEBUG("TargaLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE_ZONE("djv::AV::TargaLoad::read");
 
             image.colorProfile = ColorProfile();
             image.tags = Tags();
@@ -91,11 +94,12 @@ namespace djv
                 for (int y = 0; y < pixelDataInfo.size.y; ++y)
                 {
                     //DJV_DEBUG_PRINT("y = " << y);
-                    p = Targa::readRle(
+                    p = RLEUtil::readPackets(
                         p,
                         end,
                         data->data(0, y),
                         pixelDataInfo.size.x,
+                        channels,
                         channels);
                     if (!p)
                     {
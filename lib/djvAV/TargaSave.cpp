@@ -30,8 +30,10 @@
 #include <djvAV/TargaSave.h>
 
 #include <djvAV/OpenGLImage.h>
+#include <djvAV/RLEUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -66,6 +68,7 @@ namespace djv
         {
             //DJV_DEBUG("TargaSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE_ZONE("djv::AV::TargaSave::write");
 
             // Open the file.
             const QString fileName = _fileInfo.fileName(frame.frame);
@@ -96,13 +99,14 @@ namespace djv
             {
                 const int w = p->w(), h = p->h();
                 const int channels = Pixel::channels(p->info().pixel);
-                std::vector<quint8> scanline(w * channels * 2);
+                std::vector<quint8> scanline(RLEUtil::packetsMaxByteCount(w, channels));
                 for (int y = 0; y < h; ++y)
                 {
-                    const quint64 size = Targa::writeRle(p->data(0, y), scanline.data(), w, channels);
+                    const quint64 size = RLEUtil::writePackets(p->data(0, y), scanline.data(), w, channels);
                     io.set(scanline.data(), size);
                 }
             }
+            io.close();
         }
 
     } // namespace AV
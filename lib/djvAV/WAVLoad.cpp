@@ -29,7 +29,9 @@
 
 #include <djvAV/WAVLoad.h>
 
+#include <djvCore/Memory.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -49,37 +51,119 @@ namespace djv
                     IOPlugin::errorLabels()[IOPlugin::ERROR_OPEN]);
             }
 
-            _ioInfo.audio.type        = Audio::intType(_drwav->bytesPerSample);
+            // Compressed formats are decoded to 16-bit, and integer formats
+            // without a matching type to 32-bit.
+            Audio::TYPE type = Audio::TYPE_NONE;
+            bool direct = false;
+            switch (_drwav->translatedFormatTag)
+            {
+            case DR_WAVE_FORMAT_PCM:
+                type = Audio::intType(_drwav->bytesPerSample);
+                direct = type != Audio::TYPE_NONE;
+                if (!direct)
+                {
+                    type = Audio::S32;
+                }
+                break;
+            case DR_WAVE_FORMAT_IEEE_FLOAT:
+                type = Audio::floatType(_drwav->bytesPerSample);
+                direct = type != Audio::TYPE_NONE;
+                if (!direct)
+                {
+                    type = Audio::F32;
+                }
+                break;
+            default:
+                type = Audio::S16;
+                break;
+            }
+            _ioInfo.audio.type        = type;
             _ioInfo.audio.channels    = _drwav->channels;
             _ioInfo.audio.sampleRate  = _drwav->sampleRate;
             _ioInfo.audio.sampleCount = _drwav->totalSampleCount;
+
+            // WAV samples are little endian and the frames must not be padded
+            // to be used directly.
+            direct &=
+                (1 == _drwav->bytesPerSample || Core::Memory::LSB == Core::Memory::endian()) &&
+                _drwav->bytesPerSample * _drwav->channels == _drwav->fmt.blockAlign;
+            //DJV_DEBUG_PRINT("direct = " << direct);
+            if (direct)
+            {
+                auto io = std::make_shared<Core::FileIO>();
+                try
+                {
+                    io->open(fileInfo.fileName(), Core::FileIO::READ);
+                    const uint64_t byteCount = _drwav->totalSampleCount * _drwav->bytesPerSample;
+                    if (io->mmapP() && _drwav->dataChunkDataPos + byteCount <= io->size())
+                    {
+                        _fileIO = io;
+                        _samples = io->mmapP() + _drwav->dataChunkDataPos;
+                    }
+                }
+                catch (const Core::Error &)
+                {
+                    // Fall back to decoding the samples.
+                }
+            }
         }
 
         WAVLoad::~WAVLoad()
-        {}
+        {
+            drwav_close(_drwav);
+        }
 
         void WAVLoad::read(AudioData & data, const AudioIOInfo & ioInfo)
         {
-            if (!drwav_seek_to_sample(_drwav, ioInfo.samplesOffset))
+            //DJV_DEBUG("WAVLoad::read");
+            //DJV_DEBUG_PRINT("offset = " << ioInfo.samplesOffset);
+            //DJV_DEBUG_PRINT("size = " << ioInfo.samplesSize);
+            DJV_TRACE_ZONE("djv::AV::WAVLoad::read");
+            AudioInfo info;
+            info.channels    = _ioInfo.audio.channels;
+            info.type        = _ioInfo.audio.type;
+            info.sampleRate  = _ioInfo.audio.sampleRate;
+            info.sampleCount = !ioInfo.samplesSize ? _ioInfo.audio.sampleCount : ioInfo.samplesSize;
+            if (ioInfo.samplesOffset > _ioInfo.audio.sampleCount ||
+                info.sampleCount > _ioInfo.audio.sampleCount - ioInfo.samplesOffset)
             {
                 throw Core::Error(
                     WAV::staticName,
                     IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
             }
 
-            AudioInfo info;
-            info.channels    = _ioInfo.audio.channels;
-            info.type        = _ioInfo.audio.type;
-            info.sampleRate  = _ioInfo.audio.sampleRate;
-            info.sampleCount = !ioInfo.samplesSize ? _ioInfo.audio.sampleCount : ioInfo.samplesSize;
-            data.set(info);
+            // Return a window of the memory-mapped file.
+            if (_samples)
+            {
+                data.set(info, _samples + ioInfo.samplesOffset * Audio::byteCount(info.type), _fileIO);
+                return;
+            }
+
+            // Sequential reads continue from the current position.
+            if (ioInfo.samplesOffset != _samplesPos)
+            {
+                //DJV_DEBUG_PRINT("seek");
+                if (!drwav_seek_to_sample(_drwav, ioInfo.samplesOffset))
+                {
+                    _samplesPos = static_cast<uint64_t>(-1);
+                    throw Core::Error(
+                        WAV::staticName,
+                        IOPlugin::errorLabels()[IOPlugin::ERROR_READ]);
+                }
+                _samplesPos = ioInfo.samplesOffset;
+            }
 
+            data.set(info);
             drwav_uint64 read = 0;
             switch (info.type)
             {
+            case Audio::U8:  read = drwav_read(_drwav, info.sampleCount, data.data()); break;
             case Audio::S16: read = drwav_read_s16(_drwav, info.sampleCount, reinterpret_cast<drwav_int16 *>(data.data())); break;
+            case Audio::S32: read = drwav_read_s32(_drwav, info.sampleCount, reinterpret_cast<drwav_int32 *>(data.data())); break;
+            case Audio::F32: read = drwav_read_f32(_drwav, info.sampleCount, reinterpret_cast<float *>(data.data())); break;
             default: break;
             }
+            _samplesPos += read;
             if (read != info.sampleCount)
             {
                 throw Core::Error(
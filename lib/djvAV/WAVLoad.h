@@ -32,12 +32,22 @@
 #include <djvAV/WAV.h>
 #include <djvAV/IO.h>
 
+#include <djvCore/FileIO.h>
+
 #include <dr_libs/dr_wav.h>
 
+#include <memory>
+
 namespace djv
 {
     namespace AV
     {
+        //! This class provides a WAV loader.
+        //!
+        //! When the samples are stored in the file in the same format as the
+        //! audio data, the file is memory-mapped and reads return windows of the
+        //! file without copying. Otherwise samples are decoded, and reads that
+        //! continue from the end of the previous read do not seek.
         class WAVLoad : public Load
         {
         public:
@@ -47,7 +57,10 @@ namespace djv
             void read(AudioData &, const AudioIOInfo & = AudioIOInfo()) override;
 
         private:
-            drwav * _drwav = nullptr;
+            drwav *                       _drwav = nullptr;
+            uint64_t                      _samplesPos = 0;
+            std::shared_ptr<Core::FileIO> _fileIO;
+            const uint8_t *               _samples = nullptr;
         };
 
     } // namespace AV
@@ -39,6 +39,7 @@
 #include <djvCore/Sequence.h>
 #include <djvCore/System.h>
 #include <djvCore/Time.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QDir>
@@ -105,6 +106,7 @@ namespace djv
             
             context = this;
             qInstallMessageHandler(qtMessageOutput);
+            DJV_TRACE_THREAD("Main");
             initResources();
             
             qRegisterMetaType<FileInfo>("djv::Core::FileInfo");
@@ -124,6 +126,20 @@ namespace djv
         CoreContext::~CoreContext()
         {
             //DJV_DEBUG("CoreContext::~CoreContext");    
+#if defined(DJV_TRACE)
+            const QString traceFile = System::env("DJV_TRACE_FILE");
+            if (!traceFile.isEmpty())
+            {
+                try
+                {
+                    Trace::write(traceFile);
+                }
+                catch (const Error & error)
+                {
+                    printError(error);
+                }
+            }
+#endif // DJV_TRACE
         }
 
         namespace
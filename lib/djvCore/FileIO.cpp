@@ -54,15 +54,21 @@
 #endif // DJV_MMAP
 #if defined(DJV_WINDOWS)
 #include <io.h>
+#include <malloc.h>
 #else // DJV_WINDOWS
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 #endif // DJV_WINDOWS
 
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <vector>
 
 namespace djv
 {
@@ -93,15 +99,158 @@ namespace djv
             const quint8 *  mmapStart = nullptr;
             const quint8 *  mmapEnd = nullptr;
             const quint8 *  mmapP = nullptr;
+            std::vector<quint8> buffer;
+            quint64         bufferSize = 0;
+            FileIO::READ_MODE readMode = FileIO::READ_AUTO;
+            quint64         blockSize = 0;
+            bool            directIO = false;
+            quint8 *        direct = nullptr;
+
+            quint8 * reserve(quint64);
+            void readBlocks();
         };
 
+        namespace
+        {
+            //! The size of the buffer used to collect writes.
+            const quint64 bufferByteCount = 1024 * 1024;
+
+            //! The alignment of the memory, file offsets, and sizes used for
+            //! direct I/O.
+            const quint64 directAlignment = 4096;
+
+            //! The defaults are set from the preferences on the main thread
+            //! and read by files opened on any thread.
+            std::atomic<FileIO::READ_MODE> _defaultReadMode(FileIO::READ_MEMORY_MAP);
+            std::atomic<quint64>           _defaultBlockSize(8 * 1024 * 1024);
+
+            quint8 * alignedAlloc(quint64 size)
+            {
+#if defined(DJV_WINDOWS)
+                return reinterpret_cast<quint8 *>(_aligned_malloc(size, directAlignment));
+#else // DJV_WINDOWS
+                void * out = nullptr;
+                return 0 == posix_memalign(&out, directAlignment, size) ? reinterpret_cast<quint8 *>(out) : nullptr;
+#endif // DJV_WINDOWS
+            }
+
+            void alignedFree(quint8 * in)
+            {
+#if defined(DJV_WINDOWS)
+                _aligned_free(in);
+#else // DJV_WINDOWS
+                free(in);
+#endif // DJV_WINDOWS
+            }
+
+        } // namespace
+
+        quint8 * FileIO::Private::reserve(quint64 size)
+        {
+            // The buffer grows as needed since many files only write a small
+            // header before a large block of data.
+            if (bufferSize + size > buffer.size())
+            {
+                quint64 tmp = Math::max<quint64>(buffer.size() * 2, 4096);
+                while (tmp < bufferSize + size)
+                {
+                    tmp *= 2;
+                }
+                buffer.resize(Math::min(tmp, bufferByteCount));
+            }
+            return buffer.data() + bufferSize;
+        }
+
+        void FileIO::Private::readBlocks()
+        {
+            //DJV_DEBUG("FileIO::Private::readBlocks");
+            //DJV_DEBUG_PRINT("direct I/O = " << directIO);
+            //DJV_DEBUG_PRINT("block size = " << blockSize);
+
+            // Direct I/O reads whole aligned blocks, so the buffer is rounded
+            // up to the alignment.
+            const quint64 alignedSize = (size + directAlignment - 1) / directAlignment * directAlignment;
+            direct = alignedAlloc(alignedSize);
+            if (!direct)
+            {
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_READ].
+                    arg(QDir::toNativeSeparators(fileName)));
+            }
+            const quint64 block = Math::max(blockSize / directAlignment * directAlignment, directAlignment);
+            quint64 pos = 0;
+            while (pos < size)
+            {
+                const quint64 count = Math::min(block, alignedSize - pos);
+#if defined(DJV_WINDOWS)
+                DWORD n = 0;
+                if (!::ReadFile(f, direct + pos, static_cast<DWORD>(count), &n, 0) || !n)
+                {
+                    break;
+                }
+#else // DJV_WINDOWS
+                const ssize_t n = ::read(f, direct + pos, count);
+                if (-1 == n && EINTR == errno)
+                {
+                    continue;
+                }
+#if defined(DJV_LINUX)
+                if (-1 == n && EINVAL == errno && directIO)
+                {
+                    // Some file systems accept direct I/O when the file is
+                    // opened but not when it is read, in which case the rest
+                    // of the file is read through the system cache. The file
+                    // position is unchanged by the failed read.
+                    const int flags = ::fcntl(f, F_GETFL);
+                    if (flags != -1 && ::fcntl(f, F_SETFL, flags & ~O_DIRECT) != -1)
+                    {
+                        directIO = false;
+                        continue;
+                    }
+                }
+#endif // DJV_LINUX
+                if (n <= 0)
+                {
+                    break;
+                }
+#endif // DJV_WINDOWS
+                pos += n;
+            }
+            if (pos < size)
+            {
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_READ].
+                    arg(QDir::toNativeSeparators(fileName)));
+            }
+#if defined(DJV_LINUX)
+            if (!directIO)
+            {
+                // Drop the file from the system cache since we have our own
+                // copy.
+                ::posix_fadvise(f, 0, size, POSIX_FADV_DONTNEED);
+            }
+#endif // DJV_LINUX
+            mmapStart = direct;
+            mmapEnd = mmapStart + size;
+            mmapP = mmapStart;
+        }
+
         FileIO::FileIO() :
             _p(new Private)
-        {}
+        {
+            _p->blockSize = _defaultBlockSize.load();
+        }
 
         FileIO::~FileIO()
         {
-            close();
+            try
+            {
+                close();
+            }
+            catch (const Error &)
+            {}
         }
 
         void FileIO::open(const QString & fileName, MODE mode)
@@ -112,18 +261,32 @@ namespace djv
 
             close();
 
-            // Open the file.
+            const READ_MODE readMode = READ_AUTO == _p->readMode ? _defaultReadMode.load() : _p->readMode;
+            const bool direct = READ == mode && READ_DIRECT == readMode;
+            //DJV_DEBUG_PRINT("direct = " << direct);
+
+            // Open the file. Direct I/O is not supported by every file system,
+            // in which case the file is read in blocks through the system cache.
 #if defined(DJV_WINDOWS)
-            _p->f = ::CreateFileW(
-                StringUtil::qToStdWString(fileName).data(),
-                (WRITE == mode) ? GENERIC_WRITE : GENERIC_READ,
-                (WRITE == mode) ? 0 : FILE_SHARE_READ,
-                0,
-                (WRITE == mode) ? CREATE_ALWAYS : OPEN_EXISTING,
-                //FILE_ATTRIBUTE_NORMAL,
-                //FILE_FLAG_NO_BUFFERING |
-                FILE_FLAG_SEQUENTIAL_SCAN,
-                0);
+            _p->directIO = direct;
+            for (int i = 0; i < 2; ++i)
+            {
+                _p->f = ::CreateFileW(
+                    StringUtil::qToStdWString(fileName).data(),
+                    (WRITE == mode) ? GENERIC_WRITE : GENERIC_READ,
+                    (WRITE == mode) ? 0 : FILE_SHARE_READ,
+                    0,
+                    (WRITE == mode) ? CREATE_ALWAYS : OPEN_EXISTING,
+                    //FILE_ATTRIBUTE_NORMAL,
+                    (_p->directIO ? FILE_FLAG_NO_BUFFERING : 0) |
+                    FILE_FLAG_SEQUENTIAL_SCAN,
+                    0);
+                if (INVALID_HANDLE_VALUE != _p->f || !_p->directIO)
+                {
+                    break;
+                }
+                _p->directIO = false;
+            }
             if (INVALID_HANDLE_VALUE == _p->f)
             {
                 throw Error(
@@ -133,8 +296,13 @@ namespace djv
             }
 #else // DJV_WINDOWS
             int readFlag = 0;
+            _p->directIO = false;
 #if defined(DJV_LINUX)
-            //readFlag = O_DIRECT;
+            if (direct)
+            {
+                readFlag = O_DIRECT;
+                _p->directIO = true;
+            }
 #endif // DJV_LINUX
             _p->f = ::open(
                 fileName.toUtf8().data(),
@@ -142,6 +310,11 @@ namespace djv
                 (O_WRONLY | O_CREAT | O_TRUNC) : (O_RDONLY | readFlag),
                 (WRITE == mode) ?
                 (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) : (0));
+            if (-1 == _p->f && _p->directIO && EINVAL == errno)
+            {
+                _p->f = ::open(fileName.toUtf8().data(), O_RDONLY);
+                _p->directIO = false;
+            }
             if (-1 == _p->f)
             {
                 throw Error(
@@ -167,7 +340,11 @@ namespace djv
 
             // Memory mapping.
 #if defined(DJV_MMAP)
-            if (READ == _p->mode && _p->size > 0)
+            if (direct && _p->size > 0)
+            {
+                _p->readBlocks();
+            }
+            else if (READ == _p->mode && _p->size > 0)
             {
                 //DJV_DEBUG_PRINT("mmap");
 #if defined(DJV_WINDOWS)
@@ -214,7 +391,28 @@ namespace djv
         {
             //DJV_DEBUG("FileIO::close");
 
+            // Write the buffered data, keeping the error until the file has
+            // been closed.
+            QString error;
+            if (_p->bufferSize)
+            {
+                try
+                {
+                    writeBuffer();
+                }
+                catch (const Error &)
+                {
+                    error = errorLabels()[ERROR_WRITE].arg(QDir::toNativeSeparators(_p->fileName));
+                }
+            }
+
 #if defined(DJV_MMAP)
+            if (_p->direct)
+            {
+                alignedFree(_p->direct);
+                _p->direct = nullptr;
+                _p->mmapStart = 0;
+            }
 #if defined(DJV_WINDOWS)
             if (_p->mmapStart != 0)
             {
@@ -234,7 +432,7 @@ namespace djv
             }
 #else // DJV_WINDOWS
             _p->mmapStart = 0;
-            if (_p->mmap != (void *)-1)
+            if (_p->mmap != nullptr && _p->mmap != (void *)-1)
             {
                 //DJV_DEBUG_PRINT("munmap");
                 int r = ::munmap(_p->mmap, _p->size);
@@ -272,6 +470,10 @@ namespace djv
             _p->pos = 0;
             _p->size = 0;
             _p->mode = static_cast<MODE>(0);
+            if (!error.isEmpty())
+            {
+                throw Error("djv::Core::FileIO", error);
+            }
         }
 
         const QString & FileIO::fileName() const
@@ -354,43 +556,52 @@ namespace djv
             //DJV_DEBUG_PRINT("word size = " << wordSize);
             //DJV_DEBUG_PRINT("endian = " << _p->endian);
 
-            quint8 * p = (quint8 *)in;
-            std::vector<quint8> tmp;
             if (_p->endian && wordSize > 1)
             {
-                tmp.resize(size * wordSize);
-                p = tmp.data();
-                Memory::convertEndian(in, p, size, wordSize);
-            }
-
-#if defined(DJV_WINDOWS)
-            DWORD n;
-            if (!::WriteFile(_p->f, p, static_cast<DWORD>(size * wordSize), &n, 0))
-            {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_WRITE].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
+                // Convert the endian directly into the write buffer instead of
+                // a copy of all the data.
+                const quint8 * p = reinterpret_cast<const quint8 *>(in);
+                for (quint64 i = 0; i < size;)
+                {
+                    const quint64 count = Math::min(size - i, (bufferByteCount - _p->bufferSize) / wordSize);
+                    if (!count)
+                    {
+                        writeBuffer();
+                        continue;
+                    }
+                    Memory::convertEndian(p + i * wordSize, _p->reserve(count * wordSize), count, wordSize);
+                    _p->bufferSize += count * wordSize;
+                    _p->pos += count * wordSize;
+                    i += count;
+                }
             }
-#else
-            if (::write(_p->f, p, size * wordSize) == -1)
+            else
             {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_WRITE].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
+                write(in, size * wordSize);
             }
-#endif
 
-            _p->pos += size * wordSize;
             _p->size = Math::max(_p->pos, _p->size);
         }
 
+        void FileIO::preallocate(quint64 size)
+        {
+#if defined(DJV_LINUX)
+            // The size of the file is not changed, and errors are ignored
+            // since not every file system supports this.
+            ::fallocate(_p->f, FALLOC_FL_KEEP_SIZE, 0, size);
+#else // DJV_LINUX
+            Q_UNUSED(size);
+#endif // DJV_LINUX
+        }
+
         void FileIO::readAhead()
         {
 #if defined(DJV_MMAP)
 #if defined(DJV_LINUX)
-            ::madvise((void *)_p->mmapStart, _p->size, MADV_WILLNEED);
+            if (!_p->direct)
+            {
+                ::madvise((void *)_p->mmapStart, _p->size, MADV_WILLNEED);
+            }
 #endif // DJV_LINUX
 #else // DJV_MMAP
 #if defined(DJV_LINUX)
@@ -455,6 +666,102 @@ namespace djv
             _p->endian = in;
         }
 
+        void FileIO::write(const void * in, quint64 size)
+        {
+            // Collect small writes in the buffer; large writes go directly to
+            // the file along with the buffered data.
+            if (size >= bufferByteCount)
+            {
+                const quint64 bufferSize = _p->bufferSize;
+                _p->bufferSize = 0;
+                writeFile(_p->buffer.data(), bufferSize, in, size);
+            }
+            else
+            {
+                if (_p->bufferSize + size > bufferByteCount)
+                {
+                    writeBuffer();
+                }
+                memcpy(_p->reserve(size), in, size);
+                _p->bufferSize += size;
+            }
+            _p->pos += size;
+        }
+
+        void FileIO::writeBuffer()
+        {
+            // Clear the buffer first so that data is not written again after
+            // an error.
+            const quint64 size = _p->bufferSize;
+            _p->bufferSize = 0;
+            if (size)
+            {
+                writeFile(_p->buffer.data(), size);
+            }
+        }
+
+        void FileIO::writeFile(const void * in, quint64 size, const void * in2, quint64 size2)
+        {
+#if defined(DJV_WINDOWS)
+            const quint8 * data[] = { reinterpret_cast<const quint8 *>(in), reinterpret_cast<const quint8 *>(in2) };
+            quint64 sizes[] = { size, size2 };
+            for (int i = 0; i < 2; ++i)
+            {
+                while (sizes[i])
+                {
+                    DWORD n = 0;
+                    if (!::WriteFile(_p->f, data[i], static_cast<DWORD>(Math::min<quint64>(sizes[i], 0x40000000)), &n, 0) || !n)
+                    {
+                        throw Error(
+                            "djv::Core::FileIO",
+                            errorLabels()[ERROR_WRITE].
+                            arg(QDir::toNativeSeparators(_p->fileName)));
+                    }
+                    data[i] += n;
+                    sizes[i] -= n;
+                }
+            }
+#else // DJV_WINDOWS
+            struct iovec iov[2];
+            iov[0].iov_base = const_cast<void *>(in);
+            iov[0].iov_len = size;
+            iov[1].iov_base = const_cast<void *>(in2);
+            iov[1].iov_len = size2;
+            int i = 0;
+            while (i < 2 && !iov[i].iov_len)
+            {
+                ++i;
+            }
+            while (i < 2)
+            {
+                ssize_t n = ::writev(_p->f, iov + i, 2 - i);
+                if (-1 == n && EINTR == errno)
+                {
+                    continue;
+                }
+                if (n <= 0)
+                {
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_WRITE].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
+
+                // Skip past the data that was written.
+                while (i < 2 && static_cast<size_t>(n) >= iov[i].iov_len)
+                {
+                    n -= iov[i].iov_len;
+                    ++i;
+                }
+                if (i < 2)
+                {
+                    iov[i].iov_base = reinterpret_cast<quint8 *>(iov[i].iov_base) + n;
+                    iov[i].iov_len -= n;
+                }
+            }
+#endif // DJV_WINDOWS
+        }
+
         void FileIO::setPos(quint64 in, bool seek)
         {
             //DJV_DEBUG("FileIO::setPos");
@@ -486,6 +793,7 @@ namespace djv
 #endif
             case WRITE:
             {
+                writeBuffer();
 #if defined(DJV_WINDOWS)
                 if (!::SetFilePointer(
                     _p->f,
@@ -520,6 +828,56 @@ namespace djv
             }
         }
 
+        const QStringList & FileIO::readModeLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Core::FileIO", "Auto") <<
+                qApp->translate("djv::Core::FileIO", "Memory Map") <<
+                qApp->translate("djv::Core::FileIO", "Direct");
+            DJV_ASSERT(READ_MODE_COUNT == data.count());
+            return data;
+        }
+
+        FileIO::READ_MODE FileIO::readMode() const
+        {
+            return _p->readMode;
+        }
+
+        void FileIO::setReadMode(READ_MODE in)
+        {
+            _p->readMode = in;
+        }
+
+        quint64 FileIO::blockSize() const
+        {
+            return _p->blockSize;
+        }
+
+        void FileIO::setBlockSize(quint64 in)
+        {
+            _p->blockSize = in;
+        }
+
+        FileIO::READ_MODE FileIO::defaultReadMode()
+        {
+            return _defaultReadMode.load();
+        }
+
+        void FileIO::setDefaultReadMode(READ_MODE in)
+        {
+            _defaultReadMode.store(READ_AUTO == in ? READ_MEMORY_MAP : in);
+        }
+
+        quint64 FileIO::defaultBlockSize()
+        {
+            return _defaultBlockSize.load();
+        }
+
+        void FileIO::setDefaultBlockSize(quint64 in)
+        {
+            _defaultBlockSize.store(in);
+        }
+
         const QStringList & FileIO::errorLabels()
         {
             static const QStringList data = QStringList() <<
@@ -538,4 +896,7 @@ namespace djv
         }
 
     } // namespace Core
+
+    _DJV_STRING_OPERATOR_LABEL(Core::FileIO::READ_MODE, Core::FileIO::readModeLabels());
+
 } // namespace djv
@@ -42,6 +42,10 @@ namespace djv
     namespace Core
     {
         //! This class provides file I/O.
+        //!
+        //! Small writes are collected in a buffer and written to the file in
+        //! large blocks; the buffer is written when the position is changed
+        //! and when the file is closed.
         class FileIO
         {
             Q_GADGET
@@ -58,13 +62,31 @@ namespace djv
             };
             Q_ENUM(MODE);
 
+            //! This enumeration provides the read modes.
+            enum READ_MODE
+            {
+                READ_AUTO,       //!< Use the default read mode
+                READ_MEMORY_MAP, //!< Memory-map the file
+                READ_DIRECT,     //!< Read the file in large blocks
+
+                READ_MODE_COUNT
+            };
+            Q_ENUM(READ_MODE);
+
+            //! Get the read mode labels.
+            static const QStringList & readModeLabels();
+
             //! Open a file.
             //!
             //! Throws:
             //! - Error
             void open(const QString & fileName, MODE);
 
-            //! Close the file.
+            //! Close the file. Call this explicitly after writing to get
+            //! errors writing the buffered data; the destructor ignores them.
+            //!
+            //! Throws:
+            //! - Error
             void close();
 
             //! Get the file name.
@@ -110,6 +132,11 @@ namespace djv
             inline void setF32(const float &);
             inline void set(const std::string &);
 
+            //! Reserve space for the file that is being written, so that it is
+            //! allocated contiguously. This is only a hint and does nothing if
+            //! the file system does not support it.
+            void preallocate(quint64);
+
             //! Start an asynchronous read-ahead. This allows the operating system to
             //! cache the file by the time we need it.
             void readAhead();
@@ -143,6 +170,36 @@ namespace djv
             //! functions.
             void setEndian(bool);
 
+            //! Get the read mode.
+            READ_MODE readMode() const;
+
+            //! Set the read mode. This takes effect the next time a file is
+            //! opened for reading.
+            //!
+            //! The direct read mode reads the whole file into memory with a few
+            //! large reads when it is opened, and the memory-map functions then
+            //! refer to that memory. This avoids filling the system cache when
+            //! streaming large files that are only read once.
+            void setReadMode(READ_MODE);
+
+            //! Get the block size used by the direct read mode.
+            quint64 blockSize() const;
+
+            //! Set the block size used by the direct read mode.
+            void setBlockSize(quint64);
+
+            //! Get the read mode used by READ_AUTO.
+            static READ_MODE defaultReadMode();
+
+            //! Set the read mode used by READ_AUTO.
+            static void setDefaultReadMode(READ_MODE);
+
+            //! Get the block size given to new objects.
+            static quint64 defaultBlockSize();
+
+            //! Set the block size given to new objects.
+            static void setDefaultBlockSize(quint64);
+
             //! This enumeration provides error codes.
             enum ERROR
             {
@@ -165,6 +222,9 @@ namespace djv
 
         private:
             void setPos(quint64, bool seek);
+            void write(const void *, quint64);
+            void writeBuffer();
+            void writeFile(const void *, quint64, const void * = nullptr, quint64 = 0);
 
             DJV_PRIVATE_COPY(FileIO);
 
@@ -173,6 +233,9 @@ namespace djv
         };
 
     } // namespace Core
+
+    DJV_STRING_OPERATOR(Core::FileIO::READ_MODE);
+
 } // namespace djv
 
 #include <djvCore/FileIOInline.h>
@@ -0,0 +1,211 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCore/FrameStats.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Math.h>
+#include <djvCore/PicoJSON.h>
+#include <djvCore/ThreadRing.h>
+#include <djvCore/Time.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        const int FrameStats::ringSize = 4096;
+
+        namespace
+        {
+            typedef ThreadRing<FrameStats::Sample, FrameStats::ringSize> Rings;
+
+            struct CurrentFrame
+            {
+                bool   valid = false;
+                qint64 frame = 0;
+            };
+            thread_local CurrentFrame currentFrame;
+
+        } // namespace
+
+        FrameStats::~FrameStats()
+        {}
+
+        const QStringList & FrameStats::stageLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Core::FrameStats", "Read") <<
+                qApp->translate("djv::Core::FrameStats", "Convert") <<
+                qApp->translate("djv::Core::FrameStats", "Cache") <<
+                qApp->translate("djv::Core::FrameStats", "Upload") <<
+                qApp->translate("djv::Core::FrameStats", "Draw");
+            DJV_ASSERT(data.count() == STAGE_COUNT);
+            return data;
+        }
+
+        void FrameStats::add(STAGE stage, qint64 frame, qint64 start, qint64 duration)
+        {
+            Sample sample;
+            sample.frame    = frame;
+            sample.stage    = stage;
+            sample.start    = start;
+            sample.duration = duration;
+            Rings::add(sample);
+        }
+
+        QVector<FrameStats::Sample> FrameStats::samples()
+        {
+            QVector<Sample> out;
+            for (const auto & item : Rings::items())
+            {
+                out.append(item.value);
+            }
+            std::stable_sort(out.begin(), out.end(), [](const Sample & a, const Sample & b)
+            {
+                return a.start < b.start;
+            });
+            return out;
+        }
+
+        float FrameStats::percentile(
+            const QVector<Sample> & samples,
+            STAGE                   stage,
+            float                   percent,
+            int                     count)
+        {
+            std::vector<qint64> durations;
+            for (int i = samples.count() - 1; i >= 0 && static_cast<int>(durations.size()) < count; --i)
+            {
+                if (stage == samples[i].stage)
+                {
+                    durations.push_back(samples[i].duration);
+                }
+            }
+            if (durations.empty())
+            {
+                return 0.f;
+            }
+            std::sort(durations.begin(), durations.end());
+            const int size = static_cast<int>(durations.size());
+            const int index = Math::clamp(
+                Math::ceil(percent / 100.f * size) - 1,
+                0,
+                size - 1);
+            return durations[index] / 1000000.f;
+        }
+
+        void FrameStats::clear()
+        {
+            Rings::clear();
+        }
+
+        void FrameStats::write(const QString & fileName, const QVector<Sample> & samples)
+        {
+            std::string data;
+            if (0 == FileInfo(fileName, false).extension().compare(".json", Qt::CaseInsensitive))
+            {
+                picojson::value array(picojson::array_type, true);
+                for (const auto & sample : samples)
+                {
+                    picojson::value value(picojson::object_type, true);
+                    auto & object = value.get<picojson::object>();
+                    object["frame"]    = picojson::value(static_cast<double>(sample.frame));
+                    object["stage"]    = picojson::value(stageLabels()[sample.stage].toStdString());
+                    object["start"]    = picojson::value(static_cast<double>(sample.start));
+                    object["duration"] = picojson::value(static_cast<double>(sample.duration));
+                    array.get<picojson::array>().push_back(value);
+                }
+                picojson::value value(picojson::object_type, true);
+                value.get<picojson::object>()["samples"] = array;
+                data = value.serialize(true);
+            }
+            else
+            {
+                std::stringstream s;
+                s << "frame,stage,start,duration\n";
+                for (const auto & sample : samples)
+                {
+                    s << sample.frame << "," <<
+                        stageLabels()[sample.stage].toStdString() << "," <<
+                        sample.start << "," <<
+                        sample.duration << "\n";
+                }
+                data = s.str();
+            }
+            FileIO io;
+            io.open(fileName, FileIO::WRITE);
+            io.set(data);
+            io.close();
+        }
+
+        FrameStats::Scope::Scope(STAGE stage, qint64 frame) :
+            _stage(stage),
+            _valid(true),
+            _frame(frame),
+            _prevValid(currentFrame.valid),
+            _prevFrame(currentFrame.frame),
+            _start(Time::monotonic())
+        {
+            currentFrame.valid = true;
+            currentFrame.frame = frame;
+        }
+
+        FrameStats::Scope::Scope(STAGE stage) :
+            _stage(stage),
+            _valid(currentFrame.valid),
+            _frame(currentFrame.frame),
+            _prevValid(currentFrame.valid),
+            _prevFrame(currentFrame.frame),
+            _start(_valid ? Time::monotonic() : 0)
+        {}
+
+        FrameStats::Scope::~Scope()
+        {
+            if (_valid)
+            {
+                add(_stage, _frame, _start, Time::monotonic() - _start);
+            }
+            currentFrame.valid = _prevValid;
+            currentFrame.frame = _prevFrame;
+        }
+
+    } // namespace Core
+
+    _DJV_STRING_OPERATOR_LABEL(Core::FrameStats::STAGE, Core::FrameStats::stageLabels())
+
+} // namespace djv
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvCore/StringUtil.h>
+
+#include <QMetaType>
+#include <QVector>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides per-frame timing statistics for the stages of
+        //! the image pipeline.
+        //!
+        //! Each thread records samples into its own fixed size ring buffer so
+        //! recording does not lock or allocate, and only the most recent
+        //! samples are kept. The samples of a thread are discarded when the
+        //! thread exits.
+        class FrameStats
+        {
+            Q_GADGET
+
+        public:
+            virtual ~FrameStats() = 0;
+
+            //! This enumeration provides the pipeline stages.
+            enum STAGE
+            {
+                READ,    //!< Read the image from disk
+                CONVERT, //!< Convert the image
+                CACHE,   //!< Add the image to the cache
+                UPLOAD,  //!< Upload the image to the GPU
+                DRAW,    //!< Draw the view
+
+                STAGE_COUNT
+            };
+            Q_ENUM(STAGE);
+
+            //! Get the stage labels.
+            static const QStringList & stageLabels();
+
+            //! This struct provides a timing sample.
+            struct Sample
+            {
+                qint64 frame    = 0;
+                STAGE  stage    = READ;
+                qint64 start    = 0; //!< Nanoseconds
+                qint64 duration = 0; //!< Nanoseconds
+            };
+
+            //! The number of samples kept for each thread.
+            static const int ringSize;
+
+            //! Add a sample for the current thread.
+            static void add(STAGE, qint64 frame, qint64 start, qint64 duration);
+
+            //! Get the samples from all threads sorted by start time.
+            static QVector<Sample> samples();
+
+            //! Get a percentile of the stage duration in milliseconds over the
+            //! given number of most recent samples.
+            static float percentile(
+                const QVector<Sample> &,
+                STAGE,
+                float percent,
+                int   count = 100);
+
+            //! Discard the samples recorded so far.
+            static void clear();
+
+            //! Write samples to a file. The file is written as JSON if the
+            //! extension is ".json" and CSV otherwise.
+            //!
+            //! Throws:
+            //! - Error
+            static void write(const QString & fileName, const QVector<Sample> &);
+
+            //! This class records the duration of a stage for the lifetime of
+            //! the object.
+            class Scope
+            {
+            public:
+                //! Record the stage for the given frame. The frame also becomes
+                //! the current frame of the thread for nested scopes.
+                Scope(STAGE, qint64 frame);
+
+                //! Record the stage for the current frame of the thread. Nothing
+                //! is recorded if there is no current frame.
+                explicit Scope(STAGE);
+
+                ~Scope();
+
+            private:
+                STAGE  _stage;
+                bool   _valid     = false;
+                qint64 _frame     = 0;
+                bool   _prevValid = false;
+                qint64 _prevFrame = 0;
+                qint64 _start     = 0;
+            };
+        };
+
+    } // namespace Core
+
+    DJV_STRING_OPERATOR(Core::FrameStats::STAGE);
+
+} // namespace djv
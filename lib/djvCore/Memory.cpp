@@ -35,6 +35,17 @@
 
 #include <string.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DJV_MEMORY_X86
+#define DJV_MEMORY_TARGET(TARGET) __attribute__((target(TARGET)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define DJV_MEMORY_X86
+#define DJV_MEMORY_TARGET(TARGET)
+#include <intrin.h>
+#include <immintrin.h>
+#endif // __GNUC__
+
 namespace djv
 {
     namespace Core
@@ -88,6 +99,204 @@ namespace djv
             return *p ? LSB : MSB;
         }
 
+        namespace
+        {
+            //! Swap words one at a time. The input and output may be the same.
+            template<typename T>
+            inline void swapScalar(const quint8 * in, quint8 * out, quint64 size)
+            {
+                for (quint64 i = 0; i < size; ++i, in += sizeof(T), out += sizeof(T))
+                {
+                    T word;
+                    memcpy(&word, in, sizeof(T));
+                    T tmp = 0;
+                    for (size_t j = 0; j < sizeof(T); ++j)
+                    {
+                        tmp = (tmp << 8) | (word & 0xff);
+                        word >>= 8;
+                    }
+                    memcpy(out, &tmp, sizeof(T));
+                }
+            }
+
+            void swapScalar(const quint8 * in, quint8 * out, quint64 size, int wordSize)
+            {
+                switch (wordSize)
+                {
+                case 2: swapScalar<quint16>(in, out, size); break;
+                case 4: swapScalar<quint32>(in, out, size); break;
+                case 8: swapScalar<quint64>(in, out, size); break;
+                default: break;
+                }
+            }
+
+#if defined(DJV_MEMORY_X86)
+            //! This enumeration provides the instruction sets used to swap words.
+            enum SIMD
+            {
+                SIMD_NONE,
+                SIMD_SSSE3,
+                SIMD_AVX2
+            };
+
+            SIMD simd()
+            {
+                static const SIMD out = []
+                {
+#if defined(_MSC_VER)
+                    int info[4];
+                    __cpuid(info, 0);
+                    const int count = info[0];
+                    __cpuid(info, 1);
+                    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+                    const bool osxsave = (info[2] & (1 << 27)) != 0;
+                    bool avx2 = false;
+                    if (count >= 7 && osxsave && (_xgetbv(0) & 6) == 6)
+                    {
+                        __cpuidex(info, 7, 0);
+                        avx2 = (info[1] & (1 << 5)) != 0;
+                    }
+#else // _MSC_VER
+                    __builtin_cpu_init();
+                    const bool ssse3 = __builtin_cpu_supports("ssse3");
+                    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+                    return avx2 ? SIMD_AVX2 : (ssse3 ? SIMD_SSSE3 : SIMD_NONE);
+                }();
+                return out;
+            }
+
+            //! Get the byte shuffle that swaps the words in 16 bytes.
+            const quint8 * shuffle(int wordSize)
+            {
+                static const quint8 data[][16] =
+                {
+                    { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+                    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+                    { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 }
+                };
+                return data[2 == wordSize ? 0 : (4 == wordSize ? 1 : 2)];
+            }
+
+            // The kernels return the number of bytes swapped, the remainder is
+            // left for the scalar code.
+
+            DJV_MEMORY_TARGET("ssse3")
+            quint64 swapSSSE3(const quint8 * in, quint8 * out, quint64 byteCount, int wordSize)
+            {
+                const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle(wordSize)));
+                quint64 i = 0;
+                for (; i + 64 <= byteCount; i += 64)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 16));
+                    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 32));
+                    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 48));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(a, mask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 16), _mm_shuffle_epi8(b, mask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 32), _mm_shuffle_epi8(c, mask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 48), _mm_shuffle_epi8(d, mask));
+                }
+                for (; i + 16 <= byteCount; i += 16)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(a, mask));
+                }
+                return i;
+            }
+
+            DJV_MEMORY_TARGET("avx2")
+            quint64 swapAVX2(const quint8 * in, quint8 * out, quint64 byteCount, int wordSize)
+            {
+                const __m256i mask = _mm256_broadcastsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle(wordSize))));
+                quint64 i = 0;
+                for (; i + 128 <= byteCount; i += 128)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 32));
+                    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 64));
+                    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 96));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(a, mask));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 32), _mm256_shuffle_epi8(b, mask));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 64), _mm256_shuffle_epi8(c, mask));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 96), _mm256_shuffle_epi8(d, mask));
+                }
+                for (; i + 32 <= byteCount; i += 32)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(a, mask));
+                }
+                return i;
+            }
+#endif // DJV_MEMORY_X86
+
+            void swap(const quint8 * in, quint8 * out, quint64 size, int wordSize)
+            {
+                quint64 i = 0;
+#if defined(DJV_MEMORY_X86)
+                // Small blocks, like header values, are not worth dispatching.
+                const quint64 byteCount = size * wordSize;
+                if (byteCount >= 32)
+                {
+                    switch (simd())
+                    {
+                    case SIMD_AVX2:  i = swapAVX2(in, out, byteCount, wordSize); break;
+                    case SIMD_SSSE3: i = swapSSSE3(in, out, byteCount, wordSize); break;
+                    default: break;
+                    }
+                }
+#endif // DJV_MEMORY_X86
+                swapScalar(in + i, out + i, size - i / wordSize, wordSize);
+            }
+
+        } // namespace
+
+        void Memory::convertEndian(
+            void *  in,
+            quint64 size,
+            int     wordSize)
+        {
+            switch (wordSize)
+            {
+            case 2:
+            case 4:
+            case 8:
+            {
+                quint8 * p = reinterpret_cast<quint8 *>(in);
+                swap(p, p, size, wordSize);
+                break;
+            }
+            default: break;
+            }
+        }
+
+        void Memory::convertEndian(
+            const void * in,
+            void *       out,
+            quint64      size,
+            int          wordSize)
+        {
+            switch (wordSize)
+            {
+            case 2:
+            case 4:
+            case 8:
+                swap(
+                    reinterpret_cast<const quint8 *>(in),
+                    reinterpret_cast<quint8 *>(out),
+                    size,
+                    wordSize);
+                break;
+            default:
+                if (in != out)
+                {
+                    memcpy(out, in, size * wordSize);
+                }
+                break;
+            }
+        }
+
     } // namespace Core
 
     _DJV_STRING_OPERATOR_LABEL(Core::Memory::ENDIAN, Core::Memory::endianLabels())
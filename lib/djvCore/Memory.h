@@ -75,14 +75,17 @@ namespace djv
             //! Get the opposite of the given endian.
             static constexpr ENDIAN endianOpposite(ENDIAN);
 
-            //! Convert the endian of a block of memory in place.
-            static inline void convertEndian(
+            //! Convert the endian of a block of memory in place. The size is
+            //! given in words, and word sizes of 2, 4, and 8 bytes are swapped.
+            static void convertEndian(
                 void *  in,
                 quint64 size,
                 int     wordSize);
 
-            //! Convert the endian of a block of memory.
-            static inline void convertEndian(
+            //! Convert the endian of a block of memory while copying it. Other
+            //! word sizes are copied unchanged. The input and output may be the
+            //! same but must not otherwise overlap.
+            static void convertEndian(
                 const void * in,
                 void *       out,
                 quint64      size,
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCore/MemoryInfo.h>
+
+#include <djvCore/Memory.h>
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#if defined(DJV_WINDOWS)
+#include <windows.h>
+#elif defined(DJV_OSX)
+#include <mach/mach.h>
+#include <sys/sysctl.h>
+#endif // DJV_WINDOWS
+
+#include <algorithm>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            // cgroup v1 reports no limit as a value close to the largest signed
+            // 64-bit integer.
+            const quint64 cgroupUnlimited = static_cast<quint64>(1) << 60;
+
+            QByteArray readFile(const QString & fileName)
+            {
+                QFile file(fileName);
+                return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+            }
+
+            //! Get a value from lines of "key value" pairs.
+            quint64 keyValue(const QByteArray & in, const QByteArray & key)
+            {
+                Q_FOREACH(const QByteArray & line, in.split('\n'))
+                {
+                    const QList<QByteArray> pieces = line.simplified().split(' ');
+                    if (2 == pieces.count() && key == pieces[0])
+                    {
+                        return pieces[1].toULongLong();
+                    }
+                }
+                return 0;
+            }
+
+#if defined(DJV_LINUX)
+            //! Read the limit and usage of a cgroup. The parent cgroups are
+            //! searched as well, and the smallest limit is used.
+            void readCGroup(
+                const QString &    base,
+                QString            path,
+                const QString &    limitFile,
+                const QString &    usageFile,
+                const QByteArray & inactiveKey,
+                MemoryInfo &       out)
+            {
+                while (1)
+                {
+                    const QString dir = base + path;
+                    const quint64 limit = MemoryInfo::parseCGroupValue(readFile(dir + "/" + limitFile));
+                    if (limit && (!out.limit || limit < out.limit))
+                    {
+                        // Do not count the file cache that can be reclaimed.
+                        const quint64 usage = MemoryInfo::parseCGroupValue(readFile(dir + "/" + usageFile));
+                        const quint64 inactive = keyValue(readFile(dir + "/memory.stat"), inactiveKey);
+                        out.limit = limit;
+                        out.usage = usage > inactive ? usage - inactive : 0;
+                    }
+                    if (path.isEmpty() || "/" == path)
+                        break;
+                    path = path.left(std::max(path.lastIndexOf('/'), 1));
+                }
+            }
+#endif // DJV_LINUX
+
+        } // namespace
+
+        quint64 MemoryInfo::processAvailable() const
+        {
+            quint64 out = available;
+            if (limit)
+            {
+                const quint64 room = limit > usage ? limit - usage : 0;
+                out = out ? std::min(out, room) : room;
+            }
+            return out;
+        }
+
+        quint64 MemoryInfo::processTotal() const
+        {
+            return limit && (!total || limit < total) ? limit : total;
+        }
+
+        MemoryInfo MemoryInfo::current()
+        {
+            MemoryInfo out;
+#if defined(DJV_LINUX)
+            parseMemInfo(readFile("/proc/meminfo"), out);
+            QString v2Path;
+            QString v1Path;
+            parseCGroup(readFile("/proc/self/cgroup"), v2Path, v1Path);
+            if (!v2Path.isEmpty())
+            {
+                readCGroup("/sys/fs/cgroup", v2Path, "memory.max", "memory.current", "inactive_file", out);
+            }
+            if (!out.limit && !v1Path.isEmpty())
+            {
+                readCGroup(
+                    "/sys/fs/cgroup/memory",
+                    v1Path,
+                    "memory.limit_in_bytes",
+                    "memory.usage_in_bytes",
+                    "total_inactive_file",
+                    out);
+            }
+            out.pressure = parsePressure(readFile("/proc/pressure/memory"));
+#elif defined(DJV_WINDOWS)
+            MEMORYSTATUSEX status;
+            status.dwLength = sizeof(status);
+            if (::GlobalMemoryStatusEx(&status))
+            {
+                out.total = status.ullTotalPhys;
+                out.available = status.ullAvailPhys;
+            }
+#elif defined(DJV_OSX)
+            int mib[2] = { CTL_HW, HW_MEMSIZE };
+            uint64_t memSize = 0;
+            size_t length = sizeof(memSize);
+            if (0 == ::sysctl(mib, 2, &memSize, &length, nullptr, 0))
+            {
+                out.total = memSize;
+            }
+            vm_statistics64_data_t vm;
+            mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+            if (KERN_SUCCESS == ::host_statistics64(
+                ::mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&vm), &count))
+            {
+                out.available = (static_cast<quint64>(vm.free_count) + vm.inactive_count) * vm_page_size;
+            }
+#endif // DJV_LINUX
+            return out;
+        }
+
+        void MemoryInfo::parseMemInfo(const QByteArray & in, MemoryInfo & out)
+        {
+            // The values are given in kilobytes.
+            const QByteArray data = QByteArray(in).replace(':', ' ').replace(" kB", "");
+            out.total = keyValue(data, "MemTotal") * Memory::kilobyte;
+            out.available = keyValue(data, "MemAvailable") * Memory::kilobyte;
+            if (!out.available)
+            {
+                // Kernels older than 3.14 do not provide an estimate.
+                out.available = (
+                    keyValue(data, "MemFree") +
+                    keyValue(data, "Buffers") +
+                    keyValue(data, "Cached")) * Memory::kilobyte;
+            }
+        }
+
+        void MemoryInfo::parseCGroup(const QByteArray & in, QString & v2Path, QString & v1Path)
+        {
+            v2Path.clear();
+            v1Path.clear();
+            Q_FOREACH(const QByteArray & line, in.split('\n'))
+            {
+                // Each line has the form "hierarchy:controllers:path".
+                const int a = line.indexOf(':');
+                const int b = a != -1 ? line.indexOf(':', a + 1) : -1;
+                if (-1 == b)
+                    continue;
+                const QByteArray hierarchy = line.left(a);
+                const QByteArray controllers = line.mid(a + 1, b - a - 1);
+                const QString path = QString::fromUtf8(line.mid(b + 1).trimmed());
+                if ("0" == hierarchy && controllers.isEmpty())
+                {
+                    v2Path = path;
+                }
+                else if (controllers.split(',').contains("memory"))
+                {
+                    v1Path = path;
+                }
+            }
+        }
+
+        quint64 MemoryInfo::parseCGroupValue(const QByteArray & in)
+        {
+            bool ok = false;
+            const quint64 out = in.trimmed().toULongLong(&ok);
+            return ok && out < cgroupUnlimited ? out : 0;
+        }
+
+        float MemoryInfo::parsePressure(const QByteArray & in)
+        {
+            Q_FOREACH(const QByteArray & line, in.split('\n'))
+            {
+                const QList<QByteArray> pieces = line.simplified().split(' ');
+                if (pieces.count() < 2 || pieces[0] != "some")
+                    continue;
+                Q_FOREACH(const QByteArray & piece, pieces)
+                {
+                    if (piece.startsWith("avg10="))
+                    {
+                        bool ok = false;
+                        const float out = piece.mid(6).toFloat(&ok);
+                        return ok ? out : -1.f;
+                    }
+                }
+            }
+            return -1.f;
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+class QByteArray;
+class QString;
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides information about the memory available to the
+        //! process.
+        //!
+        //! On Linux the information comes from /proc/meminfo, the cgroup (v1 or
+        //! v2) memory controller of the process, and the memory pressure stall
+        //! information in /proc/pressure/memory.
+        class MemoryInfo
+        {
+        public:
+            //! The physical memory in bytes.
+            quint64 total = 0;
+
+            //! The memory that can be used without swapping in bytes.
+            quint64 available = 0;
+
+            //! The cgroup memory limit in bytes, or zero if there is no limit.
+            quint64 limit = 0;
+
+            //! The cgroup memory usage in bytes, not counting the file cache
+            //! that can be reclaimed.
+            quint64 usage = 0;
+
+            //! The percentage of time some tasks were stalled waiting for memory
+            //! over the last ten seconds, or -1 if it is not available.
+            float pressure = -1.f;
+
+            //! Get the memory available to the process in bytes. This is the
+            //! smaller of the available memory and the room left under the
+            //! cgroup limit, or zero if neither is known.
+            quint64 processAvailable() const;
+
+            //! Get the memory the process may use in bytes. This is the smaller
+            //! of the physical memory and the cgroup limit.
+            quint64 processTotal() const;
+
+            //! Get the current memory information.
+            static MemoryInfo current();
+
+            //! Parse the contents of /proc/meminfo.
+            static void parseMemInfo(const QByteArray &, MemoryInfo &);
+
+            //! Parse the contents of /proc/self/cgroup, returning the cgroup v2
+            //! path and the cgroup v1 memory controller path. A path is empty
+            //! if it is not found.
+            static void parseCGroup(const QByteArray &, QString & v2Path, QString & v1Path);
+
+            //! Parse a cgroup memory value. Values of "max" and the very large
+            //! values cgroup v1 uses for no limit return zero.
+            static quint64 parseCGroupValue(const QByteArray &);
+
+            //! Parse the contents of /proc/pressure/memory, returning the "some"
+            //! ten second average or -1 on error.
+            static float parsePressure(const QByteArray &);
+        };
+
+    } // namespace Core
+} // namespace djv
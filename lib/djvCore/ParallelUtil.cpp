@@ -0,0 +1,269 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/ParallelUtil.h>
+
+#include <djvCore/Trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            //! This struct provides the state for a call to forEach().
+            struct Job
+            {
+                Job(int count, const std::function<void(int)> & fnc) :
+                    count(count),
+                    fnc(fnc)
+                {}
+
+                const int                        count;
+                const std::function<void(int)> & fnc;
+                std::atomic<int>                 next{ 0 };
+                std::atomic<int>                 done{ 0 };
+                std::mutex                       mutex;
+                std::condition_variable          finished;
+                std::exception_ptr               exception;
+
+                //! Run indices until there are none left. Returns true if this
+                //! call completed the last index.
+                bool run()
+                {
+                    int i = 0;
+                    bool last = false;
+                    while ((i = next++) < count)
+                    {
+                        try
+                        {
+                            fnc(i);
+                        }
+                        catch (...)
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            if (!exception)
+                            {
+                                exception = std::current_exception();
+                            }
+                        }
+                        if (++done == count)
+                        {
+                            last = true;
+                        }
+                    }
+                    return last;
+                }
+            };
+
+            class Pool
+            {
+            public:
+                Pool()
+                {
+                    setThreadCount(0);
+                }
+
+                ~Pool()
+                {
+                    _stop();
+                }
+
+                int threadCount() const
+                {
+                    return static_cast<int>(_threads.size()) + 1;
+                }
+
+                void setThreadCount(int value)
+                {
+                    if (value <= 0)
+                    {
+                        value = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+                    }
+                    if (value == threadCount())
+                        return;
+                    _stop();
+                    _running = true;
+                    for (int i = 1; i < value; ++i)
+                    {
+                        _threads.push_back(std::thread(&Pool::_work, this));
+                    }
+                }
+
+                void add(const std::shared_ptr<Job> & job)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _jobs.push_back(job);
+                    }
+                    _cv.notify_all();
+                }
+
+                void remove(const std::shared_ptr<Job> & job)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    const auto i = std::find(_jobs.begin(), _jobs.end(), job);
+                    if (i != _jobs.end())
+                    {
+                        _jobs.erase(i);
+                    }
+                }
+
+            private:
+                void _work()
+                {
+                    DJV_TRACE_THREAD("ParallelUtil");
+                    while (true)
+                    {
+                        std::shared_ptr<Job> job;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _cv.wait(lock, [this] { return !_running || !_jobs.empty(); });
+                            if (!_running)
+                                break;
+                            job = _jobs.front();
+                            if (job->next >= job->count)
+                            {
+                                _jobs.pop_front();
+                                continue;
+                            }
+                        }
+                        DJV_TRACE_ZONE("djv::Core::ParallelUtil::job");
+                        if (job->run())
+                        {
+                            std::unique_lock<std::mutex> lock(job->mutex);
+                            job->finished.notify_all();
+                        }
+                    }
+                }
+
+                void _stop()
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _running = false;
+                    }
+                    _cv.notify_all();
+                    for (auto & thread : _threads)
+                    {
+                        thread.join();
+                    }
+                    _threads.clear();
+                }
+
+                std::vector<std::thread>          _threads;
+                std::mutex                        _mutex;
+                std::condition_variable           _cv;
+                std::deque<std::shared_ptr<Job> > _jobs;
+                bool                              _running = false;
+            };
+
+            std::mutex poolMutex;
+
+            Pool & pool()
+            {
+                static Pool data;
+                return data;
+            }
+
+        } // namespace
+
+        ParallelUtil::~ParallelUtil()
+        {}
+
+        int ParallelUtil::threadCount()
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            return pool().threadCount();
+        }
+
+        void ParallelUtil::setThreadCount(int value)
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            pool().setThreadCount(value);
+        }
+
+        void ParallelUtil::forEach(int count, const std::function<void(int)> & fnc)
+        {
+            if (count <= 0)
+                return;
+            if (1 == count || 1 == threadCount())
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    fnc(i);
+                }
+                return;
+            }
+            auto job = std::make_shared<Job>(count, fnc);
+            pool().add(job);
+            job->run();
+            {
+                std::unique_lock<std::mutex> lock(job->mutex);
+                job->finished.wait(lock, [job] { return job->done >= job->count; });
+            }
+            pool().remove(job);
+            if (job->exception)
+            {
+                std::rethrow_exception(job->exception);
+            }
+        }
+
+        void ParallelUtil::forBands(
+            int size,
+            int minSize,
+            const std::function<void(int start, int end)> & fnc)
+        {
+            if (size <= 0)
+                return;
+            const int bands = std::max(1, std::min(threadCount(), size / std::max(1, minSize)));
+            const int bandSize = (size + bands - 1) / bands;
+            forEach(bands, [size, bandSize, &fnc](int i)
+            {
+                const int start = i * bandSize;
+                const int end = std::min(size, start + bandSize);
+                if (start < end)
+                {
+                    fnc(start, end);
+                }
+            });
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides utilities for running work in parallel.
+        //!
+        //! The work is split across a shared pool of threads. The calling thread
+        //! also takes part in the work, so it is safe to call these functions from
+        //! within another parallel function.
+        class ParallelUtil
+        {
+        public:
+            virtual ~ParallelUtil() = 0;
+
+            //! Get the number of threads used for parallel work, including the
+            //! calling thread.
+            static int threadCount();
+
+            //! Set the number of threads used for parallel work. A value of zero
+            //! uses the number of processor cores.
+            static void setThreadCount(int);
+
+            //! Call a function for each index in the range [0, count). The calls
+            //! are distributed across the thread pool and this function returns
+            //! when they have all finished. The first exception thrown by the
+            //! function is re-thrown on the calling thread.
+            static void forEach(int count, const std::function<void(int)> &);
+
+            //! Split the range [0, size) into contiguous bands and call a function
+            //! with the start and end of each band. At most one band is created for
+            //! each thread and each band contains at least minSize elements.
+            static void forBands(
+                int size,
+                int minSize,
+                const std::function<void(int start, int end)> &);
+        };
+
+    } // namespace Core
+} // namespace djv
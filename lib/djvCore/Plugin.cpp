@@ -36,6 +36,7 @@
 #include <djvCore/Error.h>
 #include <djvCore/ErrorUtil.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QDir>
@@ -167,6 +168,7 @@ namespace djv
             //DJV_DEBUG_PRINT("plugin entry = " << pluginEntry);
             //DJV_DEBUG_PRINT("plugin prefix = " << pluginPrefix);
             //DJV_DEBUG_PRINT("plugin suffix = " << pluginSuffix);
+            DJV_TRACE_ZONE("djv::Core::PluginFactory");
 
             //! \todo Hard-coded OS specific shared library file extensions.
             QStringList glob;
@@ -209,6 +211,8 @@ namespace djv
             //DJV_DEBUG_PRINT("fileInfoList = " << fileInfoList.count());
             Q_FOREACH(const FileInfo & fileInfo, fileInfoList)
             {
+                DJV_TRACE_ZONE("djv::Core::PluginFactory::load");
+
                 // Open.
                 //DJV_DEBUG_PRINT("loading = " << fileInfo);
                 DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a set of fixed size ring buffers, one for each
+        //! thread, that keep the most recent values added by the thread.
+        //!
+        //! Adding a value does not lock or allocate once the ring of the thread
+        //! has been created. Values may be read from any thread. A ring is
+        //! released when its thread exits, along with its values.
+        //!
+        //! Each type and size is a separate set of rings, so it should only be
+        //! instantiated in a single library.
+        template<typename T, int Size>
+        class ThreadRing
+        {
+        public:
+            //! This struct provides a value and the thread that added it.
+            struct Item
+            {
+                int thread = 0;
+                T   value;
+            };
+
+            //! Add a value to the ring of the current thread.
+            static inline void add(const T &);
+
+            //! Get the ID of the current thread. IDs start at one and are not
+            //! reused.
+            static inline int thread();
+
+            //! Get the values from all threads, in the order they were added
+            //! for each thread.
+            static inline std::vector<Item> items();
+
+            //! Discard the values added so far.
+            static inline void clear();
+
+        private:
+            static const size_t wordCount = (sizeof(T) + sizeof(quint64) - 1) / sizeof(quint64);
+
+            //! The values are stored as atomic words so they can be copied
+            //! while the owning thread writes to them.
+            struct Entry
+            {
+                std::atomic<quint64> words[wordCount];
+            };
+
+            struct Ring
+            {
+                inline Ring(int thread);
+
+                std::unique_ptr<Entry[]> entries;
+                std::atomic<quint64>     head;
+                std::atomic<quint64>     cleared;
+                const int                thread;
+            };
+
+            static inline Ring * threadRing();
+            static inline std::mutex & mutex();
+            static inline std::vector<std::weak_ptr<Ring> > & rings();
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/ThreadRingInline.h>
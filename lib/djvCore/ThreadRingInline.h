@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <string.h>
+#include <type_traits>
+
+namespace djv
+{
+    namespace Core
+    {
+        template<typename T, int Size>
+        inline ThreadRing<T, Size>::Ring::Ring(int thread) :
+            entries(new Entry[Size]),
+            thread(thread)
+        {
+            head = 0;
+            cleared = 0;
+        }
+
+        template<typename T, int Size>
+        inline void ThreadRing<T, Size>::add(const T & value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "The value must be trivially copyable");
+            quint64 words[wordCount] = {};
+            memcpy(words, &value, sizeof(T));
+            Ring * ring = threadRing();
+            const quint64 head = ring->head.load(std::memory_order_relaxed);
+            Entry & entry = ring->entries[head % Size];
+
+            // A reader that sees any of the new words also sees the current
+            // head, so it knows the entry is being overwritten.
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < wordCount; ++i)
+            {
+                entry.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            ring->head.store(head + 1, std::memory_order_release);
+        }
+
+        template<typename T, int Size>
+        inline int ThreadRing<T, Size>::thread()
+        {
+            return threadRing()->thread;
+        }
+
+        template<typename T, int Size>
+        inline std::vector<typename ThreadRing<T, Size>::Item> ThreadRing<T, Size>::items()
+        {
+            std::vector<std::shared_ptr<Ring> > tmp;
+            {
+                std::lock_guard<std::mutex> lock(mutex());
+                for (const auto & i : rings())
+                {
+                    if (auto ring = i.lock())
+                    {
+                        tmp.push_back(ring);
+                    }
+                }
+            }
+            std::vector<Item> out;
+            for (const auto & ring : tmp)
+            {
+                const quint64 head = ring->head.load(std::memory_order_acquire);
+                const quint64 first = std::max(
+                    head > static_cast<quint64>(Size) ? head - Size : 0,
+                    ring->cleared.load());
+                std::vector<Item> ringItems(head > first ? head - first : 0);
+                for (quint64 i = first; i < head; ++i)
+                {
+                    const Entry & entry = ring->entries[i % Size];
+                    quint64 words[wordCount];
+                    for (size_t j = 0; j < wordCount; ++j)
+                    {
+                        words[j] = entry.words[j].load(std::memory_order_relaxed);
+                    }
+                    Item & item = ringItems[i - first];
+                    item.thread = ring->thread;
+                    memcpy(&item.value, words, sizeof(T));
+                }
+
+                // Drop the entries the owning thread may have overwritten while
+                // they were being copied: the slot it writes before moving the
+                // head, and the one after that in case the head has already
+                // moved on.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const quint64 head2 = ring->head.load(std::memory_order_relaxed);
+                for (quint64 i = first; i < head; ++i)
+                {
+                    if (i + Size > head2 + 1)
+                    {
+                        out.push_back(ringItems[i - first]);
+                    }
+                }
+            }
+            return out;
+        }
+
+        template<typename T, int Size>
+        inline void ThreadRing<T, Size>::clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            for (const auto & i : rings())
+            {
+                if (auto ring = i.lock())
+                {
+                    ring->cleared = ring->head.load();
+                }
+            }
+        }
+
+        template<typename T, int Size>
+        inline typename ThreadRing<T, Size>::Ring * ThreadRing<T, Size>::threadRing()
+        {
+            thread_local std::shared_ptr<Ring> ring;
+            if (!ring)
+            {
+                static std::atomic<int> threadCount(0);
+                ring.reset(new Ring(++threadCount));
+                std::lock_guard<std::mutex> lock(mutex());
+                auto & list = rings();
+                list.erase(
+                    std::remove_if(list.begin(), list.end(), [](const std::weak_ptr<Ring> & i)
+                    {
+                        return i.expired();
+                    }),
+                    list.end());
+                list.push_back(ring);
+            }
+            return ring.get();
+        }
+
+        template<typename T, int Size>
+        inline std::mutex & ThreadRing<T, Size>::mutex()
+        {
+            static std::mutex data;
+            return data;
+        }
+
+        template<typename T, int Size>
+        inline std::vector<std::weak_ptr<typename ThreadRing<T, Size>::Ring> > & ThreadRing<T, Size>::rings()
+        {
+            static std::vector<std::weak_ptr<Ring> > data;
+            return data;
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -43,6 +43,8 @@
 #include <float.h>
 #include <time.h>
 
+#include <chrono>
+
 namespace djv
 {
     namespace Core
@@ -55,6 +57,18 @@ namespace djv
             return ::time(0);
         }
 
+        qint64 Time::monotonic()
+        {
+#if defined(DJV_LINUX)
+            timespec t;
+            clock_gettime(CLOCK_MONOTONIC, &t);
+            return static_cast<qint64>(t.tv_sec) * 1000000000 + t.tv_nsec;
+#else // DJV_LINUX
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif // DJV_LINUX
+        }
+
         namespace
         {
             class Thread : public QThread
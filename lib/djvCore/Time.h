@@ -54,6 +54,11 @@ namespace djv
             //! Get the current time.
             static ::time_t current();
 
+            //! Get the time of the monotonic clock in nanoseconds. On Linux
+            //! this is CLOCK_MONOTONIC so that it can be used with
+            //! clock_nanosleep().
+            static qint64 monotonic();
+
             //! Sleep for the given number of seconds.
             static void sleep(unsigned long seconds);
 
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCore/Trace.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/PicoJSON.h>
+#include <djvCore/ThreadRing.h>
+#include <djvCore/Time.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        const int Trace::ringSize = 16384;
+
+        namespace
+        {
+            typedef ThreadRing<Trace::Event, Trace::ringSize> Rings;
+
+            std::mutex         namesMutex;
+            QMap<int, QString> threadNameMap;
+
+        } // namespace
+
+        Trace::~Trace()
+        {}
+
+        void Trace::setThreadName(const QString & name)
+        {
+            const int thread = Rings::thread();
+            std::lock_guard<std::mutex> lock(namesMutex);
+            threadNameMap[thread] = name;
+        }
+
+        QMap<int, QString> Trace::threadNames()
+        {
+            std::lock_guard<std::mutex> lock(namesMutex);
+            return threadNameMap;
+        }
+
+        void Trace::add(const char * name, qint64 start, qint64 duration)
+        {
+            Event event;
+            event.name     = name;
+            event.start    = start;
+            event.duration = duration;
+            Rings::add(event);
+        }
+
+        QVector<Trace::Event> Trace::events()
+        {
+            QVector<Event> out;
+            for (const auto & item : Rings::items())
+            {
+                Event event = item.value;
+                event.thread = item.thread;
+                out.append(event);
+            }
+            std::stable_sort(out.begin(), out.end(), [](const Event & a, const Event & b)
+            {
+                return a.start < b.start;
+            });
+            return out;
+        }
+
+        void Trace::clear()
+        {
+            Rings::clear();
+        }
+
+        void Trace::write(const QString & fileName)
+        {
+            const QVector<Event> events = Trace::events();
+            const double pid = static_cast<double>(QCoreApplication::applicationPid());
+            const qint64 start = events.count() ? events[0].start : 0;
+            picojson::value traceEvents(picojson::array_type, true);
+            const QMap<int, QString> names = threadNames();
+            for (auto i = names.begin(); i != names.end(); ++i)
+            {
+                if (!i.value().isEmpty())
+                {
+                    picojson::value args(picojson::object_type, true);
+                    args.get<picojson::object>()["name"] = picojson::value(i.value().toStdString());
+                    picojson::value value(picojson::object_type, true);
+                    auto & object = value.get<picojson::object>();
+                    object["name"] = picojson::value("thread_name");
+                    object["ph"]   = picojson::value("M");
+                    object["pid"]  = picojson::value(pid);
+                    object["tid"]  = picojson::value(static_cast<double>(i.key()));
+                    object["args"] = args;
+                    traceEvents.get<picojson::array>().push_back(value);
+                }
+            }
+            for (const auto & event : events)
+            {
+                picojson::value value(picojson::object_type, true);
+                auto & object = value.get<picojson::object>();
+                object["name"] = picojson::value(event.name ? event.name : "");
+                object["cat"]  = picojson::value("djv");
+                object["ph"]   = picojson::value("X");
+                object["ts"]   = picojson::value((event.start - start) / 1000.0);
+                object["dur"]  = picojson::value(event.duration / 1000.0);
+                object["pid"]  = picojson::value(pid);
+                object["tid"]  = picojson::value(static_cast<double>(event.thread));
+                traceEvents.get<picojson::array>().push_back(value);
+            }
+            picojson::value value(picojson::object_type, true);
+            value.get<picojson::object>()["traceEvents"] = traceEvents;
+            value.get<picojson::object>()["displayTimeUnit"] = picojson::value("ms");
+            FileIO io;
+            io.open(fileName, FileIO::WRITE);
+            io.set(value.serialize());
+            io.close();
+        }
+
+        Trace::Zone::Zone(const char * name) :
+            _name(name),
+            _start(Time::monotonic())
+        {}
+
+        Trace::Zone::~Zone()
+        {
+            add(_name, _start, Time::monotonic() - _start);
+        }
+
+    } // namespace Core
+} // namespace djv
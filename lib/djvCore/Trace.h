@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides scoped tracing zones that can be written out in
+        //! the Chrome trace event format and viewed with chrome://tracing or
+        //! Perfetto.
+        //!
+        //! Zones are added with the DJV_TRACE_ZONE() macro, which compiles to
+        //! nothing unless the DJV_TRACE CMake option is enabled. Each thread
+        //! records into its own fixed size ring buffer, so only the most recent
+        //! events are kept. The events of a thread are discarded when the
+        //! thread exits.
+        class Trace
+        {
+        public:
+            virtual ~Trace() = 0;
+
+            //! This struct provides a trace event.
+            struct Event
+            {
+                const char * name     = nullptr;
+                qint64       start    = 0; //!< Nanoseconds
+                qint64       duration = 0; //!< Nanoseconds
+                int          thread   = 0;
+            };
+
+            //! The number of events kept for each thread.
+            static const int ringSize;
+
+            //! Set the name of the current thread, shown as the track name.
+            static void setThreadName(const QString &);
+
+            //! Get the thread names.
+            static QMap<int, QString> threadNames();
+
+            //! Add an event for the current thread. The name must be a string
+            //! literal or otherwise outlive the trace.
+            static void add(const char * name, qint64 start, qint64 duration);
+
+            //! Get the events from all threads sorted by start time.
+            static QVector<Event> events();
+
+            //! Discard the events recorded so far.
+            static void clear();
+
+            //! Write the events to a Chrome trace JSON file.
+            //!
+            //! Throws:
+            //! - Error
+            static void write(const QString & fileName);
+
+            //! This class records a zone for the lifetime of the object.
+            class Zone
+            {
+            public:
+                explicit Zone(const char * name);
+                ~Zone();
+
+            private:
+                const char * _name;
+                qint64       _start;
+            };
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#if defined(DJV_TRACE)
+//! Record a tracing zone until the end of the current scope.
+#define DJV_TRACE_ZONE(NAME) \
+    djv::Core::Trace::Zone _traceZone(NAME)
+//! Set the name of the current thread.
+#define DJV_TRACE_THREAD(NAME) \
+    djv::Core::Trace::setThreadName(NAME)
+#else // DJV_TRACE
+#define DJV_TRACE_ZONE(NAME)
+#define DJV_TRACE_THREAD(NAME)
+#endif // DJV_TRACE
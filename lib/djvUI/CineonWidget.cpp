@@ -86,6 +86,11 @@ namespace djv
             _outputGammaWidget = new FloatEditSlider(context);
             _outputGammaWidget->setRange(.01f, 4.f);
 
+            _readModeWidget = new QComboBox;
+            _readModeWidget->addItems(Core::FileIO::readModeLabels());
+            _readModeWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -130,6 +135,19 @@ namespace djv
                 _outputGammaWidget);
             _layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::CineonWidget", "Read Mode"),
+                qApp->translate("djv::UI::CineonWidget",
+                    "Set how Cineon images are read. The \"Direct\" mode reads each image in "
+                    "large blocks without filling the system cache. Setting the mode to "
+                    "\"Auto\" will use the file preferences."),
+                context);
+            QFormLayout * formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::CineonWidget", "Read mode:"),
+                _readModeWidget);
+            _layout->addWidget(prefsGroupBox);
+
             _layout->addStretch();
 
             // Initialize.
@@ -162,6 +180,9 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[AV::Cineon::OUTPUT_FILM_PRINT_OPTION]);
             tmp >> _options.outputFilmPrint;
+            tmp = plugin->option(
+                plugin->options()[AV::Cineon::READ_MODE_OPTION]);
+            tmp >> _options.readMode;
             widgetUpdate();
 
             // Setup the callbacks.
@@ -205,6 +226,10 @@ namespace djv
                 _outputGammaWidget,
                 SIGNAL(valueChanged(float)),
                 SLOT(outputGammaCallback(float)));
+            connect(
+                _readModeWidget,
+                SIGNAL(activated(int)),
+                SLOT(readModeCallback(int)));
         }
 
         void CineonWidget::resetPreferences()
@@ -232,6 +257,9 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     AV::Cineon::OUTPUT_FILM_PRINT_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.outputFilmPrint;
+                else if (0 == option.compare(plugin()->options()[
+                    AV::Cineon::READ_MODE_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.readMode;
             }
             catch (const QString &)
             {
@@ -293,6 +321,12 @@ namespace djv
             pluginUpdate();
         }
 
+        void CineonWidget::readModeCallback(int in)
+        {
+            _options.readMode = static_cast<Core::FileIO::READ_MODE>(in);
+            pluginUpdate();
+        }
+
         void CineonWidget::pluginUpdate()
         {
             //DJV_DEBUG("CineonWidget::pluginUpdate");
@@ -309,6 +343,9 @@ namespace djv
             tmp << _options.outputFilmPrint;
             plugin()->setOption(
                 plugin()->options()[AV::Cineon::OUTPUT_FILM_PRINT_OPTION], tmp);
+            tmp << _options.readMode;
+            plugin()->setOption(
+                plugin()->options()[AV::Cineon::READ_MODE_OPTION], tmp);
         }
 
         void CineonWidget::widgetUpdate()
@@ -323,7 +360,8 @@ namespace djv
                 _outputColorProfileWidget <<
                 _outputBlackPointWidget <<
                 _outputWhitePointWidget <<
-                _outputGammaWidget);
+                _outputGammaWidget <<
+                _readModeWidget);
             _inputBlackPointWidget->setVisible(
                 AV::Cineon::COLOR_PROFILE_AUTO == _options.inputColorProfile ||
                 AV::Cineon::COLOR_PROFILE_FILM_PRINT == _options.inputColorProfile);
@@ -375,6 +413,7 @@ namespace djv
             _outputBlackPointWidget->setValue(_options.outputFilmPrint.black);
             _outputWhitePointWidget->setValue(_options.outputFilmPrint.white);
             _outputGammaWidget->setValue(_options.outputFilmPrint.gamma);
+            _readModeWidget->setCurrentIndex(_options.readMode);
         }
 
         CineonWidgetPlugin::CineonWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -100,6 +100,11 @@ namespace djv
             _endianWidget->setSizePolicy(
                 QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _readModeWidget = new QComboBox;
+            _readModeWidget->addItems(Core::FileIO::readModeLabels());
+            _readModeWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -176,6 +181,20 @@ namespace djv
                 _endianWidget);
             _layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::DPXWidget", "Read Mode"),
+                qApp->translate("djv::UI::DPXWidget",
+                    "Set how DPX images are read. The \"Direct\" mode reads each image in "
+                    "large blocks without filling the system cache, which is useful for "
+                    "streaming large sequences. Setting the mode to \"Auto\" will use the "
+                    "file preferences."),
+                context);
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::DPXWidget", "Read mode:"),
+                _readModeWidget);
+            _layout->addWidget(prefsGroupBox);
+
             _layout->addStretch();
 
             // Initialize.
@@ -217,6 +236,9 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[AV::DPX::ENDIAN_OPTION]);
             tmp >> _options.endian;
+            tmp = plugin->option(
+                plugin->options()[AV::DPX::READ_MODE_OPTION]);
+            tmp >> _options.readMode;
 
             widgetUpdate();
 
@@ -273,6 +295,10 @@ namespace djv
                 _endianWidget,
                 SIGNAL(activated(int)),
                 SLOT(endianCallback(int)));
+            connect(
+                _readModeWidget,
+                SIGNAL(activated(int)),
+                SLOT(readModeCallback(int)));
         }
 
         void DPXWidget::resetPreferences()
@@ -315,6 +341,9 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     AV::DPX::ENDIAN_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.endian;
+                else if (0 == option.compare(plugin()->options()[
+                    AV::DPX::READ_MODE_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.readMode;
             }
             catch (const QString &)
             {
@@ -394,6 +423,12 @@ namespace djv
             pluginUpdate();
         }
 
+        void DPXWidget::readModeCallback(int in)
+        {
+            _options.readMode = static_cast<Core::FileIO::READ_MODE>(in);
+            pluginUpdate();
+        }
+
         void DPXWidget::pluginUpdate()
         {
             QStringList tmp;
@@ -411,6 +446,8 @@ namespace djv
             plugin()->setOption(plugin()->options()[AV::DPX::TYPE_OPTION], tmp);
             tmp << _options.endian;
             plugin()->setOption(plugin()->options()[AV::DPX::ENDIAN_OPTION], tmp);
+            tmp << _options.readMode;
+            plugin()->setOption(plugin()->options()[AV::DPX::READ_MODE_OPTION], tmp);
         }
 
         void DPXWidget::widgetUpdate()
@@ -428,7 +465,8 @@ namespace djv
                 _outputGammaWidget <<
                 _versionWidget <<
                 _typeWidget <<
-                _endianWidget);
+                _endianWidget <<
+                _readModeWidget);
             //DJV_DEBUG_PRINT("input color profile = " << _options.inputColorProfile);
             //DJV_DEBUG_PRINT("output color profile = " << _options.outputColorProfile);
             _inputBlackPointWidget->setVisible(
@@ -485,6 +523,7 @@ namespace djv
             _versionWidget->setCurrentIndex(_options.version);
             _typeWidget->setCurrentIndex(_options.type);
             _endianWidget->setCurrentIndex(_options.endian);
+            _readModeWidget->setCurrentIndex(_options.readMode);
         }
 
         DPXWidgetPlugin::DPXWidgetPlugin(const QPointer<Core::CoreContext> & context) :
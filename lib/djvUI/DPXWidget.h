@@ -69,6 +69,7 @@ namespace djv
             void versionCallback(int);
             void typeCallback(int);
             void endianCallback(int);
+            void readModeCallback(int);
             
             void pluginUpdate();
             void widgetUpdate();
@@ -89,6 +90,7 @@ namespace djv
             QComboBox * _versionWidget = nullptr;
             QComboBox * _typeWidget = nullptr;
             QComboBox * _endianWidget = nullptr;
+            QComboBox * _readModeWidget = nullptr;
             QVBoxLayout * _layout = nullptr;
         };
 
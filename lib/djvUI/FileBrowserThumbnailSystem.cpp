@@ -38,6 +38,7 @@
 
 #include <djvCore/DebugLog.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Trace.h>
 
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
@@ -206,6 +207,7 @@ namespace djv
 
         void FileBrowserThumbnailSystem::run()
         {
+            DJV_TRACE_THREAD("FileBrowserThumbnailSystem");
             _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
             if (_p->openGLContext->format().testOption(QSurfaceFormat::DebugContext))
             {
@@ -248,6 +250,7 @@ namespace djv
         {
             for (auto& request : _p->infoRequests)
             {
+                DJV_TRACE_ZONE("djv::UI::FileBrowserThumbnailSystem::info");
                 AV::IOInfo info;
                 try
                 {
@@ -266,6 +269,7 @@ namespace djv
             //DJV_DEBUG("FileBrowserThumbnailSystem::_handlePixmapRequests");
             for (auto& request : _p->pixmapRequests)
             {
+                DJV_TRACE_ZONE("djv::UI::FileBrowserThumbnailSystem::pixmap");
                 QPixmap pixmap;
                 try
                 {
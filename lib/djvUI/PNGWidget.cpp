@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvUI/PNGWidget.h>
+
+#include <djvUI/UIContext.h>
+#include <djvUI/IntEditSlider.h>
+#include <djvUI/PrefsGroupBox.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/SignalBlocker.h>
+
+#include <QApplication>
+#include <QComboBox>
+#include <QFormLayout>
+#include <QVBoxLayout>
+
+namespace djv
+{
+    namespace UI
+    {
+        PNGWidget::PNGWidget(AV::IOPlugin * plugin, const QPointer<UIContext> & context) :
+            IOWidget(plugin, context)
+        {
+            //DJV_DEBUG("PNGWidget::PNGWidget");
+
+            // Create the widgets.
+            _compressionLevelWidget = new IntEditSlider(context);
+            _compressionLevelWidget->setRange(0, 9);
+            _compressionLevelWidget->setDefaultValue(AV::PNG::Options().compressionLevel);
+
+            _strategyWidget = new QComboBox;
+            _strategyWidget->addItems(AV::PNG::strategyLabels());
+            _strategyWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _filterWidget = new QComboBox;
+            _filterWidget->addItems(AV::PNG::filterLabels());
+            _filterWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            // Layout the widgets.
+            _layout = new QVBoxLayout(this);
+
+            PrefsGroupBox * prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::PNGWidget", "Compression"),
+                qApp->translate("djv::UI::PNGWidget", "Set the zlib compression used when saving PNG images."),
+                context);
+            QFormLayout * formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Level:"),
+                _compressionLevelWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Strategy:"),
+                _strategyWidget);
+            _layout->addWidget(prefsGroupBox);
+
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::PNGWidget", "Filter"),
+                qApp->translate("djv::UI::PNGWidget", "Set the row filter used when saving PNG images."),
+                context);
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Filter:"),
+                _filterWidget);
+            _layout->addWidget(prefsGroupBox);
+
+            _layout->addStretch();
+
+            // Initialize.
+            QStringList tmp;
+            tmp = plugin->option(
+                plugin->options()[AV::PNG::COMPRESSION_LEVEL_OPTION]);
+            tmp >> _options.compressionLevel;
+            tmp = plugin->option(
+                plugin->options()[AV::PNG::STRATEGY_OPTION]);
+            tmp >> _options.strategy;
+            tmp = plugin->option(
+                plugin->options()[AV::PNG::FILTER_OPTION]);
+            tmp >> _options.filter;
+
+            widgetUpdate();
+
+            // Setup the callbacks.
+            connect(
+                plugin,
+                SIGNAL(optionChanged(const QString &)),
+                SLOT(pluginCallback(const QString &)));
+            connect(
+                _compressionLevelWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(compressionLevelCallback(int)));
+            connect(
+                _strategyWidget,
+                SIGNAL(activated(int)),
+                SLOT(strategyCallback(int)));
+            connect(
+                _filterWidget,
+                SIGNAL(activated(int)),
+                SLOT(filterCallback(int)));
+        }
+
+        void PNGWidget::resetPreferences()
+        {
+            _options = AV::PNG::Options();
+            pluginUpdate();
+            widgetUpdate();
+        }
+
+        void PNGWidget::pluginCallback(const QString & option)
+        {
+            try
+            {
+                QStringList tmp;
+                tmp = plugin()->option(option);
+                if (0 == option.compare(plugin()->options()[
+                    AV::PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.compressionLevel;
+                else if (0 == option.compare(plugin()->options()[
+                    AV::PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.strategy;
+                else if (0 == option.compare(plugin()->options()[
+                    AV::PNG::FILTER_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.filter;
+            }
+            catch (const QString &)
+            {
+            }
+            widgetUpdate();
+        }
+
+        void PNGWidget::compressionLevelCallback(int in)
+        {
+            _options.compressionLevel = in;
+            pluginUpdate();
+        }
+
+        void PNGWidget::strategyCallback(int in)
+        {
+            _options.strategy = static_cast<AV::PNG::STRATEGY>(in);
+            pluginUpdate();
+        }
+
+        void PNGWidget::filterCallback(int in)
+        {
+            _options.filter = static_cast<AV::PNG::FILTER>(in);
+            pluginUpdate();
+        }
+
+        void PNGWidget::pluginUpdate()
+        {
+            QStringList tmp;
+            tmp << _options.compressionLevel;
+            plugin()->setOption(
+                plugin()->options()[AV::PNG::COMPRESSION_LEVEL_OPTION], tmp);
+            tmp << _options.strategy;
+            plugin()->setOption(
+                plugin()->options()[AV::PNG::STRATEGY_OPTION], tmp);
+            tmp << _options.filter;
+            plugin()->setOption(
+                plugin()->options()[AV::PNG::FILTER_OPTION], tmp);
+        }
+
+        void PNGWidget::widgetUpdate()
+        {
+            Core::SignalBlocker signalBlocker(QObjectList() <<
+                _compressionLevelWidget <<
+                _strategyWidget <<
+                _filterWidget);
+            _compressionLevelWidget->setValue(_options.compressionLevel);
+            _strategyWidget->setCurrentIndex(_options.strategy);
+            _filterWidget->setCurrentIndex(_options.filter);
+        }
+
+        PNGWidgetPlugin::PNGWidgetPlugin(const QPointer<Core::CoreContext> & context) :
+            IOWidgetPlugin(context)
+        {}
+
+        IOWidget * PNGWidgetPlugin::createWidget(AV::IOPlugin * plugin) const
+        {
+            return new PNGWidget(plugin, uiContext());
+        }
+
+        QString PNGWidgetPlugin::pluginName() const
+        {
+            return AV::PNG::staticName;
+        }
+
+    } // namespace UI
+} // namespace djv
@@ -29,6 +29,7 @@
 
 #include <djvUI/TIFFWidget.h>
 
+#include <djvUI/IntEdit.h>
 #include <djvUI/UIContext.h>
 #include <djvUI/PrefsGroupBox.h>
 
@@ -56,6 +57,11 @@ namespace djv
             _compressionWidget->setSizePolicy(
                 QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _rowsPerStripWidget = new IntEdit;
+            _rowsPerStripWidget->setRange(0, 65536);
+            _rowsPerStripWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -69,6 +75,16 @@ namespace djv
                 _compressionWidget);
             _layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::TIFFWidget", "Strips"),
+                qApp->translate("djv::UI::TIFFWidget", "Set the number of rows in each strip when saving TIFF images, or zero to pick a size automatically."),
+                context);
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::TIFFWidget", "Rows per strip:"),
+                _rowsPerStripWidget);
+            _layout->addWidget(prefsGroupBox);
+
             _layout->addStretch();
 
             // Initialize.
@@ -76,6 +92,9 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[AV::TIFF::COMPRESSION_OPTION]);
             tmp >> _options.compression;
+            tmp = plugin->option(
+                plugin->options()[AV::TIFF::ROWS_PER_STRIP_OPTION]);
+            tmp >> _options.rowsPerStrip;
 
             widgetUpdate();
 
@@ -88,6 +107,10 @@ namespace djv
                 _compressionWidget,
                 SIGNAL(activated(int)),
                 SLOT(compressionCallback(int)));
+            connect(
+                _rowsPerStripWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(rowsPerStripCallback(int)));
         }
 
         void TIFFWidget::resetPreferences()
@@ -106,6 +129,9 @@ namespace djv
                 if (0 == option.compare(plugin()->options()[
                     AV::TIFF::COMPRESSION_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.compression;
+                else if (0 == option.compare(plugin()->options()[
+                    AV::TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.rowsPerStrip;
             }
             catch (const QString &)
             {
@@ -119,18 +145,31 @@ namespace djv
             pluginUpdate();
         }
 
+        void TIFFWidget::rowsPerStripCallback(int in)
+        {
+            _options.rowsPerStrip = in;
+            pluginUpdate();
+        }
+
         void TIFFWidget::pluginUpdate()
         {
             QStringList tmp;
             tmp << _options.compression;
             plugin()->setOption(
                 plugin()->options()[AV::TIFF::COMPRESSION_OPTION], tmp);
+            tmp.clear();
+            tmp << _options.rowsPerStrip;
+            plugin()->setOption(
+                plugin()->options()[AV::TIFF::ROWS_PER_STRIP_OPTION], tmp);
         }
 
         void TIFFWidget::widgetUpdate()
         {
-            Core::SignalBlocker signalBlocker(_compressionWidget);
+            Core::SignalBlocker signalBlocker(QObjectList() <<
+                _compressionWidget <<
+                _rowsPerStripWidget);
             _compressionWidget->setCurrentIndex(_options.compression);
+            _rowsPerStripWidget->setValue(_options.rowsPerStrip);
         }
 
         TIFFWidgetPlugin::TIFFWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -40,6 +40,8 @@ namespace djv
 {
     namespace UI
     {
+        class IntEdit;
+
         //! This class provides a TIFF widget.
         class TIFFWidget : public IOWidget
         {
@@ -53,6 +55,7 @@ namespace djv
         private Q_SLOTS:
             void pluginCallback(const QString &);
             void compressionCallback(int);
+            void rowsPerStripCallback(int);
 
             void pluginUpdate();
             void widgetUpdate();
@@ -60,6 +63,7 @@ namespace djv
         private:
             AV::TIFF::Options _options;
             QComboBox * _compressionWidget = nullptr;
+            IntEdit * _rowsPerStripWidget = nullptr;
             QVBoxLayout * _layout = nullptr;
         };
 
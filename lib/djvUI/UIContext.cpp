@@ -59,6 +59,9 @@
 #if defined(JPEG_FOUND)
 #include <djvUI/JPEGWidget.h>
 #endif // JPEG_FOUND
+#if defined(PNG_FOUND)
+#include <djvUI/PNGWidget.h>
+#endif // PNG_FOUND
 #if defined(TIFF_FOUND)
 #include <djvUI/TIFFWidget.h>
 #endif // TIFF_FOUND
@@ -248,6 +251,9 @@ namespace djv
 #if defined(JPEG_FOUND)
                 _p->widgets->ioWidgetFactory->addPlugin(new JPEGWidgetPlugin(that));
 #endif // JPEG_FOUND
+#if defined(PNG_FOUND)
+                _p->widgets->ioWidgetFactory->addPlugin(new PNGWidgetPlugin(that));
+#endif // PNG_FOUND
 #if defined(TIFF_FOUND)
                 _p->widgets->ioWidgetFactory->addPlugin(new TIFFWidgetPlugin(that));
 #endif // TIFF_FOUND
@@ -101,7 +101,8 @@ namespace djv
                 qApp->translate("djv::ViewLib::Enum", "Pixel") <<
                 qApp->translate("djv::ViewLib::Enum", "Tags") <<
                 qApp->translate("djv::ViewLib::Enum", "Playback Frame") <<
-                qApp->translate("djv::ViewLib::Enum", "Playback Speed");
+                qApp->translate("djv::ViewLib::Enum", "Playback Speed") <<
+                qApp->translate("djv::ViewLib::Enum", "Frame Latency");
             DJV_ASSERT(data.count() == HUD_COUNT);
             return data;
         }
@@ -539,7 +540,8 @@ namespace djv
                 qApp->translate("djv::ViewLib::Enum", "Cannot open LUT: %1") <<
                 qApp->translate("djv::ViewLib::Enum", "Cannot pick color") <<
                 qApp->translate("djv::ViewLib::Enum", "Cannot compute histogram") <<
-                qApp->translate("djv::ViewLib::Enum", "Cannot magnify");
+                qApp->translate("djv::ViewLib::Enum", "Cannot magnify") <<
+                qApp->translate("djv::ViewLib::Enum", "Cannot open the disk cache: %1");
             DJV_ASSERT(ERROR_COUNT == data.count());
             return data;
         }
@@ -135,6 +135,7 @@ namespace djv
                 HUD_TAG,
                 HUD_FRAME,
                 HUD_SPEED,
+                HUD_LATENCY,
 
                 HUD_COUNT
             };
@@ -575,6 +576,7 @@ namespace djv
                 ERROR_PICK_COLOR,
                 ERROR_HISTOGRAM,
                 ERROR_MAGNIFY,
+                ERROR_DISK_CACHE,
 
                 ERROR_COUNT
             };
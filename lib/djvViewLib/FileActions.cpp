@@ -81,6 +81,8 @@ namespace djv
             _actions[MESSAGES]->setText(qApp->translate("djv::ViewLib::FileActions", "Messa&ges"));
             _actions[PREFS]->setText(qApp->translate("djv::ViewLib::FileActions", "&Preferences"));
             _actions[DEBUG_LOG]->setText(qApp->translate("djv::ViewLib::FileActions", "Debugging Log"));
+            _actions[EXPORT_FRAME_STATS]->setText(qApp->translate("djv::ViewLib::FileActions", "Export Frame Statistics"));
+            _actions[EXPORT_TRACE]->setText(qApp->translate("djv::ViewLib::FileActions", "Export Trace"));
             _actions[EXIT]->setText(qApp->translate("djv::ViewLib::FileActions", "E&xit"));
 
             for (int i = 0; i < GROUP_COUNT; ++i)
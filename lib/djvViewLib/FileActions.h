@@ -61,6 +61,8 @@ namespace djv
                 MESSAGES,
                 PREFS,
                 DEBUG_LOG,
+                EXPORT_FRAME_STATS,
+                EXPORT_TRACE,
                 EXIT,
 
                 ACTION_COUNT
@@ -29,17 +29,31 @@
 
 #include <djvViewLib/FileCache.h>
 
+#include <djvViewLib/FileCompressedCache.h>
 #include <djvViewLib/FilePrefs.h>
+#include <djvViewLib/FileSpillCache.h>
 #include <djvViewLib/ViewContext.h>
 
 #include <djvAV/Image.h>
 
 #include <djvCore/Assert.h>
+#include <djvCore/DebugLog.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Math.h>
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryInfo.h>
 #include <djvCore/Time.h>
+#include <djvCore/Trace.h>
 
+#include <QApplication>
 #include <QPointer>
+#include <QSocketNotifier>
+
+#if defined(DJV_LINUX)
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#endif // DJV_LINUX
 
 #include <algorithm>
 #include <functional>
@@ -48,6 +62,31 @@ namespace djv
 {
     namespace ViewLib
     {
+        namespace
+        {
+            // How often the available memory is checked, in milliseconds.
+            const int budgetPollTimeout = 2000;
+
+            // The percentage of the process memory that is left for the rest
+            // of the application and the system.
+            const quint64 budgetReservePercent = 10;
+
+            // Changes smaller than this are ignored so the cache is not
+            // constantly resized.
+            const quint64 budgetStepBytes = 64 * Core::Memory::megabyte;
+
+            // Shrink the cache when tasks have been stalled waiting for memory
+            // for more than this percentage of the time.
+            const float pressureThreshold = 10.f;
+
+#if defined(DJV_LINUX)
+            // Notify when tasks stall waiting for memory for a total of 150ms
+            // in a two second window.
+            const char pressureTrigger[] = "some 150000 2000000";
+#endif // DJV_LINUX
+
+        } // namespace
+
         FileCacheKey::FileCacheKey() :
             timestamp(Core::Time::current())
         {}
@@ -58,33 +97,256 @@ namespace djv
             timestamp(Core::Time::current())
         {}
 
+        bool FileCacheKey::isSameVariant(const FileCacheKey & other) const
+        {
+            return
+                layer == other.layer &&
+                proxy == other.proxy &&
+                u8Conversion == other.u8Conversion;
+        }
+
         bool FileCacheKey::operator < (const FileCacheKey & other) const
         {
-            if (window != other.window)
+            if (source != other.source)
+            {
+                return source < other.source;
+            }
+            if (sourceFrame != other.sourceFrame)
+            {
+                return sourceFrame < other.sourceFrame;
+            }
+            if (sourceTime != other.sourceTime)
+            {
+                return sourceTime < other.sourceTime;
+            }
+            if (sourceSize != other.sourceSize)
             {
-                return window < other.window;
+                return sourceSize < other.sourceSize;
             }
-            return frame < other.frame;
+            if (layer != other.layer)
+            {
+                return layer < other.layer;
+            }
+            if (proxy != other.proxy)
+            {
+                return proxy < other.proxy;
+            }
+            return u8Conversion < other.u8Conversion;
         }
 
         struct FileCache::Private
         {
             Private(const QPointer<ViewContext> & context) :
                 maxBytes(static_cast<quint64>(context->filePrefs()->cacheSizeGB() * Core::Memory::gigabyte)),
+                hotPercent(context->filePrefs()->cacheHotPercent()),
                 context(context)
             {}
 
-            std::map<FileCacheKey, std::shared_ptr<AV::Image> > items;
+            ~Private()
+            {
+                closePressure();
+            }
+
+            struct Item
+            {
+                std::shared_ptr<AV::Image> image;
+                quint64 tick = 0;
+            };
+
+            std::map<FileCacheKey, Item> items;
+            std::map<quint64, FileCacheKey> lru;
+            std::map<void *, FileCacheKey> variants;
+
+            // The windows that reference each item, and the frame index that
+            // each window uses for it.
+            std::map<FileCacheKey, std::map<void *, qint64> > refs;
+            quint64 tick = 0;
             quint64 maxBytes = 0;
             quint64 cacheBytes = 0;
+            int hotPercent = 100;
+            std::unique_ptr<FileCompressedCache> compressed;
+            std::unique_ptr<FileSpillCache> spill;
+            quint64 hits[TIER_COUNT] = { 0, 0, 0 };
+            quint64 misses[TIER_COUNT] = { 0, 0, 0 };
+            int budgetTimer = 0;
+            int pressureFd = -1;
+            std::unique_ptr<QSocketNotifier> pressureNotifier;
             QPointer<ViewContext> context;
+
+            void erase(std::map<FileCacheKey, Item>::iterator);
+
+            // Remove an item from memory, compressing it or moving it to disk
+            // when those tiers are enabled.
+            void evict(std::map<FileCacheKey, Item>::iterator);
+
+            void addRef(const FileCacheKey &);
+
+            // Get whether an item is a variant that none of the windows that
+            // reference it display.
+            bool isRedundant(const FileCacheKey &) const;
+
+            // Get whether the given window displays the variant of an item.
+            bool isDisplayed(const FileCacheKey &, void * window) const;
+
+            // Get whether an item is a proxy scaled variant that can be made
+            // again from a full resolution item in memory.
+            bool isDerived(const FileCacheKey &) const;
+
+            // Get whether an item is in any tier.
+            bool isCached(const FileCacheKey &) const;
+
+            // Remove the references to an item that is no longer in any tier.
+            void removeRefs(const FileCacheKey &);
+
+            // Remove the references to items that are no longer in any tier.
+            void removeStaleRefs();
+
+            // Move an item to the disk cache. The references are removed for
+            // the item when it can not be moved, and for the items that the
+            // disk cache removes to make room.
+            void spillItem(const FileCacheKey &, const std::shared_ptr<AV::Image> &, quint64 tick);
+
+            void closePressure();
+
+            // Get the maximum size of the uncompressed items.
+            quint64 hotMaxBytes() const;
+
+            // Get the size including the compressed items.
+            quint64 totalBytes() const;
         };
 
+        void FileCache::Private::erase(std::map<FileCacheKey, Item>::iterator i)
+        {
+            cacheBytes -= i->second.image->dataByteCount();
+            lru.erase(i->second.tick);
+            items.erase(i);
+        }
+
+        void FileCache::Private::evict(std::map<FileCacheKey, Item>::iterator i)
+        {
+            const FileCacheKey key = i->first;
+            const Item value = i->second;
+            erase(i);
+            if (compressed)
+            {
+                compressed->addItem(key, value.image, value.tick);
+            }
+            else
+            {
+                spillItem(key, value.image, value.tick);
+            }
+        }
+
+        void FileCache::Private::addRef(const FileCacheKey & key)
+        {
+            refs[key][key.window] = key.frame;
+        }
+
+        bool FileCache::Private::isRedundant(const FileCacheKey & key) const
+        {
+            const auto i = refs.find(key);
+            if (i != refs.end())
+            {
+                for (const auto & j : i->second)
+                {
+                    if (isDisplayed(key, j.first))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        bool FileCache::Private::isDisplayed(const FileCacheKey & key, void * window) const
+        {
+            const auto i = variants.find(window);
+            return i == variants.end() || key.isSameVariant(i->second);
+        }
+
+        bool FileCache::Private::isDerived(const FileCacheKey & key) const
+        {
+            if (AV::PixelDataInfo::PROXY_NONE == key.proxy)
+                return false;
+            FileCacheKey fullKey = key;
+            fullKey.proxy = AV::PixelDataInfo::PROXY_NONE;
+            return items.find(fullKey) != items.end();
+        }
+
+        bool FileCache::Private::isCached(const FileCacheKey & key) const
+        {
+            return
+                items.find(key) != items.end() ||
+                (compressed && compressed->hasItem(key)) ||
+                (spill && spill->hasItem(key));
+        }
+
+        void FileCache::Private::removeRefs(const FileCacheKey & key)
+        {
+            if (!isCached(key))
+            {
+                refs.erase(key);
+            }
+        }
+
+        void FileCache::Private::removeStaleRefs()
+        {
+            auto i = refs.begin();
+            while (i != refs.end())
+            {
+                if (!isCached(i->first))
+                {
+                    i = refs.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        void FileCache::Private::spillItem(const FileCacheKey & key, const std::shared_ptr<AV::Image> & image, quint64 tick)
+        {
+            if (spill)
+            {
+                std::vector<FileCacheKey> removed;
+                spill->addItem(key, image, tick, removed);
+                for (const auto & i : removed)
+                {
+                    removeRefs(i);
+                }
+            }
+            removeRefs(key);
+        }
+
+        void FileCache::Private::closePressure()
+        {
+            pressureNotifier.reset();
+#if defined(DJV_LINUX)
+            if (pressureFd != -1)
+            {
+                ::close(pressureFd);
+            }
+#endif // DJV_LINUX
+            pressureFd = -1;
+        }
+
+        quint64 FileCache::Private::hotMaxBytes() const
+        {
+            return compressed ? (maxBytes / 100 * hotPercent) : maxBytes;
+        }
+
+        quint64 FileCache::Private::totalBytes() const
+        {
+            return cacheBytes + (compressed ? compressed->currentSizeBytes() : 0);
+        }
+
         FileCache::FileCache(const QPointer<ViewContext> & context, QObject * parent) :
             QObject(parent),
             _p(new Private(context))
         {
             //DJV_DEBUG("FileCache::FileCache");
+            compressionCallback();
+            diskCacheCallback();
+            adaptiveCallback();
             connect(
                 context->filePrefs(),
                 SIGNAL(cacheEnabledChanged(bool)),
@@ -93,6 +355,34 @@ namespace djv
                 context->filePrefs(),
                 SIGNAL(cacheSizeGBChanged(float)),
                 SLOT(cacheSizeGBCallback(float)));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheAdaptiveChanged(bool)),
+                SLOT(adaptiveCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheMinSizeGBChanged(float)),
+                SLOT(budgetUpdate()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheCompressionChanged(bool)),
+                SLOT(compressionCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheHotPercentChanged(int)),
+                SLOT(compressionCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(diskCacheChanged(bool)),
+                SLOT(diskCacheCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(diskCacheSizeGBChanged(int)),
+                SLOT(diskCacheCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(diskCachePathChanged(const QString &)),
+                SLOT(diskCacheCallback()));
         }
 
         FileCache::~FileCache()
@@ -101,21 +391,103 @@ namespace djv
             //debug();
         }
 
+        const QStringList & FileCache::tierLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::ViewLib::FileCache", "Memory") <<
+                qApp->translate("djv::ViewLib::FileCache", "Compressed") <<
+                qApp->translate("djv::ViewLib::FileCache", "Disk");
+            DJV_ASSERT(TIER_COUNT == data.count());
+            return data;
+        }
+
         bool FileCache::hasItem(const FileCacheKey & key)
         {
-            return _p->items.find(key) != _p->items.end();
+            return hasItem(key, MEMORY) || hasItem(key, COMPRESSED) || hasItem(key, DISK);
+        }
+
+        bool FileCache::hasItem(const FileCacheKey & key, TIER tier)
+        {
+            switch (tier)
+            {
+            case MEMORY:     return _p->items.find(key) != _p->items.end();
+            case COMPRESSED: return _p->compressed && _p->compressed->hasItem(key);
+            case DISK:       return _p->spill && _p->spill->hasItem(key);
+            default: break;
+            }
+            return false;
+        }
+
+        std::shared_ptr<AV::Image> FileCache::item(const FileCacheKey & key)
+        {
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::item");
+            std::shared_ptr<AV::Image> out;
+            auto i = _p->items.find(key);
+            if (i != _p->items.end())
+            {
+                ++_p->hits[MEMORY];
+                _p->addRef(key);
+                out = i->second.image;
+                _p->lru.erase(i->second.tick);
+                i->second.tick = ++_p->tick;
+                _p->lru[i->second.tick] = key;
+                return out;
+            }
+            ++_p->misses[MEMORY];
+            if (_p->compressed)
+            {
+                try
+                {
+                    out = _p->compressed->takeItem(key);
+                }
+                catch (const Core::Error & error)
+                {
+                    _p->context->printError(error);
+                    _p->removeRefs(key);
+                }
+                if (out)
+                {
+                    ++_p->hits[COMPRESSED];
+                    addItem(key, out);
+                    return out;
+                }
+                ++_p->misses[COMPRESSED];
+            }
+            if (_p->spill)
+            {
+                out = _p->spill->item(key, ++_p->tick);
+                if (out)
+                {
+                    ++_p->hits[DISK];
+                    addItem(key, out);
+                }
+                else
+                {
+                    // Items that are out of date or could not be written are
+                    // removed by the disk cache.
+                    ++_p->misses[DISK];
+                    _p->removeRefs(key);
+                }
+            }
+            return out;
         }
 
-        std::shared_ptr<AV::Image> FileCache::item(const FileCacheKey & key) const
+        quint64 FileCache::itemByteCount(const FileCacheKey & key) const
         {
-            return _p->items.find(key)->second;
+            auto i = _p->items.find(key);
+            if (i != _p->items.end())
+            {
+                return i->second.image->dataByteCount();
+            }
+            return _p->compressed ? _p->compressed->itemByteCount(key) : 0;
         }
 
         void FileCache::addItem(const FileCacheKey & key, const std::shared_ptr<AV::Image> & item)
         {
-            _p->items[key] = item;
-            _p->cacheBytes += item->dataByteCount();
-            if (_p->cacheBytes > _p->maxBytes)
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::addItem");
+            _p->addRef(key);
+            insertItem(key, item);
+            if (isFull())
             {
                 purge();
             }
@@ -123,19 +495,23 @@ namespace djv
             debug();
         }
 
+        void FileCache::addReference(const FileCacheKey & key)
+        {
+            _p->addRef(key);
+        }
+
         void FileCache::clearItems(void * window)
         {
-            auto i = _p->items.begin();
-            while (i != _p->items.end())
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::clearItems");
+            auto i = _p->refs.begin();
+            while (i != _p->refs.end())
             {
-                if (window == i->first.window)
+                auto j = i++;
+                j->second.erase(window);
+                if (j->second.empty())
                 {
-                    _p->cacheBytes -= i->second->dataByteCount();
-                    i = _p->items.erase(i);
-                }
-                else
-                {
-                    ++i;
+                    const FileCacheKey key = j->first;
+                    removeItem(key);
                 }
             }
             Q_EMIT cacheChanged();
@@ -144,11 +520,19 @@ namespace djv
 
         void FileCache::clear()
         {
-            auto i = _p->items.begin();
-            while (i != _p->items.end())
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::clear");
+            while (_p->items.size())
+            {
+                _p->erase(_p->items.begin());
+            }
+            _p->refs.clear();
+            if (_p->compressed)
+            {
+                _p->compressed->clear();
+            }
+            if (_p->spill)
             {
-                _p->cacheBytes -= i->second->dataByteCount();
-                i = _p->items.erase(i);
+                _p->spill->clear();
             }
             Q_EMIT cacheChanged();
             debug();
@@ -156,11 +540,54 @@ namespace djv
 
         void FileCache::removeItem(const FileCacheKey & key)
         {
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::removeItem");
             auto i = _p->items.find(key);
             if (i != _p->items.end())
             {
-                _p->cacheBytes -= i->second->dataByteCount();
-                _p->items.erase(i);
+                _p->erase(i);
+            }
+            if (_p->compressed)
+            {
+                _p->compressed->removeItem(key);
+            }
+            if (_p->spill)
+            {
+                _p->spill->removeItem(key);
+            }
+            _p->refs.erase(key);
+        }
+
+        void FileCache::clearItems(void * window, qint64 frame)
+        {
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::clearItems");
+            auto i = _p->refs.begin();
+            while (i != _p->refs.end())
+            {
+                auto j = i++;
+                const auto k = j->second.find(window);
+                if (k != j->second.end() && frame == k->second)
+                {
+                    const FileCacheKey key = j->first;
+                    removeItem(key);
+                }
+            }
+            Q_EMIT cacheChanged();
+        }
+
+        void FileCache::setVariant(const FileCacheKey & key)
+        {
+            auto i = _p->variants.find(key.window);
+            if (i != _p->variants.end() && key.isSameVariant(i->second))
+                return;
+            _p->variants[key.window] = key;
+            Q_EMIT cacheChanged();
+        }
+
+        void FileCache::removeVariant(void * window)
+        {
+            if (_p->variants.erase(window))
+            {
+                Q_EMIT cacheChanged();
             }
         }
 
@@ -169,9 +596,10 @@ namespace djv
             std::vector<std::shared_ptr<AV::Image> > out;
             for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
             {
-                if (window == i->first.window)
+                const auto j = _p->refs.find(i->first);
+                if (j != _p->refs.end() && j->second.count(window))
                 {
-                    out.push_back(i->second);
+                    out.push_back(i->second.image);
                 }
             }
             return out;
@@ -191,9 +619,13 @@ namespace djv
             Core::FrameList frames;
             for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
             {
-                if (window == i->first.window)
+                const auto j = _p->refs.find(i->first);
+                if (j == _p->refs.end())
+                    continue;
+                const auto k = j->second.find(window);
+                if (k != j->second.end() && _p->isDisplayed(i->first, window))
                 {
-                    frames.push_back(i->first.frame);
+                    frames.push_back(k->second);
                 }
             }
             qSort(frames.begin(), frames.end(), compare);
@@ -210,14 +642,19 @@ namespace djv
             return _p->maxBytes;
         }
 
+        bool FileCache::isAdaptive() const
+        {
+            return _p->budgetTimer != 0;
+        }
+
         float FileCache::currentSizeGB(void * window) const
         {
             quint64 size = 0;
-            for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
+            for (auto i = _p->refs.begin(); i != _p->refs.end(); ++i)
             {
-                if (window == i->first.window)
+                if (i->second.count(window))
                 {
-                    size += i->second->dataByteCount();
+                    size += itemByteCount(i->first);
                 }
             }
             return size / static_cast<float>(Core::Memory::gigabyte);
@@ -225,12 +662,62 @@ namespace djv
 
         float FileCache::currentSizeGB() const
         {
-            return _p->cacheBytes / static_cast<float>(Core::Memory::gigabyte);
+            return _p->totalBytes() / static_cast<float>(Core::Memory::gigabyte);
         }
 
         quint64 FileCache::currentSizeBytes() const
         {
-            return _p->cacheBytes;
+            return _p->totalBytes();
+        }
+
+        bool FileCache::hasCompression() const
+        {
+            return _p->compressed != nullptr;
+        }
+
+        float FileCache::compressedSizeGB() const
+        {
+            return _p->compressed ?
+                (_p->compressed->compressedByteCount() / static_cast<float>(Core::Memory::gigabyte)) :
+                0.f;
+        }
+
+        float FileCache::compressionRatio() const
+        {
+            if (!_p->compressed)
+                return 1.f;
+            const quint64 byteCount = _p->compressed->compressedByteCount();
+            return byteCount ? (_p->compressed->dataByteCount() / static_cast<float>(byteCount)) : 1.f;
+        }
+
+        bool FileCache::hasDiskCache() const
+        {
+            return _p->spill != nullptr;
+        }
+
+        float FileCache::diskMaxSizeGB() const
+        {
+            return _p->spill ? (_p->spill->maxSizeBytes() / static_cast<float>(Core::Memory::gigabyte)) : 0.f;
+        }
+
+        float FileCache::diskCurrentSizeGB() const
+        {
+            return _p->spill ? (_p->spill->currentSizeBytes() / static_cast<float>(Core::Memory::gigabyte)) : 0.f;
+        }
+
+        quint64 FileCache::hits(TIER tier) const
+        {
+            return _p->hits[tier];
+        }
+
+        quint64 FileCache::misses(TIER tier) const
+        {
+            return _p->misses[tier];
+        }
+
+        size_t FileCache::referenceCount() const
+        {
+            return _p->refs.size();
         }
 
         const QVector<float> & FileCache::sizeGBDefaults()
@@ -257,7 +744,7 @@ namespace djv
             {
                 DJV_DEBUG_PRINT(
                     "item (count = " <<
-                    i->second.use_count() <<
+                    i->second.image.use_count() <<
                     ") = " <<
                     reinterpret_cast<qint64>(i->first.window) <<
                     " " <<
@@ -270,32 +757,102 @@ namespace djv
             //DJV_DEBUG("FileCache::setMaxSizeGB");
             //DJV_DEBUG_PRINT("size = " << size);
             //debug();
-            _p->maxBytes = static_cast<quint64>(size * Core::Memory::gigabyte);
-            //if (_p->cacheBytes > _p->maxBytes)
-            purge();
+            setMaxSizeBytes(static_cast<quint64>(size * Core::Memory::gigabyte));
             //debug();
         }
 
+        void FileCache::timerEvent(QTimerEvent *)
+        {
+            budgetUpdate();
+        }
+
+        void FileCache::insertItem(const FileCacheKey & key, const std::shared_ptr<AV::Image> & item)
+        {
+            auto i = _p->items.find(key);
+            if (i != _p->items.end())
+            {
+                _p->erase(i);
+            }
+            Private::Item value;
+            value.image = item;
+            value.tick = ++_p->tick;
+            _p->items[key] = value;
+            _p->lru[value.tick] = key;
+            _p->cacheBytes += item->dataByteCount();
+        }
+
+        void FileCache::setMaxSizeBytes(quint64 size)
+        {
+            const bool changed = size != _p->maxBytes;
+            _p->maxBytes = size;
+            //if (isFull())
+            purge();
+            if (changed)
+            {
+                Q_EMIT maxSizeGBChanged(maxSizeGB());
+            }
+        }
+
+        bool FileCache::isFull() const
+        {
+            return _p->cacheBytes > _p->hotMaxBytes() || _p->totalBytes() > _p->maxBytes;
+        }
+
         void FileCache::purge()
         {
             //DJV_DEBUG("FileCache::purge");
+            DJV_TRACE_ZONE("djv::ViewLib::FileCache::purge");
             debug();
 
-            // Delete as many items as possible to bring the cache size below the maximum size.
-            std::map<::time_t, FileCacheKey> sortedByTime;
-            for (auto i : _p->items)
+            // Remove the least recently used items until the cache size is
+            // below the maximum size. The items are compressed if compression
+            // is enabled, and then moved to the disk cache if it is enabled,
+            // keeping their place in the order.
+            //
+            // Variants that are not being displayed go first. Proxy scaled
+            // variants that can be made again from a full resolution item are
+            // discarded instead of being kept in a lower tier.
+            const quint64 hotMaxBytes = _p->hotMaxBytes();
+            for (auto i = _p->lru.begin(); i != _p->lru.end() && _p->cacheBytes > hotMaxBytes;)
             {
-                sortedByTime[i.first.timestamp] = i.first;
+                const FileCacheKey key = i->second;
+                ++i;
+                if (_p->isRedundant(key))
+                {
+                    auto j = _p->items.find(key);
+                    if (_p->isDerived(key))
+                    {
+                        _p->erase(j);
+                        _p->removeRefs(key);
+                    }
+                    else
+                    {
+                        _p->evict(j);
+                    }
+                }
+            }
+            while (_p->cacheBytes > hotMaxBytes && _p->lru.size())
+            {
+                _p->evict(_p->items.find(_p->lru.begin()->second));
             }
-            auto j = sortedByTime.begin();
-            while (_p->cacheBytes > _p->maxBytes && j != sortedByTime.end())
+            if (_p->compressed)
             {
-                auto k = _p->items.find(j->second);
-                if (k != _p->items.end())
+                FileCacheKey key;
+                std::shared_ptr<AV::Image> image;
+                quint64 tick = 0;
+                while (_p->totalBytes() > _p->maxBytes)
                 {
-                    _p->cacheBytes -= k->second->dataByteCount();
-                    _p->items.erase(k);
-                    j = sortedByTime.erase(j);
+                    try
+                    {
+                        if (!_p->compressed->takeLeastRecent(key, image, tick))
+                            break;
+                    }
+                    catch (const Core::Error &)
+                    {
+                        _p->removeRefs(key);
+                        continue;
+                    }
+                    _p->spillItem(key, image, tick);
                 }
             }
 
@@ -313,7 +870,176 @@ namespace djv
 
         void FileCache::cacheSizeGBCallback(float size)
         {
-            setMaxSizeGB(size);
+            if (isAdaptive())
+            {
+                budgetUpdate();
+            }
+            else
+            {
+                setMaxSizeGB(size);
+            }
+        }
+
+        void FileCache::adaptiveCallback()
+        {
+            //DJV_DEBUG("FileCache::adaptiveCallback");
+            auto filePrefs = _p->context->filePrefs();
+            if (_p->budgetTimer)
+            {
+                killTimer(_p->budgetTimer);
+                _p->budgetTimer = 0;
+            }
+            _p->closePressure();
+            if (filePrefs->isCacheAdaptive())
+            {
+                _p->budgetTimer = startTimer(budgetPollTimeout);
+#if defined(DJV_LINUX)
+                // Register a pressure stall trigger so the cache can shrink as
+                // soon as the system runs short of memory, without waiting for
+                // the next poll. This is not available on older kernels, in
+                // which case polling is used by itself.
+                const int fd = ::open("/proc/pressure/memory", O_RDWR | O_NONBLOCK);
+                if (fd != -1)
+                {
+                    if (::write(fd, pressureTrigger, strlen(pressureTrigger) + 1) > 0)
+                    {
+                        _p->pressureFd = fd;
+                        _p->pressureNotifier.reset(new QSocketNotifier(fd, QSocketNotifier::Exception));
+                        connect(
+                            _p->pressureNotifier.get(),
+                            SIGNAL(activated(int)),
+                            SLOT(budgetUpdate()));
+                    }
+                    else
+                    {
+                        ::close(fd);
+                    }
+                }
+#endif // DJV_LINUX
+                DJV_LOG(_p->context->debugLog(), "djv::ViewLib::FileCache",
+                    QString("Adaptive cache size enabled, pressure notifications = %1").
+                    arg(_p->pressureNotifier ? "true" : "false"));
+                budgetUpdate();
+            }
+            else
+            {
+                setMaxSizeGB(filePrefs->cacheSizeGB());
+            }
+        }
+
+        void FileCache::budgetUpdate()
+        {
+            //DJV_DEBUG("FileCache::budgetUpdate");
+            if (!isAdaptive())
+                return;
+            auto filePrefs = _p->context->filePrefs();
+            const quint64 minBytes = static_cast<quint64>(filePrefs->cacheMinSizeGB() * Core::Memory::gigabyte);
+            const quint64 maxBytes = std::max(
+                minBytes,
+                static_cast<quint64>(filePrefs->cacheSizeGB() * Core::Memory::gigabyte));
+
+            // The budget is what the cache holds now plus what is still
+            // available, less a reserve. When the available memory drops below
+            // the reserve the budget drops below the current size.
+            const Core::MemoryInfo info = Core::MemoryInfo::current();
+            const quint64 total = info.processTotal();
+            const quint64 available = info.processAvailable();
+            const quint64 reserve = total / 100 * budgetReservePercent;
+            const quint64 cacheBytes = _p->totalBytes();
+            quint64 budget = maxBytes;
+            if (total)
+            {
+                if (available >= reserve)
+                {
+                    budget = cacheBytes + (available - reserve);
+                }
+                else
+                {
+                    const quint64 shortfall = reserve - available;
+                    budget = cacheBytes > shortfall ? cacheBytes - shortfall : 0;
+                }
+            }
+            if (info.pressure >= pressureThreshold)
+            {
+                budget = std::min(budget, cacheBytes / 4 * 3);
+            }
+            budget = Core::Math::clamp(budget, minBytes, maxBytes);
+
+            const quint64 delta = budget > _p->maxBytes ? budget - _p->maxBytes : _p->maxBytes - budget;
+            if (delta < std::max(budgetStepBytes, _p->maxBytes / 100) &&
+                _p->maxBytes >= minBytes &&
+                _p->maxBytes <= maxBytes)
+                return;
+            DJV_LOG(_p->context->debugLog(), "djv::ViewLib::FileCache",
+                QString("Cache size = %1 (available = %2, limit = %3, pressure = %4%)").
+                arg(Core::Memory::sizeLabel(budget)).
+                arg(Core::Memory::sizeLabel(available)).
+                arg(info.limit ? Core::Memory::sizeLabel(info.limit) : QString("none")).
+                arg(info.pressure));
+            setMaxSizeBytes(budget);
+        }
+
+        void FileCache::compressionCallback()
+        {
+            //DJV_DEBUG("FileCache::compressionCallback");
+            auto filePrefs = _p->context->filePrefs();
+            _p->hotPercent = filePrefs->cacheHotPercent();
+            if (filePrefs->hasCacheCompression())
+            {
+                if (!_p->compressed)
+                {
+                    _p->compressed.reset(new FileCompressedCache);
+                }
+            }
+            else if (_p->compressed)
+            {
+                // Move the compressed items down to the disk cache, the ones
+                // that do not fit there are removed.
+                std::unique_ptr<FileCompressedCache> compressed = std::move(_p->compressed);
+                FileCacheKey key;
+                std::shared_ptr<AV::Image> image;
+                quint64 tick = 0;
+                while (1)
+                {
+                    try
+                    {
+                        if (!compressed->takeLeastRecent(key, image, tick))
+                            break;
+                    }
+                    catch (const Core::Error &)
+                    {
+                        _p->removeRefs(key);
+                        continue;
+                    }
+                    _p->spillItem(key, image, tick);
+                }
+            }
+            purge();
+        }
+
+        void FileCache::diskCacheCallback()
+        {
+            //DJV_DEBUG("FileCache::diskCacheCallback");
+            auto filePrefs = _p->context->filePrefs();
+
+            // There is no tier below the disk cache, so its items are removed
+            // when the settings change.
+            _p->spill.reset();
+            _p->removeStaleRefs();
+            if (filePrefs->hasDiskCache())
+            {
+                try
+                {
+                    _p->spill.reset(new FileSpillCache(
+                        filePrefs->diskCachePath(),
+                        static_cast<quint64>(filePrefs->diskCacheSizeGB()) * Core::Memory::gigabyte));
+                }
+                catch (const Core::Error & error)
+                {
+                    _p->context->printError(error);
+                }
+            }
+            Q_EMIT cacheChanged();
         }
 
     } // namespace ViewLib
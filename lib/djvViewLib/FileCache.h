@@ -31,11 +31,14 @@
 
 #include <djvViewLib/ViewLib.h>
 
+#include <djvAV/PixelData.h>
+
 #include <djvCore/Sequence.h>
 #include <djvCore/Time.h>
 #include <djvCore/Util.h>
 
 #include <QObject>
+#include <QStringList>
 
 #include <memory>
 #include <map>
@@ -52,19 +55,52 @@ namespace djv
     {
         class ViewContext;
 
+        //! This struct provides a file cache key.
+        //!
+        //! Items are identified by the source they are read from: the file, the
+        //! frame in the file, the file modification time and size, and the
+        //! layer, proxy scale, and 8-bit conversion. Windows that show the same
+        //! source share the cached item. The window and frame index record which
+        //! window asked for the item and are not part of its identity.
         struct FileCacheKey
         {
             FileCacheKey();
             FileCacheKey(void * window, qint64 frame);
 
-            void * window = nullptr;
-            qint64 frame = 0;
-            ::time_t timestamp = 0;
+            void *                   window       = nullptr;
+            qint64                   frame        = 0;
+            QString                  source;
+            qint64                   sourceFrame  = -1;
+            qint64                   sourceTime   = 0;
+            qint64                   sourceSize   = 0;
+            int                      layer        = 0;
+            AV::PixelDataInfo::PROXY proxy        = AV::PixelDataInfo::PROXY_NONE;
+            bool                     u8Conversion = false;
+            ::time_t                 timestamp    = 0;
+
+            //! Get whether the keys have the same layer, proxy scale, and 8-bit
+            //! conversion.
+            bool isSameVariant(const FileCacheKey &) const;
 
             bool operator < (const FileCacheKey &) const;
         };
 
         //! This class provides the file cache.
+        //!
+        //! The cache keeps track of which windows reference each item. Clearing
+        //! the items of a window only removes the items that no other window
+        //! references.
+        //!
+        //! Items are kept in memory, and when the disk cache is enabled the
+        //! least recently used items are moved to disk instead of being
+        //! discarded. When compression is enabled only the most recently used
+        //! items are kept as they are, the rest of the memory cache holds
+        //! compressed items.
+        //!
+        //! When the adaptive cache size is enabled the maximum size follows the
+        //! memory available to the process, within the minimum and maximum
+        //! sizes from the preferences. The available memory is polled, and on
+        //! Linux the cache also responds to memory pressure notifications.
         class FileCache : public QObject
         {
             Q_OBJECT
@@ -73,29 +109,68 @@ namespace djv
             explicit FileCache(const QPointer<ViewContext> &, QObject * parent = nullptr);
             ~FileCache() override;
 
+            //! This enumeration provides the cache tiers.
+            enum TIER
+            {
+                MEMORY,
+                COMPRESSED,
+                DISK,
+
+                TIER_COUNT
+            };
+            Q_ENUM(TIER);
+
+            //! Get the cache tier labels.
+            static const QStringList & tierLabels();
+
             //! Get whether the cache contains an item.
             bool hasItem(const FileCacheKey &);
 
-            //! Get an item from the cache.
-            std::shared_ptr<AV::Image> item(const FileCacheKey &) const;
+            //! Get whether the given cache tier contains an item.
+            bool hasItem(const FileCacheKey &, TIER);
+
+            //! Get an item from the cache. Items that are compressed or on disk
+            //! are moved back into memory. Returns nullptr if the item is not in
+            //! the cache.
+            std::shared_ptr<AV::Image> item(const FileCacheKey &);
+
+            //! Get the size in bytes of an item in memory, including compressed
+            //! items, or zero if the item is not in memory.
+            quint64 itemByteCount(const FileCacheKey &) const;
 
             //! Add an item to the cache.
             void addItem(const FileCacheKey &, const std::shared_ptr<AV::Image> &);
 
-            //! Remove all items with a zero reference count that match the given window.
+            //! Add a reference to an item from the window of the given key.
+            void addReference(const FileCacheKey &);
+
+            //! Remove the references of the given window, and the items that are
+            //! no longer referenced by any window.
             void clearItems(void *);
 
-            //! Remove all items with a zero reference count.
+            //! Remove all items from every tier, along with their references.
             void clear();
 
             //! Remove an item.
             void removeItem(const FileCacheKey &);
 
-            //! Get the list of items that match the given window.
+            //! Remove all variants of the given frame of a window. The items are
+            //! removed for every window that references them.
+            void clearItems(void *, qint64 frame);
+
+            //! Set the variant displayed by the window of the given key. Items of
+            //! other variants are removed from memory first when the cache is
+            //! full.
+            void setVariant(const FileCacheKey &);
+
+            //! Remove the variant of a window that is being closed.
+            void removeVariant(void * window);
+
+            //! Get the list of items referenced by the given window.
             std::vector<std::shared_ptr<AV::Image> > items(void *);
 
-            //! Get the list of frames that match the given window. The frames are sorted in
-            //! ascending order.
+            //! Get the list of frames referenced by the given window that match
+            //! the variant it displays. The frames are sorted in ascending order.
             Core::FrameList frames(void *);
 
             //! Get the maximum cache size in gigabytes.
@@ -104,6 +179,9 @@ namespace djv
             //! Get the maximum cache size in bytes.
             quint64 maxSizeBytes() const;
 
+            //! Get whether the cache size adapts to the available memory.
+            bool isAdaptive() const;
+
             //! Get the current size in gigabytes for the given window.
             float currentSizeGB(void *) const;
 
@@ -113,6 +191,33 @@ namespace djv
             //! Get the current cache size in bytes.
             quint64 currentSizeBytes() const;
 
+            //! Get whether compression is active.
+            bool hasCompression() const;
+
+            //! Get the size in gigabytes of the compressed items.
+            float compressedSizeGB() const;
+
+            //! Get the compression ratio of the compressed items.
+            float compressionRatio() const;
+
+            //! Get whether the disk cache is active.
+            bool hasDiskCache() const;
+
+            //! Get the maximum disk cache size in gigabytes.
+            float diskMaxSizeGB() const;
+
+            //! Get the current disk cache size in gigabytes.
+            float diskCurrentSizeGB() const;
+
+            //! Get the number of cache hits for the given tier.
+            quint64 hits(TIER) const;
+
+            //! Get the number of cache misses for the given tier.
+            quint64 misses(TIER) const;
+
+            //! Get the number of items that are referenced by a window.
+            size_t referenceCount() const;
+
             //! Get the cache size defaults in gigabytes.
             static const QVector<float> & sizeGBDefaults();
 
@@ -127,14 +232,30 @@ namespace djv
             //! This signal is emitted when the cache is modified.
             void cacheChanged();
 
+            //! This signal is emitted when the maximum cache size is changed.
+            void maxSizeGBChanged(float);
+
+        protected:
+            void timerEvent(QTimerEvent *) override;
+
         private Q_SLOTS:
             void cacheEnabledCallback(bool);
             void cacheSizeGBCallback(float);
+            void adaptiveCallback();
+            void budgetUpdate();
+            void compressionCallback();
+            void diskCacheCallback();
 
         private:
-            void removeItem(int index);
+            void insertItem(const FileCacheKey &, const std::shared_ptr<AV::Image> &);
+
+            void setMaxSizeBytes(quint64);
+
+            // Get whether the cache is larger than the maximum.
+            bool isFull() const;
 
-            // Delete null references only if the cache size exceeds the maximum.
+            // Compress or move to disk the least recently used items until the
+            // cache size is below the maximum.
             void purge();
 
             DJV_PRIVATE_COPY(FileCache);
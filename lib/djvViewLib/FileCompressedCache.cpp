@@ -0,0 +1,299 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvViewLib/FileCompressedCache.h>
+
+#include <djvAV/CompressedPixelData.h>
+#include <djvAV/Image.h>
+
+#include <djvCore/Trace.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        struct FileCompressedCache::Private
+        {
+            struct Entry
+            {
+                quint64                                  id        = 0;
+                quint64                                  tick      = 0;
+                quint64                                  byteCount = 0;
+                std::shared_ptr<AV::Image>               image;
+                std::shared_ptr<AV::CompressedPixelData> data;
+                AV::Tags                                 tags;
+                AV::ColorProfile                         colorProfile;
+            };
+
+            struct Job
+            {
+                FileCacheKey key;
+                quint64      id = 0;
+            };
+
+            // These are shared with the compression thread.
+            mutable std::mutex              mutex;
+            std::condition_variable         cv;
+            std::map<FileCacheKey, Entry>   entries;
+            std::map<quint64, FileCacheKey> lru;
+            std::deque<Job>                 jobs;
+            quint64                         id         = 0;
+            quint64                         cacheBytes = 0;
+            bool                            stop       = false;
+            std::thread                     thread;
+
+            // These must be called with the mutex locked.
+            Entry take(std::map<FileCacheKey, Entry>::iterator);
+            void remove(std::map<FileCacheKey, Entry>::iterator);
+
+            static std::shared_ptr<AV::Image> image(const Entry &);
+
+            void run();
+        };
+
+        FileCompressedCache::Private::Entry FileCompressedCache::Private::take(std::map<FileCacheKey, Entry>::iterator i)
+        {
+            Entry out = std::move(i->second);
+            cacheBytes -= out.byteCount;
+            lru.erase(out.tick);
+            entries.erase(i);
+            return out;
+        }
+
+        void FileCompressedCache::Private::remove(std::map<FileCacheKey, Entry>::iterator i)
+        {
+            take(i);
+        }
+
+        std::shared_ptr<AV::Image> FileCompressedCache::Private::image(const Entry & entry)
+        {
+            std::shared_ptr<AV::Image> out = entry.image;
+            if (!out)
+            {
+                out = std::shared_ptr<AV::Image>(new AV::Image);
+                entry.data->decompress(*out);
+                out->tags = entry.tags;
+                out->colorProfile = entry.colorProfile;
+            }
+            return out;
+        }
+
+        void FileCompressedCache::Private::run()
+        {
+            DJV_TRACE_THREAD("FileCompressedCache");
+            while (1)
+            {
+                Job job;
+                std::shared_ptr<AV::Image> image;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this] { return stop || jobs.size(); });
+                    if (stop)
+                        return;
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                    auto i = entries.find(job.key);
+                    if (i == entries.end() || i->second.id != job.id)
+                        continue;
+                    image = i->second.image;
+                }
+                std::shared_ptr<AV::CompressedPixelData> data;
+                try
+                {
+                    DJV_TRACE_ZONE("djv::ViewLib::FileCompressedCache::compress");
+                    data = std::shared_ptr<AV::CompressedPixelData>(new AV::CompressedPixelData(*image));
+                }
+                catch (const std::exception &)
+                {
+                    // Keep the image uncompressed.
+                    continue;
+                }
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    auto i = entries.find(job.key);
+                    if (i != entries.end() && i->second.id == job.id)
+                    {
+                        cacheBytes -= i->second.byteCount;
+                        i->second.byteCount = data->byteCount();
+                        cacheBytes += i->second.byteCount;
+                        i->second.data = data;
+                        i->second.image.reset();
+                    }
+                }
+            }
+        }
+
+        FileCompressedCache::FileCompressedCache() :
+            _p(new Private)
+        {
+            _p->thread = std::thread(&Private::run, _p.get());
+        }
+
+        FileCompressedCache::~FileCompressedCache()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->stop = true;
+            }
+            _p->cv.notify_one();
+            _p->thread.join();
+        }
+
+        quint64 FileCompressedCache::currentSizeBytes() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->cacheBytes;
+        }
+
+        quint64 FileCompressedCache::dataByteCount() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            quint64 out = 0;
+            for (const auto & i : _p->entries)
+            {
+                if (i.second.data)
+                {
+                    out += i.second.data->dataByteCount();
+                }
+            }
+            return out;
+        }
+
+        quint64 FileCompressedCache::compressedByteCount() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            quint64 out = 0;
+            for (const auto & i : _p->entries)
+            {
+                if (i.second.data)
+                {
+                    out += i.second.data->byteCount();
+                }
+            }
+            return out;
+        }
+
+        bool FileCompressedCache::hasItem(const FileCacheKey & key) const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->entries.find(key) != _p->entries.end();
+        }
+
+        quint64 FileCompressedCache::itemByteCount(const FileCacheKey & key) const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            auto i = _p->entries.find(key);
+            return i != _p->entries.end() ? i->second.byteCount : 0;
+        }
+
+        std::shared_ptr<AV::Image> FileCompressedCache::takeItem(const FileCacheKey & key)
+        {
+            Private::Entry entry;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                auto i = _p->entries.find(key);
+                if (i == _p->entries.end())
+                    return nullptr;
+                entry = _p->take(i);
+            }
+            return Private::image(entry);
+        }
+
+        bool FileCompressedCache::takeLeastRecent(FileCacheKey & key, std::shared_ptr<AV::Image> & image, quint64 & tick)
+        {
+            Private::Entry entry;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                if (_p->lru.empty())
+                    return false;
+                auto i = _p->entries.find(_p->lru.begin()->second);
+                key = i->first;
+                entry = _p->take(i);
+            }
+            tick = entry.tick;
+            image = Private::image(entry);
+            return true;
+        }
+
+        void FileCompressedCache::addItem(const FileCacheKey & key, const std::shared_ptr<AV::Image> & image, quint64 tick)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                auto i = _p->entries.find(key);
+                if (i != _p->entries.end())
+                {
+                    _p->remove(i);
+                }
+                Private::Entry entry;
+                entry.id           = ++_p->id;
+                entry.tick         = tick;
+                entry.byteCount    = image->dataByteCount();
+                entry.image        = image;
+                entry.tags         = image->tags;
+                entry.colorProfile = image->colorProfile;
+                _p->entries[key] = entry;
+                _p->lru[tick] = key;
+                _p->cacheBytes += entry.byteCount;
+                Private::Job job;
+                job.key = key;
+                job.id  = entry.id;
+                _p->jobs.push_back(job);
+            }
+            _p->cv.notify_one();
+        }
+
+        void FileCompressedCache::removeItem(const FileCacheKey & key)
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            auto i = _p->entries.find(key);
+            if (i != _p->entries.end())
+            {
+                _p->remove(i);
+            }
+        }
+
+        void FileCompressedCache::clear()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->entries.clear();
+            _p->lru.clear();
+            _p->jobs.clear();
+            _p->cacheBytes = 0;
+        }
+
+    } // namespace ViewLib
+} // namespace djv
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvViewLib/FileCache.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        //! This class provides the compressed tier of the file cache.
+        //!
+        //! Images are compressed by a separate thread after they are added;
+        //! until then they are kept as they are. The sizes include the images
+        //! that are waiting to be compressed.
+        class FileCompressedCache
+        {
+        public:
+            FileCompressedCache();
+            ~FileCompressedCache();
+
+            //! Get the current cache size in bytes.
+            quint64 currentSizeBytes() const;
+
+            //! Get the uncompressed size in bytes of the compressed items.
+            quint64 dataByteCount() const;
+
+            //! Get the compressed size in bytes of the compressed items.
+            quint64 compressedByteCount() const;
+
+            //! Get whether the cache contains an item.
+            bool hasItem(const FileCacheKey &) const;
+
+            //! Get the size in bytes of an item, or zero if the item is not in
+            //! the cache.
+            quint64 itemByteCount(const FileCacheKey &) const;
+
+            //! Take an item out of the cache, returning nullptr if the item is not
+            //! in the cache.
+            //!
+            //! Throws:
+            //! - Core::Error
+            std::shared_ptr<AV::Image> takeItem(const FileCacheKey &);
+
+            //! Take the least recently used item out of the cache. Returns false
+            //! if the cache is empty.
+            //!
+            //! Throws:
+            //! - Core::Error
+            bool takeLeastRecent(FileCacheKey &, std::shared_ptr<AV::Image> &, quint64 & tick);
+
+            //! Add an item to the cache.
+            void addItem(const FileCacheKey &, const std::shared_ptr<AV::Image> &, quint64 tick);
+
+            //! Remove an item.
+            void removeItem(const FileCacheKey &);
+
+            //! Remove all items.
+            void clear();
+
+        private:
+            DJV_PRIVATE_COPY(FileCompressedCache);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
@@ -53,15 +53,27 @@
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/FrameStats.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Trace.h>
 
 #include <QApplication>
+#include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
 
 namespace djv
 {
     namespace ViewLib
     {
+        namespace
+        {
+            const int watchTimeout = 500;
+
+        } // namespace
+
         struct FileGroup::Private
         {
             Private(const QPointer<ViewContext> & context) :
@@ -84,7 +96,105 @@ namespace djv
             bool                             preloadActive = false;
             int                              preloadTimer  = 0;
             qint64                           preloadFrame  = 0;
+            QPointer<QFileSystemWatcher>     watcher;
+            QPointer<QTimer>                 watchTimer;
             QPointer<FileActions>            actions;
+
+            struct Source
+            {
+                QString fileName;
+                qint64  time = 0;
+                qint64  size = 0;
+            };
+
+            // The sources are looked up once per frame until the file is
+            // opened or reloaded.
+            mutable std::map<qint64, Source> sources;
+
+            qint64 sourceFrame(qint64 frame) const
+            {
+                return ioInfo.sequence.frames.count() ? ioInfo.sequence.frames[frame] : -1;
+            }
+
+            const Source & source(qint64 frame) const
+            {
+                auto i = sources.find(frame);
+                if (i == sources.end())
+                {
+                    const QFileInfo info(fileInfo.fileName(sourceFrame(frame)));
+                    Source source;
+                    source.fileName = info.canonicalFilePath();
+                    if (source.fileName.isEmpty())
+                    {
+                        source.fileName = info.absoluteFilePath();
+                    }
+                    source.time = info.lastModified().toMSecsSinceEpoch();
+                    source.size = info.size();
+                    i = sources.insert(std::make_pair(frame, source)).first;
+                }
+                return i->second;
+            }
+
+            FileCacheKey cacheKey(void * window, qint64 frame) const
+            {
+                FileCacheKey out(window, frame);
+                const Source & source = this->source(frame);
+                out.source       = source.fileName;
+                out.sourceFrame  = sourceFrame(frame);
+                out.sourceTime   = source.time;
+                out.sourceSize   = source.size;
+                out.layer        = layer;
+                out.proxy        = proxy;
+                out.u8Conversion = u8Conversion;
+                return out;
+            }
+
+            // Make a proxy scaled image from a full resolution image in the
+            // cache instead of reading the file again. The same sampling is
+            // used as when the file is read with a proxy scale.
+            std::shared_ptr<AV::Image> proxyItem(const QPointer<FileCache> & cache, const FileCacheKey & key) const
+            {
+                std::shared_ptr<AV::Image> out;
+                if (AV::PixelDataInfo::PROXY_NONE == key.proxy)
+                    return out;
+                FileCacheKey fullKey = key;
+                fullKey.proxy = AV::PixelDataInfo::PROXY_NONE;
+                if (!cache->hasItem(fullKey))
+                    return out;
+                const auto full = cache->item(fullKey);
+                if (full && full->isValid() && AV::PixelDataInfo::PROXY_NONE == full->info().proxy)
+                {
+                    AV::PixelDataInfo info(full->info());
+                    info.size = AV::PixelDataUtil::proxyScale(info.size, key.proxy);
+                    info.proxy = key.proxy;
+                    out = std::shared_ptr<AV::Image>(new AV::Image(info));
+                    out->tags = full->tags;
+                    out->colorProfile = full->colorProfile;
+                    AV::PixelDataUtil::proxyScale(*full, *out, key.proxy);
+                }
+                return out;
+            }
+
+            // Convert an image to 8-bits. The conversion is done on the CPU
+            // when it is supported so that the OpenGL context is not needed.
+            std::shared_ptr<AV::Image> u8Image(
+                const std::shared_ptr<AV::Image> & in,
+                const QPointer<ViewContext> &      context)
+            {
+                AV::PixelDataInfo info(in->info());
+                info.pixel = AV::Pixel::pixel(AV::Pixel::format(info.pixel), AV::Pixel::U8);
+                auto out = std::shared_ptr<AV::Image>(new AV::Image(info));
+                out->tags = in->tags;
+                if (!AV::PixelDataUtil::convertU8(*in, *out, in->colorProfile))
+                {
+                    context->makeGLContextCurrent();
+                    AV::OpenGLImageOptions options;
+                    options.colorProfile = in->colorProfile;
+                    options.proxyScale = false;
+                    openGLImage->copy(*in, *out, options);
+                }
+                return out;
+            }
         };
 
         FileGroup::FileGroup(
@@ -109,6 +219,12 @@ namespace djv
             // Create the actions.
             _p->actions = new FileActions(context, this);
 
+            // Changes are collected for a short time before reloading, so
+            // that a sequence being written is not reloaded for every file.
+            _p->watchTimer = new QTimer(this);
+            _p->watchTimer->setSingleShot(true);
+            _p->watchTimer->setInterval(watchTimeout);
+
             // Initialize.
             if (copy)
             {
@@ -116,6 +232,7 @@ namespace djv
             }
             context->makeGLContextCurrent();
             _p->openGLImage.reset(new AV::OpenGLImage);
+            cacheVariantUpdate();
             preloadUpdate();
             update();
 
@@ -180,6 +297,14 @@ namespace djv
                 _p->actions->action(FileActions::DEBUG_LOG),
                 SIGNAL(triggered()),
                 SLOT(debugLogCallback()));
+            connect(
+                _p->actions->action(FileActions::EXPORT_FRAME_STATS),
+                SIGNAL(triggered()),
+                SLOT(exportFrameStatsCallback()));
+            connect(
+                _p->actions->action(FileActions::EXPORT_TRACE),
+                SIGNAL(triggered()),
+                SLOT(exportTraceCallback()));
             connect(
                 _p->actions->action(FileActions::EXIT),
                 SIGNAL(triggered()),
@@ -221,11 +346,19 @@ namespace djv
                 context->filePrefs(),
                 SIGNAL(preloadChanged(bool)),
                 SLOT(setPreload(bool)));
+            connect(
+                context->filePrefs(),
+                SIGNAL(autoReloadChanged(bool)),
+                SLOT(watchUpdate()));
 
             // Setup other callbacks.
             connect(
                 context->ioFactory(),
                 SIGNAL(optionChanged()),
+                SLOT(ioOptionCallback()));
+            connect(
+                _p->watchTimer,
+                SIGNAL(timeout()),
                 SLOT(reloadCallback()));
         }
 
@@ -237,6 +370,7 @@ namespace djv
                 _p->preloadTimer = 0;
             }
             cacheDel();
+            context()->fileCache()->removeVariant(session());
             if (_p->openGLImage)
             {
                 context()->makeGLContextCurrent();
@@ -289,21 +423,19 @@ namespace djv
             //DJV_DEBUG("FileGroup::image");
             //DJV_DEBUG_PRINT("frame = " << frame);
             std::shared_ptr<AV::Image> out;
-            context()->makeGLContextCurrent();
             auto cache = context()->fileCache();
-            const auto key = FileCacheKey(session(), frame);
-            if (cache->hasItem(key))
+            const auto key = _p->cacheKey(session(), frame);
+            out = cache->item(key);
+            if (!out)
             {
-                out = cache->item(key);
-            }
-            else
-            {
-                if (_p->load)
+                out = _p->proxyItem(cache, key);
+                if (!out && _p->load)
                 {
                     //DJV_DEBUG_PRINT("loading image");
                     out = std::shared_ptr<AV::Image>(new AV::Image);
                     try
                     {
+                        Core::FrameStats::Scope scope(Core::FrameStats::READ, _p->sourceFrame(frame));
                         _p->load->read(
                             *out,
                             AV::ImageIOInfo(
@@ -325,15 +457,8 @@ namespace djv
                         if (_p->u8Conversion)
                         {
                             //DJV_DEBUG_PRINT("u8 conversion");
-                            AV::PixelDataInfo info(out->info());
-                            info.pixel = AV::Pixel::pixel(AV::Pixel::format(info.pixel), AV::Pixel::U8);
-                            auto tmp = out;
-                            out = std::shared_ptr<AV::Image>(new AV::Image(info));
-                            out->tags = tmp->tags;
-                            AV::OpenGLImageOptions options;
-                            options.colorProfile = tmp->colorProfile;
-                            options.proxyScale = false;
-                            _p->openGLImage->copy(*tmp, *out, options);
+                            Core::FrameStats::Scope scope(Core::FrameStats::CONVERT, _p->sourceFrame(frame));
+                            out = _p->u8Image(out, context());
                         }
                     }
                     catch (Core::Error error)
@@ -348,6 +473,7 @@ namespace djv
                 if (_p->cacheEnabled && out)
                 {
                     //DJV_DEBUG_PRINT("cache image");
+                    Core::FrameStats::Scope scope(Core::FrameStats::CACHE, _p->sourceFrame(frame));
                     cache->addItem(key, out);
                 }
             }
@@ -410,7 +536,9 @@ namespace djv
                 _p->layers += _p->ioInfo.layers[i].layerName;
             }
 
+            cacheVariantUpdate();
             preloadUpdate();
+            watchUpdate();
             update();
 
             Q_EMIT fileInfoChanged(_p->fileInfo);
@@ -427,7 +555,7 @@ namespace djv
             //DJV_DEBUG_PRINT("layer list = " << size);
             _p->layer = Core::Math::wrap(layer, 0, count - 1);
             //DJV_DEBUG_PRINT("layer = " << _layer);
-            cacheDel();
+            cacheVariantUpdate();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -440,7 +568,7 @@ namespace djv
             //DJV_DEBUG("FileGroup::setProxy");
             //DJV_DEBUG_PRINT("proxy = " << proxy);
             _p->proxy = proxy;
-            cacheDel();
+            cacheVariantUpdate();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -451,7 +579,7 @@ namespace djv
             if (conversion == _p->u8Conversion)
                 return;
             _p->u8Conversion = conversion;
-            cacheDel();
+            cacheVariantUpdate();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -523,14 +651,18 @@ namespace djv
                 frameCount < totalFrames;
                 frame = Core::Math::wrap<qint64>(frame + 1, 0, totalFrames - 1), ++frameCount)
             {
-                const auto key = FileCacheKey(session(), frame);
-                if (cache->hasItem(key))
+                const auto key = _p->cacheKey(session(), frame);
+                if (const quint64 itemByteCount = cache->itemByteCount(key))
                 {
-                    byteCount += cache->item(key)->dataByteCount();
+                    // The item may have been loaded by another window.
+                    cache->addReference(key);
+                    byteCount += itemByteCount;
                 }
                 else
                 {
-                    byteCount += AV::PixelDataUtil::dataByteCount(_p->ioInfo.layers[0]);
+                    AV::PixelDataInfo info = _p->ioInfo.layers[0];
+                    info.size = AV::PixelDataUtil::proxyScale(info.size, _p->proxy);
+                    byteCount += AV::PixelDataUtil::dataByteCount(info);
                     if (byteCount <= cache->maxSizeBytes())
                     {
                         preload = true;
@@ -544,34 +676,40 @@ namespace djv
 
             if (preload)
             {
-                context()->makeGLContextCurrent();
+                const auto key = _p->cacheKey(session(), frame);
+                if (cache->hasItem(key, FileCache::DISK) && cache->item(key))
+                {
+                    // The image was read back from the disk cache.
+                    return;
+                }
+                if (auto image = _p->proxyItem(cache, key))
+                {
+                    cache->addItem(key, image);
+                    return;
+                }
                 auto image = std::shared_ptr<AV::Image>(new AV::Image);
                 if (_p->load)
                 {
                     //DJV_DEBUG_PRINT("loading image");
                     try
                     {
-                        _p->load->read(
-                            *image,
-                            AV::ImageIOInfo(
-                                _p->ioInfo.sequence.frames.count() ?
-                                _p->ioInfo.sequence.frames[frame] :
-                                -1,
-                                _p->layer,
-                                _p->proxy));
+                        {
+                            Core::FrameStats::Scope scope(Core::FrameStats::READ, _p->sourceFrame(frame));
+                            _p->load->read(
+                                *image,
+                                AV::ImageIOInfo(
+                                    _p->ioInfo.sequence.frames.count() ?
+                                    _p->ioInfo.sequence.frames[frame] :
+                                    -1,
+                                    _p->layer,
+                                    _p->proxy));
+                        }
                         if (image->isValid() && _p->u8Conversion)
                         {
                             //DJV_DEBUG_PRINT("u8 conversion");
                             //DJV_DEBUG_PRINT("image = " << *image);
-                            AV::PixelDataInfo info(image->info());
-                            info.pixel = AV::Pixel::pixel(AV::Pixel::format(info.pixel), AV::Pixel::U8);
-                            auto tmp = image;
-                            image = std::shared_ptr<AV::Image>(new AV::Image(info));
-                            image->tags = tmp->tags;
-                            AV::OpenGLImageOptions options;
-                            options.colorProfile = tmp->colorProfile;
-                            options.proxyScale = false;
-                            _p->openGLImage->copy(*tmp, *image, options);
+                            Core::FrameStats::Scope scope(Core::FrameStats::CONVERT, _p->sourceFrame(frame));
+                            image = _p->u8Image(image, context());
                         }
                     }
                     catch (const Core::Error &)
@@ -581,7 +719,8 @@ namespace djv
                 if (image->isValid())
                 {
                     //DJV_DEBUG_PRINT("image = " << *image);
-                    cache->addItem(FileCacheKey(session(), frame), image);
+                    Core::FrameStats::Scope scope(Core::FrameStats::CACHE, _p->sourceFrame(frame));
+                    cache->addItem(key, image);
                 }
             }
             else
@@ -626,28 +765,7 @@ namespace djv
         void FileGroup::reloadCallback()
         {
             //DJV_DEBUG("FileGroup::reloadCallback");
-            if (context()->imagePrefs()->hasFrameStoreFileReload())
-            {
-                Q_EMIT setFrameStore();
-            }
-            cacheDel();
-            _p->load.reset();
-            if (!_p->fileInfo.fileName().isEmpty())
-            {
-                try
-                {
-                    _p->load = context()->ioFactory()->load(_p->fileInfo, _p->ioInfo);
-                }
-                catch (Core::Error error)
-                {
-                    error.add(
-                        Enum::errorLabels()[Enum::ERROR_OPEN_IMAGE].
-                        arg(QDir::toNativeSeparators(_p->fileInfo)));
-
-                    context()->printError(error);
-                }
-            }
-            Q_EMIT imageChanged();
+            reload(false);
         }
 
         void FileGroup::reloadFrameCallback()
@@ -676,6 +794,17 @@ namespace djv
             Q_EMIT imageChanged();
         }
 
+        void FileGroup::ioOptionCallback()
+        {
+            //DJV_DEBUG("FileGroup::ioOptionCallback");
+            reload(true);
+        }
+
+        void FileGroup::watchCallback()
+        {
+            _p->watchTimer->start();
+        }
+
         void FileGroup::closeCallback()
         {
             //DJV_DEBUG("FileGroup::closeCallback");
@@ -784,6 +913,69 @@ namespace djv
             dialog->activateWindow();
         }
 
+        void FileGroup::exportFrameStatsCallback()
+        {
+            //DJV_DEBUG("FileGroup::exportFrameStatsCallback");
+            // Take the samples before the file browser is shown so they only
+            // cover the playback up to now.
+            const auto samples = Core::FrameStats::samples();
+            UI::FileBrowser * fileBrowser = context()->fileBrowser(
+                qApp->translate("djv::ViewLib::FileGroup", "Export Frame Statistics"));
+            if (fileBrowser->exec() == QDialog::Accepted)
+            {
+                const Core::FileInfo & fileInfo = fileBrowser->fileInfo();
+                //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+                if (Core::FileInfoUtil::exists(fileInfo))
+                {
+                    UI::QuestionDialog dialog(
+                        qApp->translate("djv::ViewLib::FileGroup", "Overwrite existing file \"%1\"?").
+                        arg(QDir::toNativeSeparators(fileInfo)));
+                    if (dialog.exec() != QDialog::Accepted)
+                    {
+                        return;
+                    }
+                }
+                try
+                {
+                    Core::FrameStats::write(fileInfo, samples);
+                }
+                catch (const Core::Error & error)
+                {
+                    context()->printError(error);
+                }
+            }
+        }
+
+        void FileGroup::exportTraceCallback()
+        {
+            //DJV_DEBUG("FileGroup::exportTraceCallback");
+            UI::FileBrowser * fileBrowser = context()->fileBrowser(
+                qApp->translate("djv::ViewLib::FileGroup", "Export Trace"));
+            if (fileBrowser->exec() == QDialog::Accepted)
+            {
+                const Core::FileInfo & fileInfo = fileBrowser->fileInfo();
+                //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+                if (Core::FileInfoUtil::exists(fileInfo))
+                {
+                    UI::QuestionDialog dialog(
+                        qApp->translate("djv::ViewLib::FileGroup", "Overwrite existing file \"%1\"?").
+                        arg(QDir::toNativeSeparators(fileInfo)));
+                    if (dialog.exec() != QDialog::Accepted)
+                    {
+                        return;
+                    }
+                }
+                try
+                {
+                    Core::Trace::write(fileInfo);
+                }
+                catch (const Core::Error & error)
+                {
+                    context()->printError(error);
+                }
+            }
+        }
+
         void FileGroup::preloadUpdate()
         {
             if (_p->cacheEnabled && _p->preload && _p->preloadActive)
@@ -816,10 +1008,146 @@ namespace djv
             _p->actions->group(FileActions::PROXY_GROUP)->actions()[_p->proxy]->setChecked(true);
        }
 
+        void FileGroup::watchUpdate()
+        {
+            //DJV_DEBUG("FileGroup::watchUpdate");
+            delete _p->watcher;
+            _p->watchTimer->stop();
+            if (context()->filePrefs()->hasAutoReload() && !_p->fileInfo.fileName().isEmpty())
+            {
+                _p->watcher = new QFileSystemWatcher(this);
+                if (Core::FileInfo::SEQUENCE == _p->fileInfo.type())
+                {
+                    // Watch the directory so that new frames are seen.
+                    _p->watcher->addPath(_p->fileInfo.path());
+                    connect(
+                        _p->watcher,
+                        SIGNAL(directoryChanged(const QString &)),
+                        SLOT(watchCallback()));
+                }
+                else
+                {
+                    _p->watcher->addPath(_p->fileInfo.fileName());
+                    connect(
+                        _p->watcher,
+                        SIGNAL(fileChanged(const QString &)),
+                        SLOT(watchCallback()));
+                }
+            }
+        }
+
+        void FileGroup::reload(bool all)
+        {
+            if (context()->imagePrefs()->hasFrameStoreFileReload())
+            {
+                Q_EMIT setFrameStore();
+            }
+            if (all || !reloadChanged())
+            {
+                cacheDel();
+                _p->load.reset();
+                if (!_p->fileInfo.fileName().isEmpty())
+                {
+                    try
+                    {
+                        _p->load = context()->ioFactory()->load(_p->fileInfo, _p->ioInfo);
+                    }
+                    catch (Core::Error error)
+                    {
+                        error.add(
+                            Enum::errorLabels()[Enum::ERROR_OPEN_IMAGE].
+                            arg(QDir::toNativeSeparators(_p->fileInfo)));
+
+                        context()->printError(error);
+                    }
+                }
+                watchUpdate();
+            }
+            Q_EMIT imageChanged();
+        }
+
+        bool FileGroup::reloadChanged()
+        {
+            //DJV_DEBUG("FileGroup::reloadChanged");
+            if (!_p->load || _p->fileInfo.fileName().isEmpty())
+                return false;
+
+            // Remove the frames that have changed since they were cached.
+            auto cache = context()->fileCache();
+            int changed = 0;
+            for (auto i = _p->sources.begin(); i != _p->sources.end();)
+            {
+                const QFileInfo info(i->second.fileName);
+                if (info.lastModified().toMSecsSinceEpoch() != i->second.time ||
+                    info.size() != i->second.size)
+                {
+                    if (Core::FileInfo::SEQUENCE != _p->fileInfo.type())
+                        return false;
+                    cache->clearItems(session(), i->first);
+                    i = _p->sources.erase(i);
+                    ++changed;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            // Find new frames at the end of the sequence. Frames that were
+            // inserted or removed need a full reload.
+            Core::FrameList frames;
+            if (Core::FileInfo::SEQUENCE == _p->fileInfo.type())
+            {
+                const Core::FileInfoList items = Core::FileInfoUtil::list(_p->fileInfo.path());
+                const Core::FileInfo * match = nullptr;
+                for (int i = 0; i < items.count(); ++i)
+                {
+                    if (items[i].isSequenceValid() &&
+                        items[i].extension() == _p->fileInfo.extension() &&
+                        items[i].base() == _p->fileInfo.base())
+                    {
+                        match = &items[i];
+                        break;
+                    }
+                }
+                if (!match)
+                    return false;
+                const Core::FrameList & current = _p->fileInfo.sequence().frames;
+                const Core::FrameList & found = match->sequence().frames;
+                if (found.count() < current.count() || found.mid(0, current.count()) != current)
+                    return false;
+                frames = found.mid(current.count());
+                if (frames.count())
+                {
+                    Core::Sequence sequence = _p->fileInfo.sequence();
+                    sequence.frames += frames;
+                    _p->fileInfo.setSequence(sequence);
+                    _p->ioInfo.sequence.frames += frames;
+                }
+            }
+
+            DJV_LOG(context()->debugLog(), "djv::ViewLib::FileGroup",
+                QString("Reload changed frames = %1, new frames = %2").arg(changed).arg(frames.count()));
+
+            if (frames.count())
+            {
+                Q_EMIT ioInfoChanged(_p->ioInfo);
+                Q_EMIT framesAppended(frames);
+            }
+            preloadUpdate();
+            return true;
+        }
+
         void FileGroup::cacheDel()
         {
             //DJV_DEBUG("FileGroup::cacheDel");
             context()->fileCache()->clearItems(session());
+            _p->sources.clear();
+        }
+
+        void FileGroup::cacheVariantUpdate()
+        {
+            context()->fileCache()->setVariant(_p->cacheKey(session(), 0));
         }
 
     } // namespace ViewLib
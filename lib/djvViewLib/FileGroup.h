@@ -123,6 +123,10 @@ namespace djv
             //! This signal is emitted when the I/O information is changed.
             void ioInfoChanged(const djv::AV::IOInfo &);
 
+            //! This signal is emitted when new frames are found at the end of
+            //! the sequence on reload.
+            void framesAppended(const djv::Core::FrameList &);
+
             //! This signal is emitted when the current image is changed.
             void imageChanged();
 
@@ -147,6 +151,8 @@ namespace djv
             void recentCallback(QAction *);
             void reloadCallback();
             void reloadFrameCallback();
+            void ioOptionCallback();
+            void watchCallback();
             void closeCallback();
             void exportSequenceCallback();
             void exportFrameCallback();
@@ -158,12 +164,21 @@ namespace djv
             void messagesCallback();
             void prefsCallback();
             void debugLogCallback();
+            void exportFrameStatsCallback();
+            void exportTraceCallback();
 
             void preloadUpdate();
             void update();
+            void watchUpdate();
 
         private:
+            //! Reload the file. Unless all is set only the frames that have
+            //! changed on disk are removed from the cache.
+            void reload(bool all);
+            bool reloadChanged();
+
             void cacheDel();
+            void cacheVariantUpdate();
 
             DJV_PRIVATE_COPY(FileGroup);
 
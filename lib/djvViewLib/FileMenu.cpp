@@ -74,6 +74,8 @@ namespace djv
             addAction(actions->action(FileActions::MESSAGES));
             addAction(actions->action(FileActions::PREFS));
             addAction(actions->action(FileActions::DEBUG_LOG));
+            addAction(actions->action(FileActions::EXPORT_FRAME_STATS));
+            addAction(actions->action(FileActions::EXPORT_TRACE));
             addSeparator();
             addAction(actions->action(FileActions::EXIT));
 
@@ -35,6 +35,10 @@
 
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Memory.h>
+
+#include <QDir>
+#include <QStandardPaths>
 
 namespace djv
 {
@@ -42,12 +46,27 @@ namespace djv
     {
         namespace
         {
-            const AV::PixelDataInfo::PROXY proxyDefault        = static_cast<AV::PixelDataInfo::PROXY>(0);
-            const bool                     u8ConversionDefault = false;
-            const bool                     cacheEnabledDefault = true;
-            const float                    cacheSizeGBDefault  = FileCache::sizeGBDefaults()[0];
-            const bool                     preloadDefault      = true;
-            const bool                     displayCacheDefault = true;
+            const AV::PixelDataInfo::PROXY proxyDefault            = static_cast<AV::PixelDataInfo::PROXY>(0);
+            const bool                     u8ConversionDefault     = false;
+            const bool                     cacheEnabledDefault     = true;
+            const float                    cacheSizeGBDefault      = FileCache::sizeGBDefaults()[0];
+            const bool                     cacheAdaptiveDefault    = false;
+            const float                    cacheMinSizeGBDefault   = 1.f;
+            const bool                     cacheCompressionDefault = false;
+            const int                      cacheHotPercentDefault  = 25;
+            const bool                     preloadDefault          = true;
+            const bool                     displayCacheDefault     = true;
+            const bool                     diskCacheDefault        = false;
+            const int                      diskCacheSizeGBDefault  = 16;
+            const Core::FileIO::READ_MODE  readModeDefault         = Core::FileIO::READ_MEMORY_MAP;
+            const int                      readBlockSizeMBDefault  = 8;
+            const bool                     autoReloadDefault       = false;
+
+            QString diskCachePathDefault()
+            {
+                const QString path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+                return !path.isEmpty() ? path : QDir::tempPath();
+            }
 
         } // namespace
 
@@ -57,8 +76,18 @@ namespace djv
             _u8Conversion(u8ConversionDefault),
             _cacheEnabled(cacheEnabledDefault),
             _cacheSizeGB(cacheSizeGBDefault),
+            _cacheAdaptive(cacheAdaptiveDefault),
+            _cacheMinSizeGB(cacheMinSizeGBDefault),
+            _cacheCompression(cacheCompressionDefault),
+            _cacheHotPercent(cacheHotPercentDefault),
             _preload(preloadDefault),
-            _displayCache(displayCacheDefault)
+            _displayCache(displayCacheDefault),
+            _diskCache(diskCacheDefault),
+            _diskCacheSizeGB(diskCacheSizeGBDefault),
+            _diskCachePath(diskCachePathDefault()),
+            _readMode(readModeDefault),
+            _readBlockSizeMB(readBlockSizeMBDefault),
+            _autoReload(autoReloadDefault)
         {
             UI::Prefs prefs("djv::ViewLib::FilePrefs");
             prefs.get("recent", _recent);
@@ -66,10 +95,22 @@ namespace djv
             prefs.get("u8Conversion", _u8Conversion);
             prefs.get("cache", _cacheEnabled);
             prefs.get("cacheSize", _cacheSizeGB);
+            prefs.get("cacheAdaptive", _cacheAdaptive);
+            prefs.get("cacheMinSize", _cacheMinSizeGB);
+            prefs.get("cacheCompression", _cacheCompression);
+            prefs.get("cacheHotPercent", _cacheHotPercent);
             prefs.get("preload", _preload);
             prefs.get("displayCache", _displayCache);
+            prefs.get("diskCache", _diskCache);
+            prefs.get("diskCacheSize", _diskCacheSizeGB);
+            prefs.get("diskCachePath", _diskCachePath);
+            prefs.get("readMode", _readMode);
+            prefs.get("readBlockSize", _readBlockSizeMB);
+            prefs.get("autoReload", _autoReload);
             if (_recent.count() > Core::FileInfoUtil::recentMax)
                 _recent = _recent.mid(0, Core::FileInfoUtil::recentMax);
+            Core::FileIO::setDefaultReadMode(_readMode);
+            Core::FileIO::setDefaultBlockSize(_readBlockSizeMB * Core::Memory::megabyte);
         }
 
         FilePrefs::~FilePrefs()
@@ -80,8 +121,18 @@ namespace djv
             prefs.set("u8Conversion", _u8Conversion);
             prefs.set("cache", _cacheEnabled);
             prefs.set("cacheSize", _cacheSizeGB);
+            prefs.set("cacheAdaptive", _cacheAdaptive);
+            prefs.set("cacheMinSize", _cacheMinSizeGB);
+            prefs.set("cacheCompression", _cacheCompression);
+            prefs.set("cacheHotPercent", _cacheHotPercent);
             prefs.set("preload", _preload);
             prefs.set("displayCache", _displayCache);
+            prefs.set("diskCache", _diskCache);
+            prefs.set("diskCacheSize", _diskCacheSizeGB);
+            prefs.set("diskCachePath", _diskCachePath);
+            prefs.set("readMode", _readMode);
+            prefs.set("readBlockSize", _readBlockSizeMB);
+            prefs.set("autoReload", _autoReload);
         }
 
         void FilePrefs::addRecent(const Core::FileInfo & in)
@@ -118,6 +169,26 @@ namespace djv
             return _cacheSizeGB;
         }
 
+        bool FilePrefs::isCacheAdaptive() const
+        {
+            return _cacheAdaptive;
+        }
+
+        float FilePrefs::cacheMinSizeGB() const
+        {
+            return _cacheMinSizeGB;
+        }
+
+        bool FilePrefs::hasCacheCompression() const
+        {
+            return _cacheCompression;
+        }
+
+        int FilePrefs::cacheHotPercent() const
+        {
+            return _cacheHotPercent;
+        }
+
         bool FilePrefs::hasPreload() const
         {
             return _preload;
@@ -128,14 +199,54 @@ namespace djv
             return _displayCache;
         }
 
+        bool FilePrefs::hasDiskCache() const
+        {
+            return _diskCache;
+        }
+
+        int FilePrefs::diskCacheSizeGB() const
+        {
+            return _diskCacheSizeGB;
+        }
+
+        const QString & FilePrefs::diskCachePath() const
+        {
+            return _diskCachePath;
+        }
+
+        Core::FileIO::READ_MODE FilePrefs::readMode() const
+        {
+            return _readMode;
+        }
+
+        int FilePrefs::readBlockSizeMB() const
+        {
+            return _readBlockSizeMB;
+        }
+
+        bool FilePrefs::hasAutoReload() const
+        {
+            return _autoReload;
+        }
+
         void FilePrefs::reset()
         {
             setProxy(proxyDefault);
             setU8Conversion(u8ConversionDefault);
             setCacheEnabled(cacheEnabledDefault);
             setCacheSizeGB(cacheSizeGBDefault);
+            setCacheAdaptive(cacheAdaptiveDefault);
+            setCacheMinSizeGB(cacheMinSizeGBDefault);
+            setCacheCompression(cacheCompressionDefault);
+            setCacheHotPercent(cacheHotPercentDefault);
             setPreload(preloadDefault);
             setDisplayCache(displayCacheDefault);
+            setDiskCache(diskCacheDefault);
+            setDiskCacheSizeGB(diskCacheSizeGBDefault);
+            setDiskCachePath(diskCachePathDefault());
+            setReadMode(readModeDefault);
+            setReadBlockSizeMB(readBlockSizeMBDefault);
+            setAutoReload(autoReloadDefault);
         }
 
         void FilePrefs::setProxy(AV::PixelDataInfo::PROXY proxy)
@@ -174,6 +285,42 @@ namespace djv
             Q_EMIT prefChanged();
         }
 
+        void FilePrefs::setCacheAdaptive(bool adaptive)
+        {
+            if (adaptive == _cacheAdaptive)
+                return;
+            _cacheAdaptive = adaptive;
+            Q_EMIT cacheAdaptiveChanged(_cacheAdaptive);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setCacheMinSizeGB(float size)
+        {
+            if (size == _cacheMinSizeGB)
+                return;
+            _cacheMinSizeGB = size;
+            Q_EMIT cacheMinSizeGBChanged(_cacheMinSizeGB);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setCacheCompression(bool compression)
+        {
+            if (compression == _cacheCompression)
+                return;
+            _cacheCompression = compression;
+            Q_EMIT cacheCompressionChanged(_cacheCompression);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setCacheHotPercent(int percent)
+        {
+            if (percent == _cacheHotPercent)
+                return;
+            _cacheHotPercent = percent;
+            Q_EMIT cacheHotPercentChanged(_cacheHotPercent);
+            Q_EMIT prefChanged();
+        }
+
         void FilePrefs::setPreload(bool preload)
         {
             if (preload == _preload)
@@ -192,5 +339,61 @@ namespace djv
             Q_EMIT prefChanged();
         }
 
+        void FilePrefs::setDiskCache(bool cache)
+        {
+            if (cache == _diskCache)
+                return;
+            _diskCache = cache;
+            Q_EMIT diskCacheChanged(_diskCache);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setDiskCacheSizeGB(int size)
+        {
+            if (size == _diskCacheSizeGB)
+                return;
+            _diskCacheSizeGB = size;
+            Q_EMIT diskCacheSizeGBChanged(_diskCacheSizeGB);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setDiskCachePath(const QString & path)
+        {
+            if (path == _diskCachePath)
+                return;
+            _diskCachePath = path;
+            Q_EMIT diskCachePathChanged(_diskCachePath);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setReadMode(Core::FileIO::READ_MODE mode)
+        {
+            if (mode == _readMode)
+                return;
+            _readMode = mode;
+            Core::FileIO::setDefaultReadMode(_readMode);
+            Q_EMIT readModeChanged(_readMode);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setReadBlockSizeMB(int size)
+        {
+            if (size == _readBlockSizeMB)
+                return;
+            _readBlockSizeMB = size;
+            Core::FileIO::setDefaultBlockSize(_readBlockSizeMB * Core::Memory::megabyte);
+            Q_EMIT readBlockSizeMBChanged(_readBlockSizeMB);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setAutoReload(bool autoReload)
+        {
+            if (autoReload == _autoReload)
+                return;
+            _autoReload = autoReload;
+            Q_EMIT autoReloadChanged(_autoReload);
+            Q_EMIT prefChanged();
+        }
+
     } // namespace ViewLib
 } // namespace djv
@@ -34,6 +34,7 @@
 #include <djvAV/PixelData.h>
 
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
 
 #include <QStringList>
 
@@ -65,15 +66,47 @@ namespace djv
             //! Get whether the cache is enabled.
             bool isCacheEnabled() const;
 
-            //! Get the cache size in gigabytes.
+            //! Get the cache size in gigabytes. When the adaptive cache size is
+            //! enabled this is the maximum size.
             float cacheSizeGB() const;
 
+            //! Get whether the cache size adapts to the available memory.
+            bool isCacheAdaptive() const;
+
+            //! Get the minimum adaptive cache size in gigabytes.
+            float cacheMinSizeGB() const;
+
+            //! Get whether the cache compresses images.
+            bool hasCacheCompression() const;
+
+            //! Get the percentage of the cache used for uncompressed images when
+            //! compression is enabled.
+            int cacheHotPercent() const;
+
             //! Get wheter the cache is pre-loaded.
             bool hasPreload() const;
 
             //! Get whether the cache is displayed in the timeline.
             bool hasDisplayCache() const;
 
+            //! Get whether the disk cache is enabled.
+            bool hasDiskCache() const;
+
+            //! Get the disk cache size in gigabytes.
+            int diskCacheSizeGB() const;
+
+            //! Get the disk cache directory.
+            const QString & diskCachePath() const;
+
+            //! Get the read mode.
+            Core::FileIO::READ_MODE readMode() const;
+
+            //! Get the read block size in megabytes.
+            int readBlockSizeMB() const;
+
+            //! Get whether files are reloaded automatically when they change.
+            bool hasAutoReload() const;
+
             void reset() override;
 
         public Q_SLOTS:
@@ -89,12 +122,43 @@ namespace djv
             //! Set the cache size in gigabytes.
             void setCacheSizeGB(float);
 
+            //! Set whether the cache size adapts to the available memory.
+            void setCacheAdaptive(bool);
+
+            //! Set the minimum adaptive cache size in gigabytes.
+            void setCacheMinSizeGB(float);
+
+            //! Set whether the cache compresses images.
+            void setCacheCompression(bool);
+
+            //! Set the percentage of the cache used for uncompressed images when
+            //! compression is enabled.
+            void setCacheHotPercent(int);
+
             //! Set whether the cache pre-load is enabled.
             void setPreload(bool);
 
             //! Set whether the cache is displayed in the timeline.
             void setDisplayCache(bool);
 
+            //! Set whether the disk cache is enabled.
+            void setDiskCache(bool);
+
+            //! Set the disk cache size in gigabytes.
+            void setDiskCacheSizeGB(int);
+
+            //! Set the disk cache directory.
+            void setDiskCachePath(const QString &);
+
+            //! Set the read mode.
+            void setReadMode(djv::Core::FileIO::READ_MODE);
+
+            //! Set the read block size in megabytes.
+            void setReadBlockSizeMB(int);
+
+            //! Set whether files are reloaded automatically when they change.
+            void setAutoReload(bool);
+
         Q_SIGNALS:
             //! This signal is emitted when the recent files are changed.
             void recentChanged(const djv::Core::FileInfoList &);
@@ -111,20 +175,63 @@ namespace djv
             //! This signal is emitted when the cache size is changed.
             void cacheSizeGBChanged(float);
 
+            //! This signal is emitted when the adaptive cache size is enabled or
+            //! disabled.
+            void cacheAdaptiveChanged(bool);
+
+            //! This signal is emitted when the minimum adaptive cache size is
+            //! changed.
+            void cacheMinSizeGBChanged(float);
+
+            //! This signal is emitted when the cache compression is changed.
+            void cacheCompressionChanged(bool);
+
+            //! This signal is emitted when the percentage of the cache used for
+            //! uncompressed images is changed.
+            void cacheHotPercentChanged(int);
+
             //! This signal is emitted when the cache pre-load is changed.
             void preloadChanged(bool);
 
             //! This signal is emitted when the cache display is changed.
             void displayCacheChanged(bool);
 
+            //! This signal is emitted when the disk cache is enabled or disabled.
+            void diskCacheChanged(bool);
+
+            //! This signal is emitted when the disk cache size is changed.
+            void diskCacheSizeGBChanged(int);
+
+            //! This signal is emitted when the disk cache directory is changed.
+            void diskCachePathChanged(const QString &);
+
+            //! This signal is emitted when the read mode is changed.
+            void readModeChanged(djv::Core::FileIO::READ_MODE);
+
+            //! This signal is emitted when the read block size is changed.
+            void readBlockSizeMBChanged(int);
+
+            //! This signal is emitted when automatic reloading is changed.
+            void autoReloadChanged(bool);
+
         private:
             Core::FileInfoList       _recent;
             AV::PixelDataInfo::PROXY _proxy;
             bool                     _u8Conversion;
             bool                     _cacheEnabled;
             float                    _cacheSizeGB;
+            bool                     _cacheAdaptive;
+            float                    _cacheMinSizeGB;
+            bool                     _cacheCompression;
+            int                      _cacheHotPercent;
             bool                     _preload;
             bool                     _displayCache;
+            bool                     _diskCache;
+            int                      _diskCacheSizeGB;
+            QString                  _diskCachePath;
+            Core::FileIO::READ_MODE  _readMode;
+            int                      _readBlockSizeMB;
+            bool                     _autoReload;
         };
 
     } // namespace ViewLib
@@ -29,6 +29,7 @@
 
 #include <djvViewLib/FilePrefsWidget.h>
 
+#include <djvViewLib/FileCache.h>
 #include <djvViewLib/FilePrefs.h>
 #include <djvViewLib/MiscWidget.h>
 #include <djvViewLib/ViewContext.h>
@@ -38,12 +39,16 @@
 
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Memory.h>
 #include <djvCore/SignalBlocker.h>
 
 #include <QApplication>
 #include <QCheckBox>
 #include <QComboBox>
 #include <QFormLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QSpinBox>
 #include <QVBoxLayout>
 
 namespace djv
@@ -56,8 +61,19 @@ namespace djv
             QPointer<QCheckBox>       u8ConversionWidget;
             QPointer<QCheckBox>       cacheWidget;
             QPointer<CacheSizeWidget> cacheSizeWidget;
+            QPointer<QCheckBox>       cacheAdaptiveWidget;
+            QPointer<CacheSizeWidget> cacheMinSizeWidget;
+            QPointer<QLabel>          cacheCurrentSizeLabel;
+            QPointer<QCheckBox>       cacheCompressionWidget;
+            QPointer<QSpinBox>        cacheHotPercentWidget;
             QPointer<QCheckBox>       preloadWidget;
             QPointer<QCheckBox>       displayCacheWidget;
+            QPointer<QCheckBox>       diskCacheWidget;
+            QPointer<QSpinBox>        diskCacheSizeWidget;
+            QPointer<QLineEdit>       diskCachePathWidget;
+            QPointer<QComboBox>       readModeWidget;
+            QPointer<QSpinBox>        readBlockSizeWidget;
+            QPointer<QCheckBox>       autoReloadWidget;
         };
 
         FilePrefsWidget::FilePrefsWidget(const QPointer<ViewContext> & context) :
@@ -79,12 +95,48 @@ namespace djv
 
             _p->cacheSizeWidget = new CacheSizeWidget(context.data());
 
+            _p->cacheAdaptiveWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Adapt the cache size to the available memory"));
+
+            _p->cacheMinSizeWidget = new CacheSizeWidget(context.data());
+
+            _p->cacheCurrentSizeLabel = new QLabel;
+
+            _p->cacheCompressionWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Compress images that have not been used recently"));
+
+            _p->cacheHotPercentWidget = new QSpinBox;
+            _p->cacheHotPercentWidget->setRange(1, 100);
+            _p->cacheHotPercentWidget->setSuffix("%");
+
             _p->preloadWidget = new QCheckBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Preload cache"));
 
             _p->displayCacheWidget = new QCheckBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Display cached frames in the timeline"));
 
+            // Create the disk cache widgets.
+            _p->diskCacheWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Enable the disk cache"));
+
+            _p->diskCacheSizeWidget = new QSpinBox;
+            _p->diskCacheSizeWidget->setRange(1, 4096);
+
+            _p->diskCachePathWidget = new QLineEdit;
+
+            // Create the read mode widgets. The automatic mode is not listed
+            // since this sets what it means.
+            _p->readModeWidget = new QComboBox;
+            _p->readModeWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+            _p->readModeWidget->addItems(Core::FileIO::readModeLabels().mid(Core::FileIO::READ_MEMORY_MAP));
+
+            _p->readBlockSizeWidget = new QSpinBox;
+            _p->readBlockSizeWidget->setRange(1, 256);
+
+            // Create the reload widgets.
+            _p->autoReloadWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Automatically reload files when they change"));
+
             // Layout the widgets.
             auto layout = new QVBoxLayout(this);
 
@@ -113,17 +165,75 @@ namespace djv
             prefsGroupBox = new UI::PrefsGroupBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Memory Cache"),
                 qApp->translate("djv::ViewLib::FilePrefsWidget",
-                    "The memory cache stores images for faster playback performance."),
+                    "The memory cache stores images for faster playback performance. "
+                    "Compressing the images that have not been used recently allows more "
+                    "images to fit in the cache at a small processing cost. An adaptive cache "
+                    "grows and shrinks with the memory available, between the minimum size "
+                    "and the cache size."),
                 context.data());
             formLayout = prefsGroupBox->createLayout();
             formLayout->addRow(_p->cacheWidget);
             formLayout->addRow(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Cache size (gigabytes):"),
                 _p->cacheSizeWidget);
+            formLayout->addRow(_p->cacheAdaptiveWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Minimum size (gigabytes):"),
+                _p->cacheMinSizeWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Current size:"),
+                _p->cacheCurrentSizeLabel);
+            formLayout->addRow(_p->cacheCompressionWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Uncompressed images:"),
+                _p->cacheHotPercentWidget);
             formLayout->addRow(_p->preloadWidget);
             formLayout->addRow(_p->displayCacheWidget);
             layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new UI::PrefsGroupBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Disk Cache"),
+                qApp->translate("djv::ViewLib::FilePrefsWidget",
+                    "The disk cache stores images that no longer fit in the memory cache, "
+                    "so they do not need to be loaded again. Use a directory on a fast local disk."),
+                context.data());
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(_p->diskCacheWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Cache size (gigabytes):"),
+                _p->diskCacheSizeWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Cache directory:"),
+                _p->diskCachePathWidget);
+            layout->addWidget(prefsGroupBox);
+
+            prefsGroupBox = new UI::PrefsGroupBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Read Mode"),
+                qApp->translate("djv::ViewLib::FilePrefsWidget",
+                    "Set how files are read when a file format uses the \"Auto\" read mode. "
+                    "The \"Direct\" mode reads each file in large blocks without filling the "
+                    "system cache, which helps when streaming large sequences from fast storage."),
+                context.data());
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Read mode:"),
+                _p->readModeWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Block size (megabytes):"),
+                _p->readBlockSizeWidget);
+            layout->addWidget(prefsGroupBox);
+
+            prefsGroupBox = new UI::PrefsGroupBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Reload"),
+                qApp->translate("djv::ViewLib::FilePrefsWidget",
+                    "Reloading only loads the frames that have changed on disk since they "
+                    "were cached. New frames added to the end of a sequence are appended "
+                    "to the timeline."),
+                context.data());
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(_p->autoReloadWidget);
+            layout->addWidget(prefsGroupBox);
+
             layout->addStretch();
 
             // Initialize.
@@ -146,6 +256,22 @@ namespace djv
                 _p->cacheSizeWidget,
                 SIGNAL(cacheSizeGBChanged(float)),
                 SLOT(cacheSizeGBCallback(float)));
+            connect(
+                _p->cacheAdaptiveWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(cacheAdaptiveCallback(bool)));
+            connect(
+                _p->cacheMinSizeWidget,
+                SIGNAL(cacheSizeGBChanged(float)),
+                SLOT(cacheMinSizeGBCallback(float)));
+            connect(
+                _p->cacheCompressionWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(cacheCompressionCallback(bool)));
+            connect(
+                _p->cacheHotPercentWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(cacheHotPercentCallback(int)));
             connect(
                 _p->preloadWidget,
                 SIGNAL(toggled(bool)),
@@ -154,10 +280,43 @@ namespace djv
                 _p->displayCacheWidget,
                 SIGNAL(toggled(bool)),
                 SLOT(displayCacheCallback(bool)));
+            connect(
+                _p->diskCacheWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(diskCacheCallback(bool)));
+            // Changing these recreates the cache file, so wait until editing
+            // is finished.
+            connect(
+                _p->diskCacheSizeWidget,
+                SIGNAL(editingFinished()),
+                SLOT(diskCacheSizeGBCallback()));
+            connect(
+                _p->diskCachePathWidget,
+                SIGNAL(editingFinished()),
+                SLOT(diskCachePathCallback()));
+            connect(
+                _p->readModeWidget,
+                SIGNAL(activated(int)),
+                SLOT(readModeCallback(int)));
+            connect(
+                _p->readBlockSizeWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(readBlockSizeMBCallback(int)));
+            connect(
+                _p->autoReloadWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(autoReloadCallback(bool)));
             connect(
                 context->filePrefs(),
                 SIGNAL(prefChanged()),
                 SLOT(widgetUpdate()));
+            if (auto fileCache = context->fileCache())
+            {
+                connect(
+                    fileCache,
+                    SIGNAL(maxSizeGBChanged(float)),
+                    SLOT(widgetUpdate()));
+            }
         }
 
         FilePrefsWidget::~FilePrefsWidget()
@@ -188,6 +347,26 @@ namespace djv
             context()->filePrefs()->setCacheSizeGB(in);
         }
 
+        void FilePrefsWidget::cacheAdaptiveCallback(bool in)
+        {
+            context()->filePrefs()->setCacheAdaptive(in);
+        }
+
+        void FilePrefsWidget::cacheMinSizeGBCallback(float in)
+        {
+            context()->filePrefs()->setCacheMinSizeGB(in);
+        }
+
+        void FilePrefsWidget::cacheCompressionCallback(bool in)
+        {
+            context()->filePrefs()->setCacheCompression(in);
+        }
+
+        void FilePrefsWidget::cacheHotPercentCallback(int in)
+        {
+            context()->filePrefs()->setCacheHotPercent(in);
+        }
+
         void FilePrefsWidget::preloadCallback(bool in)
         {
             context()->filePrefs()->setPreload(in);
@@ -198,6 +377,36 @@ namespace djv
             context()->filePrefs()->setDisplayCache(in);
         }
 
+        void FilePrefsWidget::diskCacheCallback(bool in)
+        {
+            context()->filePrefs()->setDiskCache(in);
+        }
+
+        void FilePrefsWidget::diskCacheSizeGBCallback()
+        {
+            context()->filePrefs()->setDiskCacheSizeGB(_p->diskCacheSizeWidget->value());
+        }
+
+        void FilePrefsWidget::diskCachePathCallback()
+        {
+            context()->filePrefs()->setDiskCachePath(_p->diskCachePathWidget->text());
+        }
+
+        void FilePrefsWidget::readModeCallback(int in)
+        {
+            context()->filePrefs()->setReadMode(static_cast<Core::FileIO::READ_MODE>(Core::FileIO::READ_MEMORY_MAP + in));
+        }
+
+        void FilePrefsWidget::readBlockSizeMBCallback(int in)
+        {
+            context()->filePrefs()->setReadBlockSizeMB(in);
+        }
+
+        void FilePrefsWidget::autoReloadCallback(bool in)
+        {
+            context()->filePrefs()->setAutoReload(in);
+        }
+
         void FilePrefsWidget::widgetUpdate()
         {
             Core::SignalBlocker signalBlocker(QObjectList() <<
@@ -205,14 +414,40 @@ namespace djv
                 _p->u8ConversionWidget <<
                 _p->cacheWidget <<
                 _p->cacheSizeWidget <<
+                _p->cacheAdaptiveWidget <<
+                _p->cacheMinSizeWidget <<
+                _p->cacheCompressionWidget <<
+                _p->cacheHotPercentWidget <<
                 _p->preloadWidget <<
-                _p->displayCacheWidget);
+                _p->displayCacheWidget <<
+                _p->diskCacheWidget <<
+                _p->diskCacheSizeWidget <<
+                _p->diskCachePathWidget <<
+                _p->readModeWidget <<
+                _p->readBlockSizeWidget <<
+                _p->autoReloadWidget);
             _p->proxyWidget->setCurrentIndex(context()->filePrefs()->proxy());
             _p->u8ConversionWidget->setChecked(context()->filePrefs()->hasU8Conversion());
             _p->cacheWidget->setChecked(context()->filePrefs()->isCacheEnabled());
             _p->cacheSizeWidget->setCacheSizeGB(context()->filePrefs()->cacheSizeGB());
+            _p->cacheAdaptiveWidget->setChecked(context()->filePrefs()->isCacheAdaptive());
+            _p->cacheMinSizeWidget->setCacheSizeGB(context()->filePrefs()->cacheMinSizeGB());
+            _p->cacheMinSizeWidget->setEnabled(context()->filePrefs()->isCacheAdaptive());
+            if (auto fileCache = context()->fileCache())
+            {
+                _p->cacheCurrentSizeLabel->setText(Core::Memory::sizeLabel(fileCache->maxSizeBytes()));
+            }
+            _p->cacheCompressionWidget->setChecked(context()->filePrefs()->hasCacheCompression());
+            _p->cacheHotPercentWidget->setValue(context()->filePrefs()->cacheHotPercent());
+            _p->cacheHotPercentWidget->setEnabled(context()->filePrefs()->hasCacheCompression());
             _p->preloadWidget->setChecked(context()->filePrefs()->hasPreload());
             _p->displayCacheWidget->setChecked(context()->filePrefs()->hasDisplayCache());
+            _p->diskCacheWidget->setChecked(context()->filePrefs()->hasDiskCache());
+            _p->diskCacheSizeWidget->setValue(context()->filePrefs()->diskCacheSizeGB());
+            _p->diskCachePathWidget->setText(context()->filePrefs()->diskCachePath());
+            _p->readModeWidget->setCurrentIndex(context()->filePrefs()->readMode() - Core::FileIO::READ_MEMORY_MAP);
+            _p->readBlockSizeWidget->setValue(context()->filePrefs()->readBlockSizeMB());
+            _p->autoReloadWidget->setChecked(context()->filePrefs()->hasAutoReload());
         }
 
     } // namespace ViewLib
@@ -55,8 +55,18 @@ namespace djv
             void u8ConversionCallback(bool);
             void cacheEnabledCallback(bool);
             void cacheSizeGBCallback(float);
+            void cacheAdaptiveCallback(bool);
+            void cacheMinSizeGBCallback(float);
+            void cacheCompressionCallback(bool);
+            void cacheHotPercentCallback(int);
             void preloadCallback(bool);
             void displayCacheCallback(bool);
+            void diskCacheCallback(bool);
+            void diskCacheSizeGBCallback();
+            void diskCachePathCallback();
+            void readModeCallback(int);
+            void readBlockSizeMBCallback(int);
+            void autoReloadCallback(bool);
 
             void widgetUpdate();
 
@@ -0,0 +1,443 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvViewLib/FileSpillCache.h>
+
+#include <djvViewLib/Enum.h>
+
+#include <djvAV/Image.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Trace.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#if defined(DJV_LINUX)
+#include <fcntl.h>
+#endif // DJV_LINUX
+
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        namespace
+        {
+            const quint64 alignment = 4096;
+
+            // Evicted images hold on to their memory until they are written,
+            // so limit how much data may be waiting.
+            const quint64 pendingMax = 512 * Core::Memory::megabyte;
+
+            qint64 sourceTime(const QString & source)
+            {
+                return !source.isEmpty() ? QFileInfo(source).lastModified().toMSecsSinceEpoch() : 0;
+            }
+
+        } // namespace
+
+        struct FileSpillCache::Private
+        {
+            ~Private();
+
+            struct Entry
+            {
+                quint64           id         = 0;
+                quint64           offset     = 0;
+                quint64           size       = 0;
+                quint64           tick       = 0;
+                AV::PixelDataInfo info;
+                AV::Tags          tags;
+                AV::ColorProfile  colorProfile;
+                QString           source;
+                qint64            sourceTime = 0;
+            };
+
+            struct Job
+            {
+                quint64                    id     = 0;
+                quint64                    offset = 0;
+                std::shared_ptr<AV::Image> image;
+            };
+
+            QString                         fileName;
+            quint64                         maxBytes   = 0;
+            quint64                         cacheBytes = 0;
+            QFile                           writeFile;
+            QFile                           readFile;
+            uchar *                         map        = nullptr;
+            std::map<FileCacheKey, Entry>   entries;
+            std::map<quint64, FileCacheKey> lru;
+            std::map<quint64, quint64>      freeList;
+            quint64                         id         = 0;
+
+            // These are shared with the writer thread.
+            std::mutex                                     mutex;
+            std::condition_variable                        cv;
+            std::deque<Job>                                jobs;
+            std::map<quint64, std::shared_ptr<AV::Image> > pending;
+            quint64                                        pendingBytes = 0;
+            std::set<quint64>                              failed;
+            bool                                           stop         = false;
+            std::thread                                    thread;
+
+            bool allocate(quint64 size, quint64 & offset);
+            void release(quint64 offset, quint64 size);
+            void remove(std::map<FileCacheKey, Entry>::iterator);
+            void touch(Entry &, quint64 tick);
+            void run();
+        };
+
+        FileSpillCache::Private::~Private()
+        {
+            if (thread.joinable())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    stop = true;
+                    jobs.clear();
+                }
+                cv.notify_one();
+                thread.join();
+            }
+            if (map)
+            {
+                readFile.unmap(map);
+            }
+            readFile.close();
+            writeFile.close();
+            if (!fileName.isEmpty())
+            {
+                QFile::remove(fileName);
+            }
+        }
+
+        bool FileSpillCache::Private::allocate(quint64 size, quint64 & offset)
+        {
+            for (auto i = freeList.begin(); i != freeList.end(); ++i)
+            {
+                if (i->second >= size)
+                {
+                    offset = i->first;
+                    const quint64 rest = i->second - size;
+                    freeList.erase(i);
+                    if (rest)
+                    {
+                        freeList[offset + size] = rest;
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void FileSpillCache::Private::release(quint64 offset, quint64 size)
+        {
+            // Merge the range with its neighbors.
+            auto next = freeList.lower_bound(offset);
+            if (next != freeList.end() && offset + size == next->first)
+            {
+                size += next->second;
+                next = freeList.erase(next);
+            }
+            if (next != freeList.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->first + prev->second == offset)
+                {
+                    prev->second += size;
+                    return;
+                }
+            }
+            freeList[offset] = size;
+        }
+
+        void FileSpillCache::Private::remove(std::map<FileCacheKey, Entry>::iterator i)
+        {
+            // A pending write to the range is finished before any write
+            // queued after it, so the range can be reused right away.
+            release(i->second.offset, i->second.size);
+            cacheBytes -= i->second.size;
+            lru.erase(i->second.tick);
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                failed.erase(i->second.id);
+            }
+            entries.erase(i);
+        }
+
+        void FileSpillCache::Private::touch(Entry & entry, quint64 tick)
+        {
+            auto i = lru.find(entry.tick);
+            if (i != lru.end())
+            {
+                const FileCacheKey key = i->second;
+                lru.erase(i);
+                lru[tick] = key;
+            }
+            entry.tick = tick;
+        }
+
+        void FileSpillCache::Private::run()
+        {
+            DJV_TRACE_THREAD("FileSpillCache");
+            while (1)
+            {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this] { return stop || jobs.size(); });
+                    if (stop)
+                        return;
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                DJV_TRACE_ZONE("djv::ViewLib::FileSpillCache::write");
+                const qint64 size = static_cast<qint64>(job.image->dataByteCount());
+                const bool ok =
+                    writeFile.seek(job.offset) &&
+                    writeFile.write(reinterpret_cast<const char *>(job.image->data()), size) == size;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    pending.erase(job.id);
+                    pendingBytes -= size;
+                    if (!ok)
+                    {
+                        failed.insert(job.id);
+                    }
+                }
+            }
+        }
+
+        FileSpillCache::FileSpillCache(const QString & path, quint64 maxBytes) :
+            _p(new Private)
+        {
+            //DJV_DEBUG("FileSpillCache::FileSpillCache");
+            //DJV_DEBUG_PRINT("path = " << path);
+            //DJV_DEBUG_PRINT("max bytes = " << maxBytes);
+            _p->fileName = QDir(path).absoluteFilePath(
+                QString("djv_view_cache_%1.bin").arg(QCoreApplication::applicationPid()));
+            _p->maxBytes = maxBytes / alignment * alignment;
+            const Core::Error error(
+                "djv::ViewLib::FileSpillCache",
+                Enum::errorLabels()[Enum::ERROR_DISK_CACHE].
+                arg(QDir::toNativeSeparators(_p->fileName)));
+            if (!_p->maxBytes || !QDir().mkpath(path))
+            {
+                throw error;
+            }
+
+            // Allocate the whole file up front so that running out of disk
+            // space is found now and not while writing.
+            _p->writeFile.setFileName(_p->fileName);
+            if (!_p->writeFile.open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Unbuffered) ||
+                !_p->writeFile.resize(_p->maxBytes))
+            {
+                throw error;
+            }
+#if defined(DJV_LINUX)
+            if (::posix_fallocate(_p->writeFile.handle(), 0, _p->maxBytes) != 0)
+            {
+                throw error;
+            }
+#endif // DJV_LINUX
+
+            _p->readFile.setFileName(_p->fileName);
+            if (!_p->readFile.open(QIODevice::ReadOnly))
+            {
+                throw error;
+            }
+            _p->map = _p->readFile.map(0, _p->maxBytes);
+            if (!_p->map)
+            {
+                throw error;
+            }
+
+            _p->freeList[0] = _p->maxBytes;
+            _p->thread = std::thread(&Private::run, _p.get());
+        }
+
+        FileSpillCache::~FileSpillCache()
+        {}
+
+        const QString & FileSpillCache::fileName() const
+        {
+            return _p->fileName;
+        }
+
+        quint64 FileSpillCache::maxSizeBytes() const
+        {
+            return _p->maxBytes;
+        }
+
+        quint64 FileSpillCache::currentSizeBytes() const
+        {
+            return _p->cacheBytes;
+        }
+
+        bool FileSpillCache::hasItem(const FileCacheKey & key) const
+        {
+            return _p->entries.find(key) != _p->entries.end();
+        }
+
+        std::shared_ptr<AV::Image> FileSpillCache::item(const FileCacheKey & key, quint64 tick)
+        {
+            std::shared_ptr<AV::Image> out;
+            auto i = _p->entries.find(key);
+            if (i == _p->entries.end())
+                return out;
+            auto & entry = i->second;
+            if (key.source != entry.source || sourceTime(entry.source) != entry.sourceTime)
+            {
+                _p->remove(i);
+                return out;
+            }
+            bool failed = false;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                auto j = _p->pending.find(entry.id);
+                if (j != _p->pending.end())
+                {
+                    out = j->second;
+                }
+                else
+                {
+                    failed = _p->failed.count(entry.id) > 0;
+                }
+            }
+            if (failed)
+            {
+                _p->remove(i);
+                return out;
+            }
+            if (!out)
+            {
+                out = std::shared_ptr<AV::Image>(new AV::Image(entry.info, _p->map + entry.offset));
+                out->tags = entry.tags;
+                out->colorProfile = entry.colorProfile;
+            }
+            _p->touch(entry, tick);
+            return out;
+        }
+
+        bool FileSpillCache::addItem(
+            const FileCacheKey &               key,
+            const std::shared_ptr<AV::Image> & item,
+            quint64                            tick,
+            std::vector<FileCacheKey> &        removed)
+        {
+            auto i = _p->entries.find(key);
+            if (i != _p->entries.end())
+            {
+                // The item was read back from the cache and is still here.
+                if (key.source == i->second.source && item->info() == i->second.info)
+                {
+                    _p->touch(i->second, tick);
+                    return true;
+                }
+                _p->remove(i);
+            }
+
+            const quint64 byteCount = item->dataByteCount();
+            const quint64 size = (byteCount + alignment - 1) / alignment * alignment;
+            if (!size || size > _p->maxBytes)
+                return false;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                if (_p->pendingBytes + byteCount > pendingMax)
+                    return false;
+            }
+            quint64 offset = 0;
+            while (!_p->allocate(size, offset))
+            {
+                if (_p->lru.empty())
+                    return false;
+                removed.push_back(_p->lru.begin()->second);
+                _p->remove(_p->entries.find(_p->lru.begin()->second));
+            }
+
+            Private::Entry entry;
+            entry.id           = ++_p->id;
+            entry.offset       = offset;
+            entry.size         = size;
+            entry.tick         = tick;
+            entry.info         = item->info();
+            entry.tags         = item->tags;
+            entry.colorProfile = item->colorProfile;
+            entry.source       = key.source;
+            entry.sourceTime   = sourceTime(key.source);
+            _p->entries[key] = entry;
+            _p->lru[tick] = key;
+            _p->cacheBytes += size;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                Private::Job job;
+                job.id     = entry.id;
+                job.offset = offset;
+                job.image  = item;
+                _p->jobs.push_back(std::move(job));
+                _p->pending[entry.id] = item;
+                _p->pendingBytes += byteCount;
+            }
+            _p->cv.notify_one();
+            return true;
+        }
+
+        void FileSpillCache::removeItem(const FileCacheKey & key)
+        {
+            auto i = _p->entries.find(key);
+            if (i != _p->entries.end())
+            {
+                _p->remove(i);
+            }
+        }
+
+        void FileSpillCache::clear()
+        {
+            while (_p->entries.size())
+            {
+                _p->remove(_p->entries.begin());
+            }
+        }
+
+    } // namespace ViewLib
+} // namespace djv
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvViewLib/FileCache.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        //! This class provides the disk tier of the file cache.
+        //!
+        //! Images evicted from memory are written by a separate thread into a
+        //! cache file that is preallocated to the maximum size, and read back
+        //! through a mapping of the file. Space in the file is handed out
+        //! first-fit and the least recently used images are removed to make
+        //! room. The file is removed when the cache is destroyed.
+        class FileSpillCache
+        {
+        public:
+            //! Create the cache file in the given directory.
+            //!
+            //! Throws:
+            //! - Core::Error
+            FileSpillCache(const QString & path, quint64 maxBytes);
+            ~FileSpillCache();
+
+            //! Get the cache file name.
+            const QString & fileName() const;
+
+            //! Get the maximum cache size in bytes.
+            quint64 maxSizeBytes() const;
+
+            //! Get the current cache size in bytes.
+            quint64 currentSizeBytes() const;
+
+            //! Get whether the cache contains an item.
+            bool hasItem(const FileCacheKey &) const;
+
+            //! Read an item from the cache. Items whose source file has changed
+            //! since they were added are removed and nullptr is returned.
+            std::shared_ptr<AV::Image> item(const FileCacheKey &, quint64 tick);
+
+            //! Add an item to the cache. The item is written asynchronously.
+            //! Returns false if the item does not fit or too many items are
+            //! waiting to be written. The keys of the least recently used items
+            //! that are removed to make room are appended to the given list.
+            bool addItem(
+                const FileCacheKey &,
+                const std::shared_ptr<AV::Image> &,
+                quint64 tick,
+                std::vector<FileCacheKey> & removed);
+
+            //! Remove an item.
+            void removeItem(const FileCacheKey &);
+
+            //! Remove all items.
+            void clear();
+
+        private:
+            DJV_PRIVATE_COPY(FileSpillCache);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
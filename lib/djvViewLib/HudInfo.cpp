@@ -42,7 +42,9 @@ namespace djv
             a.speed == b.speed &&
             Core::Math::fuzzyCompare(a.actualSpeed, b.actualSpeed) &&
             a.droppedFrames == b.droppedFrames &&
-            a.visible == b.visible;
+            a.visible == b.visible &&
+            a.latency50 == b.latency50 &&
+            a.latency95 == b.latency95;
     }
 
     bool operator != (const ViewLib::HudInfo & a, const ViewLib::HudInfo & b)
@@ -37,6 +37,7 @@
 #include <djvCore/Speed.h>
 
 #include <QMap>
+#include <QVector>
 
 namespace djv
 {
@@ -52,6 +53,11 @@ namespace djv
             float                 actualSpeed = 0.f;
             bool                  droppedFrames = false;
             QMap<Enum::HUD, bool> visible;
+
+            //! The 50th and 95th percentile durations of the frame statistics
+            //! stages in milliseconds.
+            QVector<float>        latency50;
+            QVector<float>        latency95;
         };
 
     } // namespace ViewLib
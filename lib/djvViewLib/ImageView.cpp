@@ -45,6 +45,7 @@
 #include <djvCore/Assert.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/FrameStats.h>
 #include <djvCore/Time.h>
 
 #include <QApplication>
@@ -555,7 +556,10 @@ namespace djv
 
         void ImageView::paintGL()
         {
-            UI::ImageView::paintGL();
+            {
+                Core::FrameStats::Scope scope(Core::FrameStats::DRAW, _p->hudInfo.frame);
+                UI::ImageView::paintGL();
+            }
             if (_p->grid || _p->hudEnabled || (_p->annotations.size() && _p->annotationsVisible))
             {
                 const glm::ivec2 size(width(), height());
@@ -715,6 +719,16 @@ namespace djv
                     arg(Core::Speed::speedToFloat(_p->hudInfo.speed), 0, 'f', 2).
                     arg(_p->hudInfo.actualSpeed, 0, 'f', 2);
             }
+            if (_p->hudInfo.visible[Enum::HUD_LATENCY])
+            {
+                for (int i = 0; i < _p->hudInfo.latency50.count() && i < _p->hudInfo.latency95.count(); ++i)
+                {
+                    upperRight += qApp->translate("djv::ViewLib::ImageView", "%1 = %2/%3 ms").
+                        arg(Core::FrameStats::stageLabels()[i]).
+                        arg(_p->hudInfo.latency50[i], 0, 'f', 2).
+                        arg(_p->hudInfo.latency95[i], 0, 'f', 2);
+                }
+            }
 
             // Draw the upper left contents.
             const glm::ivec2 size(width(), height());
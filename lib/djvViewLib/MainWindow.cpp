@@ -55,6 +55,7 @@
 #include <djvCore/Debug.h>
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
+#include <djvCore/FrameStats.h>
 
 #include <QApplication>
 #include <QDesktopWidget>
@@ -515,6 +516,16 @@ namespace djv
             hudInfo.actualSpeed = playbackGroup->actualSpeed();
             hudInfo.droppedFrames = playbackGroup->hasDroppedFrames();
             hudInfo.visible = _p->context->viewPrefs()->hudInfo();
+            if (hudInfo.visible[Enum::HUD_LATENCY])
+            {
+                const auto samples = Core::FrameStats::samples();
+                for (int i = 0; i < Core::FrameStats::STAGE_COUNT; ++i)
+                {
+                    const auto stage = static_cast<Core::FrameStats::STAGE>(i);
+                    hudInfo.latency50.append(Core::FrameStats::percentile(samples, stage, 50.f));
+                    hudInfo.latency95.append(Core::FrameStats::percentile(samples, stage, 95.f));
+                }
+            }
             auto viewWidget = _p->session->viewWidget();
             viewWidget->setHudInfo(hudInfo);
         }
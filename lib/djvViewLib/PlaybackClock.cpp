@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLib/PlaybackClock.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Time.h>
+#include <djvCore/Trace.h>
+
+#if defined(DJV_LINUX)
+#include <errno.h>
+#include <time.h>
+#endif // DJV_LINUX
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        namespace
+        {
+            // The clock waits on the condition variable until this close to
+            // the deadline, so that it can be stopped, and then sleeps for the
+            // rest of the time.
+            const qint64 sleepMargin = 2000000;
+
+            void sleepUntil(qint64 time)
+            {
+#if defined(DJV_LINUX)
+                timespec t;
+                t.tv_sec = time / 1000000000;
+                t.tv_nsec = time % 1000000000;
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, nullptr) == EINTR)
+                    ;
+#else // DJV_LINUX
+                const qint64 duration = time - Core::Time::monotonic();
+                if (duration > 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(duration));
+                }
+#endif // DJV_LINUX
+            }
+
+        } // namespace
+
+        PlaybackClock::Stats::Stats()
+        {
+            jitter.fill(0);
+        }
+
+        struct PlaybackClock::Private
+        {
+            // These are shared with the clock thread.
+            std::mutex              mutex;
+            std::condition_variable cv;
+            bool                    running = false;
+            float                   speed   = 0.f;
+            qint64                  epoch   = 0;
+            qint64                  period  = 0;
+            qint64                  frame   = 0;
+            qint64                  due     = 0;
+            qint64                  frames  = 0;
+            bool                    pending = false;
+            bool                    changed = false;
+            bool                    stop    = false;
+            std::thread             thread;
+
+            Stats stats;
+
+            // This must be called with the mutex locked.
+            void restart(float value)
+            {
+                speed   = value;
+                epoch   = Core::Time::monotonic();
+                period  = speed != 0.f ? static_cast<qint64>(1000000000 / Core::Math::abs(speed)) : 0;
+                frame   = 0;
+                changed = true;
+            }
+        };
+
+        PlaybackClock::PlaybackClock(QObject * parent) :
+            QObject(parent),
+            _p(new Private)
+        {
+            _p->thread = std::thread(&PlaybackClock::run, this);
+        }
+
+        PlaybackClock::~PlaybackClock()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->stop = true;
+            }
+            _p->cv.notify_one();
+            _p->thread.join();
+        }
+
+        const PlaybackClock::Stats & PlaybackClock::stats() const
+        {
+            return _p->stats;
+        }
+
+        bool PlaybackClock::isRunning() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->running;
+        }
+
+        qint64 PlaybackClock::takeFrames()
+        {
+            qint64 frames = 0;
+            qint64 due    = 0;
+            qint64 period = 0;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                frames = _p->frames;
+                due    = _p->due;
+                period = _p->period;
+                _p->frames  = 0;
+                _p->pending = false;
+            }
+            if (frames)
+            {
+                const qint64 jitter = Core::Time::monotonic() - due;
+                ++_p->stats.ticks;
+                if (jitter > period)
+                {
+                    ++_p->stats.late;
+                }
+                _p->stats.dropped += Core::Math::abs(frames) - 1;
+                const int bin = static_cast<int>(Core::Math::clamp<qint64>(jitter / 1000000, 0, Stats::jitterBins - 1));
+                ++_p->stats.jitter[bin];
+            }
+            return frames;
+        }
+
+        void PlaybackClock::start(float speed)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->running = true;
+                _p->frames  = 0;
+                _p->stats   = Stats();
+                _p->restart(speed);
+            }
+            _p->cv.notify_one();
+        }
+
+        void PlaybackClock::setSpeed(float speed)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                if (speed == _p->speed)
+                    return;
+                _p->restart(speed);
+            }
+            _p->cv.notify_one();
+        }
+
+        void PlaybackClock::stop()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->running = false;
+                _p->frames  = 0;
+                _p->changed = true;
+            }
+            _p->cv.notify_one();
+        }
+
+        void PlaybackClock::run()
+        {
+            DJV_TRACE_THREAD("PlaybackClock");
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (!_p->stop)
+            {
+                _p->changed = false;
+                if (!_p->running || !_p->period)
+                {
+                    _p->cv.wait(lock, [this] { return _p->stop || _p->changed; });
+                    continue;
+                }
+
+                // Wait until the next frame is due.
+                const qint64 deadline = _p->epoch + (_p->frame + 1) * _p->period;
+                const qint64 wait = deadline - sleepMargin - Core::Time::monotonic();
+                if (wait > 0)
+                {
+                    _p->cv.wait_for(
+                        lock,
+                        std::chrono::nanoseconds(wait),
+                        [this] { return _p->stop || _p->changed; });
+                    if (_p->stop || _p->changed)
+                        continue;
+                }
+                lock.unlock();
+                sleepUntil(deadline);
+                lock.lock();
+                if (_p->stop || _p->changed)
+                    continue;
+
+                // Count the frames that are due, which is more than one if the
+                // thread was woken late.
+                const qint64 frame = (Core::Time::monotonic() - _p->epoch) / _p->period;
+                _p->frames += _p->speed > 0.f ? (frame - _p->frame) : (_p->frame - frame);
+                _p->frame = frame;
+                _p->due = _p->epoch + frame * _p->period;
+                if (!_p->pending)
+                {
+                    _p->pending = true;
+                    Q_EMIT tick();
+                }
+            }
+        }
+
+    } // namespace ViewLib
+} // namespace djv
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvViewLib/ViewLib.h>
+
+#include <djvCore/Util.h>
+
+#include <QObject>
+
+#include <array>
+#include <memory>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        //! This class provides the playback clock.
+        //!
+        //! The clock runs on its own thread and wakes up when each frame is
+        //! due, using CLOCK_MONOTONIC and clock_nanosleep() on Linux. The tick()
+        //! signal is delivered to the thread that owns the clock. While a tick
+        //! is waiting to be handled no more are emitted; the frames are counted
+        //! instead, so a busy event loop skips frames rather than queueing them.
+        class PlaybackClock : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            explicit PlaybackClock(QObject * parent = nullptr);
+            ~PlaybackClock() override;
+
+            //! This struct provides playback statistics.
+            struct Stats
+            {
+                //! The number of one millisecond bins in the jitter histogram.
+                //! The last bin also counts anything later.
+                static const int jitterBins = 32;
+
+                quint64                         ticks   = 0;
+                quint64                         late    = 0;
+                quint64                         dropped = 0;
+                std::array<quint64, jitterBins> jitter;
+
+                Stats();
+            };
+
+            //! Get the statistics since the clock was started. A tick is late
+            //! when it is handled after the next frame is due, and frames are
+            //! dropped when more than one frame is due when a tick is handled.
+            //! The jitter is how long after a frame was due the tick was
+            //! handled.
+            const Stats & stats() const;
+
+            //! Get whether the clock is running.
+            bool isRunning() const;
+
+            //! Take the number of frames that have become due since the last
+            //! call, and update the statistics. The number is negative when the
+            //! speed is negative.
+            qint64 takeFrames();
+
+        public Q_SLOTS:
+            //! Start the clock at the given speed in frames per second.
+            void start(float);
+
+            //! Set the speed in frames per second without restarting the
+            //! statistics.
+            void setSpeed(float);
+
+            //! Stop the clock.
+            void stop();
+
+        Q_SIGNALS:
+            //! This signal is emitted when frames are due.
+            void tick();
+
+        private:
+            void run();
+
+            DJV_PRIVATE_COPY(PlaybackClock);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
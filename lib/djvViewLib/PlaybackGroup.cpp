@@ -32,6 +32,7 @@
 #include <djvViewLib/FileCache.h>
 #include <djvViewLib/Session.h>
 #include <djvViewLib/PlaybackActions.h>
+#include <djvViewLib/PlaybackClock.h>
 #include <djvViewLib/PlaybackMenu.h>
 #include <djvViewLib/PlaybackPrefs.h>
 #include <djvViewLib/PlaybackToolBar.h>
@@ -40,9 +41,11 @@
 
 #include <djvUI/ToolButton.h>
 
+#include <djvCore/DebugLog.h>
 #include <djvCore/ListUtil.h>
 #include <djvCore/SignalBlocker.h>
 #include <djvCore/Timer.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -81,15 +84,12 @@ namespace djv
             bool              inOutEnabled = true;
             qint64            inPoint = 0;
             qint64            outPoint = 0;
-            int               timer = 0;
             bool              idlePause = false;
-            bool              idleInit = true;
-            Core::Timer       idleTimer;
-            quint64           idleFrame = 0;
             Core::Timer       speedTimer;
             quint64           speedCounter = 0;
             Enum::LAYOUT      layout = static_cast<Enum::LAYOUT>(0);
 
+            QPointer<PlaybackClock>   clock;
             QPointer<PlaybackActions> actions;
         };
 
@@ -103,6 +103,8 @@ namespace djv
             // Create the actions.
             _p->actions = new PlaybackActions(context, this);
 
+            _p->clock = new PlaybackClock(this);
+
             // Initialize.
             if (copy)
             {
@@ -123,6 +125,12 @@ namespace djv
             speedUpdate();
             layoutUpdate();
 
+            // Setup the clock callbacks.
+            connect(
+                _p->clock,
+                SIGNAL(tick()),
+                SLOT(clockCallback()));
+
             // Setup the action callbacks.
             connect(
                 _p->actions->action(PlaybackActions::PLAYBACK_TOGGLE),
@@ -408,6 +416,25 @@ namespace djv
             Q_EMIT durationChanged(duration(), durationInOutEnabled());
         }
 
+        void PlaybackGroup::appendFrames(const Core::FrameList & frames)
+        {
+            if (!frames.count())
+                return;
+            //DJV_DEBUG("PlaybackGroup::appendFrames");
+            //DJV_DEBUG_PRINT("frames = " << frames.count());
+            const bool outPointEnd = _p->outPoint == sequenceEnd(_p->sequence);
+            _p->sequence.frames += frames;
+            Q_EMIT sequenceChanged(_p->sequence);
+            Q_EMIT frameListChanged(_p->sequence.frames);
+            if (outPointEnd)
+            {
+                _p->outPoint = sequenceEnd(_p->sequence);
+                Q_EMIT outPointChanged(_p->outPoint);
+            }
+            Q_EMIT endFrameChanged(endFrame(_p->inOutEnabled));
+            Q_EMIT durationChanged(duration(), durationInOutEnabled());
+        }
+
         void PlaybackGroup::setPlayback(Enum::PLAYBACK playback)
         {
             if (playback == _p->playback)
@@ -563,41 +590,20 @@ namespace djv
             Q_EMIT layoutChanged(_p->layout);
         }
 
-        void PlaybackGroup::timerEvent(QTimerEvent *)
+        void PlaybackGroup::clockCallback()
         {
-            if (_p->idlePause)
+            DJV_TRACE_ZONE("djv::ViewLib::PlaybackGroup::tick");
+            qint64 inc = _p->clock->takeFrames();
+            if (_p->idlePause || !inc)
                 return;
-            //DJV_DEBUG("PlaybackGroup::timerEvent");
+            //DJV_DEBUG("PlaybackGroup::clockCallback");
             //DJV_DEBUG_PRINT("playback = " << _p->playback);
             //DJV_DEBUG_PRINT("loop = " << _p->loop);
             //DJV_DEBUG_PRINT("every frame = " << _p->everyFrame);
             //DJV_DEBUG_PRINT("frame = " << _p->frame);
-            if (_p->idleInit)
-            {
-                //DJV_DEBUG_PRINT("init");
-                _p->idleTimer.start();
-                _p->idleFrame = 0;
-                _p->speedTimer = _p->idleTimer;
-                _p->speedCounter = 0;
-                _p->droppedFrames = false;
-                _p->droppedFramesTmp = false;
-                _p->idleInit = false;
-            }
-            else
-            {
-                _p->idleTimer.check();
-            }
-            const float speed = _p->shuttle ? _p->shuttleSpeed : Core::Speed::speedToFloat(_p->speed);
-            //DJV_DEBUG_PRINT("speed = " << speed);
-            const quint64 absoluteFrame = quint64(_p->idleTimer.seconds() * speed);
-            int inc = static_cast<int>(absoluteFrame - _p->idleFrame);
-            //DJV_DEBUG_PRINT("absolute frame = " << static_cast<int>(absoluteFrame));
             //DJV_DEBUG_PRINT("inc = " << inc);
-            if (!inc)
-                return;
 
             // Calculate current frame.
-            _p->idleFrame = absoluteFrame;
             if (Enum::REVERSE == _p->playback)
             {
                 inc = -inc;
@@ -646,20 +652,13 @@ namespace djv
                 setPlayback(Enum::STOP);
                 _p->shuttle = true;
                 _p->shuttleSpeed = 0.f;
-                _p->idleInit = true;
-                if (_p->timer)
-                    killTimer(_p->timer);
-                _p->timer = startTimer(0);
+                clockStart(_p->shuttleSpeed);
             }
             else
             {
                 _p->shuttle = false;
                 _p->droppedFrames = false;
-                if (_p->timer)
-                {
-                    killTimer(_p->timer);
-                    _p->timer = 0;
-                }
+                clockStop();
                 Q_EMIT speedChanged(_p->speed);
             }
         }
@@ -671,7 +670,7 @@ namespace djv
             _p->shuttleSpeed =
                 Core::Math::pow(static_cast<float>(Core::Math::abs(in)), 1.5) *
                 (in >= 0 ? 1.f : -1.f);
-            _p->idleFrame = quint64(_p->idleTimer.seconds() * _p->shuttleSpeed);
+            _p->clock->setSpeed(_p->shuttleSpeed);
         }
 
         void PlaybackGroup::loopCallback(QAction * action)
@@ -725,7 +724,14 @@ namespace djv
         {
             //DJV_DEBUG("PlaybackGroup::framePressedCallback");
             _p->idlePause = value;
-            _p->idleInit = !value;
+            if (value)
+            {
+                clockStop();
+            }
+            else if (_p->shuttle || Enum::FORWARD == _p->playback || Enum::REVERSE == _p->playback)
+            {
+                clockStart(_p->shuttle ? _p->shuttleSpeed : Core::Speed::speedToFloat(_p->speed));
+            }
         }
 
         void PlaybackGroup::framePressedCallback()
@@ -820,20 +826,63 @@ namespace djv
                 }
             }
 
-            if (_p->timer)
-            {
-                killTimer(_p->timer);
-                _p->timer = 0;
-            }
-
             switch (_p->playback)
             {
             case Enum::FORWARD:
             case Enum::REVERSE:
-                _p->timer = startTimer(0);
-                _p->idleInit = true;
+            {
+                const float speed = Core::Speed::speedToFloat(_p->speed);
+                if (_p->clock->isRunning())
+                {
+                    _p->clock->setSpeed(speed);
+                }
+                else
+                {
+                    clockStart(speed);
+                }
                 break;
-            default: break;
+            }
+            default:
+                if (!_p->shuttle)
+                {
+                    clockStop();
+                }
+                break;
+            }
+        }
+
+        void PlaybackGroup::clockStart(float speed)
+        {
+            _p->speedTimer.start();
+            _p->speedCounter = 0;
+            _p->droppedFrames = false;
+            _p->droppedFramesTmp = false;
+            _p->clock->start(speed);
+        }
+
+        void PlaybackGroup::clockStop()
+        {
+            if (!_p->clock->isRunning())
+                return;
+            _p->clock->stop();
+            const auto & stats = _p->clock->stats();
+            if (stats.ticks)
+            {
+                int bins = PlaybackClock::Stats::jitterBins;
+                while (bins > 1 && !stats.jitter[bins - 1])
+                {
+                    --bins;
+                }
+                QStringList jitter;
+                for (int i = 0; i < bins; ++i)
+                {
+                    jitter += QString::number(stats.jitter[i]);
+                }
+                DJV_LOG(context()->debugLog(), "djv::ViewLib::PlaybackGroup",
+                    QString("Playback ticks = %1, late = %2, dropped = %3").
+                    arg(stats.ticks).arg(stats.late).arg(stats.dropped));
+                DJV_LOG(context()->debugLog(), "djv::ViewLib::PlaybackGroup",
+                    QString("Playback jitter (milliseconds) = %1").arg(jitter.join(" ")));
             }
         }
 
@@ -106,6 +106,10 @@ namespace djv
             //! Set the sequence.
             void setSequence(const djv::Core::Sequence &);
 
+            //! Append frames to the end of the sequence, keeping the current
+            //! frame and in/out points.
+            void appendFrames(const djv::Core::FrameList &);
+
             //! Set the playback.
             void setPlayback(djv::ViewLib::Enum::PLAYBACK);
 
@@ -200,10 +204,8 @@ namespace djv
             //! This signal is emitted when the layout is changed.
             void layoutChanged(djv::ViewLib::Enum::LAYOUT);
 
-        protected:
-            void timerEvent(QTimerEvent *) override;
-
         private Q_SLOTS:
+            void clockCallback();
             void playbackCallback(QAction *);
             void playbackShuttleCallback(bool);
             void playbackShuttleValueCallback(int);
@@ -228,6 +230,8 @@ namespace djv
             bool durationInOutEnabled() const;
 
             void playbackUpdate();
+            void clockStart(float speed);
+            void clockStop();
             void timeUpdate();
             void speedUpdate();
             void layoutUpdate();
@@ -168,6 +168,11 @@ namespace djv
                 _p->fileGroup.data(),
                 SIGNAL(exportFrame(const djv::Core::FileInfo &)),
                 SLOT(exportFrameCallback(const djv::Core::FileInfo &)));
+            connect(
+                _p->fileGroup.data(),
+                SIGNAL(framesAppended(const djv::Core::FrameList &)),
+                _p->playbackGroup.data(),
+                SLOT(appendFrames(const djv::Core::FrameList &)));
 
             // Setup the image group callbacks.
             connect(
@@ -402,7 +407,7 @@ namespace djv
             //DJV_DEBUG("Session::reloadFrameCallback");
             const qint64 frame = _p->playbackGroup->frame();
             //DJV_DEBUG_PRINT("frame = " << frame);
-            _p->context->fileCache()->removeItem(FileCacheKey(this, frame));
+            _p->context->fileCache()->clearItems(this, frame);
         }
 
         void Session::exportSequenceCallback(const Core::FileInfo & in)
@@ -85,8 +85,6 @@ namespace djv
                 qApp->translate("djv::ViewLib::StatusBar", "Image information."));
 
             _p->cacheLabel = new QLabel;
-            _p->cacheLabel->setToolTip(
-                qApp->translate("djv::ViewLib::StatusBar", "File cache information."));
 
             addWidget(_p->swatch);
             addWidget(_p->pixelLabel);
@@ -192,13 +190,40 @@ namespace djv
 
         void StatusBar::widgetUpdate()
         {
-            const float sizeGB = _p->context->fileCache()->currentSizeGB();
-            const float maxSizeGB = _p->context->fileCache()->maxSizeGB();
-            _p->cacheLabel->setText(
-                qApp->translate("djv::ViewLib::StatusBar", "Cache: %1% %2/%3GB").
+            auto fileCache = _p->context->fileCache();
+            const float sizeGB = fileCache->currentSizeGB();
+            const float maxSizeGB = fileCache->maxSizeGB();
+            QString cacheLabel = qApp->translate("djv::ViewLib::StatusBar", "Cache: %1% %2/%3GB").
                 arg(static_cast<int>(sizeGB / maxSizeGB * 100)).
                 arg(sizeGB, 0, 'f', 2).
-                arg(maxSizeGB, 0, 'f', 2));
+                arg(maxSizeGB, 0, 'f', 2);
+            if (fileCache->hasCompression())
+            {
+                cacheLabel += qApp->translate("djv::ViewLib::StatusBar", " Compressed: %1GB %2:1").
+                    arg(fileCache->compressedSizeGB(), 0, 'f', 2).
+                    arg(fileCache->compressionRatio(), 0, 'f', 1);
+            }
+            if (fileCache->hasDiskCache())
+            {
+                cacheLabel += qApp->translate("djv::ViewLib::StatusBar", " Disk: %1/%2GB").
+                    arg(fileCache->diskCurrentSizeGB(), 0, 'f', 2).
+                    arg(fileCache->diskMaxSizeGB(), 0, 'f', 2);
+            }
+            _p->cacheLabel->setText(cacheLabel);
+            QStringList cacheToolTip;
+            cacheToolTip << qApp->translate("djv::ViewLib::StatusBar", "File cache information.");
+            for (int i = 0; i < FileCache::TIER_COUNT; ++i)
+            {
+                const auto tier = static_cast<FileCache::TIER>(i);
+                const quint64 hits = fileCache->hits(tier);
+                const quint64 misses = fileCache->misses(tier);
+                cacheToolTip << qApp->translate("djv::ViewLib::StatusBar", "%1: %2 hits, %3 misses (%4%)").
+                    arg(FileCache::tierLabels()[i]).
+                    arg(hits).
+                    arg(misses).
+                    arg(hits + misses ? static_cast<int>(hits * 100 / (hits + misses)) : 0);
+            }
+            _p->cacheLabel->setToolTip(cacheToolTip.join("\n"));
 
             AV::PixelDataInfo info;
             if (_p->image)
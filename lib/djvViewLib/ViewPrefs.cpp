@@ -51,7 +51,8 @@ namespace djv
                 { Enum::HUD_PIXEL, true },
                 { Enum::HUD_TAG, true },
                 { Enum::HUD_FRAME, true },
-                { Enum::HUD_SPEED, true }
+                { Enum::HUD_SPEED, true },
+                { Enum::HUD_LATENCY, false }
             };
             const AV::Color             hudColorDefault           = AV::Color(1.f);
             const Enum::HUD_BACKGROUND  hudBackgroundDefault      = Enum::HUD_BACKGROUND_SHADOW;
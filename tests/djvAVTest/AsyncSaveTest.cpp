@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/AsyncSaveTest.h>
+
+#include <djvAV/AsyncSave.h>
+#include <djvAV/AVContext.h>
+#include <djvAV/Image.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        void AsyncSaveTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("AsyncSaveTest::run");
+            write(argc, argv);
+            error(argc, argv);
+        }
+
+        void AsyncSaveTest::write(int & argc, char ** argv)
+        {
+            DJV_DEBUG("AsyncSaveTest::write");
+            AV::AVContext context(argc, argv);
+            const AV::PixelDataInfo pixelDataInfo(1, 1, AV::Pixel::L_U8);
+            const int frames = 8;
+            {
+                AV::IOInfo info(pixelDataInfo);
+                info.sequence = Sequence(1, frames);
+                AV::AsyncSave save(context.ioFactory()->save(FileInfo("AsyncSaveTest.1.ppm"), info));
+                DJV_ASSERT(2 == save.queueSize());
+                for (int i = 1; i <= frames; ++i)
+                {
+                    AV::Image image(pixelDataInfo);
+                    image.data()[0] = i * 10;
+                    save.write(std::move(image), AV::ImageIOInfo(i));
+                }
+                save.close();
+            }
+            for (int i = 1; i <= frames; ++i)
+            {
+                AV::IOInfo info;
+                auto load = context.ioFactory()->load(FileInfo(QString("AsyncSaveTest.%1.ppm").arg(i)), info);
+                AV::Image image;
+                load->read(image);
+                DJV_ASSERT(image.info().pixel == pixelDataInfo.pixel);
+                DJV_ASSERT(i * 10 == image.data()[0]);
+            }
+        }
+
+        void AsyncSaveTest::error(int & argc, char ** argv)
+        {
+            DJV_DEBUG("AsyncSaveTest::error");
+            AV::AVContext context(argc, argv);
+            const AV::PixelDataInfo pixelDataInfo(1, 1, AV::Pixel::L_U8);
+            {
+                AV::AsyncSave save(context.ioFactory()->save(FileInfo("AsyncSaveTest/error.ppm"), pixelDataInfo), 1);
+                save.write(AV::Image(pixelDataInfo));
+                try
+                {
+                    save.close();
+                    DJV_ASSERT(0);
+                }
+                catch (const Error &)
+                {}
+            }
+            {
+                AV::IOInfo info(pixelDataInfo);
+                info.sequence = Sequence(1, 3);
+                AV::AsyncSave save(context.ioFactory()->save(FileInfo("AsyncSaveTest/error.1.ppm"), info), 1);
+                bool error = false;
+                try
+                {
+                    for (int i = 1; i <= 3; ++i)
+                    {
+                        save.write(AV::Image(pixelDataInfo), AV::ImageIOInfo(i));
+                    }
+                    save.close();
+                }
+                catch (const Error &)
+                {
+                    error = true;
+                }
+                DJV_ASSERT(error);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -33,6 +33,9 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
+#include <djvCore/Timer.h>
+
+#include <vector>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -47,8 +50,38 @@ namespace djv
             convert();
             interleave();
             deinterleave();
+            if (hasBenchmarks())
+            {
+                benchmark();
+            }
         }
 
+        namespace
+        {
+            template<typename U, typename V>
+            void convertCheck(const std::vector<U> & in, Audio::TYPE inType, Audio::TYPE outType)
+            {
+                // The conversion should match Audio::convert() both out of
+                // place and in place.
+                const auto info = AudioInfo(1, inType, 1, in.size());
+                auto data = AV::AudioData(info);
+                memcpy(data.data(), in.data(), info.byteCount());
+                AudioData out;
+                AV::AudioData::convert(data, out, outType);
+                AV::AudioData::convert(data, data, outType);
+                DJV_ASSERT(out.type() == outType);
+                DJV_ASSERT(out == data);
+                auto outP = reinterpret_cast<const V *>(out.data());
+                for (size_t i = 0; i < in.size(); ++i)
+                {
+                    V tmp;
+                    Audio::convert(in[i], tmp);
+                    DJV_ASSERT(0 == memcmp(&tmp, outP + i, sizeof(V)));
+                }
+            }
+
+        } // namespace
+
         void AudioDataTest::convert()
         {
             DJV_DEBUG("AudioDataTest::convert");
@@ -67,6 +100,33 @@ namespace djv
                     DJV_DEBUG_PRINT(dataP[i] << " = " << outDataP[i]);
                 }
             }
+            {
+                std::vector<Audio::U8_T> u8;
+                std::vector<Audio::S16_T> s16;
+                std::vector<Audio::S32_T> s32;
+                std::vector<Audio::F32_T> f32 = { -2.f, -1.f, 0.f, 1.f, 2.f };
+                for (int i = 0; i < 65536 + 3; ++i)
+                {
+                    u8.push_back(static_cast<Audio::U8_T>(i));
+                    s16.push_back(static_cast<Audio::S16_T>(i));
+                    s32.push_back(static_cast<Audio::S32_T>(i * 65599u));
+                    f32.push_back(i / 32768.f - 1.f);
+                }
+                s32.push_back(Audio::s32Min);
+                s32.push_back(Audio::s32Max);
+                convertCheck<Audio::U8_T, Audio::S16_T>(u8, Audio::U8, Audio::S16);
+                convertCheck<Audio::U8_T, Audio::S32_T>(u8, Audio::U8, Audio::S32);
+                convertCheck<Audio::U8_T, Audio::F32_T>(u8, Audio::U8, Audio::F32);
+                convertCheck<Audio::S16_T, Audio::U8_T>(s16, Audio::S16, Audio::U8);
+                convertCheck<Audio::S16_T, Audio::S32_T>(s16, Audio::S16, Audio::S32);
+                convertCheck<Audio::S16_T, Audio::F32_T>(s16, Audio::S16, Audio::F32);
+                convertCheck<Audio::S32_T, Audio::U8_T>(s32, Audio::S32, Audio::U8);
+                convertCheck<Audio::S32_T, Audio::S16_T>(s32, Audio::S32, Audio::S16);
+                convertCheck<Audio::S32_T, Audio::F32_T>(s32, Audio::S32, Audio::F32);
+                convertCheck<Audio::F32_T, Audio::U8_T>(f32, Audio::F32, Audio::U8);
+                convertCheck<Audio::F32_T, Audio::S16_T>(f32, Audio::F32, Audio::S16);
+                convertCheck<Audio::F32_T, Audio::S32_T>(f32, Audio::F32, Audio::S32);
+            }
         }
 
         void AudioDataTest::interleave()
@@ -110,6 +170,35 @@ namespace djv
                         }).data(),
                     info.byteCount()));
             }
+            for (auto type : { Audio::U8, Audio::S16, Audio::S32, Audio::F32 })
+            {
+                for (size_t channels = 1; channels <= 9; ++channels)
+                {
+                    const size_t planeSize = 37;
+                    const auto info = AudioInfo(channels, type, 1, channels * planeSize);
+                    auto planar = AV::AudioData(info);
+                    for (uint64_t i = 0; i < info.byteCount(); ++i)
+                    {
+                        planar.data()[i] = static_cast<uint8_t>(i * 7);
+                    }
+                    AV::AudioData interleaved;
+                    AV::AudioData::planarInterleave(planar, interleaved);
+                    const int byteCount = Audio::byteCount(type);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        for (size_t i = 0; i < planeSize; ++i)
+                        {
+                            DJV_ASSERT(0 == memcmp(
+                                interleaved.data(i * channels + c),
+                                planar.data(c * planeSize + i),
+                                byteCount));
+                        }
+                    }
+                    AV::AudioData deinterleaved;
+                    AV::AudioData::planarDeinterleave(interleaved, deinterleaved);
+                    DJV_ASSERT(planar == deinterleaved);
+                }
+            }
         }
 
         void AudioDataTest::deinterleave()
@@ -155,5 +244,39 @@ namespace djv
             }
         }
 
+        void AudioDataTest::benchmark()
+        {
+            DJV_DEBUG("AudioDataTest::benchmark");
+
+            // One minute of stereo audio; the time per second of audio should
+            // be a small fraction of a frame interval.
+            const size_t sampleRate = 48000;
+            const size_t seconds = 60;
+            auto data = AV::AudioData(AudioInfo(2, Audio::S16, sampleRate, 2 * sampleRate * seconds));
+            data.zero();
+            AV::AudioData f32;
+            AV::AudioData s16;
+            AV::AudioData planar;
+            AV::AudioData interleaved;
+            Timer timer;
+            timer.start();
+            AV::AudioData::convert(data, f32, Audio::F32);
+            timer.check();
+            DJV_DEBUG_PRINT("S16 to F32 = " << timer.seconds() / seconds << " seconds per second");
+            timer.start();
+            AV::AudioData::convert(f32, s16, Audio::S16);
+            timer.check();
+            DJV_DEBUG_PRINT("F32 to S16 = " << timer.seconds() / seconds << " seconds per second");
+            timer.start();
+            AV::AudioData::planarDeinterleave(f32, planar);
+            timer.check();
+            DJV_DEBUG_PRINT("deinterleave = " << timer.seconds() / seconds << " seconds per second");
+            timer.start();
+            AV::AudioData::planarInterleave(planar, interleaved);
+            timer.check();
+            DJV_DEBUG_PRINT("interleave = " << timer.seconds() / seconds << " seconds per second");
+            DJV_ASSERT(interleaved == f32);
+        }
+
     } // namespace AVTest
 } // namespace djv
@@ -44,6 +44,7 @@ namespace djv
             void convert();
             void interleave();
             void deinterleave();
+            void benchmark();
         };
 
     } // namespace AVTest
@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/AudioResamplerTest.h>
+
+#include <djvAV/AudioResampler.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Timer.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        void AudioResamplerTest::run(int &, char **)
+        {
+            DJV_DEBUG("AudioResamplerTest::run");
+            members();
+            tone();
+            stream();
+            if (hasBenchmarks())
+            {
+                benchmark();
+            }
+        }
+
+        namespace
+        {
+            const double pi = 3.14159265358979323846;
+
+            //! Create a stereo tone with a sine in the left channel and a
+            //! cosine in the right channel.
+            AudioData toneData(size_t sampleRate, size_t frames, double frequency)
+            {
+                AudioData out(AudioInfo(2, Audio::F32, sampleRate, frames * 2));
+                auto p = reinterpret_cast<Audio::F32_T *>(out.data());
+                for (size_t i = 0; i < frames; ++i, p += 2)
+                {
+                    const double t = 2.0 * pi * frequency * i / sampleRate;
+                    p[0] = static_cast<float>(.5 * std::sin(t));
+                    p[1] = static_cast<float>(.25 * std::cos(t));
+                }
+                return out;
+            }
+
+            void append(const AudioData & in, std::vector<float> & out)
+            {
+                const auto p = reinterpret_cast<const Audio::F32_T *>(in.data());
+                out.insert(out.end(), p, p + in.sampleCount());
+            }
+
+        } // namespace
+
+        void AudioResamplerTest::members()
+        {
+            DJV_DEBUG("AudioResamplerTest::members");
+            {
+                const AudioResampler resampler(2, 44100, 48000, AudioResampler::QUALITY_BEST);
+                DJV_ASSERT(2 == resampler.channels());
+                DJV_ASSERT(44100 == resampler.inputSampleRate());
+                DJV_ASSERT(48000 == resampler.outputSampleRate());
+                DJV_ASSERT(AudioResampler::QUALITY_BEST == resampler.quality());
+                DJV_ASSERT(resampler.latency() > 0);
+            }
+            {
+                DJV_ASSERT(AudioResampler::QUALITY_COUNT == AudioResampler::qualityLabels().count());
+            }
+        }
+
+        void AudioResamplerTest::tone()
+        {
+            DJV_DEBUG("AudioResamplerTest::tone");
+            struct Data
+            {
+                size_t inputSampleRate;
+                size_t outputSampleRate;
+            };
+            const std::vector<Data> data =
+            {
+                { 44100, 48000 },
+                { 48000, 44100 },
+                { 48000, 48000 },
+                { 22050, 48000 },
+                { 96000, 44100 }
+            };
+            const float tolerance[AudioResampler::QUALITY_COUNT] = { 1.e-3f, 1.e-4f, 1.e-5f };
+            for (const auto & i : data)
+            {
+                for (int quality = 0; quality < AudioResampler::QUALITY_COUNT; ++quality)
+                {
+                    DJV_DEBUG_PRINT(i.inputSampleRate << " to " << i.outputSampleRate <<
+                        " quality = " << static_cast<AudioResampler::QUALITY>(quality));
+                    AudioResampler resampler(2, i.inputSampleRate, i.outputSampleRate,
+                        static_cast<AudioResampler::QUALITY>(quality));
+                    std::vector<float> out;
+                    AudioData tmp;
+                    resampler.process(toneData(i.inputSampleRate, i.inputSampleRate, 1000.0), tmp);
+                    DJV_ASSERT(i.outputSampleRate == tmp.sampleRate());
+                    append(tmp, out);
+                    resampler.flush(tmp);
+                    append(tmp, out);
+
+                    // One second of input should give one second of output
+                    // that matches the tone away from the ends.
+                    DJV_ASSERT(out.size() == i.outputSampleRate * 2);
+                    const size_t skip = resampler.latency() * i.outputSampleRate / i.inputSampleRate + 64;
+                    float error = 0.f;
+                    for (size_t j = skip; j < i.outputSampleRate - skip; ++j)
+                    {
+                        const double t = 2.0 * pi * 1000.0 * j / i.outputSampleRate;
+                        error = std::max(error, std::abs(out[j * 2] - static_cast<float>(.5 * std::sin(t))));
+                        error = std::max(error, std::abs(out[j * 2 + 1] - static_cast<float>(.25 * std::cos(t))));
+                    }
+                    DJV_DEBUG_PRINT("error = " << error);
+                    DJV_ASSERT(error < tolerance[quality]);
+                }
+            }
+            {
+                // A tone above the output Nyquist frequency should be removed.
+                AudioData in(AudioInfo(1, Audio::S16, 96000, 96000));
+                auto p = reinterpret_cast<Audio::S16_T *>(in.data());
+                for (size_t i = 0; i < in.sampleCount(); ++i)
+                {
+                    p[i] = static_cast<Audio::S16_T>(16000 * std::sin(2.0 * pi * 30000.0 * i / 96000));
+                }
+                AudioResampler resampler(1, 96000, 44100);
+                AudioData out;
+                resampler.process(in, out);
+                DJV_ASSERT(Audio::S16 == out.type());
+                auto outP = reinterpret_cast<const Audio::S16_T *>(out.data());
+                for (size_t i = 0; i < out.sampleCount(); ++i)
+                {
+                    DJV_ASSERT(std::abs(outP[i]) < 16);
+                }
+            }
+        }
+
+        void AudioResamplerTest::stream()
+        {
+            DJV_DEBUG("AudioResamplerTest::stream");
+
+            // Resampling in pieces should give the same result as resampling
+            // all at once.
+            const AudioData in = toneData(44100, 44100, 440.0);
+            AudioResampler resampler(2, 44100, 48000);
+            std::vector<float> all;
+            AudioData tmp;
+            resampler.process(in, tmp);
+            append(tmp, all);
+            resampler.flush(tmp);
+            append(tmp, all);
+
+            std::vector<float> pieces;
+            const auto inP = reinterpret_cast<const Audio::F32_T *>(in.data());
+            size_t frame = 0;
+            for (size_t size = 1; frame < 44100; size = size * 3 + 7)
+            {
+                const size_t frames = std::min(size, static_cast<size_t>(44100) - frame);
+                AudioData piece(AudioInfo(2, Audio::F32, 44100, frames * 2));
+                memcpy(piece.data(), inP + frame * 2, piece.byteCount());
+                resampler.process(piece, tmp);
+                append(tmp, pieces);
+                frame += frames;
+            }
+            resampler.flush(tmp);
+            append(tmp, pieces);
+            DJV_ASSERT(all == pieces);
+        }
+
+        void AudioResamplerTest::benchmark()
+        {
+            DJV_DEBUG("AudioResamplerTest::benchmark");
+
+            // The time to resample a second of audio should be a small
+            // fraction of a frame interval.
+            const size_t seconds = 10;
+            const AudioData in = toneData(44100, 44100 * seconds, 1000.0);
+            for (int quality = 0; quality < AudioResampler::QUALITY_COUNT; ++quality)
+            {
+                AudioResampler resampler(2, 44100, 48000, static_cast<AudioResampler::QUALITY>(quality));
+                AudioData out;
+                Timer timer;
+                timer.start();
+                resampler.process(in, out);
+                timer.check();
+                DJV_DEBUG_PRINT(static_cast<AudioResampler::QUALITY>(quality) << " = " <<
+                    timer.seconds() / seconds << " seconds per second");
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/CompressedPixelDataTest.h>
+
+#include <djvAV/CompressedPixelData.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        void CompressedPixelDataTest::run(int &, char **)
+        {
+            DJV_DEBUG("CompressedPixelDataTest::run");
+            ctors();
+            roundTrip();
+        }
+
+        void CompressedPixelDataTest::ctors()
+        {
+            DJV_DEBUG("CompressedPixelDataTest::ctors");
+            {
+                const CompressedPixelData data;
+                DJV_ASSERT(!data.info().isValid());
+                DJV_ASSERT(0 == data.dataByteCount());
+                DJV_ASSERT(0 == data.byteCount());
+            }
+            {
+                const PixelData pixelData;
+                const CompressedPixelData data(pixelData);
+                DJV_ASSERT(0 == data.byteCount());
+            }
+        }
+
+        void CompressedPixelDataTest::roundTrip()
+        {
+            DJV_DEBUG("CompressedPixelDataTest::roundTrip");
+            for (int i = 0; i < Pixel::PIXEL_COUNT; ++i)
+            {
+                const Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(i);
+                DJV_DEBUG_PRINT("pixel = " << pixel);
+
+                // Use a size that gives several bands.
+                const PixelDataInfo info(glm::ivec2(1021, 701), pixel);
+                PixelData smooth(info);
+                PixelData noise(info);
+                PixelData empty(info);
+                empty.zero();
+                for (int y = 0; y < info.size.y; ++y)
+                {
+                    quint8 * smoothP = smooth.data(0, y);
+                    quint8 * noiseP = noise.data(0, y);
+                    for (quint64 x = 0; x < smooth.scanlineByteCount(); ++x)
+                    {
+                        smoothP[x] = static_cast<quint8>((x / smooth.pixelByteCount() / 64) % 256);
+                        noiseP[x] = static_cast<quint8>(Math::rand(255.f));
+                    }
+                }
+                for (const auto & in : { smooth, noise, empty })
+                {
+                    const CompressedPixelData data(in);
+                    DJV_ASSERT(in.info() == data.info());
+                    DJV_ASSERT(in.dataByteCount() == data.dataByteCount());
+                    DJV_ASSERT(data.byteCount() <= data.dataByteCount());
+                    PixelData out;
+                    data.decompress(out);
+                    DJV_ASSERT(in == out);
+                }
+                DJV_ASSERT(CompressedPixelData(smooth).byteCount() < smooth.dataByteCount() / 2);
+                DJV_ASSERT(CompressedPixelData(empty).byteCount() < empty.dataByteCount() / 16);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
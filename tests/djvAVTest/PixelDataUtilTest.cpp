@@ -35,6 +35,7 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
+#include <djvCore/Math.h>
 
 #include <QPixmap>
 #include <QString>
@@ -52,6 +53,7 @@ namespace djv
             byteCount();
             proxy();
             interleave();
+            convertU8();
             gradient();
         }
 
@@ -142,6 +144,58 @@ namespace djv
             }
         }
 
+        void PixelDataUtilTest::convertU8()
+        {
+            DJV_DEBUG("PixelDataUtilTest::convertU8");
+            {
+                AV::PixelData data(AV::PixelDataInfo(4, 2, AV::Pixel::RGBA_F32));
+                AV::Pixel::F32_T * p = reinterpret_cast<AV::Pixel::F32_T *>(data.data());
+                for (int i = 0; i < 4 * 2 * 4; ++i)
+                {
+                    p[i] = i / static_cast<float>(4 * 2 * 4 - 1);
+                }
+                p[0] = -1.f;
+                p[1] = 2.f;
+                AV::PixelDataInfo info(data.info());
+                info.pixel = AV::Pixel::RGBA_U8;
+                AV::PixelData u8(info);
+                DJV_ASSERT(AV::PixelDataUtil::convertU8(data, u8));
+                for (int i = 0; i < 4 * 2 * 4; ++i)
+                {
+                    DJV_ASSERT(u8.data()[i] == AV::Pixel::f32ToU8(p[i]));
+                }
+
+                AV::ColorProfile colorProfile;
+                colorProfile.type = AV::ColorProfile::GAMMA;
+                colorProfile.gamma = 2.f;
+                DJV_ASSERT(AV::PixelDataUtil::convertU8(data, u8, colorProfile));
+                for (int i = 0; i < 4 * 2 * 4; ++i)
+                {
+                    const float value = (i % 4) < 3 && p[i] >= 0.f ? Math::pow(p[i], .5f) : p[i];
+                    DJV_ASSERT(u8.data()[i] == AV::Pixel::f32ToU8(value));
+                }
+
+                colorProfile.type = AV::ColorProfile::LUT;
+                colorProfile.lut.set(AV::PixelDataInfo(2, 1, AV::Pixel::L_U8));
+                colorProfile.lut.data()[0] = 255;
+                colorProfile.lut.data()[1] = 0;
+                DJV_ASSERT(AV::PixelDataUtil::convertU8(data, u8, colorProfile));
+                DJV_ASSERT(255 == u8.data()[0]);
+                DJV_ASSERT(0 == u8.data()[1]);
+                DJV_ASSERT(AV::Pixel::f32ToU8(p[3]) == u8.data()[3]);
+            }
+            {
+                AV::PixelData data(AV::PixelDataInfo(2, 2, AV::Pixel::L_U16));
+                data.zero();
+                AV::PixelData u8(AV::PixelDataInfo(2, 2, AV::Pixel::RGB_U8));
+                DJV_ASSERT(!AV::PixelDataUtil::convertU8(data, u8));
+                u8.set(AV::PixelDataInfo(1, 2, AV::Pixel::L_U8));
+                DJV_ASSERT(!AV::PixelDataUtil::convertU8(data, u8));
+                u8.set(AV::PixelDataInfo(2, 2, AV::Pixel::L_U8));
+                DJV_ASSERT(AV::PixelDataUtil::convertU8(data, u8));
+            }
+        }
+
         void PixelDataUtilTest::gradient()
         {
             DJV_DEBUG("PixelDataUtilTest::gradient");
@@ -44,6 +44,7 @@ namespace djv
             void byteCount();
             void proxy();
             void interleave();
+            void convertU8();
             void gradient();
             void qt();
         };
@@ -35,9 +35,12 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
+#include <djvCore/Memory.h>
 
 #include <QStringList>
 
+#include <vector>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -51,6 +54,7 @@ namespace djv
             mask();
             members();
             convert();
+            u10();
             operators();
         }
 
@@ -379,6 +383,128 @@ namespace djv
             }
         }
 
+        void PixelTest::u10()
+        {
+            DJV_DEBUG("PixelTest::u10");
+            const int shifts[][3] =
+            {
+                { 22, 12, 2 },
+                { 20, 10, 0 }
+            };
+            const bool swap = Memory::endian() == Memory::LSB;
+            for (int size : { 1, 4, 5, 17, 100 })
+            {
+                for (int fill = 0; fill < AV::Pixel::U10_FILL_COUNT; ++fill)
+                {
+                    for (int endian = 0; endian < 2; ++endian)
+                    {
+                        DJV_DEBUG_PRINT("size = " << size);
+                        DJV_DEBUG_PRINT("fill = " << fill);
+                        DJV_DEBUG_PRINT("endian = " << endian);
+
+                        // Create big endian words from random components.
+                        std::vector<AV::Pixel::U10_T> components(size * 3);
+                        std::vector<quint8> words(size * 4);
+                        for (int i = 0; i < size; ++i)
+                        {
+                            quint32 word = 0;
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                const AV::Pixel::U10_T value = Math::min(
+                                    static_cast<int>(Math::rand(static_cast<float>(AV::Pixel::u10Max + 1))),
+                                    AV::Pixel::u10Max);
+                                components[i * 3 + c] = value;
+                                word |= static_cast<quint32>(value) << shifts[fill][c];
+                            }
+                            for (int b = 0; b < 4; ++b)
+                            {
+                                words[i * 4 + b] = word >> (24 - b * 8);
+                            }
+                        }
+                        const bool wordsEndian = 0 == endian ? swap : !swap;
+                        if (endian)
+                        {
+                            Memory::convertEndian(words.data(), size, 4);
+                        }
+                        const AV::Pixel::U10_FILL _fill = static_cast<AV::Pixel::U10_FILL>(fill);
+
+                        // Unpack the words.
+                        std::vector<AV::Pixel::U8_T> u8(size * 3);
+                        std::vector<AV::Pixel::U16_T> u16(size * 3);
+                        std::vector<AV::Pixel::F16_T> f16(size * 3);
+                        std::vector<AV::Pixel::F32_T> f32(size * 3);
+                        std::vector<quint8> u10(size * 4);
+                        DJV_ASSERT(AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, u8.data(), AV::Pixel::RGB_U8, size));
+                        DJV_ASSERT(AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, u16.data(), AV::Pixel::RGB_U16, size));
+                        DJV_ASSERT(AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, f16.data(), AV::Pixel::RGB_F16, size));
+                        DJV_ASSERT(AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, f32.data(), AV::Pixel::RGB_F32, size));
+                        DJV_ASSERT(AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, u10.data(), AV::Pixel::RGB_U10, size));
+                        for (int i = 0; i < size * 3; ++i)
+                        {
+                            DJV_ASSERT(AV::Pixel::u10ToU8(components[i]) == u8[i]);
+                            DJV_ASSERT(AV::Pixel::u10ToU16(components[i]) == u16[i]);
+                            DJV_ASSERT(AV::Pixel::u10ToF16(components[i]) == f16[i]);
+                            DJV_ASSERT(AV::Pixel::u10ToF32(components[i]) == f32[i]);
+                        }
+                        for (int i = 0; i < size; ++i)
+                        {
+                            const AV::Pixel::U10_S * p = reinterpret_cast<const AV::Pixel::U10_S *>(u10.data() + i * 4);
+                            DJV_ASSERT(components[i * 3 + 0] == p->r);
+                            DJV_ASSERT(components[i * 3 + 1] == p->g);
+                            DJV_ASSERT(components[i * 3 + 2] == p->b);
+                        }
+
+                        // Pack the data back into words.
+                        std::vector<quint8> tmp(size * 4);
+                        DJV_ASSERT(AV::Pixel::packU10(u16.data(), AV::Pixel::RGB_U16, tmp.data(), _fill, wordsEndian, size));
+                        DJV_ASSERT(words == tmp);
+                        DJV_ASSERT(AV::Pixel::packU10(f16.data(), AV::Pixel::RGB_F16, tmp.data(), _fill, wordsEndian, size));
+                        DJV_ASSERT(words == tmp);
+                        DJV_ASSERT(AV::Pixel::packU10(f32.data(), AV::Pixel::RGB_F32, tmp.data(), _fill, wordsEndian, size));
+                        DJV_ASSERT(words == tmp);
+                        DJV_ASSERT(AV::Pixel::packU10(u10.data(), AV::Pixel::RGB_U10, tmp.data(), _fill, wordsEndian, size));
+                        DJV_ASSERT(words == tmp);
+
+                        // Unpack in place.
+                        tmp = words;
+                        AV::Pixel::unpackU10(tmp.data(), _fill, wordsEndian, tmp.data(), AV::Pixel::RGB_U10, size);
+                        DJV_ASSERT(u10 == tmp);
+
+                        // Unpack with a stride.
+                        std::vector<AV::Pixel::U16_T> strided(((size + 1) / 2) * 3);
+                        AV::Pixel::unpackU10(words.data(), _fill, wordsEndian, strided.data(), AV::Pixel::RGB_U16, (size + 1) / 2, 2);
+                        for (int i = 0; i < (size + 1) / 2; ++i)
+                        {
+                            DJV_ASSERT(u16[i * 2 * 3] == strided[i * 3]);
+                        }
+
+                        // Compare with the generic conversion.
+                        if (0 == fill)
+                        {
+                            AV::Pixel::convert(u10.data(), AV::Pixel::RGB_U10, tmp.data(), AV::Pixel::RGB_U10, size);
+                            std::vector<AV::Pixel::F32_T> f32b(size * 3);
+                            AV::Pixel::convert(tmp.data(), AV::Pixel::RGB_U10, f32b.data(), AV::Pixel::RGB_F32, size);
+                            DJV_ASSERT(f32 == f32b);
+                            AV::Pixel::convert(f32b.data(), AV::Pixel::RGB_F32, tmp.data(), AV::Pixel::RGB_U10, size);
+                            DJV_ASSERT(u10 == tmp);
+                        }
+                    }
+                }
+            }
+            {
+                quint32 word = 0;
+                quint8 u8[4];
+                DJV_ASSERT(!AV::Pixel::unpackU10(&word, AV::Pixel::U10_FILL_A, false, u8, AV::Pixel::RGBA_U8, 1));
+                DJV_ASSERT(!AV::Pixel::packU10(u8, AV::Pixel::RGBA_U8, &word, AV::Pixel::U10_FILL_A, false, 1));
+            }
+            {
+                const AV::Pixel::F32_T in[] = { -1.f, 0.f, 2.f };
+                quint32 word = 0;
+                AV::Pixel::packU10(in, AV::Pixel::RGB_F32, &word, AV::Pixel::U10_FILL_B, false, 1);
+                DJV_ASSERT(static_cast<quint32>(AV::Pixel::u10Max) == word);
+            }
+        }
+
         void PixelTest::operators()
         {
             DJV_DEBUG("PixelTest::operators");
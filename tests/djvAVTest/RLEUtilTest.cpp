@@ -0,0 +1,460 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/RLEUtilTest.h>
+
+#include <djvAV/PIC.h>
+#include <djvAV/RLA.h>
+#include <djvAV/RLEUtil.h>
+#include <djvAV/SGI.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <string.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            int randInt(int max)
+            {
+                return Math::min(static_cast<int>(Math::rand(static_cast<float>(max))), max - 1);
+            }
+
+            //! Encode PIC packets, with the long run counts stored big endian.
+            std::vector<quint8> picEncode(const quint8 * in, int size, int channels)
+            {
+                std::vector<quint8> out;
+                while (size > 0)
+                {
+                    int count = RLEUtil::runLength(in, channels, Math::min(size, 65535));
+                    if (count > 1)
+                    {
+                        if (count <= 128)
+                        {
+                            out.push_back(count + 127);
+                        }
+                        else
+                        {
+                            out.push_back(128);
+                            out.push_back(count >> 8);
+                            out.push_back(count & 0xff);
+                        }
+                        out.insert(out.end(), in, in + channels);
+                    }
+                    else
+                    {
+                        count = RLEUtil::literalLength(in, channels, Math::min(size, 128), 2);
+                        out.push_back(count - 1);
+                        out.insert(out.end(), in, in + count * channels);
+                    }
+                    in += count * channels;
+                    size -= count;
+                }
+                return out;
+            }
+
+            //! Encode a byte plane as RLA packets.
+            void rlaEncode(const quint8 * in, int size, int stride, std::vector<quint8> & out)
+            {
+                std::vector<quint8> plane(size);
+                for (int i = 0; i < size; ++i)
+                {
+                    plane[i] = in[i * stride];
+                }
+                const quint8 * p = plane.data();
+                while (size > 0)
+                {
+                    int count = RLEUtil::runLength(p, 1, Math::min(size, 128));
+                    if (count > 1)
+                    {
+                        out.push_back(count - 1);
+                        out.push_back(*p);
+                    }
+                    else
+                    {
+                        count = RLEUtil::literalLength(p, 1, Math::min(size, 128), 3);
+                        out.push_back(static_cast<quint8>(-count));
+                        out.insert(out.end(), p, p + count);
+                    }
+                    p += count;
+                    size -= count;
+                }
+            }
+
+        } // namespace
+
+        void RLEUtilTest::run(int &, char **)
+        {
+            DJV_DEBUG("RLEUtilTest::run");
+            Math::randSeed(1);
+            runLength();
+            packets();
+            sgi();
+            sgiFile();
+            pic();
+            rla();
+            fuzz();
+            if (hasBenchmarks())
+            {
+                benchmark();
+            }
+        }
+
+        void RLEUtilTest::runLength()
+        {
+            DJV_DEBUG("RLEUtilTest::runLength");
+            for (int i = 0; i < 1000; ++i)
+            {
+                const int elementSize = 1 + randInt(6);
+                const int size = 1 + randInt(100);
+                const std::vector<quint8> data = corpus(size, elementSize, 2);
+                const int max = 1 + randInt(size);
+                int run = 1;
+                while (run < max && 0 == memcmp(&data[run * elementSize], &data[0], elementSize))
+                {
+                    ++run;
+                }
+                DJV_ASSERT(run == RLEUtil::runLength(data.data(), elementSize, max));
+                int literal = max;
+                for (int j = 1, match = 1; j < max; ++j)
+                {
+                    if (0 == memcmp(&data[j * elementSize], &data[(j - 1) * elementSize], elementSize))
+                    {
+                        if (++match >= 3)
+                        {
+                            literal = Math::max(1, j - 2);
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        match = 1;
+                    }
+                }
+                DJV_ASSERT(literal == RLEUtil::literalLength(data.data(), elementSize, max, 3));
+            }
+        }
+
+        void RLEUtilTest::packets()
+        {
+            DJV_DEBUG("RLEUtilTest::packets");
+            for (int i = 0; i < 1000; ++i)
+            {
+                const int elementSize = 1 + randInt(4);
+                const int stride = elementSize + randInt(3);
+                const int size = randInt(1000);
+                const std::vector<quint8> data = corpus(size, elementSize, 1 + randInt(4));
+                std::vector<quint8> rle(RLEUtil::packetsMaxByteCount(size, elementSize));
+                const quint64 rleSize = RLEUtil::writePackets(data.data(), rle.data(), size, elementSize);
+                DJV_ASSERT(rleSize <= rle.size());
+                std::vector<quint8> out(size * stride);
+                DJV_ASSERT(rle.data() + rleSize == RLEUtil::readPackets(
+                    rle.data(), rle.data() + rleSize, out.data(), size, elementSize, stride));
+                for (int j = 0; j < size; ++j)
+                {
+                    DJV_ASSERT(0 == memcmp(&out[j * stride], &data[j * elementSize], elementSize));
+                }
+                if (rleSize)
+                {
+                    DJV_ASSERT(!RLEUtil::readPackets(
+                        rle.data(), rle.data() + rleSize - 1, out.data(), size, elementSize, stride));
+                }
+            }
+        }
+
+        void RLEUtilTest::sgi()
+        {
+            DJV_DEBUG("RLEUtilTest::sgi");
+            for (int i = 0; i < 1000; ++i)
+            {
+                const int  bytes = 1 + randInt(2);
+                const bool endian = randInt(2) ? true : false;
+                const int  size = 1 + randInt(1000);
+                const std::vector<quint8> data = corpus(size, bytes, 1 + randInt(4));
+                std::vector<quint8> rle(SGI::rleMaxByteCount(size, bytes));
+                const quint64 rleSize = SGI::writeRle(data.data(), rle.data(), size, bytes, endian);
+                DJV_ASSERT(rleSize <= rle.size());
+                const int stride = bytes * (1 + randInt(4));
+                std::vector<quint8> out(size * stride);
+                DJV_ASSERT(SGI::readRle(rle.data(), rle.data() + rleSize, out.data(), size, bytes, stride, endian));
+                for (int j = 0; j < size; ++j)
+                {
+                    DJV_ASSERT(0 == memcmp(&out[j * stride], &data[j * bytes], bytes));
+                }
+            }
+        }
+
+        void RLEUtilTest::sgiFile()
+        {
+            DJV_DEBUG("RLEUtilTest::sgiFile");
+
+            // A 16-bit scanline as stored in a file, with the words big endian:
+            // a run of three values, two literal values, and the terminator.
+            const quint8 rle[] =
+            {
+                0x00, 0x03, 0x12, 0x34,
+                0x00, 0x82, 0xab, 0xcd, 0x01, 0x02,
+                0x00, 0x00
+            };
+            const bool endian = Memory::endian() != Memory::MSB;
+            quint16 out[5] = { 0, 0, 0, 0, 0 };
+            DJV_ASSERT(SGI::readRle(
+                rle, rle + sizeof(rle), reinterpret_cast<quint8 *>(out), 5, 2, 2, endian));
+            DJV_ASSERT(0x1234 == out[0]);
+            DJV_ASSERT(0x1234 == out[1]);
+            DJV_ASSERT(0x1234 == out[2]);
+            DJV_ASSERT(0xabcd == out[3]);
+            DJV_ASSERT(0x0102 == out[4]);
+        }
+
+        void RLEUtilTest::pic()
+        {
+            DJV_DEBUG("RLEUtilTest::pic");
+            const bool endian = Memory::endian() != Memory::MSB;
+            for (int i = 0; i < 1000; ++i)
+            {
+                const int channels = 1 + randInt(4);
+                const int stride = 4;
+                const int size = 1 + randInt(1000);
+                const std::vector<quint8> data = corpus(size, channels, 1 + randInt(3));
+                const std::vector<quint8> rle = picEncode(data.data(), size, channels);
+                std::vector<quint8> out(size * stride);
+                DJV_ASSERT(rle.data() + rle.size() == PIC::readRle(
+                    rle.data(), rle.data() + rle.size(), out.data(), size, channels, stride, endian));
+                for (int j = 0; j < size; ++j)
+                {
+                    DJV_ASSERT(0 == memcmp(&out[j * stride], &data[j * channels], channels));
+                }
+            }
+        }
+
+        void RLEUtilTest::rla()
+        {
+            DJV_DEBUG("RLEUtilTest::rla");
+            const int size = 1000;
+            const int channels = 3;
+            const int bytes = 2;
+            const int stride = channels * bytes;
+            const bool lsb = Memory::LSB == Memory::endian();
+            const std::vector<quint8> data = corpus(size, stride, 3);
+            std::vector<quint8> file;
+            for (int c = 0; c < channels; ++c)
+            {
+                std::vector<quint8> rle;
+                for (int b = 0; b < bytes; ++b)
+                {
+                    rlaEncode(&data[c * bytes + (lsb ? (bytes - 1 - b) : b)], size, stride, rle);
+                }
+                file.push_back(rle.size() >> 8);
+                file.push_back(rle.size() & 0xff);
+                file.insert(file.end(), rle.begin(), rle.end());
+            }
+
+            // Add a channel with a negative size.
+            file.push_back(0xff);
+            file.push_back(0xff);
+
+            std::vector<quint8> out(size * stride);
+            const quint8 * p = file.data();
+            const quint8 * const end = file.data() + file.size();
+            for (int c = 0; c < channels; ++c)
+            {
+                p = RLA::readRle(p, end, out.data() + c * bytes, size, channels, bytes);
+                DJV_ASSERT(p);
+            }
+            DJV_ASSERT(out == data);
+            DJV_ASSERT(!RLA::readRle(p, end, out.data(), size, channels, bytes));
+            DJV_ASSERT(!RLA::skip(p, end));
+        }
+
+        void RLEUtilTest::fuzz()
+        {
+            DJV_DEBUG("RLEUtilTest::fuzz");
+
+            // Decode random and truncated data. The output buffers are sized
+            // exactly so that any write out of bounds is caught by the memory
+            // checking tools.
+            for (int i = 0; i < 10000; ++i)
+            {
+                const int size = 1 + randInt(256);
+                const int elementSize = 1 + randInt(4);
+                std::vector<quint8> in(randInt(512));
+                for (size_t j = 0; j < in.size(); ++j)
+                {
+                    in[j] = randInt(256);
+                }
+                const quint8 * const end = in.data() + in.size();
+                std::vector<quint8> out(size * elementSize);
+                const quint8 * p = RLEUtil::readPackets(in.data(), end, out.data(), size, elementSize, elementSize);
+                DJV_ASSERT(!p || (p >= in.data() && p <= end));
+                p = PIC::readRle(in.data(), end, out.data(), size, elementSize, elementSize, randInt(2) ? true : false);
+                DJV_ASSERT(!p || (p >= in.data() && p <= end));
+                p = RLA::readRle(in.data(), end, out.data(), size / elementSize, elementSize, 1);
+                DJV_ASSERT(!p || (p >= in.data() && p <= end));
+                const int bytes = 1 + randInt(2);
+                std::vector<quint8> sgiOut(size * bytes);
+                SGI::readRle(in.data(), end, sgiOut.data(), size, bytes, bytes, randInt(2) ? true : false);
+            }
+        }
+
+        void RLEUtilTest::benchmark()
+        {
+            DJV_DEBUG("RLEUtilTest::benchmark");
+            const int size = 2048 * 1556;
+            const float megabytes = size / 1024.f / 1024.f;
+            Timer timer;
+
+            // IFF tiles are compressed as byte planes.
+            {
+                const std::vector<quint8> data = corpus(size, 1, 8);
+                std::vector<quint8> rle(RLEUtil::packetsMaxByteCount(size, 1));
+                std::vector<quint8> out(size);
+                timer.start();
+                const quint64 rleSize = RLEUtil::writePackets(data.data(), rle.data(), size, 1);
+                timer.check();
+                DJV_DEBUG_PRINT("IFF write = " << megabytes / timer.seconds() << " MB/s");
+                timer.start();
+                RLEUtil::readPackets(rle.data(), rle.data() + rleSize, out.data(), size, 1, 1);
+                timer.check();
+                DJV_DEBUG_PRINT("IFF read = " << megabytes / timer.seconds() << " MB/s");
+            }
+
+            // Targa scanlines are compressed as pixels.
+            {
+                const int w = size / 4;
+                const std::vector<quint8> data = corpus(w, 4, 8);
+                std::vector<quint8> rle(RLEUtil::packetsMaxByteCount(w, 4));
+                std::vector<quint8> out(size);
+                timer.start();
+                const quint64 rleSize = RLEUtil::writePackets(data.data(), rle.data(), w, 4);
+                timer.check();
+                DJV_DEBUG_PRINT("Targa write = " << megabytes / timer.seconds() << " MB/s");
+                timer.start();
+                RLEUtil::readPackets(rle.data(), rle.data() + rleSize, out.data(), w, 4, 4);
+                timer.check();
+                DJV_DEBUG_PRINT("Targa read = " << megabytes / timer.seconds() << " MB/s");
+            }
+
+            // SGI scanlines are compressed as 16-bit channels.
+            {
+                const int w = size / 2;
+                const std::vector<quint8> data = corpus(w, 2, 8);
+                std::vector<quint8> rle(SGI::rleMaxByteCount(w, 2));
+                std::vector<quint8> out(size);
+                timer.start();
+                const quint64 rleSize = SGI::writeRle(data.data(), rle.data(), w, 2, false);
+                timer.check();
+                DJV_DEBUG_PRINT("SGI write = " << megabytes / timer.seconds() << " MB/s");
+                timer.start();
+                SGI::readRle(rle.data(), rle.data() + rleSize, out.data(), w, 2, 2, false);
+                timer.check();
+                DJV_DEBUG_PRINT("SGI read = " << megabytes / timer.seconds() << " MB/s");
+            }
+
+            // PIC scanlines are decoded into interleaved pixels.
+            {
+                const int w = size / 4;
+                const std::vector<quint8> data = corpus(w, 3, 8);
+                const std::vector<quint8> rle = picEncode(data.data(), w, 3);
+                std::vector<quint8> out(size);
+                timer.start();
+                PIC::readRle(rle.data(), rle.data() + rle.size(), out.data(), w, 3, 4, false);
+                timer.check();
+                DJV_DEBUG_PRINT("PIC read = " << megabytes / timer.seconds() << " MB/s");
+            }
+
+            // RLA scanlines are decoded a channel at a time into interleaved
+            // pixels. The channel size is limited to 16 bits so the image is
+            // split into scanlines.
+            {
+                const int w = 2048;
+                const int channels = 4;
+                const int h = size / (w * channels);
+                const std::vector<quint8> data = corpus(w * h, channels, 8);
+                std::vector<quint8> file;
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        std::vector<quint8> rle;
+                        rlaEncode(&data[(y * w) * channels + c], w, channels, rle);
+                        file.push_back(rle.size() >> 8);
+                        file.push_back(rle.size() & 0xff);
+                        file.insert(file.end(), rle.begin(), rle.end());
+                    }
+                }
+                std::vector<quint8> out(data.size());
+                const quint8 * p = file.data();
+                const quint8 * const end = file.data() + file.size();
+                timer.start();
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        p = RLA::readRle(p, end, &out[(y * w) * channels + c], w, channels, 1);
+                    }
+                }
+                timer.check();
+                DJV_ASSERT(out == data);
+                DJV_DEBUG_PRINT("RLA read = " << megabytes / timer.seconds() << " MB/s");
+            }
+        }
+
+        std::vector<quint8> RLEUtilTest::corpus(int size, int elementSize, int values)
+        {
+            // Create runs of random length from a small set of element values
+            // so that the data contains both runs and literals.
+            std::vector<quint8> out(size * elementSize);
+            std::vector<quint8> element(elementSize);
+            for (int i = 0; i < size;)
+            {
+                for (int j = 0; j < elementSize; ++j)
+                {
+                    element[j] = randInt(values);
+                }
+                for (int j = 1 + (randInt(2) ? randInt(200) : 0); j > 0 && i < size; --j, ++i)
+                {
+                    memcpy(&out[i * elementSize], element.data(), elementSize);
+                }
+            }
+            return out;
+        }
+
+    } // namespace AVTest
+} // namespace djv
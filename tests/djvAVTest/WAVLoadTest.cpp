@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/WAVLoadTest.h>
+
+#include <djvAV/AVContext.h>
+#include <djvAV/AudioData.h>
+#include <djvAV/IO.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Timer.h>
+
+#include <dr_libs/dr_wav.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            //! Write a WAV file and return the sample data as stored in the file.
+            std::vector<uint8_t> write(
+                const QString & fileName,
+                int             format,
+                int             bitsPerSample,
+                int             channels,
+                int             frames)
+            {
+                std::vector<uint8_t> out(frames * channels * (bitsPerSample / 8));
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    out[i] = static_cast<uint8_t>(i * 7 + i / 251);
+                }
+                if (DR_WAVE_FORMAT_IEEE_FLOAT == format)
+                {
+                    // Keep the floating point samples in range.
+                    float * p = reinterpret_cast<float *>(out.data());
+                    for (size_t i = 0; i < out.size() / 4; ++i)
+                    {
+                        p[i] = (i % 200) / 100.f - 1.f;
+                    }
+                }
+                drwav_data_format dataFormat;
+                dataFormat.container     = drwav_container_riff;
+                dataFormat.format        = format;
+                dataFormat.channels      = channels;
+                dataFormat.sampleRate    = 44100;
+                dataFormat.bitsPerSample = bitsPerSample;
+                drwav * wav = drwav_open_file_write(fileName.toUtf8().data(), &dataFormat);
+                DJV_ASSERT(wav);
+                drwav_write(wav, frames * channels, out.data());
+                drwav_close(wav);
+                return out;
+            }
+
+            //! Read a file in windows of the given size.
+            std::vector<uint8_t> readWindows(Load & load, uint64_t windowSize)
+            {
+                std::vector<uint8_t> out;
+                const AudioInfo & info = load.ioInfo().audio;
+                for (uint64_t offset = 0; offset < info.sampleCount; offset += windowSize)
+                {
+                    AudioData data;
+                    load.read(data, AudioIOInfo(offset, std::min(windowSize, info.sampleCount - offset)));
+                    out.insert(out.end(), data.data(), data.data() + data.byteCount());
+                }
+                return out;
+            }
+
+        } // namespace
+
+        void WAVLoadTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("WAVLoadTest::run");
+            mapped(argc, argv);
+            decoded(argc, argv);
+            if (hasBenchmarks())
+            {
+                benchmark(argc, argv);
+            }
+        }
+
+        void WAVLoadTest::mapped(int & argc, char ** argv)
+        {
+            DJV_DEBUG("WAVLoadTest::mapped");
+            AVContext context(argc, argv);
+            struct Format
+            {
+                int         format;
+                int         bitsPerSample;
+                Audio::TYPE type;
+            };
+            const std::vector<Format> formats =
+            {
+                { DR_WAVE_FORMAT_PCM, 8, Audio::U8 },
+                { DR_WAVE_FORMAT_PCM, 16, Audio::S16 },
+                { DR_WAVE_FORMAT_PCM, 32, Audio::S32 },
+                { DR_WAVE_FORMAT_IEEE_FLOAT, 32, Audio::F32 }
+            };
+            for (const auto & format : formats)
+            {
+                DJV_DEBUG_PRINT("type = " << format.type);
+                const QString fileName = "WAVLoadTest.wav";
+                const auto samples = write(fileName, format.format, format.bitsPerSample, 2, 10000);
+                IOInfo info;
+                auto load = context.ioFactory()->load(FileInfo(fileName), info);
+                DJV_ASSERT(load);
+                DJV_ASSERT(format.type == load->ioInfo().audio.type);
+                DJV_ASSERT(2 == load->ioInfo().audio.channels);
+                DJV_ASSERT(20000 == load->ioInfo().audio.sampleCount);
+
+                // Read the whole file.
+                AudioData data;
+                load->read(data);
+                DJV_ASSERT(data.isMapped());
+                DJV_ASSERT(samples.size() == data.byteCount());
+                DJV_ASSERT(0 == memcmp(samples.data(), data.data(), samples.size()));
+
+                // Read windows, which are views of the same memory.
+                const AudioData & constData = data;
+                AudioData window;
+                load->read(window, AudioIOInfo(1000, 500));
+                DJV_ASSERT(window.isMapped());
+                DJV_ASSERT(constData.data(1000) == static_cast<const AudioData &>(window).data());
+                AudioData copy = window;
+                DJV_ASSERT(copy.isMapped());
+                DJV_ASSERT(copy == window);
+                DJV_ASSERT(samples == readWindows(*load, 4096));
+
+                // Modifying a window copies the data.
+                uint8_t * p = copy.data();
+                DJV_ASSERT(!copy.isMapped());
+                p[0] = ~p[0];
+                DJV_ASSERT(copy != window);
+                DJV_ASSERT(0 == memcmp(samples.data(), constData.data(), samples.size()));
+
+                try
+                {
+                    load->read(window, AudioIOInfo(19990, 20));
+                    DJV_ASSERT(0);
+                }
+                catch (const Error &)
+                {
+                }
+            }
+        }
+
+        void WAVLoadTest::decoded(int & argc, char ** argv)
+        {
+            DJV_DEBUG("WAVLoadTest::decoded");
+            AVContext context(argc, argv);
+
+            // 24-bit samples are decoded to 32-bit.
+            const QString fileName = "WAVLoadTest.wav";
+            write(fileName, DR_WAVE_FORMAT_PCM, 24, 2, 10000);
+            IOInfo info;
+            auto load = context.ioFactory()->load(FileInfo(fileName), info);
+            DJV_ASSERT(load);
+            DJV_ASSERT(Audio::S32 == load->ioInfo().audio.type);
+            AudioData data;
+            load->read(data);
+            DJV_ASSERT(!data.isMapped());
+            const std::vector<uint8_t> samples(data.data(), data.data() + data.byteCount());
+
+            // Sequential windows continue without seeking, random windows seek.
+            DJV_ASSERT(samples == readWindows(*load, 4096));
+            DJV_ASSERT(samples == readWindows(*load, 333));
+            AudioData window;
+            load->read(window, AudioIOInfo(1234, 100));
+            DJV_ASSERT(0 == memcmp(data.data(1234), window.data(), window.byteCount()));
+            load->read(window, AudioIOInfo(10, 100));
+            DJV_ASSERT(0 == memcmp(data.data(10), window.data(), window.byteCount()));
+        }
+
+        void WAVLoadTest::benchmark(int & argc, char ** argv)
+        {
+            DJV_DEBUG("WAVLoadTest::benchmark");
+            AVContext context(argc, argv);
+            const QString fileName = "WAVLoadTest.wav";
+            for (int bitsPerSample : { 16, 24 })
+            {
+                DJV_DEBUG_PRINT("bits per sample = " << bitsPerSample);
+                write(fileName, DR_WAVE_FORMAT_PCM, bitsPerSample, 2, 44100 * 60);
+                IOInfo info;
+                auto load = context.ioFactory()->load(FileInfo(fileName), info);
+                DJV_ASSERT(load);
+                Timer timer;
+                timer.start();
+                AudioData data;
+                load->read(data);
+                timer.check();
+                DJV_DEBUG_PRINT("one read = " << timer.seconds() << " seconds");
+
+                // Reading the file in windows should cost about the same as
+                // reading it all at once.
+                timer.start();
+                const uint64_t windowSize = 4096;
+                const uint64_t sampleCount = load->ioInfo().audio.sampleCount;
+                AudioData window;
+                for (uint64_t offset = 0; offset < sampleCount; offset += windowSize)
+                {
+                    load->read(window, AudioIOInfo(offset, std::min(windowSize, sampleCount - offset)));
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("window reads = " << timer.seconds() << " seconds");
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
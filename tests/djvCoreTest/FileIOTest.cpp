@@ -33,6 +33,8 @@
 #include <djvCore/Debug.h>
 #include <djvCore/FileIO.h>
 
+#include <vector>
+
 using namespace djv::Core;
 
 namespace djv
@@ -197,6 +199,97 @@ namespace djv
                 {
                 }
             }
+            {
+                DJV_DEBUG_PRINT("large endian");
+                // Write more data than fits in the write buffer.
+                std::vector<quint32> write(400000);
+                for (size_t i = 0; i < write.size(); ++i)
+                {
+                    write[i] = static_cast<quint32>(i * 0x01020305);
+                }
+                FileIO io;
+                io.setEndian(true);
+                io.open(fileName, FileIO::WRITE);
+                io.setU32(write.data(), write.size());
+                DJV_ASSERT(write.size() * 4 == io.pos());
+                io.close();
+                io.open(fileName, FileIO::READ);
+#if ! defined (DJV_WINDOWS)
+                const quint8 * p = io.mmapP();
+                for (size_t i = 0; i < write.size(); ++i)
+                {
+                    const quint8 * w = reinterpret_cast<const quint8 *>(&write[i]);
+                    DJV_ASSERT(w[0] == p[i * 4 + 3]);
+                    DJV_ASSERT(w[3] == p[i * 4 + 0]);
+                }
+#endif // DJV_WINDOWS
+                std::vector<quint32> read(write.size());
+                io.getU32(read.data(), read.size());
+                DJV_ASSERT(write == read);
+            }
+            {
+                DJV_DEBUG_PRINT("buffered writes");
+                // Write many small pieces, a large piece that is written
+                // together with the buffered data, and then patch the start
+                // of the file. Preallocating must not change the file size.
+                FileIO io;
+                io.open(fileName, FileIO::WRITE);
+                io.preallocate(16 * 1024 * 1024);
+                const quint32 zero = 0;
+                io.setU32(zero);
+                std::vector<quint8> write;
+                for (int i = 0; i < 300000; ++i)
+                {
+                    const quint8 value = static_cast<quint8>(i);
+                    io.setU8(value);
+                    write.push_back(value);
+                }
+                std::vector<quint8> large(3 * 1024 * 1024, 7);
+                io.set(large.data(), large.size());
+                write.insert(write.end(), large.begin(), large.end());
+                const quint32 size = static_cast<quint32>(write.size());
+                DJV_ASSERT(4 + size == io.pos());
+                io.setPos(0);
+                io.setU32(size);
+                io.close();
+                DJV_ASSERT(0 == io.pos());
+
+                io.open(fileName, FileIO::READ);
+                DJV_ASSERT(4 + size == io.size());
+                quint32 readSize = 0;
+                io.getU32(&readSize);
+                DJV_ASSERT(size == readSize);
+                std::vector<quint8> read(size);
+                io.get(read.data(), read.size());
+                DJV_ASSERT(write == read);
+            }
+            {
+                DJV_DEBUG_PRINT("direct reads");
+                // Use a block size that does not divide the file size.
+                std::vector<quint8> write(1000000);
+                for (size_t i = 0; i < write.size(); ++i)
+                {
+                    write[i] = static_cast<quint8>(i * 7);
+                }
+                FileIO io;
+                io.open(fileName, FileIO::WRITE);
+                io.set(write.data(), write.size());
+                io.close();
+                io.setReadMode(FileIO::READ_DIRECT);
+                io.setBlockSize(64 * 1024);
+                io.open(fileName, FileIO::READ);
+                DJV_ASSERT(write.size() == io.size());
+                DJV_ASSERT(io.mmapEnd() - io.mmapP() == static_cast<ptrdiff_t>(write.size()));
+                std::vector<quint8> read(write.size());
+                io.get(read.data(), read.size());
+                DJV_ASSERT(write == read);
+                io.close();
+
+                const FileIO::READ_MODE readMode = FileIO::defaultReadMode();
+                FileIO::setDefaultReadMode(FileIO::READ_AUTO);
+                DJV_ASSERT(FileIO::READ_MEMORY_MAP == FileIO::defaultReadMode());
+                FileIO::setDefaultReadMode(readMode);
+            }
         }
 
     } // namespace CoreTest
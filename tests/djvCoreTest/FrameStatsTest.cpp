@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/FrameStatsTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FrameStats.h>
+#include <djvCore/Time.h>
+
+#include <QByteArray>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void FrameStatsTest::run(int &, char **)
+        {
+            DJV_DEBUG("FrameStatsTest::run");
+            members();
+            scope();
+            sort();
+            percentile();
+            write();
+        }
+
+        void FrameStatsTest::members()
+        {
+            DJV_DEBUG("FrameStatsTest::members");
+            DJV_ASSERT(FrameStats::STAGE_COUNT == FrameStats::stageLabels().count());
+            FrameStats::clear();
+            DJV_ASSERT(FrameStats::samples().isEmpty());
+        }
+
+        void FrameStatsTest::scope()
+        {
+            DJV_DEBUG("FrameStatsTest::scope");
+            FrameStats::clear();
+            {
+                // Without a current frame nothing is recorded.
+                FrameStats::Scope scope(FrameStats::UPLOAD);
+            }
+            DJV_ASSERT(FrameStats::samples().isEmpty());
+            {
+                FrameStats::Scope scope(FrameStats::DRAW, 10);
+                {
+                    FrameStats::Scope scope(FrameStats::UPLOAD);
+                }
+                {
+                    FrameStats::Scope scope(FrameStats::READ, -2);
+                    {
+                        FrameStats::Scope scope(FrameStats::CONVERT);
+                    }
+                }
+                {
+                    FrameStats::Scope scope(FrameStats::CACHE);
+                }
+            }
+            {
+                FrameStats::Scope scope(FrameStats::UPLOAD);
+            }
+            const QVector<FrameStats::Sample> samples = FrameStats::samples();
+            DJV_ASSERT(5 == samples.count());
+            DJV_ASSERT(FrameStats::DRAW == samples[0].stage);
+            DJV_ASSERT(10 == samples[0].frame);
+            int count[FrameStats::STAGE_COUNT] = { 0, 0, 0, 0, 0 };
+            for (const auto & sample : samples)
+            {
+                DJV_ASSERT(sample.duration >= 0);
+                DJV_ASSERT(sample.start >= samples[0].start);
+                ++count[sample.stage];
+                switch (sample.stage)
+                {
+                case FrameStats::READ:
+                case FrameStats::CONVERT: DJV_ASSERT(-2 == sample.frame); break;
+                default: DJV_ASSERT(10 == sample.frame); break;
+                }
+            }
+            for (int i = 0; i < FrameStats::STAGE_COUNT; ++i)
+            {
+                DJV_ASSERT(1 == count[i]);
+            }
+        }
+
+        void FrameStatsTest::sort()
+        {
+            DJV_DEBUG("FrameStatsTest::sort");
+            FrameStats::clear();
+            const qint64 t = Time::monotonic();
+            FrameStats::add(FrameStats::DRAW, 3, t + 2, 1);
+            FrameStats::add(FrameStats::READ, 1, t, 1);
+            FrameStats::add(FrameStats::CONVERT, 2, t + 1, 1);
+            const QVector<FrameStats::Sample> samples = FrameStats::samples();
+            DJV_ASSERT(3 == samples.count());
+            for (int i = 0; i < samples.count(); ++i)
+            {
+                DJV_ASSERT(i + 1 == samples[i].frame);
+                DJV_ASSERT(t + i == samples[i].start);
+            }
+            DJV_ASSERT(FrameStats::CONVERT == samples[1].stage);
+        }
+
+        void FrameStatsTest::percentile()
+        {
+            DJV_DEBUG("FrameStatsTest::percentile");
+            QVector<FrameStats::Sample> samples;
+            DJV_ASSERT(0.f == FrameStats::percentile(samples, FrameStats::READ, 50.f));
+            for (int i = 1; i <= 100; ++i)
+            {
+                FrameStats::Sample sample;
+                sample.frame = i;
+                sample.stage = FrameStats::READ;
+                sample.duration = i * 1000000;
+                samples.append(sample);
+                sample.stage = FrameStats::DRAW;
+                sample.duration = 1000000;
+                samples.append(sample);
+            }
+            DJV_ASSERT(50.f == FrameStats::percentile(samples, FrameStats::READ, 50.f));
+            DJV_ASSERT(95.f == FrameStats::percentile(samples, FrameStats::READ, 95.f));
+            DJV_ASSERT(100.f == FrameStats::percentile(samples, FrameStats::READ, 100.f));
+            DJV_ASSERT(1.f == FrameStats::percentile(samples, FrameStats::READ, 0.f));
+            DJV_ASSERT(1.f == FrameStats::percentile(samples, FrameStats::DRAW, 95.f));
+            DJV_ASSERT(95.f == FrameStats::percentile(samples, FrameStats::READ, 50.f, 10));
+            DJV_ASSERT(0.f == FrameStats::percentile(samples, FrameStats::CACHE, 50.f));
+        }
+
+        void FrameStatsTest::write()
+        {
+            DJV_DEBUG("FrameStatsTest::write");
+            QVector<FrameStats::Sample> samples;
+            FrameStats::Sample sample;
+            sample.frame = 1;
+            sample.stage = FrameStats::UPLOAD;
+            sample.start = 2;
+            sample.duration = 3;
+            samples.append(sample);
+            {
+                const QString fileName = "FrameStatsTest.csv";
+                FrameStats::write(fileName, samples);
+                FileIO io;
+                io.open(fileName, FileIO::READ);
+                QByteArray b(static_cast<int>(io.size()), 0);
+                io.get(b.data(), b.count());
+                const QString s = QString::fromLatin1(b);
+                DJV_DEBUG_PRINT("csv = " << s);
+                DJV_ASSERT(s.startsWith("frame,stage,start,duration\n"));
+                DJV_ASSERT(s.contains("1,Upload,2,3\n"));
+            }
+            {
+                const QString fileName = "FrameStatsTest.json";
+                FrameStats::write(fileName, samples);
+                FileIO io;
+                io.open(fileName, FileIO::READ);
+                QByteArray b(static_cast<int>(io.size()), 0);
+                io.get(b.data(), b.count());
+                const QString s = QString::fromLatin1(b);
+                DJV_DEBUG_PRINT("json = " << s);
+                DJV_ASSERT(s.contains("\"samples\""));
+                DJV_ASSERT(s.contains("\"Upload\""));
+            }
+            try
+            {
+                FrameStats::write("", samples);
+                DJV_ASSERT(0);
+            }
+            catch (const Error &)
+            {}
+        }
+
+    } // namespace CoreTest
+} // namespace djv
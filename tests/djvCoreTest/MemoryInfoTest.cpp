@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/MemoryInfoTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/MemoryInfo.h>
+
+#include <QByteArray>
+#include <QString>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void MemoryInfoTest::run(int &, char **)
+        {
+            DJV_DEBUG("MemoryInfoTest::run");
+            members();
+            parse();
+        }
+
+        void MemoryInfoTest::members()
+        {
+            DJV_DEBUG("MemoryInfoTest::members");
+            {
+                const MemoryInfo info = MemoryInfo::current();
+                DJV_DEBUG_PRINT("total = " << Memory::sizeLabel(info.total));
+                DJV_DEBUG_PRINT("available = " << Memory::sizeLabel(info.available));
+                DJV_DEBUG_PRINT("limit = " << Memory::sizeLabel(info.limit));
+                DJV_DEBUG_PRINT("usage = " << Memory::sizeLabel(info.usage));
+                DJV_DEBUG_PRINT("pressure = " << info.pressure);
+                DJV_ASSERT(info.processAvailable() <= info.processTotal() || !info.processTotal());
+            }
+            {
+                MemoryInfo info;
+                DJV_ASSERT(0 == info.processAvailable());
+                DJV_ASSERT(0 == info.processTotal());
+                info.total = 8 * Memory::gigabyte;
+                info.available = 6 * Memory::gigabyte;
+                DJV_ASSERT(6 * Memory::gigabyte == info.processAvailable());
+                DJV_ASSERT(8 * Memory::gigabyte == info.processTotal());
+                info.limit = 4 * Memory::gigabyte;
+                info.usage = 3 * Memory::gigabyte;
+                DJV_ASSERT(1 * Memory::gigabyte == info.processAvailable());
+                DJV_ASSERT(4 * Memory::gigabyte == info.processTotal());
+                info.usage = 5 * Memory::gigabyte;
+                DJV_ASSERT(0 == info.processAvailable());
+            }
+        }
+
+        void MemoryInfoTest::parse()
+        {
+            DJV_DEBUG("MemoryInfoTest::parse");
+            {
+                MemoryInfo info;
+                MemoryInfo::parseMemInfo(
+                    "MemTotal:       16318412 kB\n"
+                    "MemFree:         1022844 kB\n"
+                    "MemAvailable:    9341268 kB\n"
+                    "Buffers:          474780 kB\n"
+                    "Cached:          7838452 kB\n",
+                    info);
+                DJV_ASSERT(16318412 * Memory::kilobyte == info.total);
+                DJV_ASSERT(9341268 * Memory::kilobyte == info.available);
+            }
+            {
+                MemoryInfo info;
+                MemoryInfo::parseMemInfo(
+                    "MemTotal:       16318412 kB\n"
+                    "MemFree:         1000000 kB\n"
+                    "Buffers:          200000 kB\n"
+                    "Cached:          3000000 kB\n",
+                    info);
+                DJV_ASSERT(4200000 * Memory::kilobyte == info.available);
+            }
+            {
+                QString v2Path;
+                QString v1Path;
+                MemoryInfo::parseCGroup(
+                    "12:pids:/user.slice\n"
+                    "4:cpu,cpuacct:/user.slice\n"
+                    "3:memory:/user.slice/session-2.scope\n"
+                    "0::/user.slice/session-2.scope\n",
+                    v2Path,
+                    v1Path);
+                DJV_ASSERT("/user.slice/session-2.scope" == v2Path);
+                DJV_ASSERT("/user.slice/session-2.scope" == v1Path);
+                MemoryInfo::parseCGroup("0::/\n", v2Path, v1Path);
+                DJV_ASSERT("/" == v2Path);
+                DJV_ASSERT(v1Path.isEmpty());
+                MemoryInfo::parseCGroup("", v2Path, v1Path);
+                DJV_ASSERT(v2Path.isEmpty());
+                DJV_ASSERT(v1Path.isEmpty());
+            }
+            {
+                DJV_ASSERT(0 == MemoryInfo::parseCGroupValue("max\n"));
+                DJV_ASSERT(0 == MemoryInfo::parseCGroupValue("9223372036854771712\n"));
+                DJV_ASSERT(0 == MemoryInfo::parseCGroupValue(""));
+                DJV_ASSERT(2147483648ULL == MemoryInfo::parseCGroupValue("2147483648\n"));
+            }
+            {
+                DJV_ASSERT(Math::fuzzyCompare(12.5f, MemoryInfo::parsePressure(
+                    "some avg10=12.50 avg60=3.00 avg300=1.00 total=123456\n"
+                    "full avg10=2.00 avg60=0.00 avg300=0.00 total=1234\n")));
+                DJV_ASSERT(-1.f == MemoryInfo::parsePressure(""));
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
@@ -35,6 +35,8 @@
 
 #include <QString>
 
+#include <vector>
+
 using namespace djv::Core;
 
 namespace djv
@@ -45,6 +47,7 @@ namespace djv
         {
             DJV_DEBUG("MemoryTest::run");
             members();
+            endian();
         }
 
         void MemoryTest::members()
@@ -167,5 +170,41 @@ namespace djv
             }
         }
 
+        void MemoryTest::endian()
+        {
+            DJV_DEBUG("MemoryTest::endian");
+            for (int wordSize : { 1, 2, 3, 4, 8 })
+            {
+                // Use different sizes and offsets to cover the vectorized code
+                // and the remainders.
+                for (int size = 0; size < 300; size += 7)
+                {
+                    for (int offset = 0; offset < 3; ++offset)
+                    {
+                        const int byteCount = size * wordSize;
+                        std::vector<quint8> in(offset + byteCount);
+                        for (size_t i = 0; i < in.size(); ++i)
+                        {
+                            in[i] = static_cast<quint8>(i * 7 + 3);
+                        }
+                        std::vector<quint8> out(offset + byteCount);
+                        Memory::convertEndian(in.data() + offset, out.data() + offset, size, wordSize);
+                        std::vector<quint8> inPlace = in;
+                        Memory::convertEndian(inPlace.data() + offset, size, wordSize);
+                        const bool swap = 2 == wordSize || 4 == wordSize || 8 == wordSize;
+                        for (int i = 0; i < size; ++i)
+                        {
+                            for (int j = 0; j < wordSize; ++j)
+                            {
+                                const quint8 value = in[offset + i * wordSize + (swap ? (wordSize - 1 - j) : j)];
+                                DJV_ASSERT(value == out[offset + i * wordSize + j]);
+                                DJV_ASSERT(value == inPlace[offset + i * wordSize + j]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
     } // namespace CoreTest
 } // namespace djv
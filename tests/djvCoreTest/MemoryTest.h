@@ -42,6 +42,7 @@ namespace djv
 
         private:
             void members();
+            void endian();
         };
 
     } // namespace CoreTest
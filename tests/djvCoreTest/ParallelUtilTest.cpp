@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/ParallelUtilTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/ParallelUtil.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void ParallelUtilTest::run(int &, char **)
+        {
+            DJV_DEBUG("ParallelUtilTest::run");
+            forEach();
+            forBands();
+            exceptions();
+        }
+
+        void ParallelUtilTest::forEach()
+        {
+            DJV_DEBUG("ParallelUtilTest::forEach");
+            DJV_DEBUG_PRINT("thread count = " << ParallelUtil::threadCount());
+            DJV_ASSERT(ParallelUtil::threadCount() >= 1);
+            {
+                std::vector<int> data(1000, 0);
+                ParallelUtil::forEach(static_cast<int>(data.size()), [&data](int i)
+                {
+                    data[i] = i;
+                });
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    DJV_ASSERT(static_cast<int>(i) == data[i]);
+                }
+            }
+            {
+                std::atomic<int> count(0);
+                ParallelUtil::forEach(10, [&count](int)
+                {
+                    ParallelUtil::forEach(10, [&count](int)
+                    {
+                        ++count;
+                    });
+                });
+                DJV_ASSERT(100 == count);
+            }
+            {
+                const int threadCount = ParallelUtil::threadCount();
+                ParallelUtil::setThreadCount(1);
+                DJV_ASSERT(1 == ParallelUtil::threadCount());
+                std::atomic<int> count(0);
+                ParallelUtil::forEach(10, [&count](int)
+                {
+                    ++count;
+                });
+                DJV_ASSERT(10 == count);
+                ParallelUtil::setThreadCount(threadCount);
+                DJV_ASSERT(threadCount == ParallelUtil::threadCount());
+            }
+        }
+
+        void ParallelUtilTest::forBands()
+        {
+            DJV_DEBUG("ParallelUtilTest::forBands");
+            {
+                std::vector<int> data(1001, 0);
+                ParallelUtil::forBands(static_cast<int>(data.size()), 16, [&data](int start, int end)
+                {
+                    DJV_ASSERT(start < end);
+                    for (int i = start; i < end; ++i)
+                    {
+                        ++data[i];
+                    }
+                });
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    DJV_ASSERT(1 == data[i]);
+                }
+            }
+            {
+                std::atomic<int> bands(0);
+                ParallelUtil::forBands(10, 100, [&bands](int start, int end)
+                {
+                    DJV_ASSERT(0 == start);
+                    DJV_ASSERT(10 == end);
+                    ++bands;
+                });
+                DJV_ASSERT(1 == bands);
+            }
+        }
+
+        void ParallelUtilTest::exceptions()
+        {
+            DJV_DEBUG("ParallelUtilTest::exceptions");
+            bool caught = false;
+            try
+            {
+                ParallelUtil::forEach(100, [](int i)
+                {
+                    if (50 == i)
+                    {
+                        throw std::runtime_error("error");
+                    }
+                });
+            }
+            catch (const std::exception &)
+            {
+                caught = true;
+            }
+            DJV_ASSERT(caught);
+        }
+
+    } // namespace CoreTest
+} // namespace djv
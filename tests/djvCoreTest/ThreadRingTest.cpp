@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/ThreadRingTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/ThreadRing.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void ThreadRingTest::run(int &, char **)
+        {
+            DJV_DEBUG("ThreadRingTest::run");
+            members();
+            overflow();
+            threads();
+        }
+
+        namespace
+        {
+            struct Value
+            {
+                qint64 a = 0;
+                qint8  b = 0;
+            };
+
+            typedef ThreadRing<Value, 16> Rings;
+
+        } // namespace
+
+        void ThreadRingTest::members()
+        {
+            DJV_DEBUG("ThreadRingTest::members");
+            DJV_ASSERT(Rings::items().empty());
+            const int thread = Rings::thread();
+            DJV_ASSERT(thread > 0);
+            DJV_ASSERT(Rings::thread() == thread);
+            for (int i = 0; i < 3; ++i)
+            {
+                Value value;
+                value.a = i;
+                value.b = static_cast<qint8>(-i);
+                Rings::add(value);
+            }
+            auto items = Rings::items();
+            DJV_ASSERT(3 == items.size());
+            for (int i = 0; i < 3; ++i)
+            {
+                DJV_ASSERT(thread == items[i].thread);
+                DJV_ASSERT(i == items[i].value.a);
+                DJV_ASSERT(-i == items[i].value.b);
+            }
+            Rings::clear();
+            DJV_ASSERT(Rings::items().empty());
+            Rings::add(Value());
+            DJV_ASSERT(1 == Rings::items().size());
+            Rings::clear();
+        }
+
+        void ThreadRingTest::overflow()
+        {
+            DJV_DEBUG("ThreadRingTest::overflow");
+            for (int i = 0; i < 100; ++i)
+            {
+                Value value;
+                value.a = i;
+                Rings::add(value);
+            }
+
+            // The two oldest slots may be in the middle of being written, so
+            // they are not returned.
+            const auto items = Rings::items();
+            DJV_ASSERT(14 == items.size());
+            DJV_ASSERT(86 == items.front().value.a);
+            DJV_ASSERT(99 == items.back().value.a);
+            Rings::clear();
+        }
+
+        void ThreadRingTest::threads()
+        {
+            DJV_DEBUG("ThreadRingTest::threads");
+            std::atomic<int> count(0);
+            std::atomic<bool> done(false);
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; ++i)
+            {
+                threads.push_back(std::thread([i, &count, &done]
+                {
+                    for (int j = 0; j < 10; ++j)
+                    {
+                        Value value;
+                        value.a = i;
+                        Rings::add(value);
+                    }
+                    ++count;
+                    while (!done)
+                    {
+                        std::this_thread::yield();
+                    }
+                }));
+            }
+            while (count < 4)
+            {
+                std::this_thread::yield();
+            }
+            const auto items = Rings::items();
+            done = true;
+            for (auto & thread : threads)
+            {
+                thread.join();
+            }
+            DJV_ASSERT(40 == items.size());
+            for (const auto & item : items)
+            {
+                DJV_ASSERT(item.thread != Rings::thread());
+            }
+
+            // The rings are released when the threads exit.
+            DJV_ASSERT(Rings::items().empty());
+        }
+
+    } // namespace CoreTest
+} // namespace djv
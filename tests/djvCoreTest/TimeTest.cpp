@@ -54,6 +54,9 @@ namespace djv
         {
             DJV_DEBUG("TimeTest::current");
             DJV_DEBUG_PRINT(Time::timeToString(Time::current()));
+            const qint64 t = Time::monotonic();
+            Time::msleep(1);
+            DJV_ASSERT(Time::monotonic() - t >= 1000000);
         }
 
         void TimeTest::sleep()
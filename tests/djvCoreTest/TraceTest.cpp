@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/TraceTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Time.h>
+#include <djvCore/Trace.h>
+
+#include <QByteArray>
+
+#include <string.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void TraceTest::run(int &, char **)
+        {
+            DJV_DEBUG("TraceTest::run");
+            zone();
+            sort();
+            names();
+            write();
+        }
+
+        void TraceTest::zone()
+        {
+            DJV_DEBUG("TraceTest::zone");
+            Trace::clear();
+            DJV_ASSERT(Trace::events().isEmpty());
+            {
+                Trace::Zone zone("a");
+                {
+                    Trace::Zone zone("b");
+                }
+            }
+            const QVector<Trace::Event> events = Trace::events();
+            DJV_ASSERT(2 == events.count());
+            DJV_ASSERT(0 == strcmp("a", events[0].name));
+            DJV_ASSERT(0 == strcmp("b", events[1].name));
+            DJV_ASSERT(events[0].thread == events[1].thread);
+            DJV_ASSERT(events[1].start >= events[0].start);
+            DJV_ASSERT(events[1].start + events[1].duration <= events[0].start + events[0].duration);
+        }
+
+        void TraceTest::sort()
+        {
+            DJV_DEBUG("TraceTest::sort");
+            Trace::clear();
+            const qint64 t = Time::monotonic();
+            Trace::add("c", t + 2, 1);
+            Trace::add("a", t, 3);
+            Trace::add("b", t + 1, 1);
+            const QVector<Trace::Event> events = Trace::events();
+            DJV_ASSERT(3 == events.count());
+            DJV_ASSERT(0 == strcmp("a", events[0].name));
+            DJV_ASSERT(0 == strcmp("b", events[1].name));
+            DJV_ASSERT(0 == strcmp("c", events[2].name));
+            DJV_ASSERT(3 == events[0].duration);
+        }
+
+        void TraceTest::names()
+        {
+            DJV_DEBUG("TraceTest::names");
+            Trace::clear();
+            Trace::setThreadName("TraceTest");
+            {
+                Trace::Zone zone("zone");
+            }
+            const QVector<Trace::Event> events = Trace::events();
+            DJV_ASSERT(1 == events.count());
+            DJV_ASSERT(events[0].thread > 0);
+            DJV_ASSERT("TraceTest" == Trace::threadNames()[events[0].thread]);
+        }
+
+        void TraceTest::write()
+        {
+            DJV_DEBUG("TraceTest::write");
+            Trace::clear();
+            Trace::setThreadName("TraceTest");
+            {
+                Trace::Zone zone("TraceTest::write");
+            }
+            const QString fileName = "TraceTest.json";
+            Trace::write(fileName);
+            FileIO io;
+            io.open(fileName, FileIO::READ);
+            QByteArray b(static_cast<int>(io.size()), 0);
+            io.get(b.data(), b.count());
+            const QString s = QString::fromLatin1(b);
+            DJV_DEBUG_PRINT("json = " << s);
+            DJV_ASSERT(s.contains("\"traceEvents\""));
+            DJV_ASSERT(s.contains("\"TraceTest::write\""));
+            DJV_ASSERT(s.contains("\"thread_name\""));
+            try
+            {
+                Trace::write("");
+                DJV_ASSERT(0);
+            }
+            catch (const Error &)
+            {}
+        }
+
+    } // namespace CoreTest
+} // namespace djv
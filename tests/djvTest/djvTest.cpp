@@ -27,12 +27,15 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
+#include <djvAVTest/AsyncSaveTest.h>
 #include <djvAVTest/AudioDataTest.h>
+#include <djvAVTest/AudioResamplerTest.h>
 #include <djvAVTest/AudioTest.h>
 #include <djvAVTest/AVContextTest.h>
 #include <djvAVTest/ColorProfileTest.h>
 #include <djvAVTest/ColorTest.h>
 #include <djvAVTest/ColorUtilTest.h>
+#include <djvAVTest/CompressedPixelDataTest.h>
 #include <djvAVTest/ImageIOFormatsTest.h>
 #include <djvAVTest/ImageIOTest.h>
 #include <djvAVTest/ImageTest.h>
@@ -41,7 +44,9 @@
 #include <djvAVTest/PixelDataTest.h>
 #include <djvAVTest/PixelDataUtilTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/RLEUtilTest.h>
 #include <djvAVTest/TagsTest.h>
+#include <djvAVTest/WAVLoadTest.h>
 
 #include <djvCoreTest/BoxTest.h>
 #include <djvCoreTest/BoxUtilTest.h>
@@ -52,20 +57,27 @@
 #include <djvCoreTest/FileInfoUtilTest.h>
 #include <djvCoreTest/FileIOTest.h>
 #include <djvCoreTest/FileIOUtilTest.h>
+#include <djvCoreTest/FrameStatsTest.h>
 #include <djvCoreTest/ListUtilTest.h>
 #include <djvCoreTest/MathTest.h>
+#include <djvCoreTest/MemoryInfoTest.h>
 #include <djvCoreTest/MemoryTest.h>
+#include <djvCoreTest/ParallelUtilTest.h>
 #include <djvCoreTest/RangeTest.h>
 #include <djvCoreTest/SequenceTest.h>
 #include <djvCoreTest/SignalBlockerTest.h>
 #include <djvCoreTest/SpeedTest.h>
 #include <djvCoreTest/StringUtilTest.h>
 #include <djvCoreTest/SystemTest.h>
+#include <djvCoreTest/ThreadRingTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/TimerTest.h>
+#include <djvCoreTest/TraceTest.h>
 #include <djvCoreTest/UserTest.h>
 #include <djvCoreTest/VectorUtilTest.h>
 
+#include <djvViewLibTest/FileCacheTest.h>
+
 #include <djvCore/CoreContext.h>
 
 #include <QApplication>
@@ -91,26 +103,34 @@ int main(int argc, char ** argv)
             new CoreTest::FileInfoUtilTest <<
             new CoreTest::FileIOTest <<
             new CoreTest::FileIOUtilTest <<
+            new CoreTest::FrameStatsTest <<
             new CoreTest::ListUtilTest <<
             new CoreTest::MathTest <<
+            new CoreTest::MemoryInfoTest <<
             new CoreTest::MemoryTest <<
+            new CoreTest::ParallelUtilTest <<
             new CoreTest::RangeTest <<
             new CoreTest::SequenceTest <<
             new CoreTest::SignalBlockerTest <<
             new CoreTest::SpeedTest <<
             new CoreTest::StringUtilTest <<
             new CoreTest::SystemTest <<
+            new CoreTest::ThreadRingTest <<
             new CoreTest::TimeTest <<
             new CoreTest::TimerTest <<
+            new CoreTest::TraceTest <<
             new CoreTest::UserTest <<
             new CoreTest::VectorUtilTest <<
 
+            new AVTest::AsyncSaveTest <<
             new AVTest::AudioDataTest <<
+            new AVTest::AudioResamplerTest <<
             new AVTest::AudioTest <<
             new AVTest::AVContextTest <<
             new AVTest::ColorProfileTest <<
             new AVTest::ColorTest <<
             new AVTest::ColorUtilTest <<
+            new AVTest::CompressedPixelDataTest <<
             new AVTest::ImageIOFormatsTest <<
             new AVTest::ImageIOTest <<
             new AVTest::ImageTest <<
@@ -119,7 +139,11 @@ int main(int argc, char ** argv)
             new AVTest::PixelDataTest <<
             new AVTest::PixelDataUtilTest <<
             new AVTest::PixelTest <<
-            new AVTest::TagsTest;
+            new AVTest::RLEUtilTest <<
+            new AVTest::TagsTest <<
+            new AVTest::WAVLoadTest <<
+
+            new ViewLibTest::FileCacheTest;
 
         for (int i = 0; i < tests.count(); ++i)
         {
@@ -29,6 +29,8 @@
 
 #include <djvTestLib/AbstractTest.h>
 
+#include <djvCore/System.h>
+
 namespace djv
 {
     namespace TestLib
@@ -36,5 +38,10 @@ namespace djv
         AbstractTest::~AbstractTest()
         {}
 
+        bool AbstractTest::hasBenchmarks()
+        {
+            return !Core::System::env("DJV_TEST_BENCHMARK").isEmpty();
+        }
+
     } // namespace TestLib
 } // namespace djv
@@ -45,6 +45,11 @@ namespace djv
             virtual ~AbstractTest() = 0;
 
             virtual void run(int & argc, char ** argv) = 0;
+
+            //! Get whether the benchmarks are enabled. Benchmarks only print
+            //! timings, so they are skipped unless the DJV_TEST_BENCHMARK
+            //! environment variable is set.
+            static bool hasBenchmarks();
         };
 
     } // namespace TestLib
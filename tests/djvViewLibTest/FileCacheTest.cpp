@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvViewLibTest/FileCacheTest.h>
+
+#include <djvViewLib/FileCache.h>
+#include <djvViewLib/FilePrefs.h>
+#include <djvViewLib/ViewContext.h>
+
+#include <djvAV/Image.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Memory.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace ViewLibTest
+    {
+        void FileCacheTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheTest::run");
+            ViewLib::ViewContext context(argc, argv);
+            auto filePrefs = context.filePrefs();
+            const bool adaptive = filePrefs->isCacheAdaptive();
+            const bool compression = filePrefs->hasCacheCompression();
+            const bool diskCache = filePrefs->hasDiskCache();
+            filePrefs->setCacheAdaptive(false);
+            filePrefs->setDiskCache(false);
+            references(&context, false);
+            references(&context, true);
+            filePrefs->setCacheAdaptive(adaptive);
+            filePrefs->setCacheCompression(compression);
+            filePrefs->setDiskCache(diskCache);
+        }
+
+        void FileCacheTest::references(ViewLib::ViewContext * context, bool compression)
+        {
+            DJV_DEBUG("FileCacheTest::references");
+            DJV_DEBUG_PRINT("compression = " << compression);
+            context->filePrefs()->setCacheCompression(compression);
+            ViewLib::FileCache cache(context);
+            const AV::PixelDataInfo info(256, 256, AV::Pixel::RGBA_U8);
+            cache.setMaxSizeGB(4 * info.dataByteCount() / static_cast<float>(Core::Memory::gigabyte));
+
+            // Fill the cache past the maximum size, the references to the items
+            // that are removed should be removed with them.
+            std::vector<ViewLib::FileCacheKey> keys;
+            for (int i = 0; i < 100; ++i)
+            {
+                ViewLib::FileCacheKey key(&cache, i);
+                key.source = "FileCacheTest";
+                key.sourceFrame = i;
+                keys.push_back(key);
+                cache.addItem(key, std::shared_ptr<AV::Image>(new AV::Image(info)));
+            }
+            size_t count = 0;
+            for (const auto & key : keys)
+            {
+                if (cache.hasItem(key))
+                {
+                    ++count;
+                }
+            }
+            DJV_DEBUG_PRINT("count = " << count);
+            DJV_ASSERT(count == cache.referenceCount());
+            if (!compression)
+            {
+                DJV_ASSERT(count < keys.size());
+            }
+
+            cache.clearItems(&cache);
+            DJV_ASSERT(0 == cache.referenceCount());
+        }
+
+    } // namespace ViewLibTest
+} // namespace djv